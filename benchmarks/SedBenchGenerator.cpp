@@ -0,0 +1,261 @@
+/**
+ * @file    SedBenchGenerator.cpp
+ * @brief   Generates synthetic SED-ML documents for benchmarks.
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SEDML, and the latest version of libSEDML.
+ *
+ * Copyright (c) 2013, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ------------------------------------------------------------------------ -->
+ */
+
+#include "SedBenchGenerator.h"
+
+#include <cstdlib>
+#include <sstream>
+#include <sbml/math/L3Parser.h>
+
+using namespace std;
+
+
+SedBenchOptions::SedBenchOptions()
+  : numDataGenerators(1000)
+  , numTasks(0)
+  , numModels(0)
+  , nestingDepth(3)
+  , rangeSize(1000)
+  , notesSize(0)
+  , annotationSize(0)
+{
+}
+
+
+bool
+setBenchOption(SedBenchOptions& options,
+               const string& name, const string& value)
+{
+  char* end = NULL;
+  unsigned long number = strtoul(value.c_str(), &end, 10);
+
+  if (value.empty() || *end != '\0')
+    return false;
+
+  unsigned int* target = NULL;
+
+  if (name == "--data-generators")
+    target = &options.numDataGenerators;
+  else if (name == "--tasks")
+    target = &options.numTasks;
+  else if (name == "--models")
+    target = &options.numModels;
+  else if (name == "--depth")
+    target = &options.nestingDepth;
+  else if (name == "--range-size")
+    target = &options.rangeSize;
+  else if (name == "--notes-size")
+    target = &options.notesSize;
+  else if (name == "--annotation-size")
+    target = &options.annotationSize;
+
+  if (target == NULL)
+    return false;
+
+  *target = (unsigned int)number;
+  return true;
+}
+
+
+string
+getBenchOptionsUsage()
+{
+  return
+    "  --data-generators N  number of data generators (1000)\n"
+    "  --tasks N            number of tasks (data generators / 10)\n"
+    "  --models N           number of models (tasks / 10)\n"
+    "  --depth N            nesting depth of repeated tasks (3)\n"
+    "  --range-size N       values of the outer vector range (1000)\n"
+    "  --notes-size N       characters of notes per data generator (0)\n"
+    "  --annotation-size N  characters of annotation per data generator (0)\n";
+}
+
+
+static string
+makeId(const char* prefix, unsigned int n)
+{
+  ostringstream id;
+  id << prefix << n;
+  return id.str();
+}
+
+
+static void
+setMath(SedDataGenerator* dg, const string& formula)
+{
+  ASTNode* math = SBML_parseL3Formula(formula.c_str());
+  dg->setMath(math);
+  delete math;
+}
+
+
+static void
+setMath(SedSetValue* setValue, const string& formula)
+{
+  ASTNode* math = SBML_parseL3Formula(formula.c_str());
+  setValue->setMath(math);
+  delete math;
+}
+
+
+SedDocument*
+createBenchDocument(const SedBenchOptions& options)
+{
+  unsigned int numDataGenerators = options.numDataGenerators;
+  unsigned int numTasks = options.numTasks != 0
+    ? options.numTasks : (numDataGenerators + 9) / 10;
+
+  if (numTasks == 0)
+    numTasks = 1;
+
+  unsigned int numModels = options.numModels != 0
+    ? options.numModels : (numTasks + 9) / 10;
+
+  SedDocument* doc = new SedDocument(1, 4);
+
+  for (unsigned int i = 0; i < numModels; ++i)
+    {
+      SedModel* model = doc->createModel();
+      model->setId(makeId("model", i));
+      model->setLanguage("urn:sedml:language:sbml");
+      model->setSource(makeId("model", i) + ".xml");
+
+      SedChangeAttribute* change = model->createChangeAttribute();
+      change->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/"
+                        "sbml:parameter[@id='k1']/@value");
+      change->setNewValue("0.5");
+    }
+
+  SedUniformTimeCourse* sim = doc->createUniformTimeCourse();
+  sim->setId("sim0");
+  sim->setInitialTime(0);
+  sim->setOutputStartTime(0);
+  sim->setOutputEndTime(100);
+  sim->setNumberOfPoints(1000);
+  sim->createAlgorithm()->setKisaoID("KISAO:0000019");
+
+  for (unsigned int i = 0; i < numTasks; ++i)
+    {
+      SedTask* task = doc->createTask();
+      task->setId(makeId("task", i));
+      task->setModelReference(makeId("model", i % numModels));
+      task->setSimulationReference("sim0");
+    }
+
+  // repeated tasks nested inside each other, the innermost one running
+  // the first task; the outer one scans a large vector range
+  for (unsigned int depth = 0; depth < options.nestingDepth; ++depth)
+    {
+      SedRepeatedTask* repeated = doc->createRepeatedTask();
+      repeated->setId(makeId("repeated", depth));
+      repeated->setRangeId(makeId("range", depth));
+      repeated->setResetModel(true);
+
+      if (depth == 0)
+        {
+          SedVectorRange* range = repeated->createVectorRange();
+          range->setId(makeId("range", depth));
+
+          for (unsigned int i = 0; i < options.rangeSize; ++i)
+            range->addValue(i * 0.001);
+        }
+      else
+        {
+          SedUniformRange* range = repeated->createUniformRange();
+          range->setId(makeId("range", depth));
+          range->setStart(0);
+          range->setEnd(1);
+          range->setNumberOfPoints(10);
+          range->setType("linear");
+        }
+
+      SedSetValue* setValue = repeated->createTaskChange();
+      setValue->setModelReference("model0");
+      setValue->setRange(makeId("range", depth));
+      setValue->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/"
+                          "sbml:parameter[@id='k1']/@value");
+      setMath(setValue, makeId("range", depth));
+
+      repeated->createSubTask()->setTask(depth + 1 < options.nestingDepth
+                                         ? makeId("repeated", depth + 1)
+                                         : string("task0"));
+    }
+
+  string notes;
+
+  if (options.notesSize > 0)
+    notes = "<p xmlns='http://www.w3.org/1999/xhtml'>" +
+            string(options.notesSize, 'n') + "</p>";
+
+  string annotation;
+
+  if (options.annotationSize > 0)
+    annotation = "<annotation><bench xmlns='http://sed-ml.org/bench'>" +
+                 string(options.annotationSize, 'a') +
+                 "</bench></annotation>";
+
+  SedReport* report = doc->createReport();
+  report->setId("report0");
+
+  for (unsigned int i = 0; i < numDataGenerators; ++i)
+    {
+      SedDataGenerator* dg = doc->createDataGenerator();
+      dg->setId(makeId("dg", i));
+      dg->setName(makeId("data generator ", i));
+
+      SedVariable* var = dg->createVariable();
+      var->setId(makeId("v", i));
+      var->setTaskReference(makeId("task", i % numTasks));
+      var->setTarget("/sbml:sbml/sbml:model/sbml:listOfSpecies/"
+                     "sbml:species[@id='" + makeId("S", i % 50) + "']");
+
+      SedParameter* p = dg->createParameter();
+      p->setId(makeId("p", i));
+      p->setValue(1.0 + i);
+
+      setMath(dg, makeId("v", i) + " * " + makeId("p", i));
+
+      if (!notes.empty())
+        dg->setNotes(notes);
+
+      if (!annotation.empty())
+        dg->setAnnotation(annotation);
+
+      SedDataSet* ds = report->createDataSet();
+      ds->setId(makeId("ds", i));
+      ds->setLabel(makeId("dg", i));
+      ds->setDataReference(makeId("dg", i));
+    }
+
+  return doc;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file    SedBenchGenerator.h
+ * @brief   Generates synthetic SED-ML documents for benchmarks.
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SEDML, and the latest version of libSEDML.
+ *
+ * Copyright (c) 2013, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ------------------------------------------------------------------------ -->
+ */
+
+#ifndef SedBenchGenerator_h
+#define SedBenchGenerator_h
+
+#include <string>
+#include <sedml/SedTypes.h>
+
+LIBSEDML_CPP_NAMESPACE_USE
+
+
+/**
+ * The size and shape of a generated document.
+ */
+struct SedBenchOptions
+{
+  /** the number of data generators, each with a variable, a parameter
+   * and a data set in the report */
+  unsigned int numDataGenerators;
+
+  /** the number of tasks; 0 for one per ten data generators */
+  unsigned int numTasks;
+
+  /** the number of models; 0 for one per ten tasks */
+  unsigned int numModels;
+
+  /** the number of repeated tasks nested inside each other */
+  unsigned int nestingDepth;
+
+  /** the number of values of the vector range of the outer repeated
+   * task */
+  unsigned int rangeSize;
+
+  /** the number of characters of the notes of each data generator */
+  unsigned int notesSize;
+
+  /** the number of characters of the annotation of each data generator */
+  unsigned int annotationSize;
+
+  SedBenchOptions();
+};
+
+
+/**
+ * Sets an option from its command line name, such as
+ * "--data-generators", and value.
+ *
+ * @return true if the option is known and its value a number.
+ */
+bool
+setBenchOption(SedBenchOptions& options,
+               const std::string& name, const std::string& value);
+
+
+/**
+ * Returns the command line options understood by setBenchOption(), for
+ * usage messages.
+ */
+std::string
+getBenchOptionsUsage();
+
+
+/**
+ * Creates a SED-ML Level 1 Version 4 document of the given size; the
+ * caller owns the document.
+ */
+SedDocument*
+createBenchDocument(const SedBenchOptions& options);
+
+
+#endif  /* SedBenchGenerator_h */
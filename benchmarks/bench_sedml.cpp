@@ -0,0 +1,415 @@
+/**
+ * @file    bench_sedml.cpp
+ * @brief   Measures reading, writing and querying large SED-ML documents.
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SEDML, and the latest version of libSEDML.
+ *
+ * Copyright (c) 2013, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ------------------------------------------------------------------------ -->
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include <sbml/util/List.h>
+#include <sedml/common/libsedml-version.h>
+
+#include "SedBenchGenerator.h"
+
+using namespace std;
+LIBSEDML_CPP_NAMESPACE_USE
+
+
+/*
+ * The timings of one operation at one scale.
+ */
+struct BenchResult
+{
+  string name;
+  unsigned int scale;
+  unsigned int repeat;
+  double minSeconds;
+  double meanSeconds;
+  double items;
+  double bytes;
+  long maxRss;
+  bool ok;
+};
+
+
+/*
+ * Returns the peak resident set size of the process, in kilobytes, or 0
+ * where it is not known.
+ */
+static long
+getMaxRss()
+{
+#ifdef _WIN32
+  return 0;
+#else
+  struct rusage usage;
+
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif
+#endif
+}
+
+
+static double
+getFileSize(const string& filename)
+{
+  ifstream file(filename.c_str(), ios::in | ios::binary | ios::ate);
+  return file ? (double)file.tellg() : 0.0;
+}
+
+
+/*
+ * Runs the given operation repeat times, and records how long it took.
+ */
+template <typename Operation>
+static void
+measure(vector<BenchResult>& results, const string& name, unsigned int scale,
+        unsigned int repeat, double items, Operation operation)
+{
+  BenchResult result;
+  result.name = name;
+  result.scale = scale;
+  result.repeat = repeat;
+  result.minSeconds = 0;
+  result.meanSeconds = 0;
+  result.items = items;
+  result.bytes = 0;
+  result.ok = true;
+
+  double total = 0;
+
+  for (unsigned int i = 0; i < repeat && result.ok; ++i)
+    {
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      result.ok = operation();
+      double seconds = chrono::duration<double>(
+                         chrono::steady_clock::now() - start).count();
+
+      total += seconds;
+
+      if (i == 0 || seconds < result.minSeconds)
+        result.minSeconds = seconds;
+    }
+
+  result.meanSeconds = repeat > 0 ? total / repeat : 0;
+  result.maxRss = getMaxRss();
+  results.push_back(result);
+
+  cerr << "  " << name << ": " << result.minSeconds << " s"
+       << (result.ok ? "" : " (failed)") << endl;
+}
+
+
+static bool
+isValid(const SedDocument* doc, unsigned int numDataGenerators)
+{
+  return doc != NULL && doc->getNumDataGenerators() == numDataGenerators;
+}
+
+
+static void
+runScale(vector<BenchResult>& results, SedBenchOptions options,
+         unsigned int scale, unsigned int repeat, const string& workDir)
+{
+  options.numDataGenerators = scale;
+  cerr << "scale " << scale << endl;
+
+  SedDocument* doc = NULL;
+  measure(results, "generate", scale, 1, scale, [&]() {
+    doc = createBenchDocument(options);
+    return doc != NULL;
+  });
+
+  List* all = doc->getAllElements();
+  double numElements = all != NULL ? all->getSize() : 0;
+  delete all;
+
+  measure(results, "get_all_elements", scale, repeat, numElements, [&]() {
+    List* elements = doc->getAllElements();
+    bool ok = elements != NULL;
+    delete elements;
+    return ok;
+  });
+
+  measure(results, "clone", scale, repeat, numElements, [&]() {
+    SedDocument* copy = doc->clone();
+    bool ok = isValid(copy, scale);
+    delete copy;
+    return ok;
+  });
+
+  // ids looked up in an order unrelated to that of the document
+  vector<string> ids;
+
+  for (unsigned int i = 0, n = 0; i < scale; ++i)
+    {
+      n = (n * 1103515245u + 12345u) % scale;
+      ostringstream id;
+      id << "dg" << n;
+      ids.push_back(id.str());
+    }
+
+  measure(results, "lookup_id", scale, repeat, ids.size(), [&]() {
+    bool ok = true;
+
+    for (size_t i = 0; i < ids.size(); ++i)
+      ok = doc->getDataGenerator(ids[i]) != NULL && ok;
+
+    return ok;
+  });
+
+  // getElementBySId walks the whole document, so only a sample is used
+  size_t sample = ids.size() < 1000 ? ids.size() : 1000;
+  measure(results, "lookup_element", scale, repeat, sample, [&]() {
+    bool ok = true;
+
+    for (size_t i = 0; i < sample; ++i)
+      ok = doc->getElementBySId(ids[i]) != NULL && ok;
+
+    return ok;
+  });
+
+  SedWriter writer;
+  writer.setProgramName("bench_sedml");
+
+  string xml;
+  measure(results, "write_string", scale, repeat, numElements, [&]() {
+    char* text = writer.writeSedMLToString(doc);
+
+    if (text == NULL)
+      return false;
+
+    xml = text;
+    free(text);
+    return true;
+  });
+  results.back().bytes = xml.size();
+
+  SedReader reader;
+  measure(results, "read_string", scale, repeat, numElements, [&]() {
+    SedDocument* copy = reader.readSedMLFromString(xml);
+    bool ok = isValid(copy, scale);
+    delete copy;
+    return ok;
+  });
+  results.back().bytes = xml.size();
+
+  measure(results, "read_buffer", scale, repeat, numElements, [&]() {
+    SedDocument* copy = reader.readSedMLFromBuffer(xml.c_str(), xml.size());
+    bool ok = isValid(copy, scale);
+    delete copy;
+    return ok;
+  });
+  results.back().bytes = xml.size();
+
+  const char* formats[] = { "xml", "xml.gz", "xml.bz2", "xml.zip", NULL };
+
+  for (const char** format = formats; *format != NULL; ++format)
+    {
+      string extension = *format;
+
+      if ((extension == "xml.bz2" && !SedWriter::hasBzip2()) ||
+          ((extension == "xml.gz" || extension == "xml.zip") &&
+           !SedWriter::hasZlib()))
+        continue;
+
+      ostringstream path;
+      path << workDir << "/bench_sedml_" << scale << "." << extension;
+      string filename = path.str();
+
+      string suffix = extension == "xml" ? "xml" : extension.substr(4);
+      measure(results, "write_" + suffix, scale, repeat, numElements, [&]() {
+        return writer.writeSedML(doc, filename);
+      });
+      results.back().bytes = getFileSize(filename);
+
+      measure(results, "read_" + suffix, scale, repeat, numElements, [&]() {
+        SedDocument* copy = reader.readSedML(filename);
+        bool ok = isValid(copy, scale);
+        delete copy;
+        return ok;
+      });
+      results.back().bytes = getFileSize(filename);
+
+      remove(filename.c_str());
+    }
+
+  delete doc;
+}
+
+
+static void
+writeJson(ostream& out, const SedBenchOptions& options,
+          const vector<BenchResult>& results)
+{
+  out << "{" << endl
+      << "  \"library\": \"libSEDML\"," << endl
+      << "  \"version\": \"" << getLibSEDMLDottedVersion() << "\"," << endl
+      << "  \"options\": {" << endl
+      << "    \"depth\": " << options.nestingDepth << "," << endl
+      << "    \"range_size\": " << options.rangeSize << "," << endl
+      << "    \"notes_size\": " << options.notesSize << "," << endl
+      << "    \"annotation_size\": " << options.annotationSize << endl
+      << "  }," << endl
+      << "  \"results\": [";
+
+  for (size_t i = 0; i < results.size(); ++i)
+    {
+      const BenchResult& r = results[i];
+      out << (i == 0 ? "" : ",") << endl
+          << "    {\"benchmark\": \"" << r.name << "\""
+          << ", \"scale\": " << r.scale
+          << ", \"repeat\": " << r.repeat
+          << ", \"ok\": " << (r.ok ? "true" : "false")
+          << ", \"min_seconds\": " << r.minSeconds
+          << ", \"mean_seconds\": " << r.meanSeconds
+          << ", \"items\": " << r.items
+          << ", \"items_per_second\": "
+          << (r.minSeconds > 0 ? r.items / r.minSeconds : 0)
+          << ", \"bytes\": " << r.bytes
+          << ", \"max_rss_kb\": " << r.maxRss << "}";
+    }
+
+  out << endl << "  ]" << endl << "}" << endl;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  SedBenchOptions options;
+  vector<unsigned int> scales;
+  unsigned int repeat = 3;
+  string output;
+  string workDir = ".";
+  bool usage = false;
+
+  for (int i = 1; i < argc && !usage; i += 2)
+    {
+      string name = argv[i];
+
+      if (i + 1 >= argc)
+        {
+          usage = true;
+          break;
+        }
+
+      string value = argv[i + 1];
+
+      if (name == "--scales")
+        {
+          istringstream list(value);
+          string item;
+
+          while (getline(list, item, ','))
+            {
+              unsigned long scale = strtoul(item.c_str(), NULL, 10);
+
+              if (scale == 0)
+                usage = true;
+
+              scales.push_back((unsigned int)scale);
+            }
+        }
+      else if (name == "--repeat")
+        repeat = (unsigned int)strtoul(value.c_str(), NULL, 10);
+      else if (name == "--output")
+        output = value;
+      else if (name == "--work-dir")
+        workDir = value;
+      else
+        usage = !setBenchOption(options, name, value);
+    }
+
+  if (usage || repeat == 0)
+    {
+      cout << endl << "Usage: bench_sedml [options]" << endl << endl
+           << "  --scales N,N,...     numbers of data generators "
+           << "(100,1000,10000)" << endl
+           << "  --repeat N           runs of each measurement (3)" << endl
+           << "  --output FILE        JSON results file (standard output)"
+           << endl
+           << "  --work-dir DIR       directory for temporary files (.)"
+           << endl
+           << getBenchOptionsUsage() << endl;
+      return 2;
+    }
+
+  if (scales.empty())
+    {
+      scales.push_back(100);
+      scales.push_back(1000);
+      scales.push_back(10000);
+    }
+
+  vector<BenchResult> results;
+
+  for (size_t i = 0; i < scales.size(); ++i)
+    runScale(results, options, scales[i], repeat, workDir);
+
+  bool ok = true;
+
+  for (size_t i = 0; i < results.size(); ++i)
+    ok = ok && results[i].ok;
+
+  if (output.empty())
+    {
+      writeJson(cout, options, results);
+    }
+  else
+    {
+      ofstream file(output.c_str());
+      writeJson(file, options, results);
+
+      if (!file)
+        {
+          cerr << "Failed to write '" << output << "'." << endl;
+          return 1;
+        }
+    }
+
+  return ok ? 0 : 1;
+}
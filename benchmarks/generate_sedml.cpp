@@ -0,0 +1,90 @@
+/**
+ * @file    generate_sedml.cpp
+ * @brief   Writes a synthetic SED-ML document of a given size.
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SEDML, and the latest version of libSEDML.
+ *
+ * Copyright (c) 2013, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ------------------------------------------------------------------------ -->
+ */
+
+#include <iostream>
+#include <string>
+
+#include "SedBenchGenerator.h"
+
+using namespace std;
+LIBSEDML_CPP_NAMESPACE_USE
+
+int
+main (int argc, char* argv[])
+{
+  SedBenchOptions options;
+  string filename;
+
+  for (int i = 1; i < argc; ++i)
+    {
+      string arg = argv[i];
+
+      if (arg.compare(0, 2, "--") != 0 && filename.empty())
+        {
+          filename = arg;
+          continue;
+        }
+
+      if (i + 1 >= argc || !setBenchOption(options, arg, argv[i + 1]))
+        {
+          filename.clear();
+          break;
+        }
+
+      ++i;
+    }
+
+  if (filename.empty())
+    {
+      cout << endl << "Usage: generate_sedml [options] output-filename"
+           << endl << endl << getBenchOptionsUsage() << endl
+           << "The file is compressed when its name ends with .gz, .bz2 "
+           << "or .zip." << endl << endl;
+      return 2;
+    }
+
+  SedDocument* doc = createBenchDocument(options);
+
+  SedWriter writer;
+  writer.setProgramName("generate_sedml");
+  bool written = writer.writeSedML(doc, filename);
+  delete doc;
+
+  if (!written)
+    {
+      cerr << "Failed to write '" << filename << "'." << endl;
+      return 1;
+    }
+
+  return 0;
+}
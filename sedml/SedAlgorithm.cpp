@@ -36,6 +36,7 @@
 
 #include <sedml/SedAlgorithm.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -54,9 +55,6 @@ SedAlgorithm::SedAlgorithm(unsigned int level, unsigned int version)
   , mKisaoID("")
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
-
   // connect to child objects
   connectToChild();
 }
@@ -405,6 +403,42 @@ SedAlgorithm::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedAlgorithm::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedBase::writeSnapshot(writer);
+
+  mAlgorithmParameters.writeSnapshot(writer);
+  writer.writeString(mKisaoID);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedAlgorithm::readSnapshot(SedSnapshotReader& reader)
+{
+  SedBase::readSnapshot(reader);
+
+  mAlgorithmParameters.readSnapshot(reader);
+  mKisaoID = reader.readString();
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -413,8 +447,17 @@ SedAlgorithm::writeElements(XMLOutputStream& stream) const
 bool
 SedAlgorithm::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      if (getNumAlgorithmParameters() > 0)
+        {
+          mAlgorithmParameters.accept(v);
+        }
+    }
+
+  v.leave(*this);
 
+  return true;
 }
 
 
@@ -36,6 +36,7 @@
 
 #include <sedml/SedAlgorithmParameter.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -54,8 +55,6 @@ SedAlgorithmParameter::SedAlgorithmParameter(unsigned int level, unsigned int ve
   , mValue("")
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -277,6 +276,42 @@ SedAlgorithmParameter::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedAlgorithmParameter::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedBase::writeSnapshot(writer);
+
+  writer.writeString(mKisaoID);
+  writer.writeString(mValue);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedAlgorithmParameter::readSnapshot(SedSnapshotReader& reader)
+{
+  SedBase::readSnapshot(reader);
+
+  mKisaoID = reader.readString();
+  mValue = reader.readString();
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -285,8 +320,10 @@ SedAlgorithmParameter::writeElements(XMLOutputStream& stream) const
 bool
 SedAlgorithmParameter::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
 
+  return true;
 }
 
 
@@ -437,7 +474,6 @@ SedListOfAlgorithmParameters::SedListOfAlgorithmParameters(unsigned int level,
     unsigned int version)
   : SedListOf(level, version)
 {
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -498,10 +534,8 @@ SedListOfAlgorithmParameters::get(const std::string& sid)
 const SedAlgorithmParameter*
 SedListOfAlgorithmParameters::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedAlgorithmParameter>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <SedAlgorithmParameter*>(*result);
+  int index = getIndexById(sid);
+  return (index < 0) ? 0 : static_cast <SedAlgorithmParameter*>(mItems[index]);
 }
 
 
@@ -573,14 +607,11 @@ SedAlgorithmParameter*
 SedListOfAlgorithmParameters::remove(const std::string& sid)
 {
   SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedAlgorithmParameter>(sid));
+  int index = getIndexById(sid);
 
-  if (result != mItems.end())
+  if (index >= 0)
     {
-      item = *result;
-      mItems.erase(result);
+      item = SedListOf::remove((unsigned int)index);
     }
 
   return static_cast <SedAlgorithmParameter*>(item);
@@ -0,0 +1,213 @@
+/**
+ * @file    SedArena.cpp
+ * @brief   Arena allocation of Sed objects
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedArena.h>
+
+#include <algorithm>
+#include <new>
+
+using namespace std;
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygen-libsbml-internal */
+
+/* the arena of the innermost SedArenaScope of each thread */
+static thread_local SedArena* currentArena = NULL;
+
+/* all allocations are rounded up to keep this alignment */
+static const size_t SedArenaAlignment = alignof(max_align_t);
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedArena, with a single reference held by the caller.
+ */
+SedArena*
+SedArena::create(size_t blockSize)
+{
+  return new SedArena(blockSize);
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+SedArena::SedArena(size_t blockSize)
+  : mBlocks()
+  , mBlockSize(max(blockSize, SedArenaAlignment))
+  , mNext(NULL)
+  , mAvailable(0)
+  , mNumBytesAllocated(0)
+  , mReferences(1)
+{
+}
+
+
+SedArena::~SedArena()
+{
+  for (size_t i = 0; i < mBlocks.size(); ++i)
+    ::operator delete(mBlocks[i]);
+}
+
+/** @endcond */
+
+
+/*
+ * Allocates size bytes from the current block, starting a new one if
+ * needed.
+ */
+void*
+SedArena::allocate(size_t size)
+{
+  size = (size + SedArenaAlignment - 1) & ~(SedArenaAlignment - 1);
+
+  if (size > mAvailable)
+    {
+      size_t blockSize = max(size, mBlockSize);
+
+      // large objects get a block of their own; the current block
+      // remains in use
+      char* block = static_cast<char*>(::operator new(blockSize));
+      mBlocks.push_back(block);
+
+      if (blockSize > mBlockSize)
+        {
+          mNumBytesAllocated += size;
+          return block;
+        }
+
+      mNext = block;
+      mAvailable = blockSize;
+    }
+
+  void* result = mNext;
+  mNext += size;
+  mAvailable -= size;
+  mNumBytesAllocated += size;
+
+  return result;
+}
+
+
+void
+SedArena::addReference()
+{
+  ++mReferences;
+}
+
+
+void
+SedArena::removeReference()
+{
+  if (--mReferences == 0)
+    delete this;
+}
+
+
+size_t
+SedArena::getNumBytesAllocated() const
+{
+  return mNumBytesAllocated;
+}
+
+
+SedArena*
+SedArena::getCurrent()
+{
+  return currentArena;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+void
+SedArena::setCurrent(SedArena* arena)
+{
+  currentArena = arena;
+}
+/** @endcond */
+
+
+/*
+ * Makes objects created on this thread use a new SedArena.
+ */
+SedArenaScope::SedArenaScope()
+  : mArena(SedArena::create())
+  , mPrevious(SedArena::getCurrent())
+{
+  SedArena::setCurrent(mArena);
+}
+
+
+/*
+ * Makes objects created on this thread use the given SedArena.
+ */
+SedArenaScope::SedArenaScope(SedArena* arena)
+  : mArena(arena)
+  , mPrevious(SedArena::getCurrent())
+{
+  if (mArena != NULL)
+    mArena->addReference();
+
+  SedArena::setCurrent(mArena);
+}
+
+
+/*
+ * Restores the previous arena, and releases the one of this scope.
+ */
+SedArenaScope::~SedArenaScope()
+{
+  SedArena::setCurrent(mPrevious);
+
+  if (mArena != NULL)
+    mArena->removeReference();
+}
+
+
+SedArena*
+SedArenaScope::getArena() const
+{
+  return mArena;
+}
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,242 @@
+/**
+ * @file    SedArena.h
+ * @brief   Arena allocation of Sed objects
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedArena
+ * @ingroup Core
+ * @brief Monotonic memory arena from which Sed objects can be allocated.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedArena hands out memory from large blocks, and only gives the
+ * blocks back once it is no longer used.  Sed objects created while a
+ * SedArenaScope is active on the current thread are allocated from the
+ * arena of that scope, which saves one call to the system allocator per
+ * object and keeps the objects of a document close together in memory.
+ *
+ * Each object allocated from an arena holds a reference to it, so that
+ * the arena stays alive as long as any of its objects does; deleting an
+ * object does not give its memory back to the arena.  Arenas therefore
+ * suit documents that are read, used and then deleted as a whole.
+ *
+ * Deleting a document is not a single bulk free, however: each of its
+ * objects is still destroyed one by one, since their members (strings,
+ * lists, annotations) own memory of their own, and each goes through
+ * SedBase's operator delete, which reads the header in front of the
+ * object and drops its reference to the arena.  What an arena saves is
+ * the call to the system allocator and deallocator per object; the
+ * blocks themselves are freed together with the last reference.
+ *
+ * A SedArena is not thread-safe: it must only be used to allocate from
+ * one thread at a time, though its objects may be deleted on any thread.
+ *
+ * @see SedReader::setUseArena()
+ */
+
+#ifndef SedArena_h
+#define SedArena_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedArena
+{
+public:
+
+  /**
+   * Creates a new SedArena allocating memory in blocks of the given size,
+   * and returns it with a single reference held by the caller.
+   *
+   * @param blockSize the size (in bytes) of the blocks allocated.
+   *
+   * @return the new SedArena; release it with removeReference().
+   */
+  static SedArena* create(size_t blockSize = 65536);
+
+
+  /**
+   * Allocates @p size bytes, suitably aligned for any object.
+   *
+   * The memory is only freed when the arena itself is.
+   *
+   * @param size the number of bytes to allocate.
+   *
+   * @return a pointer to the memory allocated.
+   */
+  void* allocate(size_t size);
+
+
+  /**
+   * Adds a reference to this SedArena.
+   */
+  void addReference();
+
+
+  /**
+   * Removes a reference from this SedArena, freeing it (and all memory
+   * allocated from it) once the last reference is gone.
+   */
+  void removeReference();
+
+
+  /**
+   * Returns the number of bytes allocated from this SedArena so far.
+   *
+   * @return the number of bytes allocated.
+   */
+  size_t getNumBytesAllocated() const;
+
+
+  /**
+   * Returns the SedArena objects are allocated from on the current
+   * thread.
+   *
+   * @return the SedArena of the innermost SedArenaScope active on the
+   * current thread, or @c NULL if there is none.
+   */
+  static SedArena* getCurrent();
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  friend class SedArenaScope;
+
+  SedArena(size_t blockSize);
+
+  ~SedArena();
+
+  /* not copyable */
+  SedArena(const SedArena&);
+  SedArena& operator=(const SedArena&);
+
+  static void setCurrent(SedArena* arena);
+
+
+  std::vector<char*> mBlocks;
+  size_t mBlockSize;
+  char* mNext;
+  size_t mAvailable;
+  size_t mNumBytesAllocated;
+  std::atomic<size_t> mReferences;
+
+  /** @endcond */
+};
+
+
+
+/**
+ * @class SedArenaScope
+ * @ingroup Core
+ * @brief Makes Sed objects created on the current thread use a SedArena.
+ *
+ * While a SedArenaScope exists, all Sed objects created on the current
+ * thread are allocated from its arena.  Scopes may be nested; the
+ * previous arena is restored when a scope ends.
+ *
+ * @verbatim
+{
+  SedArenaScope scope;
+  SedDocument* doc = new SedDocument(1, 2);
+  doc->createTask()->setId("task1");
+  // ...
+}
+@endverbatim
+ */
+class LIBSEDML_EXTERN SedArenaScope
+{
+public:
+
+  /**
+   * Makes objects created on the current thread use a new SedArena.
+   */
+  SedArenaScope();
+
+
+  /**
+   * Makes objects created on the current thread use the given SedArena.
+   *
+   * @param arena the arena to allocate from, or @c NULL to use the
+   * system allocator.
+   */
+  SedArenaScope(SedArena* arena);
+
+
+  /**
+   * Ends this scope, restoring the previous arena.
+   */
+  ~SedArenaScope();
+
+
+  /**
+   * Returns the SedArena of this scope.
+   *
+   * @return the arena of this scope, @c NULL if there is none.
+   */
+  SedArena* getArena() const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  /* not copyable */
+  SedArenaScope(const SedArenaScope&);
+  SedArenaScope& operator=(const SedArenaScope&);
+
+  SedArena* mArena;
+  SedArena* mPrevious;
+
+  /** @endcond */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif /* __cplusplus */
+
+#endif  /* SedArena_h */
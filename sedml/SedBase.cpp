@@ -37,6 +37,7 @@
 
 #include <sstream>
 #include <vector>
+#include <memory>
 
 #include <sbml/xml/XMLError.h>
 #include <sbml/xml/XMLErrorLog.h>
@@ -52,6 +53,9 @@
 #include <sedml/SedDocument.h>
 #include <sedml/SedListOf.h>
 #include <sedml/SedBase.h>
+#include <sedml/SedArena.h>
+#include <sedml/SedSnapshot.h>
+#include <sedml/SedLoadStatistics.h>
 
 
 //#include <sbml/validator/constraints/IdList.h>
@@ -66,13 +70,44 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
 /** @endcond */
 
 
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Returns the SedNamespaces shared by the elements created for the given
+ * level and version, or NULL if the combination is not a supported one.
+ * The objects are created once, and never modified.
+ */
+static shared_ptr<SedNamespaces>
+getDefaultSedNamespaces(unsigned int level, unsigned int version)
+{
+  static const shared_ptr<SedNamespaces> defaults[] =
+  {
+    make_shared<SedNamespaces>(1, 1),
+    make_shared<SedNamespaces>(1, 2),
+    make_shared<SedNamespaces>(1, 3)
+  };
+
+  if (level != 1 || version < 1 || version > 3)
+    return shared_ptr<SedNamespaces>();
+
+  return defaults[version - 1];
+}
+
+/** @endcond */
+
+
+
 
 SedBase*
 SedBase::getElementBySId(std::string id)
 {
   if (id.empty()) return NULL;
 
-  return NULL;
+  SedDocument* doc = getSedDocument();
+
+  if (doc == NULL) return NULL;
+
+  return doc->getIndexedElementBySId(id, this);
 }
 
 
@@ -81,7 +116,11 @@ SedBase::getElementByMetaId(std::string metaid)
 {
   if (metaid.empty()) return NULL;
 
-  return NULL;
+  SedDocument* doc = getSedDocument();
+
+  if (doc == NULL) return NULL;
+
+  return doc->getIndexedElementByMetaId(metaid, this);
 }
 
 List*
@@ -99,7 +138,8 @@ SedBase::SedBase(unsigned int level, unsigned int version) :
   mNotes(NULL)
   , mAnnotation(NULL)
   , mSed(NULL)
-  , mSedNamespaces(NULL)
+  , mSedNamespaces()
+  , mSedNamespacesShared(true)
   , mUserData(NULL)
   , mLine(0)
   , mColumn(0)
@@ -108,7 +148,7 @@ SedBase::SedBase(unsigned int level, unsigned int version) :
   , mEmptyString("")
   , mURI("")
 {
-  mSedNamespaces = new SedNamespaces(level, version);
+  shareSedNamespaces(level, version);
 
   //
   // Sets the XMLNS URI of corresponding Sed Level/Version to
@@ -128,7 +168,8 @@ SedBase::SedBase(SedNamespaces *sbmlns) :
   mNotes(NULL)
   , mAnnotation(NULL)
   , mSed(NULL)
-  , mSedNamespaces(NULL)
+  , mSedNamespaces()
+  , mSedNamespacesShared(true)
   , mUserData(NULL)
   , mLine(0)
   , mColumn(0)
@@ -143,7 +184,7 @@ SedBase::SedBase(SedNamespaces *sbmlns) :
       throw SedConstructorException(err);
     }
 
-  mSedNamespaces = sbmlns->clone();
+  shareSedNamespaces(sbmlns);
 
   //
   // Sets the XMLNS URI of corresponding Sed Level/Version to
@@ -155,10 +196,10 @@ SedBase::SedBase(SedNamespaces *sbmlns) :
   //
 
 #if 0
-  cout << "[DEBUG] SedBase::SedBase(SedNamespaces*,...) " << static_cast<SedNamespaces>(*mSedNamespaces).getURI() << endl;
+  cout << "[DEBUG] SedBase::SedBase(SedNamespaces*,...) " << mSedNamespaces->getURI() << endl;
 #endif
 
-  setElementNamespace(static_cast<SedNamespaces>(*mSedNamespaces).getURI());
+  setElementNamespace(mSedNamespaces->getURI());
 }
 /** @endcond */
 
@@ -194,11 +235,13 @@ SedBase::SedBase(const SedBase& orig)
    * the copy will end up with the wrong namespace information
    * need to use the default namespace NOT the namespace local to the object
    */
-  if (orig.getSedNamespaces() != NULL)
-    this->mSedNamespaces =
-      new SedNamespaces(*const_cast<SedBase&>(orig).getSedNamespaces());
+  if (orig.mSed == NULL && orig.mSedNamespacesShared)
+    {
+      this->mSedNamespaces = orig.mSedNamespaces;
+      this->mSedNamespacesShared = true;
+    }
   else
-    this->mSedNamespaces = NULL;
+    this->shareSedNamespaces(orig.getConstSedNamespaces());
 
 
   this->mHasBeenDeleted = false;
@@ -210,17 +253,85 @@ SedBase::SedBase(const SedBase& orig)
 /** @endcond */
 
 
+/** @cond doxygen-libsbml-internal */
+/*
+ * Every object is preceded by a header recording the SedArena it was
+ * allocated from (NULL for the system allocator).  The header keeps the
+ * alignment of the object itself.
+ */
+static const size_t SedAllocationHeaderSize =
+  (sizeof(SedArena*) + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1);
+
+
+void*
+SedBase::operator new(size_t size)
+{
+  SedArena* arena = SedArena::getCurrent();
+  char* block;
+
+  if (arena != NULL)
+    {
+      block = static_cast<char*>(arena->allocate(SedAllocationHeaderSize + size));
+      arena->addReference();
+    }
+  else
+    {
+      block = static_cast<char*>(::operator new(SedAllocationHeaderSize + size));
+    }
+
+  *reinterpret_cast<SedArena**>(block) = arena;
+
+  return block + SedAllocationHeaderSize;
+}
+
+
+void*
+SedBase::operator new(size_t size, const std::nothrow_t&) throw()
+{
+  try
+    {
+      return SedBase::operator new(size);
+    }
+  catch (...)
+    {
+      return NULL;
+    }
+}
+
+
+void
+SedBase::operator delete(void* ptr)
+{
+  if (ptr == NULL) return;
+
+  char* block = static_cast<char*>(ptr) - SedAllocationHeaderSize;
+  SedArena* arena = *reinterpret_cast<SedArena**>(block);
+
+  if (arena != NULL)
+    arena->removeReference();
+  else
+    ::operator delete(block);
+}
+
+
+void
+SedBase::operator delete(void* ptr, const std::nothrow_t&) throw()
+{
+  SedBase::operator delete(ptr);
+}
+/** @endcond */
+
+
 /*
  * Destroy this SedBase object.
  */
 SedBase::~SedBase()
 {
+  if (mSed != NULL && mSed != this) mSed->removeFromIndex(this);
+
   if (mNotes != NULL)       delete mNotes;
 
   if (mAnnotation != NULL)  delete mAnnotation;
-
-  if (mSedNamespaces != NULL)  delete mSedNamespaces;
-
 }
 
 /*
@@ -246,19 +357,21 @@ SedBase& SedBase::operator=(const SedBase& rhs)
       else
         this->mAnnotation = NULL;
 
-      this->mSed       = rhs.mSed;
+      /* like the copy constructor, the assigned object keeps its own
+       * place in the tree (document and parent); it does not become part
+       * of the document of rhs
+       */
       this->mLine       = rhs.mLine;
       this->mColumn     = rhs.mColumn;
-      this->mParentSedObject = rhs.mParentSedObject;
       this->mUserData   = rhs.mUserData;
 
-      delete this->mSedNamespaces;
-
-      if (rhs.mSedNamespaces != NULL)
-        this->mSedNamespaces =
-          new SedNamespaces(*const_cast<SedBase&>(rhs).mSedNamespaces);
+      if (rhs.mSedNamespacesShared)
+        {
+          this->mSedNamespaces = rhs.mSedNamespaces;
+          this->mSedNamespacesShared = true;
+        }
       else
-        this->mSedNamespaces = NULL;
+        this->shareSedNamespaces(rhs.mSedNamespaces.get());
 
 
       this->mURI = rhs.mURI;
@@ -427,7 +540,7 @@ SedBase::getNamespaces() const
   if (mSed != NULL)
     return mSed->getSedNamespaces()->getNamespaces();
   else
-    return mSedNamespaces->getNamespaces();
+    return unshareSedNamespaces()->getNamespaces();
 }
 
 
@@ -646,6 +759,7 @@ SedBase::setMetaId(const std::string& metaid)
   else if (metaid.empty())
     {
       mMetaId.erase();
+      indexElement();
       return LIBSEDML_OPERATION_SUCCESS;
     }
   else if (!(SyntaxChecker::isValidXMLID(metaid)))
@@ -655,6 +769,7 @@ SedBase::setMetaId(const std::string& metaid)
   else
     {
       mMetaId = metaid;
+      indexElement();
       return LIBSEDML_OPERATION_SUCCESS;
     }
 }
@@ -1070,6 +1185,7 @@ SedBase::setNotes(const XMLNode* notes)
 
   if (name == "notes")
     {
+      SEDML_TIME_PHASE(SEDML_PHASE_NOTES);
       mNotes = static_cast<XMLNode*>(notes->clone());
     }
   else
@@ -1595,8 +1711,37 @@ SedBase::appendNotes(const std::string& notes)
 void
 SedBase::setSedDocument(SedDocument* d)
 {
+  if (mSed != NULL && mSed != d && mSed != this)
+    {
+      mSed->removeFromIndex(this);
+    }
+
   mSed = d;
 
+  if (mSed != NULL && mSed != this)
+    {
+      mSed->addToIndex(this);
+    }
+}
+
+
+/*
+ * Updates the entry of this element in the id/metaid index of its
+ * SedDocument, and the id index of the list containing it.
+ */
+void
+SedBase::indexElement()
+{
+  if (mSed != NULL && mSed != this)
+    {
+      mSed->addToIndex(this);
+    }
+
+  if (mParentSedObject != NULL &&
+      mParentSedObject->getTypeCode() == SEDML_LIST_OF)
+    {
+      static_cast<SedListOf*>(mParentSedObject)->invalidateIdIndex();
+    }
 }
 
 
@@ -1700,9 +1845,11 @@ SedBase::getAncestorOfType(int type, const std::string pkgName) const
 int
 SedBase::setNamespaces(XMLNamespaces* xmlns)
 {
-  if (xmlns == NULL)
+  if (mSedNamespacesShared)
     {
-      mSedNamespaces->setNamespaces(NULL);
+      if (!mSedNamespaces->hasSameNamespaces(xmlns))
+        mSedNamespaces = mSedNamespaces->getSharedCopy(xmlns);
+
       return LIBSEDML_OPERATION_SUCCESS;
     }
   else
@@ -1727,6 +1874,7 @@ SedBase::unsetMetaId()
     }
 
   mMetaId.erase();
+  indexElement();
 
   if (mMetaId.empty())
     {
@@ -1833,7 +1981,14 @@ bool
 SedBase::hasValidLevelVersionNamespaceCombination()
 {
   int typecode = getTypeCode();
-  XMLNamespaces *xmlns = getNamespaces();
+
+  // the namespaces are only read, so there is no need to give the element
+  // a copy of its own (as getNamespaces() would)
+  const SedNamespaces *sedns = getConstSedNamespaces();
+  XMLNamespaces *xmlns = NULL;
+
+  if (sedns != NULL)
+    xmlns = const_cast<XMLNamespaces*>(sedns->getNamespaces());
 
   return hasValidLevelVersionNamespaceCombination(typecode, xmlns);
 }
@@ -1908,8 +2063,8 @@ SedBase::matchesCoreSedNamespace(const SedBase * sb)
 {
   bool match = false;
 
-  SedNamespaces *sbmlns = getSedNamespaces();
-  SedNamespaces *sbmlns_rhs = sb->getSedNamespaces();
+  const SedNamespaces *sbmlns = getConstSedNamespaces();
+  const SedNamespaces *sbmlns_rhs = sb->getConstSedNamespaces();
 
   if (sbmlns->getLevel() != sbmlns_rhs->getLevel())
     return match;
@@ -1941,8 +2096,8 @@ SedBase::matchesCoreSedNamespace(const SedBase * sb) const
 {
   bool match = false;
 
-  SedNamespaces *sbmlns = getSedNamespaces();
-  SedNamespaces *sbmlns_rhs = sb->getSedNamespaces();
+  const SedNamespaces *sbmlns = getConstSedNamespaces();
+  const SedNamespaces *sbmlns_rhs = sb->getConstSedNamespaces();
 
   if (sbmlns->getLevel() != sbmlns_rhs->getLevel())
     return match;
@@ -2040,8 +2195,8 @@ SedBase::setSedNamespaces(SedNamespaces * sbmlns)
 void
 SedBase::setSedNamespacesAndOwn(SedNamespaces * sbmlns)
 {
-  delete mSedNamespaces;
-  mSedNamespaces = sbmlns;
+  mSedNamespaces.reset(sbmlns);
+  mSedNamespacesShared = false;
 
   if (sbmlns != NULL)
     setElementNamespace(sbmlns->getURI());
@@ -2053,13 +2208,75 @@ SedNamespaces *
 SedBase::getSedNamespaces() const
 {
   if (mSed != NULL)
-    return mSed->mSedNamespaces;
+    return mSed->mSedNamespaces.get();
   else if (mSedNamespaces != NULL)
-    return mSedNamespaces;
+    return unshareSedNamespaces();
   else
     return new SedNamespaces();
 }
 
+
+/*
+ * Returns the SedNamespaces of this element, or of its document, without
+ * making a copy of them; the object must not be modified.
+ */
+const SedNamespaces *
+SedBase::getConstSedNamespaces() const
+{
+  if (mSed != NULL)
+    return mSed->mSedNamespaces.get();
+  else
+    return mSedNamespaces.get();
+}
+
+
+/*
+ * Makes this element use the shared default SedNamespaces for the given
+ * level and version, or a copy of its own if the combination is not a
+ * supported one.
+ */
+void
+SedBase::shareSedNamespaces(unsigned int level, unsigned int version)
+{
+  mSedNamespaces = getDefaultSedNamespaces(level, version);
+  mSedNamespacesShared = (mSedNamespaces != NULL);
+
+  if (!mSedNamespacesShared)
+    mSedNamespaces.reset(new SedNamespaces(level, version));
+}
+
+
+/*
+ * Makes this element use the shared copy of sedns.
+ */
+void
+SedBase::shareSedNamespaces(const SedNamespaces* sedns)
+{
+  if (sedns != NULL)
+    mSedNamespaces = sedns->getSharedCopy();
+  else
+    mSedNamespaces.reset();
+
+  mSedNamespacesShared = (sedns != NULL);
+}
+
+
+/*
+ * Gives this element a copy of its SedNamespaces of its own, if they are
+ * shared, so that they can be modified.
+ */
+SedNamespaces *
+SedBase::unshareSedNamespaces() const
+{
+  if (mSedNamespacesShared)
+    {
+      mSedNamespaces.reset(mSedNamespaces->clone());
+      mSedNamespacesShared = false;
+    }
+
+  return mSedNamespaces.get();
+}
+
 /** @endcond */
 
 
@@ -2080,23 +2297,46 @@ SedBase::toSed()
 
 
 /** @cond doxygen-libsbml-internal */
+/*
+ * Takes the start tag of an element from the stream; the tokens are only
+ * parsed as they are taken.
+ */
+static bool
+readStartToken(XMLInputStream& stream, XMLToken& element)
+{
+  SEDML_TIME_PHASE(SEDML_PHASE_TOKENIZE);
+
+  if (!stream.peek().isStart()) return false;
+
+  element = stream.next();
+  return true;
+}
+
+
 /*
  * Reads (initializes) this Sed object by reading from XMLInputStream.
  */
 void
 SedBase::read(XMLInputStream& stream)
 {
-  if (!stream.peek().isStart()) return;
+  SEDML_TIME_PHASE(SEDML_PHASE_CONSTRUCT);
 
-  const XMLToken  element  = stream.next();
+  XMLToken        element;
   int             position =  0;
 
+  if (!readStartToken(stream, element)) return;
+
   setSedBaseFields(element);
 
   ExpectedAttributes expectedAttributes;
   addExpectedAttributes(expectedAttributes);
   readAttributes(element.getAttributes(), expectedAttributes);
 
+  /* the identifiers are only known now; the element itself was
+   * connected to the document by createObject
+   */
+  indexElement();
+
   /* if we are reading a document pass the
    * Sed Namespace information to the input stream object
    * thus the MathML reader can find out what level/version
@@ -2104,10 +2344,9 @@ SedBase::read(XMLInputStream& stream)
    */
   if (element.getName() == "sedML")
     {
-      SedNamespaces *ns = new SedNamespaces(getLevel(), getVersion());
+      SEDML_TIME_PHASE(SEDML_PHASE_NAMESPACES);
+      SedNamespaces ns(getLevel(), getVersion());
 
-      SBMLNamespaces *sbmlns = new SBMLNamespaces();
-      sbmlns->addNamespaces(this->getSedNamespaces()->getNamespaces());
       //stream.setNamespaces(this->getSedNamespaces());
       // need to check that any prefix on the sbmlns also occurs on element
       // remembering the horrible situation where the sbmlns might be declared
@@ -2125,7 +2364,7 @@ SedBase::read(XMLInputStream& stream)
 
               if (i > -1)
                 {
-                  if (xmlns->getURI(i) != ns->getURI())
+                  if (xmlns->getURI(i) != ns.getURI())
                     {
                       error = true;
                     }
@@ -2154,8 +2393,7 @@ SedBase::read(XMLInputStream& stream)
 
               if (error == true && errorLoggedAlready == false)
                 {
-                  static ostringstream errMsg;
-                  errMsg.str("");
+                  ostringstream errMsg;
                   errMsg << "The prefix for the <sedML> element does not match "
                          << "the prefix for the Sed namespace.  This means that "
                          << "the <sedML> element in not in the SED-ML Namespace." << endl;
@@ -2174,6 +2412,8 @@ SedBase::read(XMLInputStream& stream)
     }
   else
     {
+      SEDML_TIME_PHASE(SEDML_PHASE_NAMESPACES);
+
       //
       // checks if the given default namespace (if any) is a valid
       // Sed namespace
@@ -2197,15 +2437,22 @@ SedBase::read(XMLInputStream& stream)
       //    stream.skipText();
       // instead, read text and store in variable
       std::string text;
+      const XMLToken* nextToken;
 
-      while (stream.isGood() && stream.peek().isText())
-        {
-          text += stream.next().getCharacters();
-        }
+      {
+        SEDML_TIME_PHASE(SEDML_PHASE_TOKENIZE);
+
+        while (stream.isGood() && stream.peek().isText())
+          {
+            text += stream.next().getCharacters();
+          }
+
+        nextToken = &stream.peek();
+      }
 
       setElementText(text);
 
-      const XMLToken& next = stream.peek();
+      const XMLToken& next = *nextToken;
 
       // Re-check stream.isGood() because stream.peek() could hit something.
       if (!stream.isGood()) break;
@@ -2237,6 +2484,8 @@ SedBase::read(XMLInputStream& stream)
               if (!stream.isGood()) break;
 
               checkListOfPopulated(object);
+
+              childElementRead(object);
             }
           else if (!(readOtherXML(stream)
                      || readAnnotation(stream)
@@ -2267,7 +2516,9 @@ SedBase::setElementText(const std::string &text)
 void
 SedBase::write(XMLOutputStream& stream) const
 {
-  XMLNamespaces *xmlns = getNamespaces();
+  SEDML_TIME_PHASE(SEDML_PHASE_WRITE_ELEMENTS);
+
+  const XMLNamespaces *xmlns = getConstSedNamespaces()->getNamespaces();
 
   if (0)
     {
@@ -2319,6 +2570,43 @@ SedBase::writeElements(XMLOutputStream& stream) const
 /** @endcond */
 
 
+/** @cond doxygen-libsbml-internal */
+/*
+ * Writes the metaid, notes and annotation of this object to a snapshot.
+ */
+void
+SedBase::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  const_cast <SedBase *>(this)->syncAnnotation();
+
+  writer.writeString(mMetaId);
+  writer.writeXMLNode(mNotes);
+  writer.writeXMLNode(mAnnotation);
+  writer.writeUInt(mLine);
+  writer.writeUInt(mColumn);
+}
+
+
+/*
+ * Reads the values written by writeSnapshot() back from a snapshot.
+ */
+void
+SedBase::readSnapshot(SedSnapshotReader& reader)
+{
+  mMetaId = reader.readString();
+
+  delete mNotes;
+  mNotes = reader.readXMLNode();
+
+  delete mAnnotation;
+  mAnnotation = reader.readXMLNode();
+
+  mLine = reader.readUInt();
+  mColumn = reader.readUInt();
+}
+/** @endcond */
+
+
 /** @cond doxygen-libsbml-internal */
 /*
  * Subclasses should override this method to create, store, and then
@@ -2369,6 +2657,7 @@ SedBase::readAnnotation(XMLInputStream& stream)
   if (name == "annotation"
       || (getLevel() == 1 && getVersion() == 1 && name == "annotations"))
     {
+      SEDML_TIME_PHASE(SEDML_PHASE_ANNOTATION);
 
       // If an annotation already exists, log it as an error and replace
       // the content of the existing annotation with the new one.
@@ -2718,7 +3007,7 @@ SedBase::getPrefix() const
 {
   std::string prefix = "";
 
-  XMLNamespaces *xmlns = getNamespaces();
+  const XMLNamespaces *xmlns = getConstSedNamespaces()->getNamespaces();
   string uri = getURI();
 
   if (xmlns && mSed && false) //!mSed->isEnabledDefaultNS(uri))
@@ -2761,7 +3050,7 @@ SedBase::getSedPrefix() const
 {
   std::string prefix = "";
 
-  XMLNamespaces *xmlns = getNamespaces();
+  const XMLNamespaces *xmlns = getConstSedNamespaces()->getNamespaces();
 
   if (xmlns == NULL)
     return getPrefix();
@@ -2918,8 +3207,12 @@ SedBase::checkListOfPopulated(SedBase* object)
 
   if (object->getTypeCode() == SEDML_LIST_OF)
     {
-      // Check that the list has at least one element.
-      if (static_cast <SedListOf*>(object)->size() == 0)
+      // Check that the list has at least one element. When the document
+      // is streamed, its elements may have been dropped already.
+      const SedDocument* doc = getSedDocument();
+
+      if (static_cast <SedListOf*>(object)->size() == 0
+          && (doc == NULL || doc->getElementCallback() == NULL))
         {
           //typecode (int) tc = static_cast<SedListOf*>(object)->getItemTypeCode();
           //int tc = static_cast<SedListOf*>(object)->getItemTypeCode();
@@ -2935,6 +3228,16 @@ SedBase::checkListOfPopulated(SedBase* object)
 }
 /** @endcond */
 
+/** @cond doxygen-libsbml-internal */
+/*
+ * Called once a child element has been read completely.
+ */
+void
+SedBase::childElementRead(SedBase* /* child */)
+{
+}
+/** @endcond */
+
 //This assumes that the parent of the object is of the type SedListOf.  If this is not the case, it will need to be overridden.
 int SedBase::removeFromParentAndDelete()
 {
@@ -3027,8 +3330,7 @@ SedBase::checkDefaultNamespace(const XMLNamespaces* xmlns,
 
       if (!defaultURI.empty() && mURI != defaultURI)
         {
-          static ostringstream errMsg;
-          errMsg.str("");
+          ostringstream errMsg;
           errMsg << "xmlns=\"" << defaultURI << "\" in <" << elementName
                  << "> element is an invalid namespace." << endl;
 
@@ -150,6 +150,8 @@
 #include <string>
 #include <stdexcept>
 #include <algorithm>
+#include <memory>
+#include <new>
 
 #include <sedml/SedErrorLog.h>
 
@@ -174,6 +176,8 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
 //class SedErrorLog;
 class SedVisitor;
 class SedDocument;
+class SedSnapshotWriter;
+class SedSnapshotReader;
 
 
 
@@ -189,6 +193,18 @@ public:
   virtual ~SedBase();
 
 
+  /** @cond doxygen-libsbml-internal */
+  /*
+   * Sed objects are allocated from the SedArena of the current
+   * SedArenaScope, if any, and from the system allocator otherwise.
+   */
+  static void* operator new(size_t size);
+  static void* operator new(size_t size, const std::nothrow_t&) throw();
+  static void operator delete(void* ptr);
+  static void operator delete(void* ptr, const std::nothrow_t&) throw();
+  /** @endcond */
+
+
   /**
    * Assignment operator for SedBase.
    *
@@ -227,6 +243,10 @@ public:
    * to find.
    *
    * @return pointer to the first element found with the given identifier.
+   *
+   * @note The lookup uses the id index maintained by the SedDocument this
+   * object belongs to; objects not connected to a document have no
+   * children that can be found this way.
    */
   virtual SedBase* getElementBySId(std::string id);
 
@@ -239,6 +259,9 @@ public:
    * object to find.
    *
    * @return pointer to the first element found with the given meta-identifier.
+   *
+   * @note The lookup uses the metaid index maintained by the SedDocument
+   * this object belongs to.
    */
   virtual SedBase* getElementByMetaId(std::string metaid);
 
@@ -739,6 +762,10 @@ public:
    * (in Sed Level&nbsp;3) packages used in addition to Sed Level&nbsp;3
    * Core.
    *
+   * Elements that are not connected to a SedDocument share their
+   * namespaces with other elements; calling this method gives the element
+   * a copy of its own, so that the object returned can be modified.
+   *
    * @return the XML Namespaces associated with this Sed object
    *
    * @see getLevel()
@@ -2104,6 +2131,24 @@ public:
   /** @endcond */
 
 
+  /** @cond doxygen-libsbml-internal */
+  /**
+   * Subclasses should override this method to write their attributes and
+   * contained Sed objects to a snapshot.  Be sure to call your parents
+   * implementation of this method as well, and to read the values back
+   * in the same order in readSnapshot().
+   */
+  virtual void writeSnapshot(SedSnapshotWriter& writer) const;
+
+
+  /**
+   * Subclasses should override this method to read the values written by
+   * writeSnapshot() back from a snapshot.
+   */
+  virtual void readSnapshot(SedSnapshotReader& reader);
+  /** @endcond */
+
+
   /** @cond doxygen-libsbml-internal */
   /* function returns true if component has all the required
    * attributes
@@ -2139,7 +2184,9 @@ public:
 
 
   /** @cond doxygen-libsbml-internal */
-  /* gets the Sednamespaces - internal use only*/
+  /* gets the Sednamespaces - internal use only; an element not
+   * connected to a document first gets a copy of its own, if its
+   * namespaces are shared with other elements */
   virtual SedNamespaces * getSedNamespaces() const;
   /** @endcond */
 
@@ -2455,6 +2502,16 @@ protected:
    */
   void checkListOfPopulated(SedBase* object);
 
+
+  /**
+   * Called by read() once the child element @p child has been read
+   * completely (up to and including its end tag).  The default
+   * implementation does nothing.
+   *
+   * @see SedStreamReader
+   */
+  virtual void childElementRead(SedBase* child);
+
   /**
    * Checks that the given default namespace in the given element is valid.
    * If the given default namespace is not valid, an error is logged.
@@ -2541,6 +2598,52 @@ protected:
   SedBase* getRootElement();
 
 
+  /**
+   * Updates the entry of this element in the id/metaid index of its
+   * SedDocument (if any), and drops the id index of the SedListOf
+   * containing it.  Needs to be called whenever the "id" or "metaid" of
+   * an element changes.
+   *
+   * @see SedDocument::addToIndex()
+   */
+  void indexElement();
+
+
+  /**
+   * Returns the SedNamespaces of this element (or of its document),
+   * without giving the element a copy of its own; the object returned
+   * must not be modified.
+   */
+  const SedNamespaces * getConstSedNamespaces() const;
+
+
+  /**
+   * Makes this element use the shared SedNamespaces object for the given
+   * level and version (and the default namespace of that combination),
+   * rather than a copy of its own.
+   */
+  void shareSedNamespaces(unsigned int level, unsigned int version);
+
+
+  /**
+   * Makes this element use the shared copy of the given SedNamespaces
+   * (see SedNamespaces::getSharedCopy()), rather than a copy of its own.
+   *
+   * The elements of a document are constructed from the SedNamespaces of
+   * the document and rarely declare namespaces of their own, so nearly
+   * all of them end up sharing a single object.
+   */
+  void shareSedNamespaces(const SedNamespaces* sedns);
+
+
+  /**
+   * Gives this element a copy of its SedNamespaces of its own, if they
+   * are shared with other elements, and returns it.  Needs to be called
+   * before the namespaces are handed out for modification.
+   */
+  SedNamespaces * unshareSedNamespaces() const;
+
+
   // ------------------------------------------------------------------
 
 
@@ -2548,7 +2651,14 @@ protected:
   XMLNode*        mNotes;
   XMLNode*        mAnnotation;
   SedDocument*   mSed;
-  SedNamespaces* mSedNamespaces;
+
+  /* the namespaces of this element; unless mSedNamespacesShared is false
+   * the object is shared with other elements and must not be modified
+   * (see unshareSedNamespaces())
+   */
+  mutable std::shared_ptr<SedNamespaces> mSedNamespaces;
+  mutable bool    mSedNamespacesShared;
+
   void*           mUserData;
 
   unsigned int mLine;
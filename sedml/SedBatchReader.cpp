@@ -0,0 +1,241 @@
+/**
+ * @file    SedBatchReader.cpp
+ * @brief   Reads many Sed Documents in parallel
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedBatchReader.h>
+#include <sedml/SedReader.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedThreadPool.h>
+
+#include <mutex>
+
+using namespace std;
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+SedBatchCallback::~SedBatchCallback()
+{
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Collects the documents into a vector, by position.
+ */
+class SedCollectDocuments : public SedBatchCallback
+{
+public:
+  SedCollectDocuments(vector<SedDocument*>& documents)
+    : mDocuments(documents)
+  {
+  }
+
+  virtual void documentRead(unsigned int index, const std::string&,
+                            SedDocument* d)
+  {
+    mDocuments[index] = d;
+  }
+
+private:
+  vector<SedDocument*>& mDocuments;
+};
+
+/** @endcond */
+
+
+SedBatchReader::SedBatchReader(unsigned int numThreads)
+  : mNumThreads(numThreads)
+{
+}
+
+
+SedBatchReader::~SedBatchReader()
+{
+}
+
+
+unsigned int
+SedBatchReader::getNumThreads() const
+{
+  return mNumThreads;
+}
+
+
+void
+SedBatchReader::setNumThreads(unsigned int numThreads)
+{
+  mNumThreads = numThreads;
+}
+
+
+vector<SedDocument*>
+SedBatchReader::readSedMLFromFiles(const vector<string>& filenames)
+{
+  vector<SedDocument*> documents(filenames.size(), (SedDocument*)NULL);
+  SedCollectDocuments collect(documents);
+
+  try
+    {
+      readSedMLFromFiles(filenames, collect);
+    }
+  catch (...)
+    {
+      for (size_t i = 0; i < documents.size(); ++i)
+        delete documents[i];
+
+      throw;
+    }
+
+  return documents;
+}
+
+
+void
+SedBatchReader::readSedMLFromFiles(const vector<string>& filenames,
+                                   SedBatchCallback& callback)
+{
+  if (filenames.empty()) return;
+
+  mutex callbackMutex;
+  bool failed = false;
+
+  /* each file is read with its own reader, on the thread that takes it */
+  SedThreadPool::forEach(getNumWorkers(filenames.size()), filenames.size(),
+                         [&](size_t i)
+  {
+    try
+      {
+        SedReader reader;
+        SedDocument* d = reader.readSedMLFromFile(filenames[i]);
+
+        lock_guard<mutex> lock(callbackMutex);
+
+        if (failed)
+          {
+            delete d;
+            return;
+          }
+
+        callback.documentRead((unsigned int)i, filenames[i], d);
+      }
+    catch (...)
+      {
+        lock_guard<mutex> lock(callbackMutex);
+        failed = true;
+        throw;
+      }
+  });
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+unsigned int
+SedBatchReader::getNumWorkers(size_t numFiles) const
+{
+  return SedThreadPool::getNumWorkers(mNumThreads, numFiles);
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Creates a new SedBatchReader and returns it.
+ */
+LIBSEDML_EXTERN
+SedBatchReader_t *
+SedBatchReader_create(unsigned int numThreads)
+{
+  return new (nothrow) SedBatchReader(numThreads);
+}
+
+
+/**
+ * Frees the given SedBatchReader.
+ */
+LIBSEDML_EXTERN
+void
+SedBatchReader_free(SedBatchReader_t *sr)
+{
+  if (sr != NULL)
+    delete sr;
+}
+
+
+/**
+ * Reads the given files in parallel, storing the documents by position.
+ */
+LIBSEDML_EXTERN
+int
+SedBatchReader_readSedMLFromFiles(SedBatchReader_t *sr,
+                                  const char **filenames,
+                                  unsigned int numFiles,
+                                  SedDocument_t **documents)
+{
+  if (sr == NULL || documents == NULL || (filenames == NULL && numFiles > 0))
+    return LIBSEDML_INVALID_OBJECT;
+
+  vector<string> files;
+
+  for (unsigned int i = 0; i < numFiles; ++i)
+    files.push_back(filenames[i] != NULL ? filenames[i] : "");
+
+  try
+    {
+      vector<SedDocument*> result = sr->readSedMLFromFiles(files);
+
+      for (unsigned int i = 0; i < numFiles; ++i)
+        documents[i] = result[i];
+    }
+  catch (...)
+    {
+      return LIBSEDML_OPERATION_FAILED;
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,225 @@
+/**
+ * @file    SedBatchReader.h
+ * @brief   Reads many Sed Documents in parallel
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedBatchReader
+ * @ingroup Core
+ * @brief Reads many SED-ML files in parallel on a pool of threads.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * The SedBatchReader reads a list of SED-ML files using a number of
+ * worker threads.  Every file is read by SedReader into its own
+ * SedDocument, so that each document carries its own SedErrorLog.
+ *
+ * The documents can either be collected and returned in the order of
+ * the input files, or be handed to a SedBatchCallback as soon as each
+ * of them has been read.
+ */
+
+#ifndef SedBatchReader_h
+#define SedBatchReader_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedBatchCallback
+{
+public:
+
+  /**
+   * Destroys this SedBatchCallback.
+   */
+  virtual ~SedBatchCallback();
+
+
+  /**
+   * Called once the file with the given index has been read.
+   *
+   * Calls are made from the worker threads in the order in which the
+   * documents complete, but never concurrently.
+   *
+   * @param index the position of the file in the list of filenames
+   * @param filename the name of the file that was read
+   * @param d the SedDocument read; the callee takes ownership of it.
+   */
+  virtual void documentRead(unsigned int index, const std::string& filename,
+                            SedDocument* d) = 0;
+};
+
+
+class LIBSEDML_EXTERN SedBatchReader
+{
+public:
+
+  /**
+   * Creates a new SedBatchReader using the given number of threads.
+   *
+   * @param numThreads the number of worker threads; @c 0 (the default)
+   * uses the number of hardware threads available.
+   */
+  SedBatchReader(unsigned int numThreads = 0);
+
+
+  /**
+   * Destroys this SedBatchReader.
+   */
+  virtual ~SedBatchReader();
+
+
+  /**
+   * Returns the number of worker threads used by this SedBatchReader.
+   *
+   * @return the number of threads, @c 0 for the number of hardware
+   * threads available.
+   */
+  unsigned int getNumThreads() const;
+
+
+  /**
+   * Sets the number of worker threads used by this SedBatchReader.
+   *
+   * @param numThreads the number of worker threads; @c 0 uses the number
+   * of hardware threads available.
+   */
+  void setNumThreads(unsigned int numThreads);
+
+
+  /**
+   * Reads the given files in parallel.
+   *
+   * @param filenames the names of the files to read
+   *
+   * @return the SedDocument objects read, in the order of @p filenames.
+   * The caller owns the returned documents.
+   */
+  std::vector<SedDocument*>
+  readSedMLFromFiles(const std::vector<std::string>& filenames);
+
+
+  /**
+   * Reads the given files in parallel, handing each SedDocument to
+   * @p callback as soon as it has been read.
+   *
+   * The method returns once all files have been read.
+   *
+   * @param filenames the names of the files to read
+   * @param callback the SedBatchCallback receiving the documents
+   */
+  void readSedMLFromFiles(const std::vector<std::string>& filenames,
+                          SedBatchCallback& callback);
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  /**
+   * Returns the number of threads to use for the given number of files.
+   */
+  unsigned int getNumWorkers(size_t numFiles) const;
+
+
+  unsigned int mNumThreads;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+/**
+ * Creates a new SedBatchReader using @p numThreads worker threads
+ * (@c 0 for the number of hardware threads), and returns it.
+ */
+LIBSEDML_EXTERN
+SedBatchReader_t *
+SedBatchReader_create(unsigned int numThreads);
+
+
+/**
+ * Frees the given SedBatchReader, created with SedBatchReader_create().
+ */
+LIBSEDML_EXTERN
+void
+SedBatchReader_free(SedBatchReader_t *sr);
+
+
+/**
+ * Reads the @p numFiles files named in @p filenames in parallel, storing
+ * the SedDocument read from each file at the same position of
+ * @p documents, which must have room for @p numFiles pointers.
+ *
+ * @return integer value indicating success/failure of the operation.
+ * The possible return values are:
+ * @li LIBSEDML_OPERATION_SUCCESS
+ * @li LIBSEDML_INVALID_OBJECT
+ * @li LIBSEDML_OPERATION_FAILED
+ */
+LIBSEDML_EXTERN
+int
+SedBatchReader_readSedMLFromFiles(SedBatchReader_t *sr,
+                                  const char **filenames,
+                                  unsigned int numFiles,
+                                  SedDocument_t **documents);
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+
+#endif  /* SedBatchReader_h */
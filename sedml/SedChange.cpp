@@ -36,6 +36,7 @@
 
 #include <sedml/SedChange.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -53,8 +54,6 @@ SedChange::SedChange(unsigned int level, unsigned int version)
   , mTarget("")
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -218,6 +217,40 @@ SedChange::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedChange::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedBase::writeSnapshot(writer);
+
+  writer.writeString(mTarget);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedChange::readSnapshot(SedSnapshotReader& reader)
+{
+  SedBase::readSnapshot(reader);
+
+  mTarget = reader.readString();
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -226,8 +259,10 @@ SedChange::writeElements(XMLOutputStream& stream) const
 bool
 SedChange::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
 
+  return true;
 }
 
 
@@ -326,7 +361,6 @@ SedListOfChanges::SedListOfChanges(unsigned int level,
                                    unsigned int version)
   : SedListOf(level, version)
 {
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -387,10 +421,8 @@ SedListOfChanges::get(const std::string& sid)
 const SedChange*
 SedListOfChanges::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedChange>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <SedChange*>(*result);
+  int index = getIndexById(sid);
+  return (index < 0) ? 0 : static_cast <SedChange*>(mItems[index]);
 }
 
 
@@ -534,14 +566,11 @@ SedChange*
 SedListOfChanges::remove(const std::string& sid)
 {
   SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedChange>(sid));
+  int index = getIndexById(sid);
 
-  if (result != mItems.end())
+  if (index >= 0)
     {
-      item = *result;
-      mItems.erase(result);
+      item = SedListOf::remove((unsigned int)index);
     }
 
   return static_cast <SedChange*>(item);
@@ -234,6 +234,28 @@ public:
   /** @endcond doxygen-libsedml-internal */
 
 
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Writes the attributes and children of this object to a snapshot.
+   */
+  virtual void writeSnapshot(SedSnapshotWriter& writer) const;
+
+
+  /** @endcond doxygen-libsedml-internal */
+
+
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Reads the attributes and children of this object from a snapshot.
+   */
+  virtual void readSnapshot(SedSnapshotReader& reader);
+
+
+  /** @endcond doxygen-libsedml-internal */
+
+
   /** @cond doxygen-libsedml-internal */
 
   /**
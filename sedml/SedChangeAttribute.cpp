@@ -36,6 +36,7 @@
 
 #include <sedml/SedChangeAttribute.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -53,8 +54,6 @@ SedChangeAttribute::SedChangeAttribute(unsigned int level, unsigned int version)
   , mNewValue("")
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -232,6 +231,40 @@ SedChangeAttribute::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedChangeAttribute::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedChange::writeSnapshot(writer);
+
+  writer.writeString(mNewValue);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedChangeAttribute::readSnapshot(SedSnapshotReader& reader)
+{
+  SedChange::readSnapshot(reader);
+
+  mNewValue = reader.readString();
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -240,8 +273,10 @@ SedChangeAttribute::writeElements(XMLOutputStream& stream) const
 bool
 SedChangeAttribute::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
 
+  return true;
 }
 
 
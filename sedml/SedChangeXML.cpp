@@ -36,6 +36,7 @@
 
 #include <sedml/SedChangeXML.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -53,8 +54,6 @@ SedChangeXML::SedChangeXML(unsigned int level, unsigned int version)
   , mNewXML(NULL)
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -244,6 +243,41 @@ SedChangeXML::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedChangeXML::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedChange::writeSnapshot(writer);
+
+  writer.writeXMLNode(mNewXML);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedChangeXML::readSnapshot(SedSnapshotReader& reader)
+{
+  SedChange::readSnapshot(reader);
+
+  delete mNewXML;
+  mNewXML = reader.readXMLNode();
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -252,8 +286,10 @@ SedChangeXML::writeElements(XMLOutputStream& stream) const
 bool
 SedChangeXML::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
 
+  return true;
 }
 
 
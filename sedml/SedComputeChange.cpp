@@ -36,6 +36,7 @@
 
 #include <sedml/SedComputeChange.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 #include <sbml/math/MathML.h>
 #include <sbml/math/ASTNode.h>
@@ -57,9 +58,6 @@ SedComputeChange::SedComputeChange(unsigned int level, unsigned int version)
   , mMath(NULL)
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
-
   // connect to child objects
   connectToChild();
 }
@@ -552,6 +550,7 @@ SedComputeChange::writeElements(XMLOutputStream& stream) const
 
   if (isSetMath() == true)
     {
+      SEDML_TIME_PHASE(SEDML_PHASE_WRITE_MATHML);
       writeMathML(getMath(), stream, NULL);
     }
 }
@@ -560,6 +559,46 @@ SedComputeChange::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedComputeChange::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedChange::writeSnapshot(writer);
+
+  mVariables.writeSnapshot(writer);
+  mParameters.writeSnapshot(writer);
+  writer.writeMath(mMath);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedComputeChange::readSnapshot(SedSnapshotReader& reader)
+{
+  SedChange::readSnapshot(reader);
+
+  mVariables.readSnapshot(reader);
+  mParameters.readSnapshot(reader);
+
+  delete mMath;
+  mMath = reader.readMath();
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -568,8 +607,22 @@ SedComputeChange::writeElements(XMLOutputStream& stream) const
 bool
 SedComputeChange::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      if (getNumVariables() > 0)
+        {
+          mVariables.accept(v);
+        }
+
+      if (getNumParameters() > 0)
+        {
+          mParameters.accept(v);
+        }
+    }
+
+  v.leave(*this);
 
+  return true;
 }
 
 
@@ -638,6 +691,7 @@ SedComputeChange::readOtherXML(XMLInputStream& stream)
 
   if (name == "math")
     {
+      SEDML_TIME_PHASE(SEDML_PHASE_MATHML);
       const XMLToken elem = stream.peek();
       const std::string prefix = checkMathMLNamespace(elem);
 
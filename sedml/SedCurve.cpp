@@ -36,6 +36,7 @@
 
 #include <sedml/SedCurve.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -66,8 +67,6 @@ SedCurve::SedCurve(unsigned int level, unsigned int version)
   , mLineStyle("")
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -393,7 +392,9 @@ SedCurve::isSetLineStyle() const
 int
 SedCurve::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  indexElement();
+  return result;
 }
 
 
@@ -541,6 +542,7 @@ int
 SedCurve::unsetId()
 {
   mId.erase();
+  indexElement();
 
   if (mId.empty() == true)
     {
@@ -790,6 +792,66 @@ SedCurve::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedCurve::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedBase::writeSnapshot(writer);
+
+  writer.writeString(mId);
+  writer.writeString(mName);
+  writer.writeBool(mLogX);
+  writer.writeBool(mIsSetLogX);
+  writer.writeBool(mLogY);
+  writer.writeBool(mIsSetLogY);
+  writer.writeString(mXDataReference);
+  writer.writeString(mYDataReference);
+  writer.writeString(mLineColor);
+  writer.writeString(mFillColor);
+  writer.writeString(mSymbol);
+  writer.writeDouble(mLineThickness);
+  writer.writeBool(mIsSetLineThickness);
+  writer.writeString(mLineStyle);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedCurve::readSnapshot(SedSnapshotReader& reader)
+{
+  SedBase::readSnapshot(reader);
+
+  mId = reader.readString();
+  mName = reader.readString();
+  mLogX = reader.readBool();
+  mIsSetLogX = reader.readBool();
+  mLogY = reader.readBool();
+  mIsSetLogY = reader.readBool();
+  mXDataReference = reader.readString();
+  mYDataReference = reader.readString();
+  mLineColor = reader.readString();
+  mFillColor = reader.readString();
+  mSymbol = reader.readString();
+  mLineThickness = reader.readDouble();
+  mIsSetLineThickness = reader.readBool();
+  mLineStyle = reader.readString();
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -798,8 +860,10 @@ SedCurve::writeElements(XMLOutputStream& stream) const
 bool
 SedCurve::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
 
+  return true;
 }
 
 
@@ -1070,7 +1134,6 @@ SedListOfCurves::SedListOfCurves(unsigned int level,
                                  unsigned int version)
   : SedListOf(level, version)
 {
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -1131,10 +1194,8 @@ SedListOfCurves::get(const std::string& sid)
 const SedCurve*
 SedListOfCurves::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedCurve>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <SedCurve*>(*result);
+  int index = getIndexById(sid);
+  return (index < 0) ? 0 : static_cast <SedCurve*>(mItems[index]);
 }
 
 
@@ -1206,14 +1267,11 @@ SedCurve*
 SedListOfCurves::remove(const std::string& sid)
 {
   SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedCurve>(sid));
+  int index = getIndexById(sid);
 
-  if (result != mItems.end())
+  if (index >= 0)
     {
-      item = *result;
-      mItems.erase(result);
+      item = SedListOf::remove((unsigned int)index);
     }
 
   return static_cast <SedCurve*>(item);
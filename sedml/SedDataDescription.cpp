@@ -36,10 +36,14 @@
 
 #include <sedml/SedDataDescription.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
+#include <sbml/xml/XMLOutputStream.h>
 
 #include <numl/DimensionDescription.h>
 
+#include <sstream>
+
 using namespace std;
 
 
@@ -59,9 +63,6 @@ SedDataDescription::SedDataDescription(unsigned int level, unsigned int version)
   , mDataSources(level, version)
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
-
   // connect to child objects
   connectToChild();
 }
@@ -268,7 +269,9 @@ SedDataDescription::isSetDimensionDescription() const
 int
 SedDataDescription::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  indexElement();
+  return result;
 }
 
 
@@ -342,6 +345,7 @@ int
 SedDataDescription::unsetId()
 {
   mId.erase();
+  indexElement();
 
   if (mId.empty() == true)
     {
@@ -653,6 +657,74 @@ SedDataDescription::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedDataDescription::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedBase::writeSnapshot(writer);
+
+  writer.writeString(mId);
+  writer.writeString(mName);
+  writer.writeString(mFormat);
+  writer.writeString(mSource);
+
+  // the NuML dimension description is kept as XML
+  writer.writeBool(isSetDimensionDescription());
+
+  if (isSetDimensionDescription() == true)
+    {
+      std::ostringstream xml;
+      XMLOutputStream stream(xml, "UTF-8", false);
+      mDimensionDescription->write(stream);
+      writer.writeString(xml.str());
+    }
+
+  mDataSources.writeSnapshot(writer);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedDataDescription::readSnapshot(SedSnapshotReader& reader)
+{
+  SedBase::readSnapshot(reader);
+
+  mId = reader.readString();
+  mName = reader.readString();
+  mFormat = reader.readString();
+  mSource = reader.readString();
+
+  delete mDimensionDescription;
+  mDimensionDescription = NULL;
+
+  if (reader.readBool())
+    {
+      std::string xml = reader.readString();
+      XMLInputStream stream(xml.c_str(), false);
+      stream.next();
+      stream.skipText();
+      mDimensionDescription = new DimensionDescription();
+      mDimensionDescription->read(stream);
+    }
+
+  mDataSources.readSnapshot(reader);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -661,8 +733,17 @@ SedDataDescription::writeElements(XMLOutputStream& stream) const
 bool
 SedDataDescription::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      if (getNumDataSources() > 0)
+        {
+          mDataSources.accept(v);
+        }
+    }
 
+  v.leave(*this);
+
+  return true;
 }
 
 
@@ -854,7 +935,6 @@ SedListOfDataDescriptions::SedListOfDataDescriptions(unsigned int level,
     unsigned int version)
   : SedListOf(level, version)
 {
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -915,10 +995,8 @@ SedListOfDataDescriptions::get(const std::string& sid)
 const SedDataDescription*
 SedListOfDataDescriptions::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedDataDescription>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <SedDataDescription*>(*result);
+  int index = getIndexById(sid);
+  return (index < 0) ? 0 : static_cast <SedDataDescription*>(mItems[index]);
 }
 
 
@@ -990,14 +1068,11 @@ SedDataDescription*
 SedListOfDataDescriptions::remove(const std::string& sid)
 {
   SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedDataDescription>(sid));
+  int index = getIndexById(sid);
 
-  if (result != mItems.end())
+  if (index >= 0)
     {
-      item = *result;
-      mItems.erase(result);
+      item = SedListOf::remove((unsigned int)index);
     }
 
   return static_cast <SedDataDescription*>(item);
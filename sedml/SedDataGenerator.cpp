@@ -36,6 +36,7 @@
 
 #include <sedml/SedDataGenerator.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 #include <sbml/math/MathML.h>
 #include <sbml/math/ASTNode.h>
@@ -59,9 +60,6 @@ SedDataGenerator::SedDataGenerator(unsigned int level, unsigned int version)
   , mMath(NULL)
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
-
   // connect to child objects
   connectToChild();
 }
@@ -211,7 +209,9 @@ SedDataGenerator::isSetMath() const
 int
 SedDataGenerator::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  indexElement();
+  return result;
 }
 
 
@@ -270,6 +270,7 @@ int
 SedDataGenerator::unsetId()
 {
   mId.erase();
+  indexElement();
 
   if (mId.empty() == true)
     {
@@ -664,6 +665,7 @@ SedDataGenerator::writeElements(XMLOutputStream& stream) const
 
   if (isSetMath() == true)
     {
+      SEDML_TIME_PHASE(SEDML_PHASE_WRITE_MATHML);
       writeMathML(getMath(), stream, NULL);
     }
 }
@@ -672,6 +674,50 @@ SedDataGenerator::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedDataGenerator::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedBase::writeSnapshot(writer);
+
+  writer.writeString(mId);
+  writer.writeString(mName);
+  mVariables.writeSnapshot(writer);
+  mParameters.writeSnapshot(writer);
+  writer.writeMath(mMath);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedDataGenerator::readSnapshot(SedSnapshotReader& reader)
+{
+  SedBase::readSnapshot(reader);
+
+  mId = reader.readString();
+  mName = reader.readString();
+  mVariables.readSnapshot(reader);
+  mParameters.readSnapshot(reader);
+
+  delete mMath;
+  mMath = reader.readMath();
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -680,8 +726,22 @@ SedDataGenerator::writeElements(XMLOutputStream& stream) const
 bool
 SedDataGenerator::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      if (getNumVariables() > 0)
+        {
+          mVariables.accept(v);
+        }
 
+      if (getNumParameters() > 0)
+        {
+          mParameters.accept(v);
+        }
+    }
+
+  v.leave(*this);
+
+  return true;
 }
 
 
@@ -786,6 +846,7 @@ SedDataGenerator::readOtherXML(XMLInputStream& stream)
 
   if (name == "math")
     {
+      SEDML_TIME_PHASE(SEDML_PHASE_MATHML);
       const XMLToken elem = stream.peek();
       const std::string prefix = checkMathMLNamespace(elem);
 
@@ -835,7 +896,6 @@ SedListOfDataGenerators::SedListOfDataGenerators(unsigned int level,
     unsigned int version)
   : SedListOf(level, version)
 {
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -896,10 +956,8 @@ SedListOfDataGenerators::get(const std::string& sid)
 const SedDataGenerator*
 SedListOfDataGenerators::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedDataGenerator>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <SedDataGenerator*>(*result);
+  int index = getIndexById(sid);
+  return (index < 0) ? 0 : static_cast <SedDataGenerator*>(mItems[index]);
 }
 
 
@@ -971,14 +1029,11 @@ SedDataGenerator*
 SedListOfDataGenerators::remove(const std::string& sid)
 {
   SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedDataGenerator>(sid));
+  int index = getIndexById(sid);
 
-  if (result != mItems.end())
+  if (index >= 0)
     {
-      item = *result;
-      mItems.erase(result);
+      item = SedListOf::remove((unsigned int)index);
     }
 
   return static_cast <SedDataGenerator*>(item);
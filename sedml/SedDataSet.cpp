@@ -36,6 +36,7 @@
 
 #include <sedml/SedDataSet.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -56,8 +57,6 @@ SedDataSet::SedDataSet(unsigned int level, unsigned int version)
   , mDataReference("")
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -213,7 +212,9 @@ SedDataSet::isSetDataReference() const
 int
 SedDataSet::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  indexElement();
+  return result;
 }
 
 
@@ -268,6 +269,7 @@ int
 SedDataSet::unsetId()
 {
   mId.erase();
+  indexElement();
 
   if (mId.empty() == true)
     {
@@ -394,6 +396,46 @@ SedDataSet::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedDataSet::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedBase::writeSnapshot(writer);
+
+  writer.writeString(mId);
+  writer.writeString(mLabel);
+  writer.writeString(mName);
+  writer.writeString(mDataReference);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedDataSet::readSnapshot(SedSnapshotReader& reader)
+{
+  SedBase::readSnapshot(reader);
+
+  mId = reader.readString();
+  mLabel = reader.readString();
+  mName = reader.readString();
+  mDataReference = reader.readString();
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -402,8 +444,10 @@ SedDataSet::writeElements(XMLOutputStream& stream) const
 bool
 SedDataSet::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
 
+  return true;
 }
 
 
@@ -567,7 +611,6 @@ SedListOfDataSets::SedListOfDataSets(unsigned int level,
                                      unsigned int version)
   : SedListOf(level, version)
 {
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -628,10 +671,8 @@ SedListOfDataSets::get(const std::string& sid)
 const SedDataSet*
 SedListOfDataSets::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedDataSet>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <SedDataSet*>(*result);
+  int index = getIndexById(sid);
+  return (index < 0) ? 0 : static_cast <SedDataSet*>(mItems[index]);
 }
 
 
@@ -703,14 +744,11 @@ SedDataSet*
 SedListOfDataSets::remove(const std::string& sid)
 {
   SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedDataSet>(sid));
+  int index = getIndexById(sid);
 
-  if (result != mItems.end())
+  if (index >= 0)
     {
-      item = *result;
-      mItems.erase(result);
+      item = SedListOf::remove((unsigned int)index);
     }
 
   return static_cast <SedDataSet*>(item);
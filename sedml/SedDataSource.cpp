@@ -36,6 +36,7 @@
 
 #include <sedml/SedDataSource.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -56,9 +57,6 @@ SedDataSource::SedDataSource(unsigned int level, unsigned int version)
   , mSlices(level, version)
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
-
   // connect to child objects
   connectToChild();
 }
@@ -205,7 +203,9 @@ SedDataSource::isSetIndexSet() const
 int
 SedDataSource::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  indexElement();
+  return result;
 }
 
 
@@ -242,6 +242,7 @@ int
 SedDataSource::unsetId()
 {
   mId.erase();
+  indexElement();
 
   if (mId.empty() == true)
     {
@@ -514,6 +515,46 @@ SedDataSource::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedDataSource::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedBase::writeSnapshot(writer);
+
+  writer.writeString(mId);
+  writer.writeString(mName);
+  writer.writeString(mIndexSet);
+  mSlices.writeSnapshot(writer);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedDataSource::readSnapshot(SedSnapshotReader& reader)
+{
+  SedBase::readSnapshot(reader);
+
+  mId = reader.readString();
+  mName = reader.readString();
+  mIndexSet = reader.readString();
+  mSlices.readSnapshot(reader);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -522,8 +563,17 @@ SedDataSource::writeElements(XMLOutputStream& stream) const
 bool
 SedDataSource::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      if (getNumSlices() > 0)
+        {
+          mSlices.accept(v);
+        }
+    }
+
+  v.leave(*this);
 
+  return true;
 }
 
 
@@ -665,7 +715,6 @@ SedListOfDataSources::SedListOfDataSources(unsigned int level,
     unsigned int version)
   : SedListOf(level, version)
 {
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -726,10 +775,8 @@ SedListOfDataSources::get(const std::string& sid)
 const SedDataSource*
 SedListOfDataSources::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedDataSource>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <SedDataSource*>(*result);
+  int index = getIndexById(sid);
+  return (index < 0) ? 0 : static_cast <SedDataSource*>(mItems[index]);
 }
 
 
@@ -801,14 +848,11 @@ SedDataSource*
 SedListOfDataSources::remove(const std::string& sid)
 {
   SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedDataSource>(sid));
+  int index = getIndexById(sid);
 
-  if (result != mItems.end())
+  if (index >= 0)
     {
-      item = *result;
-      mItems.erase(result);
+      item = SedListOf::remove((unsigned int)index);
     }
 
   return static_cast <SedDataSource*>(item);
@@ -0,0 +1,476 @@
+/**
+ * @file    SedDependencyGraph.cpp
+ * @brief   Dependencies between the elements of a Sed Document
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedDependencyGraph.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedModel.h>
+#include <sedml/SedComputeChange.h>
+#include <sedml/SedSimulation.h>
+#include <sedml/SedTask.h>
+#include <sedml/SedRepeatedTask.h>
+#include <sedml/SedSubTask.h>
+#include <sedml/SedSetValue.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedVariable.h>
+#include <sedml/SedOutput.h>
+#include <sedml/SedReport.h>
+#include <sedml/SedDataSet.h>
+#include <sedml/SedPlot2D.h>
+#include <sedml/SedPlot3D.h>
+#include <sedml/SedCurve.h>
+#include <sedml/SedSurface.h>
+
+#include <algorithm>
+
+using namespace std;
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygen-libsedml-internal */
+
+static bool
+compareOrder(const SedSubTask* a, const SedSubTask* b)
+{
+  return a->getOrder() < b->getOrder();
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Creates the SedDependencyGraph of the given SedDocument.
+ */
+SedDependencyGraph::SedDependencyGraph(const SedDocument* doc)
+  : mDocument(doc)
+  , mNodes()
+  , mIndex()
+  , mIds()
+  , mDependencies()
+  , mDependents()
+  , mSubTasks()
+  , mHasCycle(false)
+{
+  if (doc == NULL)
+    return;
+
+  for (unsigned int i = 0; i < doc->getNumModels(); ++i)
+    addNode(doc->getModel(i));
+
+  for (unsigned int i = 0; i < doc->getNumSimulations(); ++i)
+    addNode(doc->getSimulation(i));
+
+  for (unsigned int i = 0; i < doc->getNumTasks(); ++i)
+    addNode(doc->getTask(i));
+
+  for (unsigned int i = 0; i < doc->getNumDataGenerators(); ++i)
+    addNode(doc->getDataGenerator(i));
+
+  for (unsigned int i = 0; i < doc->getNumOutputs(); ++i)
+    addNode(doc->getOutput(i));
+
+  for (unsigned int n = 0; n < mNodes.size(); ++n)
+    {
+      const SedBase* object = mNodes[n];
+
+      switch (object->getTypeCode())
+        {
+        case SEDML_MODEL:
+          {
+            const SedModel* model = static_cast<const SedModel*>(object);
+            const string& source = model->getSource();
+            addDependency(n, (!source.empty() && source[0] == '#')
+                             ? source.substr(1) : source);
+
+            for (unsigned int i = 0; i < model->getNumChanges(); ++i)
+              {
+                const SedChange* change = model->getChange(i);
+
+                if (change->getTypeCode() != SEDML_CHANGE_COMPUTECHANGE)
+                  continue;
+
+                const SedComputeChange* compute =
+                  static_cast<const SedComputeChange*>(change);
+
+                for (unsigned int j = 0; j < compute->getNumVariables(); ++j)
+                  addDependency(n,
+                                compute->getVariable(j)->getModelReference());
+              }
+          }
+          break;
+
+        case SEDML_TASK:
+        case SEDML_TASK_REPEATEDTASK:
+          {
+            const SedTask* task = static_cast<const SedTask*>(object);
+            addDependency(n, task->getModelReference());
+            addDependency(n, task->getSimulationReference());
+
+            if (object->getTypeCode() != SEDML_TASK_REPEATEDTASK)
+              break;
+
+            const SedRepeatedTask* repeated =
+              static_cast<const SedRepeatedTask*>(object);
+
+            for (unsigned int i = 0; i < repeated->getNumTaskChanges(); ++i)
+              {
+                const SedSetValue* change = repeated->getTaskChange(i);
+                addDependency(n, change->getModelReference());
+
+                for (unsigned int j = 0; j < change->getNumVariables(); ++j)
+                  addDependency(n, change->getVariable(j)->getModelReference());
+              }
+
+            vector<const SedSubTask*> subTasks;
+
+            for (unsigned int i = 0; i < repeated->getNumSubTasks(); ++i)
+              subTasks.push_back(repeated->getSubTask(i));
+
+            stable_sort(subTasks.begin(), subTasks.end(), compareOrder);
+
+            for (size_t i = 0; i < subTasks.size(); ++i)
+              {
+                int t = getNodeIndex(subTasks[i]->getTask());
+                int type = t >= 0 ? mNodes[t]->getTypeCode() : SEDML_UNKNOWN;
+
+                if (type == SEDML_TASK || type == SEDML_TASK_REPEATEDTASK)
+                  mSubTasks[n].push_back((unsigned int)t);
+              }
+          }
+          break;
+
+        case SEDML_DATAGENERATOR:
+          {
+            const SedDataGenerator* dg =
+              static_cast<const SedDataGenerator*>(object);
+
+            for (unsigned int i = 0; i < dg->getNumVariables(); ++i)
+              {
+                const SedVariable* variable = dg->getVariable(i);
+                addDependency(n, variable->getTaskReference());
+                addDependency(n, variable->getModelReference());
+              }
+          }
+          break;
+
+        case SEDML_OUTPUT_REPORT:
+          {
+            const SedReport* report = static_cast<const SedReport*>(object);
+
+            for (unsigned int i = 0; i < report->getNumDataSets(); ++i)
+              addDependency(n, report->getDataSet(i)->getDataReference());
+          }
+          break;
+
+        case SEDML_OUTPUT_PLOT2D:
+          {
+            const SedPlot2D* plot = static_cast<const SedPlot2D*>(object);
+
+            for (unsigned int i = 0; i < plot->getNumCurves(); ++i)
+              {
+                addDependency(n, plot->getCurve(i)->getXDataReference());
+                addDependency(n, plot->getCurve(i)->getYDataReference());
+              }
+          }
+          break;
+
+        case SEDML_OUTPUT_PLOT3D:
+          {
+            const SedPlot3D* plot = static_cast<const SedPlot3D*>(object);
+
+            for (unsigned int i = 0; i < plot->getNumSurfaces(); ++i)
+              {
+                addDependency(n, plot->getSurface(i)->getXDataReference());
+                addDependency(n, plot->getSurface(i)->getYDataReference());
+                addDependency(n, plot->getSurface(i)->getZDataReference());
+              }
+          }
+          break;
+
+        default:
+          break;
+        }
+    }
+
+  // repeated tasks inherit the dependencies of the tasks they run
+  vector<int> state(mNodes.size(), 0);
+
+  for (unsigned int n = 0; n < mNodes.size(); ++n)
+    {
+      if (!mSubTasks[n].empty() && !addSubTaskDependencies(n, state))
+        mHasCycle = true;
+    }
+
+  for (unsigned int n = 0; n < mNodes.size(); ++n)
+    {
+      vector<unsigned int>& dependencies = mDependencies[n];
+      sort(dependencies.begin(), dependencies.end());
+      dependencies.erase(unique(dependencies.begin(), dependencies.end()),
+                         dependencies.end());
+      dependencies.erase(remove(dependencies.begin(), dependencies.end(), n),
+                         dependencies.end());
+
+      for (size_t i = 0; i < dependencies.size(); ++i)
+        mDependents[dependencies[i]].push_back(n);
+    }
+
+  vector<unsigned int> order;
+
+  if (getTopologicalOrder(order) != LIBSEDML_OPERATION_SUCCESS)
+    mHasCycle = true;
+}
+
+
+/*
+ * Destroys this SedDependencyGraph.
+ */
+SedDependencyGraph::~SedDependencyGraph()
+{
+}
+
+
+/*
+ * Returns the SedDocument of this SedDependencyGraph.
+ */
+const SedDocument*
+SedDependencyGraph::getSedDocument() const
+{
+  return mDocument;
+}
+
+
+/*
+ * Returns the number of nodes.
+ */
+unsigned int
+SedDependencyGraph::getNumNodes() const
+{
+  return (unsigned int)mNodes.size();
+}
+
+
+/*
+ * Returns the element of the nth node.
+ */
+const SedBase*
+SedDependencyGraph::getNode(unsigned int n) const
+{
+  return n < mNodes.size() ? mNodes[n] : NULL;
+}
+
+
+/*
+ * Returns the index of the node of the given element.
+ */
+int
+SedDependencyGraph::getNodeIndex(const SedBase* object) const
+{
+  unordered_map<const SedBase*, unsigned int>::const_iterator it =
+    mIndex.find(object);
+  return it == mIndex.end() ? -1 : (int)it->second;
+}
+
+
+/*
+ * Returns the index of the node with the given identifier.
+ */
+int
+SedDependencyGraph::getNodeIndex(const std::string& sid) const
+{
+  unordered_map<string, unsigned int>::const_iterator it = mIds.find(sid);
+  return it == mIds.end() ? -1 : (int)it->second;
+}
+
+
+/*
+ * Returns the dependencies of the nth node.
+ */
+const std::vector<unsigned int>&
+SedDependencyGraph::getDependencies(unsigned int n) const
+{
+  static const vector<unsigned int> empty;
+  return n < mNodes.size() ? mDependencies[n] : empty;
+}
+
+
+/*
+ * Returns the dependents of the nth node.
+ */
+const std::vector<unsigned int>&
+SedDependencyGraph::getDependents(unsigned int n) const
+{
+  static const vector<unsigned int> empty;
+  return n < mNodes.size() ? mDependents[n] : empty;
+}
+
+
+/*
+ * Returns the tasks run by the nth node.
+ */
+const std::vector<unsigned int>&
+SedDependencyGraph::getSubTasks(unsigned int n) const
+{
+  static const vector<unsigned int> empty;
+  return n < mNodes.size() ? mSubTasks[n] : empty;
+}
+
+
+/*
+ * Returns true if the dependencies contain a cycle.
+ */
+bool
+SedDependencyGraph::hasCycle() const
+{
+  return mHasCycle;
+}
+
+
+/*
+ * Returns the nodes in an order where each follows its dependencies.
+ */
+int
+SedDependencyGraph::getTopologicalOrder(std::vector<unsigned int>& order) const
+{
+  order.clear();
+  order.reserve(mNodes.size());
+
+  vector<size_t> pending(mNodes.size());
+
+  for (unsigned int n = 0; n < mNodes.size(); ++n)
+    {
+      pending[n] = mDependencies[n].size();
+
+      if (pending[n] == 0)
+        order.push_back(n);
+    }
+
+  for (size_t i = 0; i < order.size(); ++i)
+    {
+      const vector<unsigned int>& dependents = mDependents[order[i]];
+
+      for (size_t j = 0; j < dependents.size(); ++j)
+        if (--pending[dependents[j]] == 0)
+          order.push_back(dependents[j]);
+    }
+
+  if (order.size() != mNodes.size() || mHasCycle)
+    return LIBSEDML_OPERATION_FAILED;
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds a node for the given element.
+ */
+unsigned int
+SedDependencyGraph::addNode(const SedBase* object)
+{
+  unsigned int n = (unsigned int)mNodes.size();
+  mNodes.push_back(object);
+  mIndex[object] = n;
+
+  if (!object->getId().empty())
+    mIds.insert(make_pair(object->getId(), n));
+
+  mDependencies.push_back(vector<unsigned int>());
+  mDependents.push_back(vector<unsigned int>());
+  mSubTasks.push_back(vector<unsigned int>());
+  return n;
+}
+
+
+/*
+ * Makes the nth node depend on the node with the given identifier, if
+ * there is one.
+ */
+void
+SedDependencyGraph::addDependency(unsigned int n, const std::string& sid)
+{
+  if (sid.empty())
+    return;
+
+  int dependency = getNodeIndex(sid);
+
+  if (dependency >= 0)
+    mDependencies[n].push_back((unsigned int)dependency);
+}
+
+
+/*
+ * Adds the dependencies of the tasks run by the repeated task of the nth
+ * node, after those of nested repeated tasks; returns false if repeated
+ * tasks run each other.
+ */
+bool
+SedDependencyGraph::addSubTaskDependencies(unsigned int n,
+                                           std::vector<int>& state)
+{
+  if (state[n] == 2)
+    return true;
+
+  if (state[n] == 1)
+    return false;
+
+  state[n] = 1;
+
+  for (size_t i = 0; i < mSubTasks[n].size(); ++i)
+    {
+      unsigned int task = mSubTasks[n][i];
+
+      if (!mSubTasks[task].empty() && !addSubTaskDependencies(task, state))
+        return false;
+
+      mDependencies[n].insert(mDependencies[n].end(),
+                              mDependencies[task].begin(),
+                              mDependencies[task].end());
+    }
+
+  state[n] = 2;
+  return true;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+#endif  /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
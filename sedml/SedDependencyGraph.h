@@ -0,0 +1,248 @@
+/**
+ * @file    SedDependencyGraph.h
+ * @brief   Dependencies between the elements of a Sed Document
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedDependencyGraph
+ * @ingroup Core
+ * @brief The graph of the references between the elements of a
+ * SedDocument.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedDependencyGraph has one node for each SedModel, SedSimulation,
+ * SedTask (including SedRepeatedTask), SedDataGenerator and SedOutput of
+ * a SedDocument.  The dependencies of a node are the nodes that must be
+ * dealt with before it:
+ *
+ * @li a SedModel depends on the model named by its "source", and on the
+ * models used by the variables of its SedComputeChange elements;
+ * @li a SedTask depends on its SedModel and SedSimulation;
+ * @li a SedRepeatedTask depends on the models changed by its SedSetValue
+ * elements, and on the dependencies of the tasks of its SedSubTask
+ * elements, which it runs itself;
+ * @li a SedDataGenerator depends on the tasks and models its SedVariable
+ * elements refer to;
+ * @li a SedOutput depends on the data generators it displays.
+ *
+ * The tasks that a SedRepeatedTask runs are no dependencies, as the
+ * repeated task runs them itself; they are listed by getSubTasks().
+ * References that cannot be resolved are ignored.
+ */
+
+#ifndef SedDependencyGraph_h
+#define SedDependencyGraph_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedDependencyGraph
+{
+public:
+
+  /**
+   * Creates the SedDependencyGraph of the given SedDocument.
+   *
+   * The SedDocument must not be changed while this SedDependencyGraph is
+   * in use.
+   *
+   * @param doc the SedDocument.
+   */
+  SedDependencyGraph(const SedDocument* doc);
+
+
+  /**
+   * Destroys this SedDependencyGraph.
+   */
+  virtual ~SedDependencyGraph();
+
+
+  /**
+   * Returns the SedDocument of this SedDependencyGraph.
+   *
+   * @return the SedDocument this SedDependencyGraph was created for.
+   */
+  const SedDocument* getSedDocument() const;
+
+
+  /**
+   * Returns the number of nodes of this SedDependencyGraph.
+   *
+   * @return the number of nodes.
+   */
+  unsigned int getNumNodes() const;
+
+
+  /**
+   * Returns the element of the nth node.
+   *
+   * @param n an unsigned int representing the index of the node.
+   *
+   * @return the SedModel, SedSimulation, SedTask, SedDataGenerator or
+   * SedOutput, or @c NULL if @p n is out of range.
+   */
+  const SedBase* getNode(unsigned int n) const;
+
+
+  /**
+   * Returns the index of the node of the given element.
+   *
+   * @param object the element.
+   *
+   * @return the index of the node, or @c -1 if @p object has no node.
+   */
+  int getNodeIndex(const SedBase* object) const;
+
+
+  /**
+   * Returns the index of the node of the element with the given
+   * identifier.
+   *
+   * @param sid the identifier of the element.
+   *
+   * @return the index of the node, or @c -1 if no node has this
+   * identifier.
+   */
+  int getNodeIndex(const std::string& sid) const;
+
+
+  /**
+   * Returns the dependencies of the nth node.
+   *
+   * @param n an unsigned int representing the index of the node.
+   *
+   * @return the indices of the nodes that must be dealt with before it.
+   */
+  const std::vector<unsigned int>& getDependencies(unsigned int n) const;
+
+
+  /**
+   * Returns the dependents of the nth node.
+   *
+   * @param n an unsigned int representing the index of the node.
+   *
+   * @return the indices of the nodes that depend on it.
+   */
+  const std::vector<unsigned int>& getDependents(unsigned int n) const;
+
+
+  /**
+   * Returns the tasks run by the nth node, if it is a SedRepeatedTask.
+   *
+   * @param n an unsigned int representing the index of the node.
+   *
+   * @return the indices of the tasks of its subtasks, in the order of
+   * their "order" attribute; empty for other nodes.
+   */
+  const std::vector<unsigned int>& getSubTasks(unsigned int n) const;
+
+
+  /**
+   * Predicate returning @c true if the dependencies contain a cycle.
+   *
+   * A cycle arises from models that are sources of each other, or from
+   * repeated tasks that run each other.
+   *
+   * @return @c true if there is a cycle, @c false otherwise.
+   */
+  bool hasCycle() const;
+
+
+  /**
+   * Returns the nodes of this SedDependencyGraph in an order where each
+   * node follows its dependencies.
+   *
+   * @param order the vector receiving the indices of the nodes.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_OPERATION_FAILED
+   *
+   * The operation fails if the dependencies contain a cycle.
+   */
+  int getTopologicalOrder(std::vector<unsigned int>& order) const;
+
+
+protected:
+
+  /** @cond doxygen-libsedml-internal */
+
+  unsigned int addNode(const SedBase* object);
+
+  void addDependency(unsigned int n, const std::string& sid);
+
+  bool addSubTaskDependencies(unsigned int n, std::vector<int>& state);
+
+  const SedDocument* mDocument;
+
+  std::vector<const SedBase*> mNodes;
+
+  std::unordered_map<const SedBase*, unsigned int> mIndex;
+
+  std::unordered_map<std::string, unsigned int> mIds;
+
+  std::vector<std::vector<unsigned int> > mDependencies;
+
+  std::vector<std::vector<unsigned int> > mDependents;
+
+  std::vector<std::vector<unsigned int> > mSubTasks;
+
+  bool mHasCycle;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedDependencyGraph_h */
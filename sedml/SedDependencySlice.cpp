@@ -0,0 +1,409 @@
+/**
+ * @file    SedDependencySlice.cpp
+ * @brief   The part of a Sed document needed by a set of outputs
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedDependencySlice.h>
+#include <sedml/SedDependencyGraph.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedModel.h>
+#include <sedml/SedSimulation.h>
+#include <sedml/SedTask.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedVariable.h>
+#include <sedml/SedOutput.h>
+
+#include <set>
+#include <utility>
+
+using namespace std;
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygen-libsedml-internal */
+
+static bool
+isOutput(const SedBase* object)
+{
+  switch (object->getTypeCode())
+    {
+    case SEDML_OUTPUT:
+    case SEDML_OUTPUT_REPORT:
+    case SEDML_OUTPUT_PLOT2D:
+    case SEDML_OUTPUT_PLOT3D:
+      return true;
+    default:
+      return false;
+    }
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Creates a new, empty SedDependencySlice of the given
+ * SedDependencyGraph.
+ */
+SedDependencySlice::SedDependencySlice(const SedDependencyGraph& graph)
+  : mGraph(graph)
+  , mSelected(graph.getNumNodes(), false)
+  , mNodes()
+  , mTasks()
+  , mSimulations()
+  , mModels()
+  , mDataGenerators()
+  , mRecorded()
+{
+}
+
+
+/*
+ * Destroys this SedDependencySlice.
+ */
+SedDependencySlice::~SedDependencySlice()
+{
+}
+
+
+/*
+ * Returns the SedDependencyGraph of this SedDependencySlice.
+ */
+const SedDependencyGraph&
+SedDependencySlice::getGraph() const
+{
+  return mGraph;
+}
+
+
+/*
+ * Adds the given output, and everything it depends on.
+ */
+int
+SedDependencySlice::addOutput(const SedOutput* output)
+{
+  int n = mGraph.getNodeIndex(output);
+
+  if (n < 0)
+    return LIBSEDML_INVALID_OBJECT;
+
+  addNode((unsigned int)n);
+  update();
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Adds the output with the given identifier, and everything it depends
+ * on.
+ */
+int
+SedDependencySlice::addOutput(const std::string& sid)
+{
+  int n = mGraph.getNodeIndex(sid);
+
+  if (n < 0 || !isOutput(mGraph.getNode((unsigned int)n)))
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  addNode((unsigned int)n);
+  update();
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Removes all outputs from this SedDependencySlice.
+ */
+void
+SedDependencySlice::clear()
+{
+  mSelected.assign(mGraph.getNumNodes(), false);
+  update();
+}
+
+
+/*
+ * Predicate returning true if the nth node is part of this slice.
+ */
+bool
+SedDependencySlice::contains(unsigned int n) const
+{
+  return n < mSelected.size() && mSelected[n];
+}
+
+
+/*
+ * Predicate returning true if the given element is a node of this slice.
+ */
+bool
+SedDependencySlice::contains(const SedBase* object) const
+{
+  int n = mGraph.getNodeIndex(object);
+  return n >= 0 && contains((unsigned int)n);
+}
+
+
+/*
+ * Returns the nodes of this SedDependencySlice.
+ */
+const std::vector<unsigned int>&
+SedDependencySlice::getNodes() const
+{
+  return mNodes;
+}
+
+
+/*
+ * Returns the number of tasks used by this SedDependencySlice.
+ */
+unsigned int
+SedDependencySlice::getNumTasks() const
+{
+  return (unsigned int)mTasks.size();
+}
+
+
+/*
+ * Returns the nth task used by this SedDependencySlice.
+ */
+const SedTask*
+SedDependencySlice::getTask(unsigned int n) const
+{
+  return n < mTasks.size() ? mTasks[n] : NULL;
+}
+
+
+/*
+ * Returns the number of simulations used by this SedDependencySlice.
+ */
+unsigned int
+SedDependencySlice::getNumSimulations() const
+{
+  return (unsigned int)mSimulations.size();
+}
+
+
+/*
+ * Returns the nth simulation used by this SedDependencySlice.
+ */
+const SedSimulation*
+SedDependencySlice::getSimulation(unsigned int n) const
+{
+  return n < mSimulations.size() ? mSimulations[n] : NULL;
+}
+
+
+/*
+ * Returns the number of models used by this SedDependencySlice.
+ */
+unsigned int
+SedDependencySlice::getNumModels() const
+{
+  return (unsigned int)mModels.size();
+}
+
+
+/*
+ * Returns the nth model used by this SedDependencySlice.
+ */
+const SedModel*
+SedDependencySlice::getModel(unsigned int n) const
+{
+  return n < mModels.size() ? mModels[n] : NULL;
+}
+
+
+/*
+ * Returns the number of data generators used by this SedDependencySlice.
+ */
+unsigned int
+SedDependencySlice::getNumDataGenerators() const
+{
+  return (unsigned int)mDataGenerators.size();
+}
+
+
+/*
+ * Returns the nth data generator used by this SedDependencySlice.
+ */
+const SedDataGenerator*
+SedDependencySlice::getDataGenerator(unsigned int n) const
+{
+  return n < mDataGenerators.size() ? mDataGenerators[n] : NULL;
+}
+
+
+/*
+ * Returns the variables to be recorded by the given task.
+ */
+const std::vector<const SedVariable*>&
+SedDependencySlice::getRecordedVariables(const SedTask* task) const
+{
+  static const vector<const SedVariable*> empty;
+
+  map<const SedTask*, vector<const SedVariable*> >::const_iterator it =
+    mRecorded.find(task);
+  return it == mRecorded.end() ? empty : it->second;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Selects the given node and all the nodes it depends on.
+ */
+void
+SedDependencySlice::addNode(unsigned int n)
+{
+  vector<unsigned int> stack(1, n);
+
+  while (!stack.empty())
+    {
+      unsigned int node = stack.back();
+      stack.pop_back();
+
+      if (mSelected[node])
+        continue;
+
+      mSelected[node] = true;
+      const vector<unsigned int>& dependencies = mGraph.getDependencies(node);
+      stack.insert(stack.end(), dependencies.begin(), dependencies.end());
+    }
+}
+
+
+/*
+ * Lists the given task, and the tasks it runs as subtasks.
+ */
+void
+SedDependencySlice::addTask(unsigned int n, std::vector<bool>& visited)
+{
+  if (visited[n])
+    return;
+
+  visited[n] = true;
+  mTasks.push_back(static_cast<const SedTask*>(mGraph.getNode(n)));
+
+  const vector<unsigned int>& subTasks = mGraph.getSubTasks(n);
+
+  for (size_t i = 0; i < subTasks.size(); ++i)
+    addTask(subTasks[i], visited);
+}
+
+
+/*
+ * Rebuilds the lists of elements from the selected nodes.
+ */
+void
+SedDependencySlice::update()
+{
+  mNodes.clear();
+  mTasks.clear();
+  mSimulations.clear();
+  mModels.clear();
+  mDataGenerators.clear();
+  mRecorded.clear();
+
+  vector<bool> visited(mSelected.size(), false);
+  map<const SedTask*, set<pair<string, string> > > targets;
+
+  for (unsigned int n = 0; n < mSelected.size(); ++n)
+    {
+      if (!mSelected[n])
+        continue;
+
+      mNodes.push_back(n);
+      const SedBase* object = mGraph.getNode(n);
+
+      switch (object->getTypeCode())
+        {
+        case SEDML_MODEL:
+          mModels.push_back(static_cast<const SedModel*>(object));
+          break;
+
+        case SEDML_TASK:
+        case SEDML_TASK_REPEATEDTASK:
+          addTask(n, visited);
+          break;
+
+        case SEDML_DATAGENERATOR:
+          {
+            const SedDataGenerator* dg =
+              static_cast<const SedDataGenerator*>(object);
+            mDataGenerators.push_back(dg);
+
+            for (unsigned int i = 0; i < dg->getNumVariables(); ++i)
+              {
+                const SedVariable* variable = dg->getVariable(i);
+                int t = mGraph.getNodeIndex(variable->getTaskReference());
+
+                if (t < 0)
+                  continue;
+
+                const SedBase* task = mGraph.getNode((unsigned int)t);
+
+                if (task->getTypeCode() != SEDML_TASK &&
+                    task->getTypeCode() != SEDML_TASK_REPEATEDTASK)
+                  continue;
+
+                // a quantity used by several data generators is recorded once
+                const SedTask* key = static_cast<const SedTask*>(task);
+
+                pair<string, string> quantity(variable->getTarget(),
+                                              variable->getSymbol());
+
+                if (targets[key].insert(quantity).second)
+                  mRecorded[key].push_back(variable);
+              }
+          }
+          break;
+
+        default:
+          if (!isOutput(object))
+            mSimulations.push_back(static_cast<const SedSimulation*>(object));
+
+          break;
+        }
+    }
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+#endif  /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,307 @@
+/**
+ * @file    SedDependencySlice.h
+ * @brief   The part of a Sed document needed by a set of outputs
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedDependencySlice
+ * @ingroup Core
+ * @brief The elements of a SedDocument that a set of outputs needs.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedDependencySlice starts from the SedOutput elements added to it,
+ * and follows the dependencies of a SedDependencyGraph back from them:
+ * from the datasets, curves and surfaces of each output to its
+ * data generators, from their variables to tasks, and from the tasks
+ * to their models and simulations.  The nodes reached are the only ones
+ * a SedExecutor needs to run to produce these outputs; everything else
+ * in the document may be skipped.
+ *
+ * Besides the nodes, a SedDependencySlice lists the tasks, models and
+ * simulations used, including the tasks that repeated tasks run
+ * themselves, and for each task the variables whose values have to be
+ * recorded, without repeating a target or symbol.
+ */
+
+#ifndef SedDependencySlice_h
+#define SedDependencySlice_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+class SedDependencyGraph;
+class SedOutput;
+class SedTask;
+class SedModel;
+class SedSimulation;
+class SedDataGenerator;
+class SedVariable;
+
+
+class LIBSEDML_EXTERN SedDependencySlice
+{
+public:
+
+  /**
+   * Creates a new, empty SedDependencySlice of the given
+   * SedDependencyGraph.
+   *
+   * @param graph the SedDependencyGraph; it must not be destroyed while
+   * this SedDependencySlice is in use.
+   */
+  SedDependencySlice(const SedDependencyGraph& graph);
+
+
+  /**
+   * Destroys this SedDependencySlice.
+   */
+  virtual ~SedDependencySlice();
+
+
+  /**
+   * Returns the SedDependencyGraph of this SedDependencySlice.
+   *
+   * @return the SedDependencyGraph this SedDependencySlice was created
+   * for.
+   */
+  const SedDependencyGraph& getGraph() const;
+
+
+  /**
+   * Adds the given output, and everything it depends on, to this
+   * SedDependencySlice.
+   *
+   * @param output the SedOutput.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INVALID_OBJECT
+   */
+  int addOutput(const SedOutput* output);
+
+
+  /**
+   * Adds the output with the given identifier, and everything it depends
+   * on, to this SedDependencySlice.
+   *
+   * @param sid the identifier of the SedOutput.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INVALID_ATTRIBUTE_VALUE
+   */
+  int addOutput(const std::string& sid);
+
+
+  /**
+   * Removes all outputs from this SedDependencySlice.
+   */
+  void clear();
+
+
+  /**
+   * Predicate returning @c true if the nth node of the graph is part of
+   * this SedDependencySlice.
+   *
+   * @param n an unsigned int representing the index of the node.
+   *
+   * @return @c true if the node has to be run for the outputs added,
+   * @c false otherwise.
+   */
+  bool contains(unsigned int n) const;
+
+
+  /**
+   * Predicate returning @c true if the given element is a node of this
+   * SedDependencySlice.
+   *
+   * @param object an element of the SedDocument.
+   *
+   * @return @c true if the element has to be run for the outputs added,
+   * @c false otherwise.
+   */
+  bool contains(const SedBase* object) const;
+
+
+  /**
+   * Returns the nodes of this SedDependencySlice.
+   *
+   * @return the indices of the nodes of the graph that have to be run,
+   * in increasing order.
+   */
+  const std::vector<unsigned int>& getNodes() const;
+
+
+  /**
+   * Returns the number of tasks used by this SedDependencySlice.
+   *
+   * @return the number of tasks, including those that repeated tasks
+   * run themselves.
+   */
+  unsigned int getNumTasks() const;
+
+
+  /**
+   * Returns the nth task used by this SedDependencySlice.
+   *
+   * @param n an unsigned int representing the index of the task.
+   *
+   * @return the SedTask, or @c NULL if @p n is out of range.
+   */
+  const SedTask* getTask(unsigned int n) const;
+
+
+  /**
+   * Returns the number of simulations used by this SedDependencySlice.
+   *
+   * @return the number of simulations.
+   */
+  unsigned int getNumSimulations() const;
+
+
+  /**
+   * Returns the nth simulation used by this SedDependencySlice.
+   *
+   * @param n an unsigned int representing the index of the simulation.
+   *
+   * @return the SedSimulation, or @c NULL if @p n is out of range.
+   */
+  const SedSimulation* getSimulation(unsigned int n) const;
+
+
+  /**
+   * Returns the number of models used by this SedDependencySlice.
+   *
+   * @return the number of models.
+   */
+  unsigned int getNumModels() const;
+
+
+  /**
+   * Returns the nth model used by this SedDependencySlice.
+   *
+   * @param n an unsigned int representing the index of the model.
+   *
+   * @return the SedModel, or @c NULL if @p n is out of range.
+   */
+  const SedModel* getModel(unsigned int n) const;
+
+
+  /**
+   * Returns the number of data generators used by this
+   * SedDependencySlice.
+   *
+   * @return the number of data generators.
+   */
+  unsigned int getNumDataGenerators() const;
+
+
+  /**
+   * Returns the nth data generator used by this SedDependencySlice.
+   *
+   * @param n an unsigned int representing the index of the data
+   * generator.
+   *
+   * @return the SedDataGenerator, or @c NULL if @p n is out of range.
+   */
+  const SedDataGenerator* getDataGenerator(unsigned int n) const;
+
+
+  /**
+   * Returns the variables to be recorded by the given task.
+   *
+   * @param task a SedTask of the SedDocument.
+   *
+   * @return the variables of the data generators of this
+   * SedDependencySlice that refer to @p task, one for each distinct
+   * target and symbol; the list is empty if @p task records nothing.
+   */
+  const std::vector<const SedVariable*>&
+  getRecordedVariables(const SedTask* task) const;
+
+
+protected:
+
+  /** @cond doxygen-libsedml-internal */
+
+  /* not copyable */
+  SedDependencySlice(const SedDependencySlice&);
+  SedDependencySlice& operator=(const SedDependencySlice&);
+
+  void addNode(unsigned int n);
+
+  void addTask(unsigned int n, std::vector<bool>& visited);
+
+  void update();
+
+  const SedDependencyGraph& mGraph;
+
+  std::vector<bool> mSelected;
+
+  std::vector<unsigned int> mNodes;
+
+  std::vector<const SedTask*> mTasks;
+
+  std::vector<const SedSimulation*> mSimulations;
+
+  std::vector<const SedModel*> mModels;
+
+  std::vector<const SedDataGenerator*> mDataGenerators;
+
+  std::map<const SedTask*, std::vector<const SedVariable*> > mRecorded;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedDependencySlice_h */
@@ -36,8 +36,11 @@
 
 #include <sedml/SedDocument.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
+#include <fstream>
+
 
 using namespace std;
 
@@ -60,7 +63,9 @@ SedDocument::SedDocument(unsigned int level, unsigned int version)
   , mTasks(level, version)
   , mDataGenerators(level, version)
   , mOutputs(level, version)
-
+  , mElementCallback(NULL)
+  , mBinaryValueThreshold(0)
+  , mCompressBinaryValues(false)
 {
   mLevel = level;
   mIsSetLevel = true;
@@ -92,13 +97,19 @@ SedDocument::SedDocument(SedNamespaces* sedns)
   , mTasks(sedns)
   , mDataGenerators(sedns)
   , mOutputs(sedns)
-
+  , mElementCallback(NULL)
+  , mBinaryValueThreshold(0)
+  , mCompressBinaryValues(false)
 {
   mLevel = sedns->getLevel();
   mIsSetLevel = true;
   mVersion = sedns->getVersion();
   mIsSetVersion = true;
 
+  // the document keeps a copy of its namespaces, as they are modified
+  // when it is read or written
+  setSedNamespaces(sedns);
+
   setSedDocument(this);
 
   // set the element namespace of this object
@@ -114,7 +125,11 @@ SedDocument::SedDocument(SedNamespaces* sedns)
  */
 SedDocument::SedDocument(const SedDocument& orig)
   : SedBase(orig)
+  , mElementCallback(NULL)
+  , mBinaryValueThreshold(0)
+  , mCompressBinaryValues(false)
 {
+  setSedNamespaces(orig.getSedNamespaces());
   setSedDocument(this);
 
   mLevel  = orig.mLevel;
@@ -127,6 +142,8 @@ SedDocument::SedDocument(const SedDocument& orig)
   mTasks  = orig.mTasks;
   mDataGenerators  = orig.mDataGenerators;
   mOutputs  = orig.mOutputs;
+  mBinaryValueThreshold = orig.mBinaryValueThreshold;
+  mCompressBinaryValues = orig.mCompressBinaryValues;
 
   // connect to child objects
   connectToChild();
@@ -143,6 +160,7 @@ SedDocument::operator=(const SedDocument& rhs)
     {
       SedBase::operator=(rhs);
 
+      setSedNamespaces(rhs.getSedNamespaces());
       setSedDocument(this);
 
       mLevel  = rhs.mLevel;
@@ -155,6 +173,8 @@ SedDocument::operator=(const SedDocument& rhs)
       mTasks  = rhs.mTasks;
       mDataGenerators  = rhs.mDataGenerators;
       mOutputs  = rhs.mOutputs;
+      mBinaryValueThreshold = rhs.mBinaryValueThreshold;
+      mCompressBinaryValues = rhs.mCompressBinaryValues;
 
       // connect to child objects
       connectToChild();
@@ -179,6 +199,12 @@ SedDocument::clone() const
  */
 SedDocument::~SedDocument()
 {
+  // detach all children, so that they do not update the index of this
+  // document while its members are destroyed
+  mIdIndex.clear();
+  mMetaIdIndex.clear();
+  mIndexedKeys.clear();
+  setSedDocument(NULL);
 }
 
 
@@ -1261,6 +1287,58 @@ SedDocument::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedDocument::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedBase::writeSnapshot(writer);
+
+  writer.writeInt(mLevel);
+  writer.writeBool(mIsSetLevel);
+  writer.writeInt(mVersion);
+  writer.writeBool(mIsSetVersion);
+  mDataDescriptions.writeSnapshot(writer);
+  mSimulations.writeSnapshot(writer);
+  mModels.writeSnapshot(writer);
+  mTasks.writeSnapshot(writer);
+  mDataGenerators.writeSnapshot(writer);
+  mOutputs.writeSnapshot(writer);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedDocument::readSnapshot(SedSnapshotReader& reader)
+{
+  SedBase::readSnapshot(reader);
+
+  mLevel = reader.readInt();
+  mIsSetLevel = reader.readBool();
+  mVersion = reader.readInt();
+  mIsSetVersion = reader.readBool();
+  mDataDescriptions.readSnapshot(reader);
+  mSimulations.readSnapshot(reader);
+  mModels.readSnapshot(reader);
+  mTasks.readSnapshot(reader);
+  mDataGenerators.readSnapshot(reader);
+  mOutputs.readSnapshot(reader);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -1269,8 +1347,41 @@ SedDocument::writeElements(XMLOutputStream& stream) const
 bool
 SedDocument::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+
+  if (getNumDataDescriptions() > 0)
+    {
+      mDataDescriptions.accept(v);
+    }
 
+  if (getNumSimulations() > 0)
+    {
+      mSimulations.accept(v);
+    }
+
+  if (getNumModels() > 0)
+    {
+      mModels.accept(v);
+    }
+
+  if (getNumTasks() > 0)
+    {
+      mTasks.accept(v);
+    }
+
+  if (getNumDataGenerators() > 0)
+    {
+      mDataGenerators.accept(v);
+    }
+
+  if (getNumOutputs() > 0)
+    {
+      mOutputs.accept(v);
+    }
+
+  v.leave(*this);
+
+  return true;
 }
 
 
@@ -1396,6 +1507,26 @@ SedDocument::getNumErrors(unsigned int severity) const
 }
 
 
+/*
+ * Returns the counters and timers of the phases of reading this
+ * SedDocument.
+ */
+const SedLoadStatistics&
+SedDocument::getLoadStatistics() const
+{
+  return mLoadStatistics;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+SedLoadStatistics&
+SedDocument::getLoadStatistics()
+{
+  return mLoadStatistics;
+}
+/** @endcond */
+
+
 /*
  * @return the SedErrorLog used to log errors during while reading and
  * validating Sed.
@@ -1496,6 +1627,291 @@ SedDocument::getNamespaces() const
 {
   return mSedNamespaces->getNamespaces();
 }
+
+
+/** @cond doxygen-libsedml-internal */
+
+/* marks the start of a snapshot ("SEDS" when read as bytes) */
+static const unsigned int SedSnapshotMagic = 0x53444553;
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Writes this SedDocument to the given stream as a binary snapshot.
+ */
+int
+SedDocument::saveSnapshot(std::ostream& stream) const
+{
+  SedSnapshotWriter writer(stream);
+
+  writer.writeUInt(SedSnapshotMagic);
+  writer.writeUInt(SEDML_SNAPSHOT_FORMAT_VERSION);
+  writer.writeUInt(getLevel());
+  writer.writeUInt(getVersion());
+
+  const XMLNamespaces* xmlns = getNamespaces();
+  writer.writeBool(xmlns != NULL);
+
+  if (xmlns != NULL)
+    writer.writeNamespaces(*xmlns);
+
+  writeSnapshot(writer);
+
+  return writer.good() ? LIBSEDML_OPERATION_SUCCESS : LIBSEDML_OPERATION_FAILED;
+}
+
+
+/*
+ * Reads a SedDocument from a binary snapshot written by saveSnapshot().
+ */
+SedDocument*
+SedDocument::loadSnapshot(std::istream& stream)
+{
+  SedSnapshotReader reader(stream);
+
+  if (reader.readUInt() != SedSnapshotMagic ||
+      reader.readUInt() != SEDML_SNAPSHOT_FORMAT_VERSION)
+    return NULL;
+
+  unsigned int level = reader.readUInt();
+  unsigned int version = reader.readUInt();
+
+  XMLNamespaces xmlns;
+  bool hasNamespaces = reader.readBool();
+
+  if (hasNamespaces)
+    reader.readNamespaces(xmlns);
+
+  if (!reader.good())
+    return NULL;
+
+  SedDocument* document = new SedDocument(level, version);
+
+  if (hasNamespaces)
+    document->setNamespaces(&xmlns);
+
+  document->readSnapshot(reader);
+
+  if (!reader.good())
+    {
+      delete document;
+      return NULL;
+    }
+
+  // hand the document down to all elements read
+  document->connectToChild();
+
+  return document;
+}
+
+
+/*
+ * Sets the number of values above which vector ranges are written in
+ * binary.
+ */
+int
+SedDocument::setBinaryValueThreshold(unsigned int numValues)
+{
+  mBinaryValueThreshold = numValues;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+unsigned int
+SedDocument::getBinaryValueThreshold() const
+{
+  return mBinaryValueThreshold;
+}
+
+
+/*
+ * Sets whether binary values are compressed.
+ */
+int
+SedDocument::setCompressBinaryValues(bool compress)
+{
+  mCompressBinaryValues = compress;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+bool
+SedDocument::getCompressBinaryValues() const
+{
+  return mCompressBinaryValues;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Removes the entry stored under key for element from the given index.
+ */
+static void
+removeIndexEntry(std::unordered_multimap<std::string, SedBase*>& index,
+                 const std::string& key, const SedBase* element)
+{
+  if (key.empty()) return;
+
+  typedef std::unordered_multimap<std::string, SedBase*>::iterator Iter;
+  std::pair<Iter, Iter> range = index.equal_range(key);
+
+  for (Iter it = range.first; it != range.second; ++it)
+    {
+      if (it->second == element)
+        {
+          index.erase(it);
+          return;
+        }
+    }
+}
+
+
+/*
+ * @return true if element is nested (at any depth) within ancestor.
+ */
+static bool
+isContainedIn(const SedBase* element, const SedBase* ancestor)
+{
+  const SedBase* parent = element->getParentSedObject();
+
+  while (parent != NULL)
+    {
+      if (parent == ancestor) return true;
+
+      parent = parent->getParentSedObject();
+    }
+
+  return false;
+}
+
+
+/*
+ * Adds the element to the id/metaid index of this document.
+ */
+void
+SedDocument::addToIndex(SedBase* element)
+{
+  if (element == NULL) return;
+
+  const std::string& id = element->getId();
+  const std::string& metaid = element->getMetaId();
+
+  SedIndexedKeys::iterator keys = mIndexedKeys.find(element);
+
+  if (keys != mIndexedKeys.end())
+    {
+      if (keys->second.first == id && keys->second.second == metaid)
+        return;
+
+      removeIndexEntry(mIdIndex, keys->second.first, element);
+      removeIndexEntry(mMetaIdIndex, keys->second.second, element);
+
+      if (id.empty() && metaid.empty())
+        {
+          mIndexedKeys.erase(keys);
+          return;
+        }
+
+      keys->second = std::make_pair(id, metaid);
+    }
+  else if (id.empty() && metaid.empty())
+    {
+      return;
+    }
+  else
+    {
+      mIndexedKeys[element] = std::make_pair(id, metaid);
+    }
+
+  if (!id.empty()) mIdIndex.insert(std::make_pair(id, element));
+
+  if (!metaid.empty()) mMetaIdIndex.insert(std::make_pair(metaid, element));
+}
+
+
+/*
+ * Removes the element from the id/metaid index of this document.
+ */
+void
+SedDocument::removeFromIndex(SedBase* element)
+{
+  SedIndexedKeys::iterator keys = mIndexedKeys.find(element);
+
+  if (keys == mIndexedKeys.end()) return;
+
+  removeIndexEntry(mIdIndex, keys->second.first, element);
+  removeIndexEntry(mMetaIdIndex, keys->second.second, element);
+  mIndexedKeys.erase(keys);
+}
+
+
+/*
+ * Returns the element with the given id contained in ancestor.
+ */
+SedBase*
+SedDocument::getIndexedElementBySId(const std::string& id,
+                                    const SedBase* ancestor) const
+{
+  typedef SedElementIndex::const_iterator Iter;
+  std::pair<Iter, Iter> range = mIdIndex.equal_range(id);
+
+  for (Iter it = range.first; it != range.second; ++it)
+    {
+      if (it->second->getId() != id) continue;
+
+      if (ancestor == this || isContainedIn(it->second, ancestor))
+        return it->second;
+    }
+
+  return NULL;
+}
+
+
+/*
+ * Returns the element with the given metaid contained in ancestor.
+ */
+SedBase*
+SedDocument::getIndexedElementByMetaId(const std::string& metaid,
+                                       const SedBase* ancestor) const
+{
+  typedef SedElementIndex::const_iterator Iter;
+  std::pair<Iter, Iter> range = mMetaIdIndex.equal_range(metaid);
+
+  for (Iter it = range.first; it != range.second; ++it)
+    {
+      if (it->second->getMetaId() != metaid) continue;
+
+      if (ancestor == this || isContainedIn(it->second, ancestor))
+        return it->second;
+    }
+
+  return NULL;
+}
+
+
+/*
+ * Sets the callback receiving top-level elements while reading.
+ */
+void
+SedDocument::setElementCallback(SedElementCallback* callback)
+{
+  mElementCallback = callback;
+}
+
+
+/*
+ * Returns the callback receiving top-level elements while reading.
+ */
+SedElementCallback*
+SedDocument::getElementCallback() const
+{
+  return mElementCallback;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
 /**
  * write comments
  */
@@ -1537,6 +1953,73 @@ SedDocument_clone(SedDocument_t * sd)
 }
 
 
+/**
+ * Writes the given SedDocument to a file as a binary snapshot.
+ */
+LIBSEDML_EXTERN
+int
+SedDocument_saveSnapshotToFile(const SedDocument_t * sd, const char * filename)
+{
+  if (sd == NULL || filename == NULL)
+    return LIBSEDML_INVALID_OBJECT;
+
+  std::ofstream stream(filename, std::ios::out | std::ios::binary);
+
+  if (!stream)
+    return LIBSEDML_OPERATION_FAILED;
+
+  return sd->saveSnapshot(stream);
+}
+
+
+/**
+ * Reads a SedDocument from a file holding a binary snapshot.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedDocument_loadSnapshotFromFile(const char * filename)
+{
+  if (filename == NULL)
+    return NULL;
+
+  std::ifstream stream(filename, std::ios::in | std::ios::binary);
+
+  if (!stream)
+    return NULL;
+
+  return SedDocument::loadSnapshot(stream);
+}
+
+
+/**
+ * Sets the number of values above which vector ranges are written in the
+ * compact binary encoding (@c 0 to never use it).
+ */
+LIBSEDML_EXTERN
+int
+SedDocument_setBinaryValueThreshold(SedDocument_t * sd,
+                                    unsigned int numValues)
+{
+  if (sd == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return sd->setBinaryValueThreshold(numValues);
+}
+
+
+/**
+ * Sets whether binary encoded values are compressed (@p compress
+ * non-zero) or not.
+ */
+LIBSEDML_EXTERN
+int
+SedDocument_setCompressBinaryValues(SedDocument_t * sd, int compress)
+{
+  if (sd == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return sd->setCompressBinaryValues(compress != 0);
+}
+
+
 /**
  * write comments
  */
@@ -45,12 +45,16 @@
 #ifdef __cplusplus
 
 
+#include <iosfwd>
 #include <string>
+#include <unordered_map>
+#include <utility>
 
 
 #include <sedml/SedBase.h>
 #include <sedml/SedListOf.h>
 #include <sedml/SedNamespaces.h>
+#include <sedml/SedLoadStatistics.h>
 #include <sedml/SedDataDescription.h>
 #include <sedml/SedSimulation.h>
 #include <sedml/SedModel.h>
@@ -63,6 +67,8 @@
 
 LIBSEDML_CPP_NAMESPACE_BEGIN
 
+class SedElementCallback;
+
 
 class LIBSEDML_EXTERN SedDocument : public SedBase
 {
@@ -1149,6 +1155,28 @@ public:
   /** @endcond doxygen-libsedml-internal */
 
 
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Writes the attributes and children of this object to a snapshot.
+   */
+  virtual void writeSnapshot(SedSnapshotWriter& writer) const;
+
+
+  /** @endcond doxygen-libsedml-internal */
+
+
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Reads the attributes and children of this object from a snapshot.
+   */
+  virtual void readSnapshot(SedSnapshotReader& reader);
+
+
+  /** @endcond doxygen-libsedml-internal */
+
+
   /** @cond doxygen-libsedml-internal */
 
   /**
@@ -1295,6 +1323,27 @@ public:
    */
   unsigned int getNumErrors(unsigned int severity) const;
 
+
+  /**
+   * Returns the counters and timers of the phases of reading this
+   * SedDocument.
+   *
+   * @return the SedLoadStatistics recorded by the SedReader that read
+   * this SedDocument; all zero if it was not read, or libSEDML was built
+   * without the CMake option @c WITH_INSTRUMENTATION.
+   *
+   * @see SedLoadStatistics::isEnabled()
+   */
+  const SedLoadStatistics& getLoadStatistics() const;
+
+
+  /** @cond doxygen-libsedml-internal */
+
+  SedLoadStatistics& getLoadStatistics();
+
+  /** @endcond doxygen-libsedml-internal */
+
+
   /**
    * Returns a list of XML Namespaces associated with the XML content
    * of this SED-ML document.
@@ -1303,6 +1352,157 @@ public:
    */
   virtual XMLNamespaces* getNamespaces() const;
 
+
+  /**
+   * Writes this SedDocument to the given stream as a binary snapshot.
+   *
+   * A snapshot holds the complete content of the document, including
+   * math, notes and annotations, in a versioned binary format that
+   * loadSnapshot() reads back without parsing any XML.  Snapshots are
+   * meant for caching documents between runs of the same version of
+   * libSEDML, not for exchanging them: use SedWriter for that.
+   *
+   * @param stream the stream to write to, opened in binary mode.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  @if clike The value is drawn from the
+   * enumeration #OperationReturnValues_t. @endif The possible values
+   * returned by this function are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_OPERATION_FAILED
+   *
+   * @see loadSnapshot()
+   */
+  int saveSnapshot(std::ostream& stream) const;
+
+
+  /**
+   * Reads a SedDocument from a binary snapshot written by saveSnapshot().
+   *
+   * @param stream the stream to read from, opened in binary mode.
+   *
+   * @return the SedDocument read, owned by the caller, or @c NULL if the
+   * stream does not hold a snapshot of the format version of this
+   * libSEDML, or the snapshot is truncated or damaged.
+   *
+   * @see saveSnapshot()
+   */
+  static SedDocument* loadSnapshot(std::istream& stream);
+
+
+  /**
+   * Sets the number of values above which the SedVectorRange objects of
+   * this SedDocument are written in a compact binary encoding.
+   *
+   * Instead of one @c &lt;value&gt; element per value, such ranges are
+   * written as a single @c &lt;binaryValues&gt; element holding the
+   * base64 encoded little-endian doubles (see
+   * setCompressBinaryValues()).  The element is in the namespace
+   * <code>http://sed-ml.org/libsedml/binaryValues</code>; this is a
+   * libSEDML extension that other SED-ML software will not understand,
+   * so it is off by default.
+   *
+   * @param numValues the threshold; @c 0 (the default) always writes
+   * @c &lt;value&gt; elements.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   */
+  int setBinaryValueThreshold(unsigned int numValues);
+
+
+  /**
+   * Returns the number of values above which the SedVectorRange objects
+   * of this SedDocument are written in a compact binary encoding.
+   *
+   * @return the threshold, @c 0 if the binary encoding is not used.
+   *
+   * @see setBinaryValueThreshold(unsigned int numValues)
+   */
+  unsigned int getBinaryValueThreshold() const;
+
+
+  /**
+   * Sets whether binary encoded values are compressed (with zlib) before
+   * being base64 encoded.
+   *
+   * Compression is only available if libSEDML is linked with zlib; it is
+   * silently skipped otherwise.
+   *
+   * @param compress @c true to compress binary values, @c false (the
+   * default) otherwise.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values returned by this function are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   *
+   * @see setBinaryValueThreshold(unsigned int numValues)
+   */
+  int setCompressBinaryValues(bool compress);
+
+
+  /**
+   * Returns whether binary encoded values are compressed.
+   *
+   * @return @c true if binary values are compressed, @c false otherwise.
+   */
+  bool getCompressBinaryValues() const;
+
+
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Adds the given element to the id/metaid index of this SedDocument,
+   * replacing any entry the element had under previous identifiers.
+   *
+   * @param element the element (contained in this document) to index
+   */
+  void addToIndex(SedBase* element);
+
+
+  /**
+   * Removes the given element from the id/metaid index of this
+   * SedDocument.
+   *
+   * @param element the element to remove
+   */
+  void removeFromIndex(SedBase* element);
+
+
+  /**
+   * Returns the element with the given id that is contained in
+   * @p ancestor, or @c NULL if there is no such element.
+   */
+  SedBase* getIndexedElementBySId(const std::string& id,
+                                  const SedBase* ancestor) const;
+
+
+  /**
+   * Returns the element with the given metaid that is contained in
+   * @p ancestor, or @c NULL if there is no such element.
+   */
+  SedBase* getIndexedElementByMetaId(const std::string& metaid,
+                                     const SedBase* ancestor) const;
+
+
+  /**
+   * Sets the callback that receives each top-level element (model,
+   * task, output, ...) as soon as it has been read.  Used by
+   * SedStreamReader; set to @c NULL once reading is done.
+   */
+  void setElementCallback(SedElementCallback* callback);
+
+
+  /**
+   * Returns the callback set with setElementCallback(), or @c NULL.
+   */
+  SedElementCallback* getElementCallback() const;
+
+
+  /** @endcond doxygen-libsedml-internal */
+
+
 protected:
   /**
    *
@@ -1316,6 +1516,31 @@ private:
 
   SedErrorLog mErrorLog;
 
+  /** @cond doxygen-libsedml-internal */
+
+  typedef std::unordered_multimap<std::string, SedBase*> SedElementIndex;
+  typedef std::unordered_map<const SedBase*,
+          std::pair<std::string, std::string> > SedIndexedKeys;
+
+  /* elements of this document by id and by metaid */
+  SedElementIndex mIdIndex;
+  SedElementIndex mMetaIdIndex;
+
+  /* the id and metaid each element is currently indexed under */
+  SedIndexedKeys mIndexedKeys;
+
+  /* receives top-level elements while the document is being read */
+  SedElementCallback* mElementCallback;
+
+  /* the phases of reading this document */
+  SedLoadStatistics mLoadStatistics;
+
+  /* how the vector ranges of this document are written */
+  unsigned int mBinaryValueThreshold;
+  bool mCompressBinaryValues;
+
+  /** @endcond doxygen-libsedml-internal */
+
 };
 
 
@@ -1344,6 +1569,27 @@ SedDocument_t *
 SedDocument_clone(SedDocument_t * sd);
 
 
+LIBSEDML_EXTERN
+int
+SedDocument_saveSnapshotToFile(const SedDocument_t * sd, const char * filename);
+
+
+LIBSEDML_EXTERN
+SedDocument_t *
+SedDocument_loadSnapshotFromFile(const char * filename);
+
+
+LIBSEDML_EXTERN
+int
+SedDocument_setBinaryValueThreshold(SedDocument_t * sd,
+                                    unsigned int numValues);
+
+
+LIBSEDML_EXTERN
+int
+SedDocument_setCompressBinaryValues(SedDocument_t * sd, int compress);
+
+
 LIBSEDML_EXTERN
 int
 SedDocument_getLevel(SedDocument_t * sd);
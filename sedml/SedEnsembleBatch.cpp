@@ -0,0 +1,299 @@
+/**
+ * @file    SedEnsembleBatch.cpp
+ * @brief   Iterations of a repeated task packed into one backend request
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedEnsembleBatch.h>
+#include <sedml/SedModelPatch.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedRepeatedTask.h>
+#include <sedml/SedSubTask.h>
+#include <sedml/SedSetValue.h>
+#include <sedml/SedFunctionalRange.h>
+#include <sedml/SedUniformTimeCourse.h>
+
+#include <limits>
+
+using namespace std;
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Returns the task of the only subtask of the given repeated task.
+ */
+static const SedTask*
+getEnsembleTask(const SedRepeatedTask* task)
+{
+  const SedDocument* doc = task != NULL ? task->getSedDocument() : NULL;
+
+  if (doc == NULL || task->getNumSubTasks() != 1)
+    return NULL;
+
+  const SedTask* sub = doc->getTask(task->getSubTask(0)->getTask());
+
+  if (sub == NULL || sub->getTypeCode() != SEDML_TASK)
+    return NULL;
+
+  return sub;
+}
+
+
+/*
+ * Returns the time course run by the given task.
+ */
+static const SedUniformTimeCourse*
+getEnsembleSimulation(const SedTask* task)
+{
+  const SedDocument* doc = task != NULL ? task->getSedDocument() : NULL;
+  const SedSimulation* sim = doc != NULL
+    ? doc->getSimulation(task->getSimulationReference()) : NULL;
+
+  if (sim == NULL || sim->getTypeCode() != SEDML_SIMULATION_UNIFORMTIMECOURSE)
+    return NULL;
+
+  return static_cast<const SedUniformTimeCourse*>(sim);
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Creates a new, empty SedEnsembleBatch.
+ */
+SedEnsembleBatch::SedEnsembleBatch(const SedModelPatch& patch,
+                                   unsigned int capacity)
+  : mPatch(patch)
+  , mTask(getEnsembleTask(patch.getRepeatedTask()))
+  , mSimulation(getEnsembleSimulation(mTask))
+  , mCapacity(capacity)
+  , mIterations()
+  , mValues(patch.getNumSlots())
+{
+  mIterations.reserve(capacity);
+
+  for (size_t i = 0; i < mValues.size(); ++i)
+    mValues[i].reserve(capacity);
+}
+
+
+/*
+ * Destroys this SedEnsembleBatch.
+ */
+SedEnsembleBatch::~SedEnsembleBatch()
+{
+}
+
+
+/*
+ * Predicate returning @c true if the iterations of the given repeated
+ * task can be run as an ensemble.
+ */
+bool
+SedEnsembleBatch::isBatchable(const SedRepeatedTask* task)
+{
+  // without a reset, each iteration starts from the state the previous
+  // one left the model in
+  if (task == NULL || !task->getResetModel())
+    return false;
+
+  const SedTask* sub = getEnsembleTask(task);
+
+  if (sub == NULL || getEnsembleSimulation(sub) == NULL)
+    return false;
+
+  for (unsigned int i = 0; i < task->getNumTaskChanges(); ++i)
+    if (task->getTaskChange(i)->getModelReference()
+        != sub->getModelReference())
+      return false;
+
+  // functional ranges reading the model depend on the simulations
+  for (unsigned int i = 0; i < task->getNumRanges(); ++i)
+    {
+      const SedRange* range = task->getRange(i);
+
+      if (range->getTypeCode() == SEDML_RANGE_FUNCTIONALRANGE &&
+          static_cast<const SedFunctionalRange*>(range)->getNumVariables() > 0)
+        return false;
+    }
+
+  return true;
+}
+
+
+/*
+ * Returns the SedModelPatch of this SedEnsembleBatch.
+ */
+const SedModelPatch&
+SedEnsembleBatch::getPatch() const
+{
+  return mPatch;
+}
+
+
+/*
+ * Returns the repeated task of this SedEnsembleBatch.
+ */
+const SedRepeatedTask*
+SedEnsembleBatch::getRepeatedTask() const
+{
+  return mPatch.getRepeatedTask();
+}
+
+
+/*
+ * Returns the task run for each iteration.
+ */
+const SedTask*
+SedEnsembleBatch::getTask() const
+{
+  return mTask;
+}
+
+
+/*
+ * Returns the time course run for each iteration.
+ */
+const SedUniformTimeCourse*
+SedEnsembleBatch::getSimulation() const
+{
+  return mSimulation;
+}
+
+
+/*
+ * Returns the number of iterations this SedEnsembleBatch holds at most.
+ */
+unsigned int
+SedEnsembleBatch::getCapacity() const
+{
+  return mCapacity;
+}
+
+
+/*
+ * Returns the number of iterations in this SedEnsembleBatch.
+ */
+unsigned int
+SedEnsembleBatch::getNumIterations() const
+{
+  return (unsigned int)mIterations.size();
+}
+
+
+/*
+ * Returns the iteration of the repeated task at the given position.
+ */
+unsigned int
+SedEnsembleBatch::getIteration(unsigned int n) const
+{
+  return n < mIterations.size() ? mIterations[n] : 0;
+}
+
+
+/*
+ * Returns the number of parameters of each iteration.
+ */
+unsigned int
+SedEnsembleBatch::getNumParameters() const
+{
+  return (unsigned int)mValues.size();
+}
+
+
+/*
+ * Returns the values of a parameter for all the iterations.
+ */
+const double*
+SedEnsembleBatch::getValues(unsigned int slot) const
+{
+  if (slot >= mValues.size() || mValues[slot].empty())
+    return NULL;
+
+  return &mValues[slot][0];
+}
+
+
+/*
+ * Returns the value of a parameter for one iteration.
+ */
+double
+SedEnsembleBatch::getValue(unsigned int n, unsigned int slot) const
+{
+  if (slot >= mValues.size() || n >= mValues[slot].size())
+    return numeric_limits<double>::quiet_NaN();
+
+  return mValues[slot][n];
+}
+
+
+/*
+ * Adds an iteration with the current values of the slots.
+ */
+int
+SedEnsembleBatch::addIteration(unsigned int iteration)
+{
+  if (mIterations.size() >= mCapacity)
+    return LIBSEDML_INDEX_EXCEEDS_SIZE;
+
+  mIterations.push_back(iteration);
+
+  for (unsigned int i = 0; i < mValues.size(); ++i)
+    mValues[i].push_back(mPatch.getValue(i));
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Removes all the iterations of this SedEnsembleBatch.
+ */
+void
+SedEnsembleBatch::clear()
+{
+  mIterations.clear();
+
+  for (size_t i = 0; i < mValues.size(); ++i)
+    mValues[i].clear();
+}
+
+
+#endif  /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,266 @@
+/**
+ * @file    SedEnsembleBatch.h
+ * @brief   Iterations of a repeated task packed into one backend request
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedEnsembleBatch
+ * @ingroup Core
+ * @brief Iterations of a SedRepeatedTask packed into one request to a
+ * SedSimulatorBackend.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * Many repeated tasks run the same time course again and again, only
+ * changing parameter values through their SedSetValue elements.  Their
+ * iterations do not depend on each other, and a simulator can integrate
+ * several of them at once, as an ensemble.  isBatchable() tells whether
+ * a repeated task is of that kind: it must reset its model before each
+ * iteration, run a single SedTask with a SedUniformTimeCourse, change
+ * only the model of that task, and have no SedFunctionalRange reading
+ * values from a model.
+ *
+ * A SedEnsembleBatch holds the values of the slots of a SedModelPatch,
+ * the parameters, for a number of consecutive iterations.  They are
+ * stored as a structure of arrays: getValues() returns the values of
+ * one parameter for all the iterations of the batch, and getIteration()
+ * maps each of them back to its iteration of the repeated task, so that
+ * the results of the ensemble can be recorded per iteration.
+ *
+ * SedExecutor builds batches of the size given by
+ * SedSimulatorBackend::getEnsembleSize(), and passes them to
+ * SedSimulatorBackend::executeEnsemble().
+ */
+
+#ifndef SedEnsembleBatch_h
+#define SedEnsembleBatch_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedRepeatedTask;
+class SedTask;
+class SedUniformTimeCourse;
+class SedModelPatch;
+
+
+class LIBSEDML_EXTERN SedEnsembleBatch
+{
+public:
+
+  /**
+   * Creates a new, empty SedEnsembleBatch.
+   *
+   * @param patch the compiled SedModelPatch of the repeated task, whose
+   * slots are the parameters of the batch; it must outlive the batch.
+   * @param capacity the number of iterations the batch holds at most.
+   */
+  SedEnsembleBatch(const SedModelPatch& patch, unsigned int capacity);
+
+
+  /**
+   * Destroys this SedEnsembleBatch.
+   */
+  virtual ~SedEnsembleBatch();
+
+
+  /**
+   * Predicate returning @c true if the iterations of the given repeated
+   * task can be run as an ensemble.
+   *
+   * @param task the SedRepeatedTask.
+   *
+   * @return @c true if @p task resets its model, has a single subtask
+   * running a SedTask with a SedUniformTimeCourse, only sets values of
+   * the model of that task, and its ranges do not read values from a
+   * model; @c false otherwise.
+   */
+  static bool isBatchable(const SedRepeatedTask* task);
+
+
+  /**
+   * Returns the SedModelPatch of this SedEnsembleBatch.
+   *
+   * @return the SedModelPatch whose slots are the parameters.
+   */
+  const SedModelPatch& getPatch() const;
+
+
+  /**
+   * Returns the repeated task of this SedEnsembleBatch.
+   *
+   * @return the SedRepeatedTask of the SedModelPatch.
+   */
+  const SedRepeatedTask* getRepeatedTask() const;
+
+
+  /**
+   * Returns the task run for each iteration.
+   *
+   * @return the SedTask of the only subtask of the repeated task, or
+   * @c NULL if it cannot be found.
+   */
+  const SedTask* getTask() const;
+
+
+  /**
+   * Returns the time course run for each iteration.
+   *
+   * @return the SedUniformTimeCourse of the task, or @c NULL if the task
+   * has none.
+   */
+  const SedUniformTimeCourse* getSimulation() const;
+
+
+  /**
+   * Returns the number of iterations this SedEnsembleBatch holds at
+   * most.
+   *
+   * @return the capacity of the batch.
+   */
+  unsigned int getCapacity() const;
+
+
+  /**
+   * Returns the number of iterations in this SedEnsembleBatch.
+   *
+   * @return the number of iterations added since the batch was created
+   * or last cleared.
+   */
+  unsigned int getNumIterations() const;
+
+
+  /**
+   * Returns the iteration of the repeated task at the given position of
+   * this SedEnsembleBatch.
+   *
+   * @param n an unsigned int representing the position in the batch.
+   *
+   * @return the index of the iteration in the repeated task, or @c 0 if
+   * @p n is out of range.
+   */
+  unsigned int getIteration(unsigned int n) const;
+
+
+  /**
+   * Returns the number of parameters of each iteration.
+   *
+   * @return the number of slots of the SedModelPatch.
+   */
+  unsigned int getNumParameters() const;
+
+
+  /**
+   * Returns the values of a parameter for all the iterations of this
+   * SedEnsembleBatch.
+   *
+   * @param slot the index of the slot of the SedModelPatch.
+   *
+   * @return an array of getNumIterations() values, or @c NULL if @p slot
+   * is out of range or the batch is empty.
+   */
+  const double* getValues(unsigned int slot) const;
+
+
+  /**
+   * Returns the value of a parameter for one iteration of this
+   * SedEnsembleBatch.
+   *
+   * @param n an unsigned int representing the position in the batch.
+   * @param slot the index of the slot of the SedModelPatch.
+   *
+   * @return the value, or NaN if @p n or @p slot is out of range.
+   */
+  double getValue(unsigned int n, unsigned int slot) const;
+
+
+  /**
+   * Adds an iteration to this SedEnsembleBatch, with the current values
+   * of the slots of the SedModelPatch.
+   *
+   * @param iteration the index of the iteration in the repeated task,
+   * for which the SedModelPatch was last updated.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INDEX_EXCEEDS_SIZE, if the batch is full
+   */
+  int addIteration(unsigned int iteration);
+
+
+  /**
+   * Removes all the iterations of this SedEnsembleBatch.
+   */
+  void clear();
+
+
+protected:
+
+  /** @cond doxygen-libsedml-internal */
+
+  /* not copyable */
+  SedEnsembleBatch(const SedEnsembleBatch&);
+  SedEnsembleBatch& operator=(const SedEnsembleBatch&);
+
+  const SedModelPatch& mPatch;
+
+  const SedTask* mTask;
+
+  const SedUniformTimeCourse* mSimulation;
+
+  unsigned int mCapacity;
+
+  std::vector<unsigned int> mIterations;
+
+  std::vector<std::vector<double> > mValues;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedEnsembleBatch_h */
@@ -35,10 +35,10 @@
  * ---------------------------------------------------------------------- -->
  */
 
+#include <algorithm>
 #include <string>
 #include <iostream>
 #include <iomanip>
-#include <sstream>
 
 #include <sbml/xml/XMLError.h>
 #include <sedml/SedError.h>
@@ -74,6 +74,31 @@ getSeverityForEntry(unsigned int index,
 }
 
 
+/*
+ * Orders entries of the errorTable by code, for findErrorTableEntry().
+ */
+static bool
+isEntryBeforeCode(const sbmlErrorTableEntry& entry, unsigned int code)
+{
+  return entry.code < code;
+}
+
+
+/*
+ * Helper function for SedError().  Returns the errorTable entry for the
+ * given code, or NULL if there is none.
+ */
+static const sbmlErrorTableEntry*
+findErrorTableEntry(unsigned int code)
+{
+  const sbmlErrorTableEntry* end = errorTable + errorTableSize;
+  const sbmlErrorTableEntry* entry =
+    lower_bound(errorTable, end, code, isEntryBeforeCode);
+
+  return (entry != end && entry->code == code) ? entry : NULL;
+}
+
+
 /*
  * @return the severity as a string for the given @n code.
  */
@@ -118,7 +143,7 @@ std::string SedError::stringForSeverity(unsigned int code) const
  * A similar table for severity strings is currently unnecessary because
  * libSed never returns anything more than the XMLSeverityCode_t values.
  */
-static struct sbmlCategoryString
+static const struct sbmlCategoryString
 {
   unsigned int catCode;
   const char * catString;
@@ -131,7 +156,7 @@ static struct sbmlCategoryString
   { LIBSEDML_CAT_INTERNAL_CONSISTENCY,   "Internal consistency"        }
 };
 
-static unsigned int sbmlCategoryStringTableSize
+static const unsigned int sbmlCategoryStringTableSize
   = sizeof(sbmlCategoryStringTable) / sizeof(sbmlCategoryStringTable[0]);
 
 /*
@@ -177,19 +202,9 @@ SedError::SedError(const unsigned int errorId
   else if (mErrorId > XMLErrorCodesUpperBound
            && mErrorId < SedCodesUpperBound)
     {
-      unsigned int tableSize = sizeof(errorTable) / sizeof(errorTable[0]);
-      unsigned int index = 0;
+      const sbmlErrorTableEntry* entry = findErrorTableEntry(mErrorId);
 
-      for (unsigned int i = 0; i < tableSize; i++)
-        {
-          if (mErrorId == errorTable[i].code)
-            {
-              index = i;
-              break;
-            }
-        }
-
-      if (index == 0 && mErrorId != SedUnknownError)
+      if (entry == NULL)
         {
           // The id is in the range of error numbers that are supposed to be in
           // the Sed layer, but it's NOT in our table. This is an internal error.
@@ -203,15 +218,17 @@ SedError::SedError(const unsigned int errorId
 
           // Now we log the error as an UnKnown Error and mark it as invalid
 
+          entry = &errorTable[0];
           mValidError = false;
         }
 
       // The rest of this block massages the results to account for how some
-      // internal bookkeeping is done in libSed 3, and also to provide
-      // additional info in the messages.
+      // internal bookkeeping is done in libSed 3.
 
-      mCategory     = errorTable[index].category;
-      mShortMessage = errorTable[index].shortMessage;
+      unsigned int index = (unsigned int)(entry - errorTable);
+      mCategory     = entry->category;
+      mShortMessage = entry->shortMessage;
+      string message;
 
       if (mErrorId == SedInconsistentArgUnitsWarnings
           || mErrorId == SedInconsistentPowerUnitsWarnings
@@ -220,7 +237,6 @@ SedError::SedError(const unsigned int errorId
           mErrorId = SedInconsistentArgUnits;
         }
 
-      ostringstream newMsg;
       mSeverity = getSeverityForEntry(index, level, version);
 
       if (mValidError == false)
@@ -239,9 +255,11 @@ SedError::SedError(const unsigned int errorId
           // here, we translate the errors into the same basic error code and
           // add some elaboration to the error text message.
 
+          message += findErrorTableEntry(SedNotSchemaConformant)->message;
+          message += " ";
+
           mErrorId  = SedNotSchemaConformant;
           mSeverity = LIBSEDML_SEV_ERROR;
-          newMsg << errorTable[3].message << " "; // FIXME
         }
       else if (mSeverity == LIBSEDML_SEV_GENERAL_WARNING)
         {
@@ -251,27 +269,28 @@ SedError::SedError(const unsigned int errorId
           // we use the GeneralWarning code for those cases in SedErrorTable.h
           // and then here we translate them into regular warnings.
 
+          message += "[Although Sed Level " + to_string(level)
+                     + " Version " + to_string(version)
+                     + " does not explicitly define the following as an"
+                     + " error, other Levels and/or Versions of Sed do.] \n";
+
           mSeverity = LIBSEDML_SEV_WARNING;
-          newMsg << "[Although Sed Level " << level
-                 << " Version " << version << " does not explicitly define the "
-                 << "following as an error, other Levels and/or Versions "
-                 << "of Sed do.] " << endl;
         }
 
-      // Finish updating the (full) error message.
-
-      newMsg << errorTable[index].message;
+      // Finish updating the (full) error message.  It is put together with
+      // std::string rather than an ostringstream, as errors are created
+      // for every problem found while reading.
 
-      // look for individual references
-      // if the code for this error does not yet exist skip
+      message += entry->message;
 
       if (!details.empty())
         {
-          newMsg << " " << details;
+          message += " ";
+          message += details;
         }
 
-      newMsg << endl;
-      mMessage  = newMsg.str();
+      message += "\n";
+      mMessage.swap(message);
 
       // We mucked around with the severity code and (maybe) category code
       // after creating the XMLError object, so we may have to update the
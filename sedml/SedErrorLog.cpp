@@ -63,6 +63,8 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
  * Creates a new empty SedErrorLog.
  */
 SedErrorLog::SedErrorLog()
+  : mMaxErrors(0)
+  , mNumDroppedErrors(0)
 {
 }
 
@@ -147,7 +149,8 @@ SedErrorLog::logPackageError(const std::string& package
 void
 SedErrorLog::add(const SedError& error)
 {
-  if (error.getSeverity() != LIBSEDML_SEV_NOT_APPLICABLE)
+  if (error.getSeverity() != LIBSEDML_SEV_NOT_APPLICABLE
+      && acceptError(error))
     XMLErrorLog::add(error);
 }
 
@@ -165,7 +168,8 @@ SedErrorLog::add(const std::list<SedError>& errors)
   list<SedError>::const_iterator iter;
 
   for (iter = errors.begin(); iter != end; ++iter)
-    XMLErrorLog::add(*iter);
+    if (acceptError(*iter))
+      XMLErrorLog::add(*iter);
 }
 
 /*
@@ -181,7 +185,8 @@ SedErrorLog::add(const std::vector<SedError>& errors)
   vector<SedError>::const_iterator iter;
 
   for (iter = errors.begin(); iter != end; ++iter)
-    XMLErrorLog::add(*iter);
+    if (acceptError(*iter))
+      XMLErrorLog::add(*iter);
 }
 
 /*
@@ -225,12 +230,25 @@ SedErrorLog::remove(const unsigned int errorId)
   //
   vector<XMLError*>::iterator delIter;
 
+  // the counts tell whether there is anything to find at all
+  updateCounts();
+
+  map<unsigned int, unsigned int>::iterator count = mIdCounts.find(errorId);
+
+  if (count == mIdCounts.end())
+    return;
+
   // finds an item with the given errorId (the first item will be found if
   // there are two or more items with the same Id)
   delIter = find_if(mErrors.begin(), mErrors.end(), MatchErrorId(errorId));
 
   if (delIter != mErrors.end())
     {
+      // the counted keys line up with mErrors after updateCounts()
+      size_t index = delIter - mErrors.begin();
+      uncount(mCounted[index]);
+      mCounted.erase(mCounted.begin() + index);
+
       // deletes (invoke delete operator for the matched item) and erases (removes
       // the pointer from mErrors) the matched item (if any)
       delete *delIter;
@@ -242,41 +260,98 @@ SedErrorLog::remove(const unsigned int errorId)
 bool
 SedErrorLog::contains(const unsigned int errorId)
 {
-  vector<XMLError*>::iterator iter;
+  return getNumErrorsWithId(errorId) > 0;
+}
 
-  // finds an item with the given errorId (the first item will be found if
-  // there are two or more items with the same Id)
-  iter = find_if(mErrors.begin(), mErrors.end(), MatchErrorId(errorId));
 
-  if (iter != mErrors.end())
-    {
-      return true;
-    }
-  else
+/*
+ * Removes all errors that are not to be kept, in a single pass.
+ */
+unsigned int
+SedErrorLog::removeAllExcept(bool (*keep)(const unsigned int errorId))
+{
+  size_t last = 0;
+
+  // the counted keys line up with mErrors after updateCounts(), and are
+  // compacted along with it
+  updateCounts();
+
+  // see remove() for why remove_if cannot be used here
+  for (size_t i = 0; i < mErrors.size(); ++i)
     {
-      return false;
+      if (keep(mErrors[i]->getErrorId()))
+        {
+          mErrors[last] = mErrors[i];
+          mCounted[last] = mCounted[i];
+          ++last;
+        }
+      else
+        {
+          uncount(mCounted[i]);
+          delete mErrors[i];
+        }
     }
+
+  unsigned int removed = (unsigned int)(mErrors.size() - last);
+  mErrors.resize(last);
+  mCounted.resize(last);
+
+  return removed;
 }
 
 
 /*
- * Helper class used by
- * SedErrorLog::getNumFailsWithSeverity(SedErrorSeverity_t).
+ * Brings the counts in line with the errors in the log.
  */
-class MatchSeverity
+void
+SedErrorLog::updateCounts() const
 {
-public:
-  MatchSeverity(const unsigned int s) : severity(s) {};
+  size_t n = 0;
 
-  bool operator()(XMLError* e) const
-  {
-    return e->getSeverity() == severity;
-  };
+  // the counts only depend on the severity and id of each error, so
+  // comparing these also catches errors that were cleared, removed or
+  // changed through XMLErrorLog since the counts were last updated
+  while (n < mCounted.size() && n < mErrors.size()
+         && mCounted[n].first == mErrors[n]->getSeverity()
+         && mCounted[n].second == mErrors[n]->getErrorId())
+    ++n;
 
-private:
-  unsigned int severity;
-};
+  for (size_t i = n; i < mCounted.size(); ++i)
+    uncount(mCounted[i]);
 
+  mCounted.resize(n);
+
+  for (; n < mErrors.size(); ++n)
+    {
+      mCounted.push_back(make_pair(mErrors[n]->getSeverity(),
+                                   mErrors[n]->getErrorId()));
+      ++mSeverityCounts[mCounted.back().first];
+      ++mIdCounts[mCounted.back().second];
+    }
+}
+
+
+void
+SedErrorLog::uncount(const pair<unsigned int, unsigned int>& key) const
+{
+  if (--mSeverityCounts[key.first] == 0)
+    mSeverityCounts.erase(key.first);
+
+  if (--mIdCounts[key.second] == 0)
+    mIdCounts.erase(key.second);
+}
+
+
+bool
+SedErrorLog::acceptError(const XMLError& error)
+{
+  if (mMaxErrors == 0 || mErrors.size() < mMaxErrors
+      || error.getSeverity() == LIBSEDML_SEV_FATAL)
+    return true;
+
+  ++mNumDroppedErrors;
+  return false;
+}
 
 
 /** @endcond */
@@ -284,16 +359,12 @@ private:
 unsigned int
 SedErrorLog::getNumFailsWithSeverity(unsigned int severity) const
 {
-  int n = 0;
+  updateCounts();
 
-#if defined(__SUNPRO_CC)
-  // Workaround for Sun cc which is missing:
-  count_if(mErrors.begin(), mErrors.end(), MatchSeverity(severity), n);
-#else
-  n = (int)count_if(mErrors.begin(), mErrors.end(), MatchSeverity(severity));
-#endif
+  map<unsigned int, unsigned int>::const_iterator count =
+    mSeverityCounts.find(severity);
 
-  return n;
+  return count != mSeverityCounts.end() ? count->second : 0;
 }
 
 /*
@@ -302,16 +373,64 @@ SedErrorLog::getNumFailsWithSeverity(unsigned int severity) const
 unsigned int
 SedErrorLog::getNumFailsWithSeverity(unsigned int severity)
 {
-  int n = 0;
+  return static_cast<const SedErrorLog*>(this)
+         ->getNumFailsWithSeverity(severity);
+}
+
+
+/*
+ * Returns the number of errors that are logged with the given id.
+ */
+unsigned int
+SedErrorLog::getNumErrorsWithId(unsigned int errorId) const
+{
+  updateCounts();
+
+  map<unsigned int, unsigned int>::const_iterator count =
+    mIdCounts.find(errorId);
+
+  return count != mIdCounts.end() ? count->second : 0;
+}
+
+
+/*
+ * Sets the maximum number of errors kept.
+ */
+void
+SedErrorLog::setMaxErrors(unsigned int maxErrors)
+{
+  mMaxErrors = maxErrors;
+}
 
-#if defined(__SUNPRO_CC)
-  // Workaround for Sun cc which is missing:
-  count_if(mErrors.begin(), mErrors.end(), MatchSeverity(severity), n);
-#else
-  n = (int)count_if(mErrors.begin(), mErrors.end(), MatchSeverity(severity));
-#endif
 
-  return n;
+/*
+ * Returns the maximum number of errors kept.
+ */
+unsigned int
+SedErrorLog::getMaxErrors() const
+{
+  return mMaxErrors;
+}
+
+
+/*
+ * Returns the number of errors not kept because the log was full.
+ */
+unsigned int
+SedErrorLog::getNumDroppedErrors() const
+{
+  return mNumDroppedErrors;
+}
+
+
+/*
+ * Deletes all errors, and resets the count of dropped errors.
+ */
+void
+SedErrorLog::clearLog()
+{
+  XMLErrorLog::clearLog();
+  mNumDroppedErrors = 0;
 }
 
 
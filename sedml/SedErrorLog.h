@@ -85,6 +85,8 @@
 
 #ifdef __cplusplus
 
+#include <map>
+#include <utility>
 #include <vector>
 
 LIBSEDML_CPP_NAMESPACE_BEGIN
@@ -171,6 +173,64 @@ public:
   unsigned int getNumFailsWithSeverity(unsigned int severity) const;
 
 
+  /**
+   * Returns the number of errors that have been logged with the given
+   * error identifier.
+   *
+   * @param errorId the error identifier to count.
+   *
+   * @return a count of the number of errors with the given identifier.
+   *
+   * @see contains(const unsigned int errorId)
+   */
+  unsigned int getNumErrorsWithId(unsigned int errorId) const;
+
+
+  /**
+   * Sets the maximum number of errors kept by this SedErrorLog.
+   *
+   * Once the log is full, further errors passed to add() are counted,
+   * but not kept, except for fatal errors.  This bounds the memory used
+   * when many malformed documents are read in a batch.  Errors logged by
+   * the XML parser through the XMLErrorLog interface are always kept.
+   *
+   * @param maxErrors the maximum number of errors; @c 0 (the default)
+   * for no limit.
+   *
+   * @see getNumDroppedErrors()
+   */
+  void setMaxErrors(unsigned int maxErrors);
+
+
+  /**
+   * Returns the maximum number of errors kept by this SedErrorLog.
+   *
+   * @return the maximum number of errors, @c 0 for no limit.
+   */
+  unsigned int getMaxErrors() const;
+
+
+  /**
+   * Returns the number of errors that were not kept because this
+   * SedErrorLog was full.
+   *
+   * @return the number of errors dropped since the log was last cleared.
+   *
+   * @see setMaxErrors(unsigned int maxErrors)
+   */
+  unsigned int getNumDroppedErrors() const;
+
+
+  /**
+   * Deletes all errors from this SedErrorLog, and resets the count of
+   * dropped errors.
+   *
+   * The count of dropped errors is left as it is when the log is cleared
+   * through XMLErrorLog::clearLog().
+   */
+  void clearLog();
+
+
   /** @cond doxygen-libsbml-internal */
 
   /**
@@ -289,6 +349,53 @@ public:
   bool contains(const unsigned int errorId);
 
 
+  /**
+   * Removes all errors for which @p keep returns @c false, in a single
+   * pass that preserves the order of the remaining errors.
+   *
+   * @param keep a function taking the identifier of an error, and
+   * returning whether the error is to be kept.
+   *
+   * @return the number of errors removed.
+   */
+  unsigned int removeAllExcept(bool (*keep)(const unsigned int errorId));
+
+
+  /** @endcond */
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  /**
+   * Brings the counters in line with the errors in the log.  The errors
+   * are compared with the severity and id they were counted with, so
+   * that changes made through the non-virtual methods of XMLErrorLog,
+   * such as clearLog() or changeErrorSeverity(), are caught as well;
+   * only the errors from the first difference on are counted again.
+   */
+  void updateCounts() const;
+
+  /**
+   * Takes an error counted with the given severity and id off the
+   * counters.
+   */
+  void uncount(const std::pair<unsigned int, unsigned int>& key) const;
+
+  /**
+   * Returns @c false, counting the error as dropped, if @p error is not
+   * to be kept because the log is full.
+   */
+  bool acceptError(const XMLError& error);
+
+
+  unsigned int mMaxErrors;
+  unsigned int mNumDroppedErrors;
+
+  /* the severity and id each error in mErrors was counted with */
+  mutable std::vector<std::pair<unsigned int, unsigned int> > mCounted;
+  mutable std::map<unsigned int, unsigned int> mSeverityCounts;
+  mutable std::map<unsigned int, unsigned int> mIdCounts;
+
   /** @endcond */
 };
 
@@ -63,7 +63,11 @@ typedef struct
 } sbmlErrorTableEntry;
 
 
-static const sbmlErrorTableEntry errorTable[] =
+/*
+ * The entries must be sorted by code: SedError finds them by binary
+ * search, which is checked at compile time below.
+ */
+static constexpr sbmlErrorTableEntry errorTable[] =
 {
   // 10000
   {
@@ -9130,6 +9134,28 @@ static const sbmlErrorTableEntry errorTable[] =
   }
 };
 
+static constexpr unsigned int errorTableSize =
+  sizeof(errorTable) / sizeof(errorTable[0]);
+
+
+/*
+ * Returns true if the entries from first up to (excluding) last are sorted
+ * by code; the range is halved, so the recursion is only logarithmically
+ * deep.
+ */
+static constexpr bool
+isErrorTableSorted(unsigned int first, unsigned int last)
+{
+  return last - first < 2
+         || (errorTable[first + (last - first) / 2 - 1].code
+               < errorTable[first + (last - first) / 2].code
+             && isErrorTableSorted(first, first + (last - first) / 2)
+             && isErrorTableSorted(first + (last - first) / 2, last));
+}
+
+static_assert(isErrorTableSorted(0, errorTableSize),
+              "the entries of errorTable must be sorted by code");
+
 LIBSEDML_CPP_NAMESPACE_END
 
 /** @endcond */
@@ -0,0 +1,437 @@
+/**
+ * @file    SedExecutor.cpp
+ * @brief   Runs the tasks of a Sed Document in parallel
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedExecutor.h>
+#include <sedml/SedDependencyGraph.h>
+#include <sedml/SedDependencySlice.h>
+#include <sedml/SedSimulatorBackend.h>
+#include <sedml/SedModelResolver.h>
+#include <sedml/SedModelPatch.h>
+#include <sedml/SedEnsembleBatch.h>
+#include <sedml/SedIterationSpace.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedModel.h>
+#include <sedml/SedTask.h>
+#include <sedml/SedRepeatedTask.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedOutput.h>
+#include <sedml/SedThreadPool.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+using namespace std;
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * The nodes ready to run on one worker: the worker itself takes the
+ * most recent node, the others steal the oldest one.
+ */
+struct SedWorkQueue
+{
+  mutex lock;
+  deque<unsigned int> nodes;
+};
+
+/** @endcond doxygen-libsedml-internal */
+
+
+SedExecutor::SedExecutor(SedSimulatorBackend* backend,
+                         unsigned int numThreads)
+  : mBackend(backend)
+  , mResolver(NULL)
+  , mNumThreads(numThreads)
+  , mStatus()
+  , mNumFailed(0)
+{
+}
+
+
+SedExecutor::~SedExecutor()
+{
+}
+
+
+SedSimulatorBackend*
+SedExecutor::getBackend() const
+{
+  return mBackend;
+}
+
+
+void
+SedExecutor::setBackend(SedSimulatorBackend* backend)
+{
+  mBackend = backend;
+}
+
+
+unsigned int
+SedExecutor::getNumThreads() const
+{
+  return mNumThreads;
+}
+
+
+void
+SedExecutor::setNumThreads(unsigned int numThreads)
+{
+  mNumThreads = numThreads;
+}
+
+
+SedModelResolver*
+SedExecutor::getModelResolver() const
+{
+  return mResolver;
+}
+
+
+void
+SedExecutor::setModelResolver(SedModelResolver* resolver)
+{
+  mResolver = resolver;
+}
+
+
+int
+SedExecutor::execute(const SedDocument* doc)
+{
+  if (doc == NULL)
+    return LIBSEDML_INVALID_OBJECT;
+
+  SedDependencyGraph graph(doc);
+  return execute(graph);
+}
+
+
+int
+SedExecutor::execute(const SedDependencyGraph& graph)
+{
+  return run(graph, NULL);
+}
+
+
+int
+SedExecutor::execute(const SedDependencySlice& slice)
+{
+  return run(slice.getGraph(), &slice);
+}
+
+
+int
+SedExecutor::getStatus(unsigned int n) const
+{
+  return n < mStatus.size() ? mStatus[n] : LIBSEDML_INVALID_OBJECT;
+}
+
+
+unsigned int
+SedExecutor::getNumFailed() const
+{
+  return mNumFailed;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Runs the nodes of the graph, or only those of the slice if there is
+ * one: a slice holds all the dependencies of its nodes, so that only
+ * the dependents outside of it have to be skipped.
+ */
+int
+SedExecutor::run(const SedDependencyGraph& graph,
+                 const SedDependencySlice* slice)
+{
+  mStatus.clear();
+  mNumFailed = 0;
+
+  if (mBackend == NULL || graph.hasCycle())
+    return LIBSEDML_INVALID_OBJECT;
+
+  size_t numNodes = graph.getNumNodes();
+  size_t numSelected = slice != NULL ? slice->getNodes().size() : numNodes;
+
+  // the nodes left out of a slice are never run
+  mStatus.assign(numNodes, slice != NULL ? LIBSEDML_INVALID_OBJECT
+                                         : LIBSEDML_OPERATION_SUCCESS);
+
+  if (slice != NULL)
+    for (size_t i = 0; i < numSelected; ++i)
+      mStatus[slice->getNodes()[i]] = LIBSEDML_OPERATION_SUCCESS;
+
+  if (numSelected == 0)
+    return LIBSEDML_OPERATION_SUCCESS;
+
+  unsigned int numWorkers = getNumWorkers(numSelected);
+  unique_ptr<SedWorkQueue[]> queues(new SedWorkQueue[numWorkers]);
+  unique_ptr<atomic<size_t>[]> pending(new atomic<size_t>[numNodes]);
+  unique_ptr<atomic<bool>[]> blocked(new atomic<bool>[numNodes]);
+  atomic<size_t> remaining(numSelected);
+  atomic<size_t> queued(0);
+  mutex idleMutex;
+  condition_variable idle;
+
+  /* queued is only changed under the lock of the queue the node goes
+   * into or comes out of, so a node is always counted before it can be
+   * taken and the count cannot drop below zero; it is raised before the
+   * idle lock is taken, so a worker about to sleep either sees it or is
+   * already waiting for the notification */
+  auto push = [&](unsigned int w, unsigned int node)
+  {
+    {
+      lock_guard<mutex> lock(queues[w].lock);
+      queues[w].nodes.push_back(node);
+      ++queued;
+    }
+
+    /* taking the lock orders the push before a worker goes to sleep */
+    {
+      lock_guard<mutex> lock(idleMutex);
+    }
+    idle.notify_one();
+  };
+
+  auto take = [&](unsigned int w, unsigned int& node)
+  {
+    for (unsigned int k = 0; k < numWorkers; ++k)
+      {
+        SedWorkQueue& queue = queues[(w + k) % numWorkers];
+        lock_guard<mutex> lock(queue.lock);
+
+        if (queue.nodes.empty())
+          continue;
+
+        if (k == 0)
+          {
+            node = queue.nodes.back();
+            queue.nodes.pop_back();
+          }
+        else
+          {
+            node = queue.nodes.front();
+            queue.nodes.pop_front();
+          }
+
+        --queued;
+        return true;
+      }
+
+    return false;
+  };
+
+  unsigned int numRoots = 0;
+
+  for (unsigned int n = 0; n < numNodes; ++n)
+    {
+      pending[n] = graph.getDependencies(n).size();
+      blocked[n] = false;
+
+      if (pending[n] == 0 && (slice == NULL || slice->contains(n)))
+        {
+          queues[numRoots % numWorkers].nodes.push_back(n);
+          ++queued;
+          ++numRoots;
+        }
+    }
+
+  /* each worker runs the nodes that are ready, and queues the dependents
+   * that become ready on itself */
+  auto worker = [&](unsigned int w)
+  {
+    while (remaining > 0)
+      {
+        unsigned int node;
+
+        if (!take(w, node))
+          {
+            unique_lock<mutex> lock(idleMutex);
+            idle.wait(lock, [&]() { return queued > 0 || remaining == 0; });
+            continue;
+          }
+
+        int status = blocked[node] ? LIBSEDML_OPERATION_FAILED
+                                   : executeNode(graph.getNode(node));
+        mStatus[node] = status;
+
+        const vector<unsigned int>& dependents = graph.getDependents(node);
+
+        for (size_t i = 0; i < dependents.size(); ++i)
+          {
+            if (slice != NULL && !slice->contains(dependents[i]))
+              continue;
+
+            if (status != LIBSEDML_OPERATION_SUCCESS)
+              blocked[dependents[i]] = true;
+
+            if (--pending[dependents[i]] == 0)
+              push(w, dependents[i]);
+          }
+
+        if (--remaining == 0)
+          {
+            lock_guard<mutex> lock(idleMutex);
+            idle.notify_all();
+          }
+      }
+  };
+
+  SedThreadPool::run(numWorkers, worker);
+
+  for (size_t n = 0; n < numNodes; ++n)
+    if (mStatus[n] != LIBSEDML_OPERATION_SUCCESS &&
+        (slice == NULL || slice->contains((unsigned int)n)))
+      ++mNumFailed;
+
+  return mNumFailed == 0 ? LIBSEDML_OPERATION_SUCCESS
+                         : LIBSEDML_OPERATION_FAILED;
+}
+
+
+unsigned int
+SedExecutor::getNumWorkers(size_t numNodes) const
+{
+  return SedThreadPool::getNumWorkers(mNumThreads, numNodes);
+}
+
+
+/*
+ * Hands the given element to the backend; exceptions thrown by the
+ * backend count as failures.
+ */
+int
+SedExecutor::executeNode(const SedBase* object)
+{
+  try
+    {
+      switch (object->getTypeCode())
+        {
+        case SEDML_MODEL:
+          return mBackend->loadModel(static_cast<const SedModel*>(object));
+
+        case SEDML_TASK:
+          return mBackend->executeTask(static_cast<const SedTask*>(object));
+
+        case SEDML_TASK_REPEATEDTASK:
+          return executeRepeatedTask(
+                   static_cast<const SedRepeatedTask*>(object));
+
+        case SEDML_DATAGENERATOR:
+          return mBackend->evaluateDataGenerator(
+                   static_cast<const SedDataGenerator*>(object));
+
+        case SEDML_OUTPUT:
+        case SEDML_OUTPUT_REPORT:
+        case SEDML_OUTPUT_PLOT2D:
+        case SEDML_OUTPUT_PLOT3D:
+          return mBackend->writeOutput(static_cast<const SedOutput*>(object));
+
+        default:
+          // simulations only describe how the tasks using them run
+          return LIBSEDML_OPERATION_SUCCESS;
+        }
+    }
+  catch (...)
+    {
+      return LIBSEDML_OPERATION_FAILED;
+    }
+}
+
+
+int
+SedExecutor::executeRepeatedTask(const SedRepeatedTask* task)
+{
+  unsigned int size = mBackend->getEnsembleSize();
+
+  if (size == 0 || mResolver == NULL || !SedEnsembleBatch::isBatchable(task))
+    return mBackend->executeRepeatedTask(task);
+
+  // a patch that cannot be compiled leaves the task to the backend, which
+  // reports what is wrong with it
+  SedModelPatch patch(task);
+
+  if (patch.compile(*mResolver) != LIBSEDML_OPERATION_SUCCESS)
+    return mBackend->executeRepeatedTask(task);
+
+  SedIterationSpace space(task);
+
+  if (!space.isValid())
+    return LIBSEDML_INVALID_OBJECT;
+
+  SedEnsembleBatch batch(patch, size);
+  unsigned int numIterations = space.getNumIterations();
+
+  for (unsigned int i = 0; i < numIterations; ++i)
+    {
+      int status = patch.update(space, i);
+
+      if (status == LIBSEDML_OPERATION_SUCCESS)
+        status = batch.addIteration(i);
+
+      if (status != LIBSEDML_OPERATION_SUCCESS)
+        return status;
+
+      if (batch.getNumIterations() == size || i + 1 == numIterations)
+        {
+          status = mBackend->executeEnsemble(batch);
+
+          if (status != LIBSEDML_OPERATION_SUCCESS)
+            return status;
+
+          batch.clear();
+        }
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+#endif  /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
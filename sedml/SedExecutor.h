@@ -0,0 +1,258 @@
+/**
+ * @file    SedExecutor.h
+ * @brief   Runs the tasks of a Sed Document in parallel
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedExecutor
+ * @ingroup Core
+ * @brief Runs the elements of a SedDocument on a pool of threads.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedExecutor walks the SedDependencyGraph of a SedDocument and hands
+ * each model, task, data generator and output to a SedSimulatorBackend
+ * as soon as everything it depends on has been dealt with.  Elements
+ * that do not depend on each other, such as the tasks of a document,
+ * which SED-ML runs independently of each other, are handed over from
+ * several threads at once.
+ *
+ * Each worker thread keeps its own queue of elements that are ready to
+ * run, and takes work from the queues of the others once its own is
+ * empty.  The order of the subtasks of a SedRepeatedTask is kept, as
+ * they run one after the other inside the repeated task; the order in
+ * which independent top-level elements run is not defined.
+ *
+ * When an element fails, the elements depending on it are not run and
+ * fail as well; the others still run.
+ *
+ * When the backend runs ensembles and a SedModelResolver is set, the
+ * repeated tasks that allow it are run as batches of iterations, each
+ * passed to SedSimulatorBackend::executeEnsemble() at once; see
+ * SedEnsembleBatch.
+ */
+
+#ifndef SedExecutor_h
+#define SedExecutor_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+class SedDocument;
+class SedDependencyGraph;
+class SedDependencySlice;
+class SedSimulatorBackend;
+class SedModelResolver;
+class SedRepeatedTask;
+
+
+class LIBSEDML_EXTERN SedExecutor
+{
+public:
+
+  /**
+   * Creates a new SedExecutor.
+   *
+   * @param backend the SedSimulatorBackend that runs the elements; it is
+   * not owned by the SedExecutor.
+   * @param numThreads the number of worker threads; @c 0 (the default)
+   * uses the number of hardware threads available.
+   */
+  SedExecutor(SedSimulatorBackend* backend, unsigned int numThreads = 0);
+
+
+  /**
+   * Destroys this SedExecutor.
+   */
+  virtual ~SedExecutor();
+
+
+  /**
+   * Returns the SedSimulatorBackend of this SedExecutor.
+   *
+   * @return the backend.
+   */
+  SedSimulatorBackend* getBackend() const;
+
+
+  /**
+   * Sets the SedSimulatorBackend of this SedExecutor.
+   *
+   * @param backend the backend; it is not owned by the SedExecutor.
+   */
+  void setBackend(SedSimulatorBackend* backend);
+
+
+  /**
+   * Returns the number of worker threads used by this SedExecutor.
+   *
+   * @return the number of threads, @c 0 for the number of hardware
+   * threads available.
+   */
+  unsigned int getNumThreads() const;
+
+
+  /**
+   * Sets the number of worker threads used by this SedExecutor.
+   *
+   * @param numThreads the number of worker threads; @c 0 uses the number
+   * of hardware threads available.
+   */
+  void setNumThreads(unsigned int numThreads);
+
+
+  /**
+   * Returns the SedModelResolver of this SedExecutor.
+   *
+   * @return the resolver through which the models of repeated tasks run
+   * as ensembles are resolved, or @c NULL if there is none.
+   */
+  SedModelResolver* getModelResolver() const;
+
+
+  /**
+   * Sets the SedModelResolver of this SedExecutor.
+   *
+   * @param resolver the resolver through which the models of repeated
+   * tasks run as ensembles are resolved; it is not owned by the
+   * SedExecutor.  With @c NULL, the default, repeated tasks are always
+   * passed to SedSimulatorBackend::executeRepeatedTask().
+   */
+  void setModelResolver(SedModelResolver* resolver);
+
+
+  /**
+   * Runs all the elements of the given SedDocument.
+   *
+   * @param doc the SedDocument to run.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INVALID_OBJECT
+   * @li LIBSEDML_OPERATION_FAILED
+   *
+   * LIBSEDML_INVALID_OBJECT is returned, without running anything, when
+   * there is no backend or the dependencies contain a cycle, and
+   * LIBSEDML_OPERATION_FAILED when any element failed.
+   */
+  int execute(const SedDocument* doc);
+
+
+  /**
+   * Runs all the nodes of the given SedDependencyGraph.
+   *
+   * @param graph the SedDependencyGraph of the SedDocument to run.
+   *
+   * @return integer value indicating success/failure of the operation,
+   * as for execute(const SedDocument*).
+   */
+  int execute(const SedDependencyGraph& graph);
+
+
+  /**
+   * Runs the nodes of the given SedDependencySlice, and nothing else.
+   *
+   * @param slice the SedDependencySlice of the outputs to produce.
+   *
+   * @return integer value indicating success/failure of the operation,
+   * as for execute(const SedDocument*).
+   */
+  int execute(const SedDependencySlice& slice);
+
+
+  /**
+   * Returns the status of the nth node of the last graph run.
+   *
+   * @param n an unsigned int representing the index of the node in the
+   * SedDependencyGraph.
+   *
+   * @return the value returned by the backend for the node,
+   * LIBSEDML_OPERATION_FAILED if it was not run because a node it
+   * depends on failed, or LIBSEDML_INVALID_OBJECT if @p n is out of
+   * range or the node was left out of the slice run.
+   */
+  int getStatus(unsigned int n) const;
+
+
+  /**
+   * Returns the number of nodes of the last graph run that failed.
+   *
+   * @return the number of nodes whose status is not
+   * LIBSEDML_OPERATION_SUCCESS.
+   */
+  unsigned int getNumFailed() const;
+
+
+protected:
+
+  /** @cond doxygen-libsedml-internal */
+
+  int run(const SedDependencyGraph& graph, const SedDependencySlice* slice);
+
+  unsigned int getNumWorkers(size_t numNodes) const;
+
+  int executeNode(const SedBase* object);
+
+  int executeRepeatedTask(const SedRepeatedTask* task);
+
+  SedSimulatorBackend* mBackend;
+
+  SedModelResolver* mResolver;
+
+  unsigned int mNumThreads;
+
+  std::vector<int> mStatus;
+
+  unsigned int mNumFailed;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedExecutor_h */
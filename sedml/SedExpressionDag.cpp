@@ -0,0 +1,293 @@
+/**
+ * @file    SedExpressionDag.cpp
+ * @brief   Evaluates all Sed DataGenerators of a document as one expression DAG
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedExpressionDag.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedVariable.h>
+#include <sedml/SedParameter.h>
+
+#include <new>
+#include <tuple>
+
+using namespace std;
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/*
+ * Creates a new SedExpressionDag for the data generators of the given
+ * SedDocument.
+ */
+SedExpressionDag::SedExpressionDag(const SedDocument* doc)
+  : mDocument(doc)
+  , mInputs()
+  , mInputIndex()
+  , mDataGenerators()
+  , mOutputIndex()
+  , mProgram()
+{
+  if (doc == NULL)
+    return;
+
+  typedef tuple<string, string, string, string> VariableKey;
+  map<VariableKey, unsigned int> keys;
+
+  for (unsigned int i = 0; i < doc->getNumDataGenerators(); ++i)
+    {
+      const SedDataGenerator* dg = doc->getDataGenerator(i);
+
+      // variables referring to the same quantity share one input; the
+      // first identifier bound to a name in the data generator wins, as
+      // in SedMathProgram::compile()
+      map<string, unsigned int> inputs;
+
+      for (unsigned int j = 0; j < dg->getNumVariables(); ++j)
+        {
+          const SedVariable* var = dg->getVariable(j);
+          VariableKey key(var->getTaskReference(), var->getModelReference(),
+                          var->getTarget(), var->getSymbol());
+
+          map<VariableKey, unsigned int>::iterator it = keys.find(key);
+
+          if (it == keys.end())
+            {
+              unsigned int input = (unsigned int)mInputs.size();
+              it = keys.insert(make_pair(key, input)).first;
+              mInputs.push_back(var);
+            }
+
+          mInputIndex[var] = it->second;
+          inputs.insert(make_pair(var->getId(), it->second));
+        }
+
+      map<string, double> constants;
+
+      for (unsigned int j = 0; j < dg->getNumParameters(); ++j)
+        {
+          const SedParameter* p = dg->getParameter(j);
+          constants[p->getId()] = p->getValue();
+        }
+
+      int output = mProgram.addOutput(dg->getMath(), inputs, constants);
+
+      if (output < 0)
+        continue;
+
+      mDataGenerators.push_back(dg);
+      mOutputIndex.insert(make_pair(dg->getId(), (unsigned int)output));
+    }
+}
+
+
+/*
+ * Destroys this SedExpressionDag.
+ */
+SedExpressionDag::~SedExpressionDag()
+{
+}
+
+
+/*
+ * Returns the SedDocument of this SedExpressionDag.
+ */
+const SedDocument*
+SedExpressionDag::getSedDocument() const
+{
+  return mDocument;
+}
+
+
+/*
+ * Returns the number of inputs of this SedExpressionDag.
+ */
+unsigned int
+SedExpressionDag::getNumInputs() const
+{
+  return (unsigned int)mInputs.size();
+}
+
+
+/*
+ * Returns the first SedVariable bound to the nth input.
+ */
+const SedVariable*
+SedExpressionDag::getInput(unsigned int n) const
+{
+  return n < mInputs.size() ? mInputs[n] : NULL;
+}
+
+
+/*
+ * Returns the index of the input bound to the given SedVariable.
+ */
+int
+SedExpressionDag::getInputIndex(const SedVariable* variable) const
+{
+  map<const SedVariable*, unsigned int>::const_iterator it =
+    mInputIndex.find(variable);
+  return it == mInputIndex.end() ? -1 : (int)it->second;
+}
+
+
+/*
+ * Returns the number of outputs of this SedExpressionDag.
+ */
+unsigned int
+SedExpressionDag::getNumOutputs() const
+{
+  return (unsigned int)mDataGenerators.size();
+}
+
+
+/*
+ * Returns the SedDataGenerator computed by the nth output.
+ */
+const SedDataGenerator*
+SedExpressionDag::getDataGenerator(unsigned int n) const
+{
+  return n < mDataGenerators.size() ? mDataGenerators[n] : NULL;
+}
+
+
+/*
+ * Returns the index of the output computing the given data generator.
+ */
+int
+SedExpressionDag::getOutputIndex(const std::string& sid) const
+{
+  map<string, unsigned int>::const_iterator it = mOutputIndex.find(sid);
+  return it == mOutputIndex.end() ? -1 : (int)it->second;
+}
+
+
+/*
+ * Returns the SedMathProgram of this SedExpressionDag.
+ */
+const SedMathProgram&
+SedExpressionDag::getProgram() const
+{
+  return mProgram;
+}
+
+
+/*
+ * Evaluates all data generators over arrays of points.
+ */
+int
+SedExpressionDag::evaluate(const double* const* inputs, size_t numPoints,
+                           double* const* results) const
+{
+  return mProgram.evaluate(inputs, numPoints, results);
+}
+
+
+#endif  /* __cplusplus */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Creates a new SedExpressionDag and returns it.
+ */
+LIBSEDML_EXTERN
+SedExpressionDag_t *
+SedExpressionDag_create(const SedDocument_t *doc)
+{
+  return new (nothrow) SedExpressionDag(doc);
+}
+
+
+/**
+ * Frees the given SedExpressionDag.
+ */
+LIBSEDML_EXTERN
+void
+SedExpressionDag_free(SedExpressionDag_t *sed)
+{
+  if (sed != NULL)
+    delete sed;
+}
+
+
+/**
+ * Returns the number of inputs.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedExpressionDag_getNumInputs(const SedExpressionDag_t *sed)
+{
+  return (sed != NULL) ? sed->getNumInputs() : 0;
+}
+
+
+/**
+ * Returns the index of the output computing the given data generator.
+ */
+LIBSEDML_EXTERN
+int
+SedExpressionDag_getOutputIndex(const SedExpressionDag_t *sed,
+                                const char *sid)
+{
+  if (sed == NULL || sid == NULL)
+    return -1;
+
+  return sed->getOutputIndex(sid);
+}
+
+
+/**
+ * Evaluates all data generators over arrays of points.
+ */
+LIBSEDML_EXTERN
+int
+SedExpressionDag_evaluate(const SedExpressionDag_t *sed,
+                          const double **inputs,
+                          size_t numPoints,
+                          double **results)
+{
+  if (sed == NULL)
+    return LIBSEDML_INVALID_OBJECT;
+
+  return sed->evaluate(inputs, numPoints, results);
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
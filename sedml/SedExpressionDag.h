@@ -0,0 +1,284 @@
+/**
+ * @file    SedExpressionDag.h
+ * @brief   Evaluates all Sed DataGenerators of a document as one expression DAG
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedExpressionDag
+ * @ingroup Core
+ * @brief Evaluates all data generators of a SedDocument at once.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedExpressionDag compiles the math of every SedDataGenerator of a
+ * SedDocument into a single SedMathProgram with one output per data
+ * generator.  Variables that refer to the same quantity are bound to
+ * the same input, whatever their identifiers: two SedVariable objects
+ * are the same input when their taskReference, modelReference, target
+ * and symbol all agree.  Subexpressions that several data generators
+ * have in common, such as the total in @c X/total and @c Y/total, are
+ * then computed only once per point.
+ *
+ * Data generators whose math cannot be compiled have no output; their
+ * variables are still bound to inputs.
+ */
+
+#ifndef SedExpressionDag_h
+#define SedExpressionDag_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedMathProgram.h>
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+class SedDataGenerator;
+class SedVariable;
+
+
+class LIBSEDML_EXTERN SedExpressionDag
+{
+public:
+
+  /**
+   * Creates a new SedExpressionDag for the data generators of the given
+   * SedDocument.
+   *
+   * @param doc the SedDocument; it must not be changed while this
+   * SedExpressionDag is in use.
+   */
+  SedExpressionDag(const SedDocument* doc);
+
+
+  /**
+   * Destroys this SedExpressionDag.
+   */
+  virtual ~SedExpressionDag();
+
+
+  /**
+   * Returns the SedDocument of this SedExpressionDag.
+   *
+   * @return the SedDocument this SedExpressionDag was created for.
+   */
+  const SedDocument* getSedDocument() const;
+
+
+  /**
+   * Returns the number of inputs of this SedExpressionDag.
+   *
+   * @return the number of distinct quantities referred to by the
+   * variables of the data generators.
+   */
+  unsigned int getNumInputs() const;
+
+
+  /**
+   * Returns the first SedVariable bound to the nth input.
+   *
+   * @param n an unsigned int representing the index of the input.
+   *
+   * @return the SedVariable, or @c NULL if @p n is out of range.
+   */
+  const SedVariable* getInput(unsigned int n) const;
+
+
+  /**
+   * Returns the index of the input bound to the given SedVariable.
+   *
+   * @param variable a SedVariable of one of the data generators.
+   *
+   * @return the index of the input, or @c -1 if @p variable is not a
+   * variable of the SedDocument.
+   */
+  int getInputIndex(const SedVariable* variable) const;
+
+
+  /**
+   * Returns the number of outputs of this SedExpressionDag.
+   *
+   * @return the number of data generators whose math was compiled.
+   */
+  unsigned int getNumOutputs() const;
+
+
+  /**
+   * Returns the SedDataGenerator computed by the nth output.
+   *
+   * @param n an unsigned int representing the index of the output.
+   *
+   * @return the SedDataGenerator, or @c NULL if @p n is out of range.
+   */
+  const SedDataGenerator* getDataGenerator(unsigned int n) const;
+
+
+  /**
+   * Returns the index of the output computing the given data generator.
+   *
+   * @param sid the identifier of the SedDataGenerator.
+   *
+   * @return the index of the output, or @c -1 if there is no such data
+   * generator or its math could not be compiled.
+   */
+  int getOutputIndex(const std::string& sid) const;
+
+
+  /**
+   * Returns the SedMathProgram of this SedExpressionDag.
+   *
+   * @return the SedMathProgram computing all outputs.
+   */
+  const SedMathProgram& getProgram() const;
+
+
+  /**
+   * Evaluates all data generators over arrays of points.
+   *
+   * @param inputs an array of getNumInputs() columns, each holding
+   * @p numPoints values.
+   * @param numPoints the number of points to evaluate.
+   * @param results an array of getNumOutputs() columns, each receiving
+   * @p numPoints values.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INVALID_OBJECT
+   */
+  int evaluate(const double* const* inputs, size_t numPoints,
+               double* const* results) const;
+
+
+protected:
+
+  /** @cond doxygen-libsedml-internal */
+
+  /* not copyable */
+  SedExpressionDag(const SedExpressionDag&);
+  SedExpressionDag& operator=(const SedExpressionDag&);
+
+  const SedDocument* mDocument;
+
+  std::vector<const SedVariable*> mInputs;
+
+  std::map<const SedVariable*, unsigned int> mInputIndex;
+
+  std::vector<const SedDataGenerator*> mDataGenerators;
+
+  std::map<std::string, unsigned int> mOutputIndex;
+
+  SedMathProgram mProgram;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+/**
+ * Creates a new SedExpressionDag for the data generators of the given
+ * SedDocument and returns it.
+ */
+LIBSEDML_EXTERN
+SedExpressionDag_t *
+SedExpressionDag_create(const SedDocument_t *doc);
+
+
+/**
+ * Frees the given SedExpressionDag, created with
+ * SedExpressionDag_create().
+ */
+LIBSEDML_EXTERN
+void
+SedExpressionDag_free(SedExpressionDag_t *sed);
+
+
+/**
+ * Returns the number of inputs of @p sed.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedExpressionDag_getNumInputs(const SedExpressionDag_t *sed);
+
+
+/**
+ * Returns the index of the output of @p sed computing the data generator
+ * with the given identifier, or @c -1.
+ */
+LIBSEDML_EXTERN
+int
+SedExpressionDag_getOutputIndex(const SedExpressionDag_t *sed,
+                                const char *sid);
+
+
+/**
+ * Evaluates all data generators of @p sed over @p numPoints points,
+ * reading getNumInputs() columns from @p inputs and writing one column
+ * per output to @p results.
+ */
+LIBSEDML_EXTERN
+int
+SedExpressionDag_evaluate(const SedExpressionDag_t *sed,
+                          const double **inputs,
+                          size_t numPoints,
+                          double **results);
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+
+#endif  /* SedExpressionDag_h */
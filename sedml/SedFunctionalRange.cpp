@@ -36,6 +36,7 @@
 
 #include <sedml/SedFunctionalRange.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 #include <sbml/math/MathML.h>
 #include <sbml/math/ASTNode.h>
@@ -58,9 +59,6 @@ SedFunctionalRange::SedFunctionalRange(unsigned int level, unsigned int version)
   , mMath(NULL)
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
-
   // connect to child objects
   connectToChild();
 }
@@ -616,6 +614,7 @@ SedFunctionalRange::writeElements(XMLOutputStream& stream) const
 
   if (isSetMath() == true)
     {
+      SEDML_TIME_PHASE(SEDML_PHASE_WRITE_MATHML);
       writeMathML(getMath(), stream, NULL);
     }
 }
@@ -624,6 +623,48 @@ SedFunctionalRange::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedFunctionalRange::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedRange::writeSnapshot(writer);
+
+  mVariables.writeSnapshot(writer);
+  mParameters.writeSnapshot(writer);
+  writer.writeString(mRange);
+  writer.writeMath(mMath);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedFunctionalRange::readSnapshot(SedSnapshotReader& reader)
+{
+  SedRange::readSnapshot(reader);
+
+  mVariables.readSnapshot(reader);
+  mParameters.readSnapshot(reader);
+  mRange = reader.readString();
+
+  delete mMath;
+  mMath = reader.readMath();
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -632,8 +673,22 @@ SedFunctionalRange::writeElements(XMLOutputStream& stream) const
 bool
 SedFunctionalRange::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      if (getNumVariables() > 0)
+        {
+          mVariables.accept(v);
+        }
 
+      if (getNumParameters() > 0)
+        {
+          mParameters.accept(v);
+        }
+    }
+
+  v.leave(*this);
+
+  return true;
 }
 
 
@@ -722,6 +777,7 @@ SedFunctionalRange::readOtherXML(XMLInputStream& stream)
 
   if (name == "math")
     {
+      SEDML_TIME_PHASE(SEDML_PHASE_MATHML);
       const XMLToken elem = stream.peek();
       const std::string prefix = checkMathMLNamespace(elem);
 
@@ -768,7 +824,6 @@ SedListOfFunctionalRanges::SedListOfFunctionalRanges(unsigned int level,
     unsigned int version)
   : SedListOf(level, version)
 {
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -829,10 +884,8 @@ SedListOfFunctionalRanges::get(const std::string& sid)
 const SedFunctionalRange*
 SedListOfFunctionalRanges::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedFunctionalRange>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <SedFunctionalRange*>(*result);
+  int index = getIndexById(sid);
+  return (index < 0) ? 0 : static_cast <SedFunctionalRange*>(mItems[index]);
 }
 
 
@@ -904,14 +957,11 @@ SedFunctionalRange*
 SedListOfFunctionalRanges::remove(const std::string& sid)
 {
   SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedFunctionalRange>(sid));
+  int index = getIndexById(sid);
 
-  if (result != mItems.end())
+  if (index >= 0)
     {
-      item = *result;
-      mItems.erase(result);
+      item = SedListOf::remove((unsigned int)index);
     }
 
   return static_cast <SedFunctionalRange*>(item);
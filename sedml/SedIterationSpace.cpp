@@ -0,0 +1,842 @@
+/**
+ * @file    SedIterationSpace.cpp
+ * @brief   Enumerates the iterations of a Sed RepeatedTask
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedIterationSpace.h>
+#include <sedml/SedMathProgram.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedRepeatedTask.h>
+#include <sedml/SedSubTask.h>
+#include <sedml/SedUniformRange.h>
+#include <sedml/SedVectorRange.h>
+#include <sedml/SedFunctionalRange.h>
+
+#include <sbml/math/ASTNode.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <new>
+
+using namespace std;
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * The ranges and subtasks of one SedRepeatedTask, nested depth levels
+ * inside the repeated task of the SedIterationSpace.
+ */
+class SedIterationLevel
+{
+public:
+  /* where a SedFunctionalRange finds the value of an identifier: a range
+   * of the level at the given depth, or a variable when depth is -1 */
+  struct Input
+  {
+    int depth;
+    unsigned int index;
+  };
+
+  struct Range
+  {
+    std::string id;
+    int typeCode;
+    unsigned int numValues;
+    double start;
+    double end;
+    unsigned int numSteps;
+    bool log;
+    const SedVectorRange* vector;
+    SedMathProgram program;
+    std::vector<Input> inputs;
+  };
+
+  struct Child
+  {
+    const SedSubTask* subTask;
+    const SedTask* task;
+    const SedIterationLevel* level;
+  };
+
+  const SedRepeatedTask* task;
+  unsigned int depth;
+  std::vector<Range> ranges;
+  std::vector<unsigned int> order;
+  unsigned int numIterations;
+  std::vector<Child> children;
+  unsigned long long numSteps;
+};
+
+
+/*
+ * Collects the identifiers used in the given math, once each.
+ */
+static void
+collectNames(const ASTNode* node, vector<string>& names)
+{
+  if (node == NULL)
+    return;
+
+  if ((node->getType() == AST_NAME) && node->getName() != NULL &&
+      find(names.begin(), names.end(), node->getName()) == names.end())
+    names.push_back(node->getName());
+
+  for (unsigned int i = 0; i < node->getNumChildren(); ++i)
+    collectNames(node->getChild(i), names);
+}
+
+
+static int
+findRange(const SedIterationLevel* level, const string& id)
+{
+  for (size_t r = 0; r < level->ranges.size(); ++r)
+    if (level->ranges[r].id == id)
+      return (int)r;
+
+  return -1;
+}
+
+
+/*
+ * Sorts the ranges of a level so that every SedFunctionalRange comes
+ * after the ranges of the same level it refers to; returns false on a
+ * cycle.
+ */
+static bool
+sortRanges(SedIterationLevel* level, unsigned int r, vector<int>& state)
+{
+  if (state[r] == 2)
+    return true;
+
+  if (state[r] == 1)
+    return false;
+
+  state[r] = 1;
+  const vector<SedIterationLevel::Input>& inputs = level->ranges[r].inputs;
+
+  for (size_t k = 0; k < inputs.size(); ++k)
+    {
+      if (inputs[k].depth == (int)level->depth &&
+          !sortRanges(level, inputs[k].index, state))
+        return false;
+    }
+
+  state[r] = 2;
+  level->order.push_back(r);
+  return true;
+}
+
+
+static bool
+compareOrder(const SedSubTask* a, const SedSubTask* b)
+{
+  return a->getOrder() < b->getOrder();
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Creates a new SedIterationSpace for the given SedRepeatedTask.
+ */
+SedIterationSpace::SedIterationSpace(const SedRepeatedTask* task)
+  : mTask(task)
+  , mLevels()
+  , mVariableIds()
+  , mVariableValues()
+  , mStack()
+  , mCurrent()
+  , mStarted(false)
+  , mValid(task != NULL)
+{
+  if (task != NULL)
+    {
+      vector<const SedIterationLevel*> outer;
+      createLevel(task, outer);
+    }
+}
+
+
+/*
+ * Destroys this SedIterationSpace.
+ */
+SedIterationSpace::~SedIterationSpace()
+{
+  for (size_t i = 0; i < mLevels.size(); ++i)
+    delete mLevels[i];
+}
+
+
+/*
+ * Returns true if the iterations of the repeated task could be
+ * determined.
+ */
+bool
+SedIterationSpace::isValid() const
+{
+  return mValid;
+}
+
+
+/*
+ * Returns the SedRepeatedTask of this SedIterationSpace.
+ */
+const SedRepeatedTask*
+SedIterationSpace::getRepeatedTask() const
+{
+  return mTask;
+}
+
+
+/*
+ * Returns the number of iterations of the repeated task.
+ */
+unsigned int
+SedIterationSpace::getNumIterations() const
+{
+  return mValid ? mLevels[0]->numIterations : 0;
+}
+
+
+/*
+ * Returns the number of steps of the repeated task.
+ */
+unsigned long long
+SedIterationSpace::getNumSteps() const
+{
+  return mValid ? mLevels[0]->numSteps : 0;
+}
+
+
+/*
+ * Returns the number of ranges of the repeated task.
+ */
+unsigned int
+SedIterationSpace::getNumRanges() const
+{
+  return mLevels.empty() ? 0 : (unsigned int)mLevels[0]->ranges.size();
+}
+
+
+/*
+ * Returns the identifier of the nth range of the repeated task.
+ */
+const std::string&
+SedIterationSpace::getRangeId(unsigned int n) const
+{
+  static const string empty;
+
+  if (n >= getNumRanges())
+    return empty;
+
+  return mLevels[0]->ranges[n].id;
+}
+
+
+/*
+ * Returns the value of the nth range in the given iteration.
+ */
+double
+SedIterationSpace::getRangeValue(unsigned int n, unsigned int iteration) const
+{
+  vector<double> values;
+
+  if (getValues(iteration, values) != LIBSEDML_OPERATION_SUCCESS ||
+      n >= values.size())
+    return numeric_limits<double>::quiet_NaN();
+
+  return values[n];
+}
+
+
+/*
+ * Computes the values of all ranges in the given iteration.
+ */
+int
+SedIterationSpace::getValues(unsigned int iteration,
+                             std::vector<double>& values) const
+{
+  if (!mValid)
+    return LIBSEDML_INVALID_OBJECT;
+
+  if (iteration >= mLevels[0]->numIterations)
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  vector<vector<double> > levels(1);
+  computeValues(mLevels[0], iteration, levels);
+  values.swap(levels[0]);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Sets the value of a variable used by a SedFunctionalRange.
+ */
+int
+SedIterationSpace::setVariableValue(const std::string& id, double value)
+{
+  vector<string>::const_iterator it =
+    find(mVariableIds.begin(), mVariableIds.end(), id);
+
+  if (it == mVariableIds.end())
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  mVariableValues[it - mVariableIds.begin()] = value;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Restarts the walk through the steps.
+ */
+void
+SedIterationSpace::reset()
+{
+  mStack.clear();
+  mStarted = false;
+}
+
+
+/*
+ * Moves to the next step.
+ */
+bool
+SedIterationSpace::next()
+{
+  if (!mValid)
+    return false;
+
+  if (!mStarted)
+    {
+      mStarted = true;
+      mStack.clear();
+      enter(mLevels[0]);
+    }
+  else if (!mStack.empty())
+    {
+      ++mStack.back().child;
+    }
+
+  return settle();
+}
+
+
+/*
+ * Returns the number of repeated tasks enclosing the current step.
+ */
+unsigned int
+SedIterationSpace::getDepth() const
+{
+  return (unsigned int)mStack.size();
+}
+
+
+/*
+ * Returns the repeated task at the given depth of the current step.
+ */
+const SedRepeatedTask*
+SedIterationSpace::getRepeatedTask(unsigned int depth) const
+{
+  return depth < mStack.size() ? mStack[depth].level->task : NULL;
+}
+
+
+/*
+ * Returns the iteration at the given depth of the current step.
+ */
+unsigned int
+SedIterationSpace::getIteration(unsigned int depth) const
+{
+  return depth < mStack.size() ? mStack[depth].iteration : 0;
+}
+
+
+/*
+ * Returns the SedSubTask executed in the current step.
+ */
+const SedSubTask*
+SedIterationSpace::getSubTask() const
+{
+  if (mStack.empty())
+    return NULL;
+
+  const Frame& f = mStack.back();
+  return f.level->children[f.child].subTask;
+}
+
+
+/*
+ * Returns the task executed in the current step.
+ */
+const SedTask*
+SedIterationSpace::getTask() const
+{
+  if (mStack.empty())
+    return NULL;
+
+  const Frame& f = mStack.back();
+  return f.level->children[f.child].task;
+}
+
+
+/*
+ * Returns the value of the given range in the current step.
+ */
+double
+SedIterationSpace::getValue(const std::string& rangeId) const
+{
+  for (size_t d = mStack.size(); d > 0; --d)
+    {
+      int r = findRange(mStack[d - 1].level, rangeId);
+
+      if (r >= 0)
+        return mCurrent[d - 1][r];
+    }
+
+  return numeric_limits<double>::quiet_NaN();
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Creates the level of the given repeated task, nested inside the
+ * levels in outer, together with the levels of its nested repeated
+ * tasks.  Returns NULL, and marks this SedIterationSpace as invalid, if
+ * the task already encloses itself.
+ */
+SedIterationLevel*
+SedIterationSpace::createLevel(const SedRepeatedTask* task,
+                               std::vector<const SedIterationLevel*>& outer)
+{
+  for (size_t i = 0; i < outer.size(); ++i)
+    {
+      if (outer[i]->task == task)
+        {
+          mValid = false;
+          return NULL;
+        }
+    }
+
+  SedIterationLevel* level = new SedIterationLevel();
+  mLevels.push_back(level);
+  level->task = task;
+  level->depth = (unsigned int)outer.size();
+  level->numIterations = 0;
+  level->numSteps = 0;
+
+  unsigned int numRanges = task->getNumRanges();
+  level->ranges.resize(numRanges);
+
+  for (unsigned int r = 0; r < numRanges; ++r)
+    {
+      const SedRange* range = task->getRange(r);
+      SedIterationLevel::Range& current = level->ranges[r];
+      current.id = range->getId();
+      current.typeCode = range->getTypeCode();
+      current.numValues = 0;
+      current.start = 0.0;
+      current.end = 0.0;
+      current.numSteps = 0;
+      current.log = false;
+      current.vector = NULL;
+
+      if (current.typeCode == SEDML_RANGE_UNIFORMRANGE)
+        {
+          const SedUniformRange* uniform =
+            static_cast<const SedUniformRange*>(range);
+          int numPoints = uniform->getNumberOfPoints();
+          current.start = uniform->getStart();
+          current.end = uniform->getEnd();
+          current.numSteps = numPoints > 0 ? (unsigned int)numPoints : 0;
+          current.numValues = current.numSteps + 1;
+          current.log = uniform->getType() == "log";
+        }
+      else if (current.typeCode == SEDML_RANGE_VECTORRANGE)
+        {
+          current.vector = static_cast<const SedVectorRange*>(range);
+          current.numValues = current.vector->getNumValues();
+        }
+    }
+
+  // bind the identifiers used by functional ranges: their own variables
+  // and parameters first, then the ranges of this and the enclosing
+  // repeated tasks, innermost first
+  for (unsigned int r = 0; r < numRanges; ++r)
+    {
+      SedIterationLevel::Range& current = level->ranges[r];
+
+      if (current.typeCode != SEDML_RANGE_FUNCTIONALRANGE)
+        continue;
+
+      const SedFunctionalRange* functional =
+        static_cast<const SedFunctionalRange*>(task->getRange(r));
+
+      map<string, double> constants;
+
+      for (unsigned int i = 0; i < functional->getNumParameters(); ++i)
+        {
+          const SedParameter* p = functional->getParameter(i);
+          constants[p->getId()] = p->getValue();
+        }
+
+      vector<string> names;
+      collectNames(functional->getMath(), names);
+
+      vector<string> inputIds;
+
+      for (size_t i = 0; i < names.size(); ++i)
+        {
+          const string& name = names[i];
+
+          if (constants.find(name) != constants.end())
+            continue;
+
+          SedIterationLevel::Input input = { -1, 0 };
+          int index = -1;
+
+          if (functional->getVariable(name) != NULL)
+            {
+              vector<string>::iterator it =
+                find(mVariableIds.begin(), mVariableIds.end(), name);
+              input.index = (unsigned int)(it - mVariableIds.begin());
+
+              if (it == mVariableIds.end())
+                {
+                  mVariableIds.push_back(name);
+                  mVariableValues.push_back(
+                    numeric_limits<double>::quiet_NaN());
+                }
+            }
+          else if ((index = findRange(level, name)) >= 0 && index != (int)r)
+            {
+              input.depth = (int)level->depth;
+              input.index = (unsigned int)index;
+            }
+          else
+            {
+              index = -1;
+
+              for (size_t d = outer.size(); d > 0 && index < 0; --d)
+                {
+                  index = findRange(outer[d - 1], name);
+                  input.depth = (int)d - 1;
+                  input.index = (unsigned int)index;
+                }
+
+              // unbound identifiers make the compilation below fail
+              if (index < 0)
+                continue;
+            }
+
+          current.inputs.push_back(input);
+          inputIds.push_back(name);
+        }
+
+      if (current.program.compile(functional->getMath(), inputIds, constants)
+          != LIBSEDML_OPERATION_SUCCESS)
+        mValid = false;
+    }
+
+  vector<int> state(numRanges, 0);
+
+  for (unsigned int r = 0; r < numRanges; ++r)
+    {
+      if (!sortRanges(level, r, state))
+        {
+          mValid = false;
+          break;
+        }
+    }
+
+  // the master range gives the number of iterations; a functional range
+  // has as many values as the range it is indexed by
+  int master = task->isSetRangeId() ? findRange(level, task->getRangeId())
+                                    : (numRanges > 0 ? 0 : -1);
+
+  if (task->isSetRangeId() && master < 0)
+    mValid = false;
+
+  for (unsigned int hops = 0; master >= 0 && hops <= numRanges; ++hops)
+    {
+      if (level->ranges[master].typeCode != SEDML_RANGE_FUNCTIONALRANGE)
+        {
+          level->numIterations = level->ranges[master].numValues;
+          break;
+        }
+
+      master = findRange(level, static_cast<const SedFunctionalRange*>
+                         (task->getRange(master))->getRange());
+    }
+
+  vector<const SedSubTask*> subTasks;
+
+  for (unsigned int i = 0; i < task->getNumSubTasks(); ++i)
+    subTasks.push_back(task->getSubTask(i));
+
+  stable_sort(subTasks.begin(), subTasks.end(), compareOrder);
+
+  const SedDocument* doc = task->getSedDocument();
+  unsigned long long stepsPerIteration = 0;
+
+  for (size_t i = 0; i < subTasks.size(); ++i)
+    {
+      SedIterationLevel::Child child;
+      child.subTask = subTasks[i];
+      child.task = doc != NULL ? doc->getTask(subTasks[i]->getTask()) : NULL;
+      child.level = NULL;
+
+      if (child.task != NULL &&
+          child.task->getTypeCode() == SEDML_TASK_REPEATEDTASK)
+        {
+          outer.push_back(level);
+          child.level = createLevel(
+            static_cast<const SedRepeatedTask*>(child.task), outer);
+          outer.pop_back();
+        }
+
+      stepsPerIteration += child.level != NULL ? child.level->numSteps : 1;
+      level->children.push_back(child);
+    }
+
+  level->numSteps = stepsPerIteration * level->numIterations;
+  return level;
+}
+
+
+/*
+ * Computes the values of the ranges of the given level in the given
+ * iteration, into values[level->depth]; the values of the enclosing
+ * levels are read from the entries before it.
+ */
+void
+SedIterationSpace::computeValues(const SedIterationLevel* level,
+                                 unsigned int iteration,
+                                 std::vector<std::vector<double> >& values) const
+{
+  vector<double>& result = values[level->depth];
+  result.assign(level->ranges.size(), numeric_limits<double>::quiet_NaN());
+
+  vector<double> arguments;
+
+  for (size_t k = 0; k < level->order.size(); ++k)
+    {
+      unsigned int r = level->order[k];
+      const SedIterationLevel::Range& range = level->ranges[r];
+
+      if (range.typeCode == SEDML_RANGE_FUNCTIONALRANGE)
+        {
+          arguments.resize(range.inputs.size());
+
+          for (size_t i = 0; i < range.inputs.size(); ++i)
+            {
+              const SedIterationLevel::Input& input = range.inputs[i];
+              arguments[i] = input.depth < 0 ? mVariableValues[input.index]
+                                             : values[input.depth][input.index];
+            }
+
+          result[r] = range.program.evaluate(arguments.empty() ? NULL
+                                                               : &arguments[0]);
+        }
+      else if (iteration < range.numValues)
+        {
+          if (range.vector != NULL)
+            result[r] = range.vector->getValuesData()[iteration];
+          else if (iteration == range.numSteps)
+            result[r] = range.end;
+          else if (range.log)
+            result[r] = range.start * pow(range.end / range.start,
+                                          (double)iteration / range.numSteps);
+          else
+            result[r] = range.start + (range.end - range.start) *
+                        iteration / range.numSteps;
+        }
+    }
+}
+
+
+/*
+ * Starts the first iteration of the given level.
+ */
+void
+SedIterationSpace::enter(const SedIterationLevel* level)
+{
+  Frame f = { level, 0, 0 };
+  mStack.push_back(f);
+
+  if (mCurrent.size() < mStack.size())
+    mCurrent.resize(mStack.size());
+
+  if (level->numIterations > 0)
+    computeValues(level, 0, mCurrent);
+}
+
+
+/*
+ * Moves from the current position to the next subtask that is not
+ * itself a repeated task, entering nested repeated tasks and starting
+ * new iterations as needed; returns false at the end.
+ */
+bool
+SedIterationSpace::settle()
+{
+  while (!mStack.empty())
+    {
+      Frame& f = mStack.back();
+      const SedIterationLevel* level = f.level;
+
+      if (level->numSteps == 0 ||
+          (f.child >= level->children.size() &&
+           ++f.iteration >= level->numIterations))
+        {
+          mStack.pop_back();
+
+          if (!mStack.empty())
+            ++mStack.back().child;
+
+          continue;
+        }
+
+      if (f.child >= level->children.size())
+        {
+          f.child = 0;
+          computeValues(level, f.iteration, mCurrent);
+          continue;
+        }
+
+      const SedIterationLevel::Child& child = level->children[f.child];
+
+      if (child.level == NULL)
+        return true;
+
+      enter(child.level);
+    }
+
+  return false;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+#endif  /* __cplusplus */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Creates a new SedIterationSpace and returns it.
+ */
+LIBSEDML_EXTERN
+SedIterationSpace_t *
+SedIterationSpace_create(const SedRepeatedTask_t *srt)
+{
+  return new (nothrow) SedIterationSpace(srt);
+}
+
+
+/**
+ * Frees the given SedIterationSpace.
+ */
+LIBSEDML_EXTERN
+void
+SedIterationSpace_free(SedIterationSpace_t *sis)
+{
+  if (sis != NULL)
+    delete sis;
+}
+
+
+/**
+ * Returns the number of iterations of the repeated task.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedIterationSpace_getNumIterations(const SedIterationSpace_t *sis)
+{
+  return (sis != NULL) ? sis->getNumIterations() : 0;
+}
+
+
+/**
+ * Returns the value of the nth range in the given iteration.
+ */
+LIBSEDML_EXTERN
+double
+SedIterationSpace_getRangeValue(const SedIterationSpace_t *sis,
+                                unsigned int n,
+                                unsigned int iteration)
+{
+  if (sis == NULL)
+    return numeric_limits<double>::quiet_NaN();
+
+  return sis->getRangeValue(n, iteration);
+}
+
+
+/**
+ * Moves to the next step.
+ */
+LIBSEDML_EXTERN
+int
+SedIterationSpace_next(SedIterationSpace_t *sis)
+{
+  return (sis != NULL && sis->next()) ? 1 : 0;
+}
+
+
+/**
+ * Returns the value of the given range in the current step.
+ */
+LIBSEDML_EXTERN
+double
+SedIterationSpace_getValue(const SedIterationSpace_t *sis,
+                           const char *rangeId)
+{
+  if (sis == NULL || rangeId == NULL)
+    return numeric_limits<double>::quiet_NaN();
+
+  return sis->getValue(rangeId);
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
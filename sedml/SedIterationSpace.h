@@ -0,0 +1,398 @@
+/**
+ * @file    SedIterationSpace.h
+ * @brief   Enumerates the iterations of a Sed RepeatedTask
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedIterationSpace
+ * @ingroup Core
+ * @brief Enumerates the iterations described by a SedRepeatedTask.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedIterationSpace computes the values that the ranges of a
+ * SedRepeatedTask take in each iteration, without storing them.  The
+ * number of iterations is that of the master range named by the "range"
+ * attribute; the other ranges advance in lockstep with it.  A
+ * SedUniformRange of type "linear" or "log" yields numberOfPoints + 1
+ * values, a SedVectorRange its values, and a SedFunctionalRange the
+ * value of its math, evaluated from the current values of the ranges it
+ * refers to, its parameters and its variables.  The values of model
+ * variables are not known to libSEDML; they are set with
+ * setVariableValue() and are NaN otherwise.
+ *
+ * The values of any iteration of the repeated task can be requested
+ * directly with getRangeValue() or getValues().  In addition, reset()
+ * and next() walk all the steps of the repeated task: one step for each
+ * execution of a SedSubTask, in the order of their "order" attribute.
+ * A subtask referring to another SedRepeatedTask expands into all the
+ * steps of that task, once per iteration of the outer task, so that
+ * nested scans are walked one step at a time, without building the
+ * product of their iterations.
+ */
+
+#ifndef SedIterationSpace_h
+#define SedIterationSpace_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedRepeatedTask;
+class SedSubTask;
+class SedTask;
+class SedIterationLevel;
+
+
+class LIBSEDML_EXTERN SedIterationSpace
+{
+public:
+
+  /**
+   * Creates a new SedIterationSpace for the given SedRepeatedTask.
+   *
+   * Subtasks are resolved through the SedDocument containing @p task;
+   * the SedRepeatedTask must not be changed while this SedIterationSpace
+   * is in use.
+   *
+   * @param task the SedRepeatedTask whose iterations are enumerated.
+   */
+  SedIterationSpace(const SedRepeatedTask* task);
+
+
+  /**
+   * Destroys this SedIterationSpace.
+   */
+  virtual ~SedIterationSpace();
+
+
+  /**
+   * Predicate returning @c true if the iterations of the repeated task
+   * could be determined.
+   *
+   * @return @c false if the task is @c NULL, a SedFunctionalRange has
+   * math that cannot be evaluated or ranges that depend on each other,
+   * or repeated tasks contain each other; @c true otherwise.
+   */
+  bool isValid() const;
+
+
+  /**
+   * Returns the SedRepeatedTask of this SedIterationSpace.
+   *
+   * @return the SedRepeatedTask this SedIterationSpace was created for.
+   */
+  const SedRepeatedTask* getRepeatedTask() const;
+
+
+  /**
+   * Returns the number of iterations of the repeated task.
+   *
+   * @return the number of values of the master range.
+   */
+  unsigned int getNumIterations() const;
+
+
+  /**
+   * Returns the number of steps of the repeated task.
+   *
+   * @return the number of executions of subtasks, including those of
+   * nested repeated tasks, that next() walks through.
+   */
+  unsigned long long getNumSteps() const;
+
+
+  /**
+   * Returns the number of ranges of the repeated task.
+   *
+   * @return the number of ranges.
+   */
+  unsigned int getNumRanges() const;
+
+
+  /**
+   * Returns the identifier of the nth range of the repeated task.
+   *
+   * @param n an unsigned int representing the index of the range.
+   *
+   * @return the identifier, or the empty string if @p n is out of range.
+   */
+  const std::string& getRangeId(unsigned int n) const;
+
+
+  /**
+   * Returns the value of the nth range of the repeated task in the given
+   * iteration.
+   *
+   * @param n an unsigned int representing the index of the range.
+   * @param iteration the index of the iteration.
+   *
+   * @return the value, or NaN if @p n or @p iteration is out of range.
+   */
+  double getRangeValue(unsigned int n, unsigned int iteration) const;
+
+
+  /**
+   * Computes the values of all ranges of the repeated task in the given
+   * iteration.
+   *
+   * @param iteration the index of the iteration.
+   * @param values the vector receiving one value per range.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INVALID_OBJECT
+   * @li LIBSEDML_INVALID_ATTRIBUTE_VALUE
+   */
+  int getValues(unsigned int iteration, std::vector<double>& values) const;
+
+
+  /**
+   * Sets the value of a variable used by the math of a SedFunctionalRange.
+   *
+   * @param id the identifier of the SedVariable.
+   * @param value the value of the model variable it refers to.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INVALID_ATTRIBUTE_VALUE
+   */
+  int setVariableValue(const std::string& id, double value);
+
+
+  /**
+   * Restarts the walk through the steps of the repeated task; the next
+   * call to next() moves to the first step.
+   */
+  void reset();
+
+
+  /**
+   * Moves to the next step of the repeated task.
+   *
+   * @return @c true if there is a step, @c false once all the steps have
+   * been walked through.
+   */
+  bool next();
+
+
+  /**
+   * Returns the number of repeated tasks enclosing the current step.
+   *
+   * @return @c 1 for the steps of the repeated task itself, one more for
+   * each nested repeated task, and @c 0 when there is no current step.
+   */
+  unsigned int getDepth() const;
+
+
+  /**
+   * Returns the repeated task at the given depth of the current step.
+   *
+   * @param depth the depth, @c 0 being the repeated task itself.
+   *
+   * @return the SedRepeatedTask, or @c NULL if @p depth is out of range.
+   */
+  const SedRepeatedTask* getRepeatedTask(unsigned int depth) const;
+
+
+  /**
+   * Returns the iteration of the repeated task at the given depth of the
+   * current step.
+   *
+   * @param depth the depth, @c 0 being the repeated task itself.
+   *
+   * @return the index of the iteration, or @c 0 if @p depth is out of
+   * range.
+   */
+  unsigned int getIteration(unsigned int depth) const;
+
+
+  /**
+   * Returns the SedSubTask executed in the current step.
+   *
+   * @return the SedSubTask, or @c NULL when there is no current step.
+   */
+  const SedSubTask* getSubTask() const;
+
+
+  /**
+   * Returns the task executed in the current step.
+   *
+   * @return the task the current SedSubTask refers to, or @c NULL if it
+   * cannot be found or there is no current step.
+   */
+  const SedTask* getTask() const;
+
+
+  /**
+   * Returns the value of the range with the given identifier in the
+   * current step.
+   *
+   * @param rangeId the identifier of a range of any of the repeated tasks
+   * enclosing the current step; the innermost one is used.
+   *
+   * @return the value, or NaN if there is no such range.
+   */
+  double getValue(const std::string& rangeId) const;
+
+
+protected:
+
+  /** @cond doxygen-libsedml-internal */
+
+  struct Frame
+  {
+    const SedIterationLevel* level;
+    unsigned int iteration;
+    unsigned int child;
+  };
+
+  /* not copyable */
+  SedIterationSpace(const SedIterationSpace&);
+  SedIterationSpace& operator=(const SedIterationSpace&);
+
+  SedIterationLevel* createLevel(const SedRepeatedTask* task,
+                                 std::vector<const SedIterationLevel*>& outer);
+
+  void computeValues(const SedIterationLevel* level, unsigned int iteration,
+                     std::vector<std::vector<double> >& values) const;
+
+  void enter(const SedIterationLevel* level);
+
+  bool settle();
+
+  const SedRepeatedTask* mTask;
+
+  std::vector<SedIterationLevel*> mLevels;
+
+  std::vector<std::string> mVariableIds;
+
+  std::vector<double> mVariableValues;
+
+  std::vector<Frame> mStack;
+
+  std::vector<std::vector<double> > mCurrent;
+
+  bool mStarted;
+
+  bool mValid;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+/**
+ * Creates a new SedIterationSpace for the given SedRepeatedTask and
+ * returns it.
+ */
+LIBSEDML_EXTERN
+SedIterationSpace_t *
+SedIterationSpace_create(const SedRepeatedTask_t *srt);
+
+
+/**
+ * Frees the given SedIterationSpace, created with
+ * SedIterationSpace_create().
+ */
+LIBSEDML_EXTERN
+void
+SedIterationSpace_free(SedIterationSpace_t *sis);
+
+
+/**
+ * Returns the number of iterations of the repeated task of @p sis.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedIterationSpace_getNumIterations(const SedIterationSpace_t *sis);
+
+
+/**
+ * Returns the value of the nth range of the repeated task of @p sis in
+ * the given iteration, or NaN.
+ */
+LIBSEDML_EXTERN
+double
+SedIterationSpace_getRangeValue(const SedIterationSpace_t *sis,
+                                unsigned int n,
+                                unsigned int iteration);
+
+
+/**
+ * Moves @p sis to its next step, returning @c 1 if there is one and
+ * @c 0 otherwise.
+ */
+LIBSEDML_EXTERN
+int
+SedIterationSpace_next(SedIterationSpace_t *sis);
+
+
+/**
+ * Returns the value of the given range in the current step of @p sis,
+ * or NaN.
+ */
+LIBSEDML_EXTERN
+double
+SedIterationSpace_getValue(const SedIterationSpace_t *sis,
+                           const char *rangeId);
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+
+#endif  /* SedIterationSpace_h */
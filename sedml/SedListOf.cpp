@@ -37,9 +37,13 @@
 
 #include <algorithm>
 #include <functional>
+#include <mutex>
 
 #include <sedml/SedVisitor.h>
 #include <sedml/SedListOf.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedStreamReader.h>
+#include <sedml/SedSnapshot.h>
 #include <sedml/common/common.h>
 
 /** @cond doxygen-ignored */
@@ -55,6 +59,9 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
  */
 SedListOf::SedListOf(unsigned int level, unsigned int version)
   : SedBase(level, version)
+  , mItems()
+  , mIdIndex()
+  , mIdIndexValid(false)
 {
   if (!hasValidLevelVersionNamespaceCombination())
     throw SedConstructorException();
@@ -66,6 +73,9 @@ SedListOf::SedListOf(unsigned int level, unsigned int version)
  */
 SedListOf::SedListOf(SedNamespaces* sbmlns)
   : SedBase(sbmlns)
+  , mItems()
+  , mIdIndex()
+  , mIdIndexValid(false)
 {
   if (!hasValidLevelVersionNamespaceCombination())
     throw SedConstructorException();
@@ -99,10 +109,26 @@ struct Clone : public unary_function<SedBase*, SedBase*>
 };
 
 
+/**
+ * Used by SedListOf::setSedDocument() and SedListOf::clear().
+ */
+struct SetSedDocument : public unary_function<SedBase*, void>
+{
+  SedDocument* d;
+
+  SetSedDocument(SedDocument* d) : d(d) { }
+  void operator()(SedBase* sbase) { sbase->setSedDocument(d); }
+};
+
+
 /*
  * Copy constructor. Creates a copy of this SedListOf items.
  */
-SedListOf::SedListOf(const SedListOf& orig) : SedBase(orig)
+SedListOf::SedListOf(const SedListOf& orig)
+  : SedBase(orig)
+  , mItems()
+  , mIdIndex()
+  , mIdIndexValid(false)
 {
   mItems.resize(orig.size());
   transform(orig.mItems.begin(), orig.mItems.end(), mItems.begin(), Clone());
@@ -122,6 +148,7 @@ SedListOf& SedListOf::operator=(const SedListOf& rhs)
       for_each(mItems.begin(), mItems.end(), Delete());
       mItems.resize(rhs.size());
       transform(rhs.mItems.begin(), rhs.mItems.end(), mItems.begin(), Clone());
+      invalidateIdIndex();
       connectToChild();
     }
 
@@ -182,6 +209,7 @@ SedListOf::insertAndOwn(int location, SedBase* item)
     {
       mItems.insert(mItems.begin() + location, item);
       item->connectToParent(this);
+      invalidateIdIndex();
       return LIBSEDML_OPERATION_SUCCESS;
     }
   else if (!isValidTypeForList(item))
@@ -192,6 +220,7 @@ SedListOf::insertAndOwn(int location, SedBase* item)
     {
       mItems.insert(mItems.begin() + location, item);
       item->connectToParent(this);
+      invalidateIdIndex();
       return LIBSEDML_OPERATION_SUCCESS;
     }
 }
@@ -219,6 +248,7 @@ SedListOf::appendAndOwn(SedBase* item)
     {
       mItems.push_back(item);
       item->connectToParent(this);
+      addToIdIndex(item);
       return LIBSEDML_OPERATION_SUCCESS;
     }
   else if (!isValidTypeForList(item))
@@ -229,6 +259,7 @@ SedListOf::appendAndOwn(SedBase* item)
     {
       mItems.push_back(item);
       item->connectToParent(this);
+      addToIdIndex(item);
       return LIBSEDML_OPERATION_SUCCESS;
     }
 }
@@ -279,6 +310,8 @@ SedListOf::getElementBySId(std::string id)
 {
   if (id.empty()) return NULL;
 
+  if (getSedDocument() != NULL) return SedBase::getElementBySId(id);
+
   for (unsigned int i = 0; i < size(); i++)
     {
       SedBase* obj = get(i);
@@ -301,6 +334,8 @@ SedListOf::getElementByMetaId(std::string metaid)
 {
   if (metaid.empty()) return NULL;
 
+  if (getSedDocument() != NULL) return SedBase::getElementByMetaId(metaid);
+
   for (unsigned int i = 0; i < size(); i++)
     {
       SedBase* obj = get(i);
@@ -387,8 +422,11 @@ SedListOf::clear(bool doDelete)
 {
   if (doDelete)
     for_each(mItems.begin(), mItems.end(), Delete());
+  else
+    for_each(mItems.begin(), mItems.end(), SetSedDocument(NULL));
 
   mItems.clear();
+  invalidateIdIndex();
 }
 
 int SedListOf::removeFromParentAndDelete()
@@ -412,7 +450,14 @@ SedListOf::remove(unsigned int n)
 {
   SedBase* item = get(n);
 
-  if (item != NULL) mItems.erase(mItems.begin() + n);
+  if (item != NULL)
+    {
+      mItems.erase(mItems.begin() + n);
+      invalidateIdIndex();
+
+      // the item is no longer part of the document
+      item->setSedDocument(NULL);
+    }
 
   return item;
 }
@@ -451,17 +496,66 @@ SedListOf::size() const
 }
 
 
+/** @cond doxygen-libsbml-internal */
 
-/**
- * Used by SedListOf::setSedDocument().
+/* guards building the id index of lists read from several threads */
+static std::mutex idIndexMutex;
+
+
+/*
+ * Returns the position of the first item with the given identifier,
+ * building the index of identifiers if needed.
  */
-struct SetSedDocument : public unary_function<SedBase*, void>
+int
+SedListOf::getIndexById(const std::string& sid) const
 {
-  SedDocument* d;
+  if (!mIdIndexValid.load(std::memory_order_acquire))
+    {
+      std::lock_guard<std::mutex> lock(idIndexMutex);
+
+      if (!mIdIndexValid.load(std::memory_order_relaxed))
+        {
+          mIdIndex.clear();
+          mIdIndex.reserve(mItems.size());
+
+          // emplace() keeps the first of several items with the same id
+          for (unsigned int n = 0; n < mItems.size(); ++n)
+            mIdIndex.emplace(mItems[n]->getId(), n);
+
+          mIdIndexValid.store(true, std::memory_order_release);
+        }
+    }
+
+  std::unordered_map<std::string, unsigned int>::const_iterator it =
+    mIdIndex.find(sid);
+
+  return (it == mIdIndex.end()) ? -1 : static_cast<int>(it->second);
+}
+
+
+/*
+ * Drops the index of the identifiers of the items.
+ */
+void
+SedListOf::invalidateIdIndex()
+{
+  mIdIndexValid.store(false, std::memory_order_relaxed);
+}
+
+
+/*
+ * Adds the item just appended to the index of identifiers, if there is
+ * one.
+ */
+void
+SedListOf::addToIdIndex(SedBase* item)
+{
+  if (mIdIndexValid.load(std::memory_order_relaxed))
+    mIdIndex.emplace(item->getId(), size() - 1);
+}
+
+/** @endcond */
 
-  SetSedDocument(SedDocument* d) : d(d) { }
-  void operator()(SedBase* sbase) { sbase->setSedDocument(d); }
-};
 
 
 /**
@@ -501,6 +595,38 @@ SedListOf::connectToChild()
 /** @endcond */
 
 
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Passes completely read top-level elements to the element callback of
+ * the document.
+ */
+void
+SedListOf::childElementRead(SedBase* child)
+{
+  SedDocument* doc = getSedDocument();
+
+  if (doc == NULL || doc->getElementCallback() == NULL) return;
+
+  // only the direct children of the listOf elements of the document
+  if (getParentSedObject() != doc) return;
+
+  if (doc->getElementCallback()->elementRead(child)) return;
+
+  // the element was just read, so it normally is the last one
+  for (unsigned int n = size(); n > 0; --n)
+    {
+      if (mItems[n - 1] == child)
+        {
+          delete remove(n - 1);
+          break;
+        }
+    }
+}
+
+/** @endcond */
+
+
 /*
  * @return the typecode (int) of this Sed object or SEDML_UNKNOWN
  * (default).
@@ -562,6 +688,46 @@ SedListOf::writeElements(XMLOutputStream& stream) const
 }
 /** @endcond */
 
+/** @cond doxygen-libsbml-internal */
+/*
+ * Writes the items of this list, each preceded by its type code, to a
+ * snapshot.
+ */
+void
+SedListOf::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedBase::writeSnapshot(writer);
+
+  writer.writeUInt(static_cast<unsigned int>(mItems.size()));
+
+  for (ListItem::const_iterator it = mItems.begin(); it != mItems.end(); ++it)
+    writer.writeObject(*it);
+}
+
+
+/*
+ * Reads the items of this list back from a snapshot.
+ */
+void
+SedListOf::readSnapshot(SedSnapshotReader& reader)
+{
+  SedBase::readSnapshot(reader);
+
+  unsigned int numItems = reader.readUInt();
+
+  for (unsigned int i = 0; i < numItems && reader.good(); ++i)
+    {
+      SedBase* item = reader.readObject(getSedNamespaces());
+
+      if (item == NULL || appendAndOwn(item) != LIBSEDML_OPERATION_SUCCESS)
+        {
+          delete item;
+          reader.setFailed();
+        }
+    }
+}
+/** @endcond */
+
 /** @cond doxygen-libsbml-internal */
 /**
  * Subclasses should override this method to get the list of
@@ -82,7 +82,10 @@
 
 #include <vector>
 #include <algorithm>
+#include <atomic>
 #include <functional>
+#include <string>
+#include <unordered_map>
 
 #include <sedml/SedBase.h>
 
@@ -394,6 +397,33 @@ public:
    */
   unsigned int size() const;
 
+
+  /** @cond doxygen-libsbml-internal */
+
+  /**
+   * Returns the position of the first item in this SedListOf with the
+   * given identifier.
+   *
+   * The positions are looked up in an index of the identifiers of the
+   * items, which is built on first use and then kept until the items of
+   * the list or their identifiers change.
+   *
+   * @param sid the identifier of the item sought.
+   *
+   * @return the position of the item, or @c -1 if no item has the
+   * identifier @p sid.
+   */
+  int getIndexById(const std::string& sid) const;
+
+
+  /**
+   * Drops the index of the identifiers of the items of this SedListOf,
+   * to be rebuilt when it is next needed.
+   */
+  void invalidateIdIndex();
+
+  /** @endcond */
+
   /** @cond doxygen-libsbml-internal */
 
   /**
@@ -505,6 +535,20 @@ public:
   /** @endcond */
 
 
+  /** @cond doxygen-libsbml-internal */
+  /**
+   * Writes the items of this list to a snapshot.
+   */
+  virtual void writeSnapshot(SedSnapshotWriter& writer) const;
+
+
+  /**
+   * Reads the items of this list back from a snapshot.
+   */
+  virtual void readSnapshot(SedSnapshotReader& reader);
+  /** @endcond */
+
+
 protected:
   /** @cond doxygen-libsbml-internal */
 
@@ -542,8 +586,27 @@ protected:
 
   virtual bool isValidTypeForList(SedBase * item) const;
 
+  /**
+   * Hands elements of the top-level lists of a SedDocument to the
+   * SedElementCallback of the document (if any), and deletes them if the
+   * callback does not keep them.
+   */
+  virtual void childElementRead(SedBase* child);
+
+  /**
+   * Adds the item just appended to the index of identifiers, if it has
+   * been built.
+   */
+  void addToIdIndex(SedBase* item);
+
   ListItem mItems;
 
+  /* maps the identifiers of the items to the position of the first item
+   * with that identifier; only up to date while mIdIndexValid is set
+   */
+  mutable std::unordered_map<std::string, unsigned int> mIdIndex;
+  mutable std::atomic<bool> mIdIndexValid;
+
   /** @endcond */
 };
 
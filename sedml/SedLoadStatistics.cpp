@@ -0,0 +1,359 @@
+/**
+ * @file    SedLoadStatistics.cpp
+ * @brief   Counters and timers for the phases of reading and writing documents
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedLoadStatistics.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+
+using namespace std;
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygen-libsedml-internal */
+
+static const char* SEDML_PHASE_NAMES[SEDML_NUM_PHASES] =
+{
+  "read",
+  "tokenize",
+  "construct",
+  "mathml",
+  "annotation",
+  "notes",
+  "namespaces",
+  "write",
+  "write_elements",
+  "write_mathml",
+  "compress"
+};
+
+
+/* the statistics recorded into, and the innermost phase timed, on each
+ * thread */
+static thread_local SedLoadStatistics* sCurrentStatistics = NULL;
+static thread_local SedPhaseTimer* sCurrentTimer = NULL;
+
+
+static double
+getClockSeconds()
+{
+  return chrono::duration<double>(
+           chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Creates a new, empty SedLoadStatistics.
+ */
+SedLoadStatistics::SedLoadStatistics()
+  : mOrigin(0)
+  , mTraceEnabled(false)
+  , mEvents()
+{
+  clear();
+}
+
+
+/*
+ * Predicate returning @c true if libSEDML was built with instrumentation.
+ */
+bool
+SedLoadStatistics::isEnabled()
+{
+#ifdef LIBSEDML_USE_INSTRUMENTATION
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+/*
+ * Returns the name of the given phase.
+ */
+const char*
+SedLoadStatistics::getPhaseName(SedPhase_t phase)
+{
+  if (phase < 0 || phase >= SEDML_NUM_PHASES)
+    return "unknown";
+
+  return SEDML_PHASE_NAMES[phase];
+}
+
+
+/*
+ * Resets all counters, timers and events to zero.
+ */
+void
+SedLoadStatistics::clear()
+{
+  for (int i = 0; i < SEDML_NUM_PHASES; ++i)
+    {
+      mCounts[i] = 0;
+      mSeconds[i] = 0;
+    }
+
+  mEvents.clear();
+  mOrigin = getClockSeconds();
+}
+
+
+/*
+ * Returns the number of times the given phase was entered.
+ */
+unsigned long long
+SedLoadStatistics::getCount(SedPhase_t phase) const
+{
+  if (phase < 0 || phase >= SEDML_NUM_PHASES)
+    return 0;
+
+  return mCounts[phase];
+}
+
+
+/*
+ * Returns the time spent in the given phase.
+ */
+double
+SedLoadStatistics::getSeconds(SedPhase_t phase) const
+{
+  if (phase < 0 || phase >= SEDML_NUM_PHASES)
+    return 0;
+
+  return mSeconds[phase];
+}
+
+
+/*
+ * Returns the time spent in all phases.
+ */
+double
+SedLoadStatistics::getTotalSeconds() const
+{
+  double total = 0;
+
+  for (int i = 0; i < SEDML_NUM_PHASES; ++i)
+    total += mSeconds[i];
+
+  return total;
+}
+
+
+/*
+ * Predicate returning @c true if phases are recorded as events.
+ */
+bool
+SedLoadStatistics::getTraceEnabled() const
+{
+  return mTraceEnabled;
+}
+
+
+/*
+ * Sets whether phases are recorded as events.
+ */
+void
+SedLoadStatistics::setTraceEnabled(bool enabled)
+{
+  mTraceEnabled = enabled;
+}
+
+
+/*
+ * Returns the number of events recorded.
+ */
+unsigned int
+SedLoadStatistics::getNumTraceEvents() const
+{
+  return (unsigned int)mEvents.size();
+}
+
+
+/*
+ * Writes the recorded events in the JSON format of the Chrome trace
+ * viewer.
+ */
+int
+SedLoadStatistics::writeChromeTrace(std::ostream& stream) const
+{
+  ios_base::fmtflags flags = stream.flags();
+  streamsize precision = stream.precision();
+
+  stream << fixed << setprecision(3)
+         << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+
+  for (size_t i = 0; i < mEvents.size(); ++i)
+    {
+      const Event& event = mEvents[i];
+      stream << (i == 0 ? "\n" : ",\n")
+             << "{\"name\": \"" << getPhaseName(event.phase)
+             << "\", \"cat\": \"sedml\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1"
+             << ", \"ts\": " << event.start * 1e6
+             << ", \"dur\": " << event.seconds * 1e6 << "}";
+    }
+
+  // the totals are not part of the format, and ignored by the viewer
+  stream << "\n], \"sedmlPhases\": {";
+
+  for (int i = 0; i < SEDML_NUM_PHASES; ++i)
+    {
+      stream << (i == 0 ? "\n" : ",\n")
+             << "\"" << SEDML_PHASE_NAMES[i] << "\": {\"count\": "
+             << mCounts[i] << ", \"seconds\": " << setprecision(9)
+             << mSeconds[i] << setprecision(3) << "}";
+    }
+
+  stream << "\n}}" << endl;
+
+  stream.flags(flags);
+  stream.precision(precision);
+  return stream.good() ? LIBSEDML_OPERATION_SUCCESS
+                       : LIBSEDML_OPERATION_FAILED;
+}
+
+
+/*
+ * Writes the recorded events to a file.
+ */
+int
+SedLoadStatistics::writeChromeTrace(const std::string& filename) const
+{
+  ofstream stream(filename.c_str());
+
+  if (!stream)
+    return LIBSEDML_OPERATION_FAILED;
+
+  return writeChromeTrace(stream);
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Records a phase.
+ */
+void
+SedLoadStatistics::record(SedPhase_t phase, double start, double seconds,
+                          double selfSeconds)
+{
+  ++mCounts[phase];
+  mSeconds[phase] += selfSeconds;
+
+  if (mTraceEnabled && phase != SEDML_PHASE_TOKENIZE)
+    {
+      Event event;
+      event.phase = phase;
+      event.start = start;
+      event.seconds = seconds;
+      mEvents.push_back(event);
+    }
+}
+
+
+/*
+ * Returns the time since the statistics were cleared.
+ */
+double
+SedLoadStatistics::getElapsed() const
+{
+  return getClockSeconds() - mOrigin;
+}
+
+
+SedStatisticsScope::SedStatisticsScope(SedLoadStatistics& statistics)
+  : mPrevious(sCurrentStatistics)
+  , mPreviousTimer(sCurrentTimer)
+{
+  if (sCurrentStatistics == &statistics)
+    return;
+
+  statistics.clear();
+  sCurrentStatistics = &statistics;
+  sCurrentTimer = NULL;
+}
+
+
+SedStatisticsScope::~SedStatisticsScope()
+{
+  sCurrentStatistics = mPrevious;
+  sCurrentTimer = mPreviousTimer;
+}
+
+
+SedPhaseTimer::SedPhaseTimer(SedPhase_t phase)
+  : mStatistics(sCurrentStatistics)
+  , mParent(sCurrentTimer)
+  , mPhase(phase)
+  , mStart(0)
+  , mNested(0)
+{
+  if (mStatistics == NULL)
+    return;
+
+  sCurrentTimer = this;
+  mStart = mStatistics->getElapsed();
+}
+
+
+SedPhaseTimer::~SedPhaseTimer()
+{
+  if (mStatistics == NULL)
+    return;
+
+  double seconds = mStatistics->getElapsed() - mStart;
+  mStatistics->record(mPhase, mStart, seconds, seconds - mNested);
+
+  if (mParent != NULL)
+    mParent->mNested += seconds;
+
+  sCurrentTimer = mParent;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+#endif  /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
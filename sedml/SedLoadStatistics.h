@@ -0,0 +1,338 @@
+/**
+ * @file    SedLoadStatistics.h
+ * @brief   Counters and timers for the phases of reading and writing documents
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedLoadStatistics
+ * @ingroup Core
+ * @brief Counters and timers for the phases of reading and writing a
+ * SedDocument.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * When libSEDML is configured with the CMake option
+ * @c WITH_INSTRUMENTATION, SedReader and SedWriter time the phases of
+ * their work, listed by #SedPhase_t: tokenizing the XML, constructing
+ * Sed objects, reading MathML, annotations and notes, checking
+ * namespaces, writing elements and MathML, and compressing.  Each phase
+ * is counted, and timed exclusive of the phases nested in it, so that
+ * the times of all phases add up to the time of the whole operation.
+ *
+ * The statistics of the last read of a document are returned by
+ * SedDocument::getLoadStatistics(), and those of the last write by
+ * SedWriter::getWriteStatistics().  When tracing is enabled, through
+ * SedReader::setTraceEnabled() or SedWriter::setTraceEnabled(), each
+ * phase is also recorded as an event, except for tokenizing, which is
+ * too fine grained, and the events can be written in the JSON format
+ * of the Chrome trace viewer.
+ *
+ * Without @c WITH_INSTRUMENTATION, nothing is counted or timed, at no
+ * cost, and all statistics are zero; isEnabled() tells which is the
+ * case.
+ */
+
+#ifndef SedLoadStatistics_h
+#define SedLoadStatistics_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/**
+ * @enum SedPhase_t
+ * The phases of reading and writing a document timed by
+ * SedLoadStatistics.
+ */
+typedef enum
+{
+    SEDML_PHASE_READ = 0        /*!< Reading, outside the other phases */
+  , SEDML_PHASE_TOKENIZE        /*!< Tokenizing the XML */
+  , SEDML_PHASE_CONSTRUCT       /*!< Constructing and reading Sed objects */
+  , SEDML_PHASE_MATHML          /*!< Reading MathML */
+  , SEDML_PHASE_ANNOTATION      /*!< Reading annotations */
+  , SEDML_PHASE_NOTES           /*!< Reading notes */
+  , SEDML_PHASE_NAMESPACES      /*!< Checking namespaces */
+  , SEDML_PHASE_WRITE           /*!< Writing, outside the other phases */
+  , SEDML_PHASE_WRITE_ELEMENTS  /*!< Writing Sed objects */
+  , SEDML_PHASE_WRITE_MATHML    /*!< Writing MathML */
+  , SEDML_PHASE_COMPRESS        /*!< Compressing the output */
+  , SEDML_NUM_PHASES            /*!< The number of phases */
+} SedPhase_t;
+
+LIBSEDML_CPP_NAMESPACE_END
+
+
+#ifdef __cplusplus
+
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedLoadStatistics
+{
+public:
+
+  /**
+   * Creates a new, empty SedLoadStatistics.
+   */
+  SedLoadStatistics();
+
+
+  /**
+   * Predicate returning @c true if libSEDML was built with
+   * instrumentation.
+   *
+   * @return @c true if phases are counted and timed, @c false if all
+   * statistics stay zero.
+   */
+  static bool isEnabled();
+
+
+  /**
+   * Returns the name of the given phase.
+   *
+   * @param phase the #SedPhase_t.
+   *
+   * @return the name, such as "mathml", or "unknown" if @p phase is out
+   * of range.
+   */
+  static const char* getPhaseName(SedPhase_t phase);
+
+
+  /**
+   * Resets all counters, timers and events to zero; whether tracing is
+   * enabled is kept.
+   */
+  void clear();
+
+
+  /**
+   * Returns the number of times the given phase was entered.
+   *
+   * @param phase the #SedPhase_t.
+   *
+   * @return the count, or @c 0 if @p phase is out of range.
+   */
+  unsigned long long getCount(SedPhase_t phase) const;
+
+
+  /**
+   * Returns the time spent in the given phase, exclusive of the phases
+   * nested in it.
+   *
+   * @param phase the #SedPhase_t.
+   *
+   * @return the time in seconds, or @c 0 if @p phase is out of range.
+   */
+  double getSeconds(SedPhase_t phase) const;
+
+
+  /**
+   * Returns the time spent in all phases.
+   *
+   * @return the time in seconds of the operations timed.
+   */
+  double getTotalSeconds() const;
+
+
+  /**
+   * Predicate returning @c true if phases are recorded as events.
+   *
+   * @return @c true if tracing is enabled, @c false otherwise.
+   */
+  bool getTraceEnabled() const;
+
+
+  /**
+   * Sets whether phases are recorded as events.
+   *
+   * @param enabled @c true to record events, which costs memory for each
+   * element read or written.
+   */
+  void setTraceEnabled(bool enabled);
+
+
+  /**
+   * Returns the number of events recorded.
+   *
+   * @return the number of events.
+   */
+  unsigned int getNumTraceEvents() const;
+
+
+  /**
+   * Writes the recorded events in the JSON format of the Chrome trace
+   * viewer, along with the counters and timers of all phases.
+   *
+   * @param stream the stream to write to.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_OPERATION_FAILED
+   */
+  int writeChromeTrace(std::ostream& stream) const;
+
+
+  /**
+   * Writes the recorded events to a file, in the JSON format of the
+   * Chrome trace viewer.
+   *
+   * @param filename the name of the file to write.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_OPERATION_FAILED
+   */
+  int writeChromeTrace(const std::string& filename) const;
+
+
+  /** @cond doxygen-libsedml-internal */
+
+  /*
+   * Records a phase that started at the given time, in seconds since the
+   * statistics were cleared, and lasted the given time, of which the
+   * given time was spent outside nested phases.
+   */
+  void record(SedPhase_t phase, double start, double seconds,
+              double selfSeconds);
+
+  /*
+   * Returns the time, in seconds since the statistics were cleared.
+   */
+  double getElapsed() const;
+
+  /** @endcond doxygen-libsedml-internal */
+
+
+protected:
+
+  /** @cond doxygen-libsedml-internal */
+
+  struct Event
+  {
+    SedPhase_t phase;
+    double start;
+    double seconds;
+  };
+
+  unsigned long long mCounts[SEDML_NUM_PHASES];
+
+  double mSeconds[SEDML_NUM_PHASES];
+
+  double mOrigin;
+
+  bool mTraceEnabled;
+
+  std::vector<Event> mEvents;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+/** @cond doxygen-libsedml-internal */
+
+class SedPhaseTimer;
+
+/*
+ * Makes the given statistics those recorded into by the phases timed on
+ * this thread, for the lifetime of the scope; the statistics are cleared
+ * unless they are already being recorded into.
+ */
+class LIBSEDML_EXTERN SedStatisticsScope
+{
+public:
+  SedStatisticsScope(SedLoadStatistics& statistics);
+
+  ~SedStatisticsScope();
+
+private:
+  SedStatisticsScope(const SedStatisticsScope&);
+  SedStatisticsScope& operator=(const SedStatisticsScope&);
+
+  SedLoadStatistics* mPrevious;
+  SedPhaseTimer* mPreviousTimer;
+};
+
+
+/*
+ * Times a phase for the lifetime of the scope, into the statistics of
+ * the current SedStatisticsScope, if any.
+ */
+class LIBSEDML_EXTERN SedPhaseTimer
+{
+public:
+  SedPhaseTimer(SedPhase_t phase);
+
+  ~SedPhaseTimer();
+
+private:
+  SedPhaseTimer(const SedPhaseTimer&);
+  SedPhaseTimer& operator=(const SedPhaseTimer&);
+
+  SedLoadStatistics* mStatistics;
+  SedPhaseTimer* mParent;
+  SedPhase_t mPhase;
+  double mStart;
+  double mNested;
+};
+
+
+#ifdef LIBSEDML_USE_INSTRUMENTATION
+#define SEDML_COLLECT_STATISTICS(statistics) \
+  SedStatisticsScope sedml_statistics_scope(statistics)
+#define SEDML_TIME_PHASE(phase) \
+  SedPhaseTimer sedml_phase_timer(phase)
+#else
+#define SEDML_COLLECT_STATISTICS(statistics)
+#define SEDML_TIME_PHASE(phase)
+#endif
+
+/** @endcond doxygen-libsedml-internal */
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedLoadStatistics_h */
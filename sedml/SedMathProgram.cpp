@@ -0,0 +1,1276 @@
+/**
+ * @file    SedMathProgram.cpp
+ * @brief   Compiled, vectorized evaluator for Sed math
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedMathProgram.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedVariable.h>
+#include <sedml/SedParameter.h>
+
+#include <sbml/math/ASTNode.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <new>
+
+using namespace std;
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * The number of points evaluated by each instruction in one pass; the
+ * registers of a block are small enough to stay in the cache.
+ */
+static const size_t SEDML_MATH_BLOCK_SIZE = 256;
+
+static const double SEDML_MATH_PI = 3.14159265358979323846;
+
+static const double SEDML_MATH_AVOGADRO = 6.02214179e23;
+
+enum SedMathOpcode
+{
+  /* loads */
+  OP_INPUT,
+  OP_CONST,
+  OP_AGGREGATE,
+
+  /* unary operations */
+  OP_NEG,
+  OP_NOT,
+  OP_ABS,
+  OP_EXP,
+  OP_LN,
+  OP_LOG10,
+  OP_SQRT,
+  OP_FLOOR,
+  OP_CEIL,
+  OP_FACTORIAL,
+  OP_SIN,
+  OP_COS,
+  OP_TAN,
+  OP_SEC,
+  OP_CSC,
+  OP_COT,
+  OP_SINH,
+  OP_COSH,
+  OP_TANH,
+  OP_SECH,
+  OP_CSCH,
+  OP_COTH,
+  OP_ASIN,
+  OP_ACOS,
+  OP_ATAN,
+  OP_ASEC,
+  OP_ACSC,
+  OP_ACOT,
+  OP_ASINH,
+  OP_ACOSH,
+  OP_ATANH,
+  OP_ASECH,
+  OP_ACSCH,
+  OP_ACOTH,
+
+  /* binary operations */
+  OP_ADD,
+  OP_SUB,
+  OP_MUL,
+  OP_DIV,
+  OP_POW,
+  OP_ROOT,
+  OP_LOG,
+  OP_MIN,
+  OP_MAX,
+  OP_QUOTIENT,
+  OP_REM,
+  OP_EQ,
+  OP_NEQ,
+  OP_GT,
+  OP_GEQ,
+  OP_LT,
+  OP_LEQ,
+  OP_AND,
+  OP_OR,
+  OP_XOR,
+  OP_IMPLIES,
+
+  /* ternary operations */
+  OP_SELECT,
+
+  /* copies a register to an output */
+  OP_STORE
+};
+
+enum SedMathAggregate
+{
+  AGGREGATE_SUM,
+  AGGREGATE_PRODUCT,
+  AGGREGATE_MIN,
+  AGGREGATE_MAX
+};
+
+
+static bool
+isUnary(int op)
+{
+  return op >= OP_NEG && op <= OP_ACOTH;
+}
+
+
+static unsigned int
+getNumOperands(int op)
+{
+  if (isUnary(op))
+    return 1;
+
+  if (op == OP_SELECT)
+    return 3;
+
+  if (op >= OP_ADD && op < OP_SELECT)
+    return 2;
+
+  return 0;
+}
+
+
+static double
+applyUnary(int op, double x)
+{
+  switch (op)
+    {
+    case OP_NEG:       return -x;
+    case OP_NOT:       return x == 0.0 ? 1.0 : 0.0;
+    case OP_ABS:       return fabs(x);
+    case OP_EXP:       return exp(x);
+    case OP_LN:        return log(x);
+    case OP_LOG10:     return log10(x);
+    case OP_SQRT:      return sqrt(x);
+    case OP_FLOOR:     return floor(x);
+    case OP_CEIL:      return ceil(x);
+    case OP_FACTORIAL: return tgamma(x + 1.0);
+    case OP_SIN:       return sin(x);
+    case OP_COS:       return cos(x);
+    case OP_TAN:       return tan(x);
+    case OP_SEC:       return 1.0 / cos(x);
+    case OP_CSC:       return 1.0 / sin(x);
+    case OP_COT:       return 1.0 / tan(x);
+    case OP_SINH:      return sinh(x);
+    case OP_COSH:      return cosh(x);
+    case OP_TANH:      return tanh(x);
+    case OP_SECH:      return 1.0 / cosh(x);
+    case OP_CSCH:      return 1.0 / sinh(x);
+    case OP_COTH:      return 1.0 / tanh(x);
+    case OP_ASIN:      return asin(x);
+    case OP_ACOS:      return acos(x);
+    case OP_ATAN:      return atan(x);
+    case OP_ASEC:      return acos(1.0 / x);
+    case OP_ACSC:      return asin(1.0 / x);
+    case OP_ACOT:      return atan(1.0 / x);
+    case OP_ASINH:     return asinh(x);
+    case OP_ACOSH:     return acosh(x);
+    case OP_ATANH:     return atanh(x);
+    case OP_ASECH:     return acosh(1.0 / x);
+    case OP_ACSCH:     return asinh(1.0 / x);
+    case OP_ACOTH:     return atanh(1.0 / x);
+    default:           return numeric_limits<double>::quiet_NaN();
+    }
+}
+
+
+static double
+applyBinary(int op, double x, double y)
+{
+  switch (op)
+    {
+    case OP_ADD:      return x + y;
+    case OP_SUB:      return x - y;
+    case OP_MUL:      return x * y;
+    case OP_DIV:      return x / y;
+    case OP_POW:      return pow(x, y);
+    case OP_ROOT:     return pow(y, 1.0 / x);
+    case OP_LOG:      return log(y) / log(x);
+    case OP_MIN:      return y < x ? y : x;
+    case OP_MAX:      return y > x ? y : x;
+    case OP_QUOTIENT: return floor(x / y);
+    case OP_REM:      return fmod(x, y);
+    case OP_EQ:       return x == y ? 1.0 : 0.0;
+    case OP_NEQ:      return x != y ? 1.0 : 0.0;
+    case OP_GT:       return x > y ? 1.0 : 0.0;
+    case OP_GEQ:      return x >= y ? 1.0 : 0.0;
+    case OP_LT:       return x < y ? 1.0 : 0.0;
+    case OP_LEQ:      return x <= y ? 1.0 : 0.0;
+    case OP_AND:      return (x != 0.0 && y != 0.0) ? 1.0 : 0.0;
+    case OP_OR:       return (x != 0.0 || y != 0.0) ? 1.0 : 0.0;
+    case OP_XOR:      return ((x != 0.0) != (y != 0.0)) ? 1.0 : 0.0;
+    case OP_IMPLIES:  return (x == 0.0 || y != 0.0) ? 1.0 : 0.0;
+    default:          return numeric_limits<double>::quiet_NaN();
+    }
+}
+
+
+/*
+ * The loops below take their operation as a functor, so that simple
+ * operations are inlined into a loop the compiler can vectorize.
+ */
+template <typename Function>
+static void
+unaryLoop(double* dst, const double* x, size_t n, Function f)
+{
+  for (size_t i = 0; i < n; ++i)
+    dst[i] = f(x[i]);
+}
+
+
+template <typename Function>
+static void
+binaryLoop(double* dst, const double* x, const double* y, size_t n,
+           Function f)
+{
+  for (size_t i = 0; i < n; ++i)
+    dst[i] = f(x[i], y[i]);
+}
+
+
+/*
+ * Returns the aggregate named by an AST_FUNCTION or csymbol node, taken
+ * from the fragment of its definitionURL (as in
+ * "http://sed-ml.org/#sum") or else from its name; returns -1 if the
+ * node is no aggregate.
+ */
+static int
+getAggregate(const ASTNode* node)
+{
+  string name = node->getDefinitionURLString();
+  string::size_type pos = name.rfind('#');
+
+  if (pos != string::npos)
+    name = name.substr(pos + 1);
+  else if (node->getName() != NULL)
+    name = node->getName();
+
+  if (name == "sum")     return AGGREGATE_SUM;
+
+  if (name == "product") return AGGREGATE_PRODUCT;
+
+  if (name == "min")     return AGGREGATE_MIN;
+
+  if (name == "max")     return AGGREGATE_MAX;
+
+  return -1;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Creates a new, empty SedMathProgram.
+ */
+SedMathProgram::SedMathProgram()
+  : mInputIds()
+  , mBindings(NULL)
+  , mConstants(NULL)
+  , mValues()
+  , mValueNumbers()
+  , mOutputs()
+  , mCode()
+  , mAggregates()
+  , mNumRegisters(0)
+{
+}
+
+
+/*
+ * Destroys this SedMathProgram.
+ */
+SedMathProgram::~SedMathProgram()
+{
+}
+
+
+/*
+ * Compiles the math of the given SedDataGenerator.
+ */
+int
+SedMathProgram::compile(const SedDataGenerator* dataGenerator)
+{
+  if (dataGenerator == NULL)
+    {
+      clear();
+      return LIBSEDML_INVALID_OBJECT;
+    }
+
+  vector<string> inputIds;
+
+  for (unsigned int i = 0; i < dataGenerator->getNumVariables(); ++i)
+    inputIds.push_back(dataGenerator->getVariable(i)->getId());
+
+  map<string, double> constants;
+
+  for (unsigned int i = 0; i < dataGenerator->getNumParameters(); ++i)
+    {
+      const SedParameter* p = dataGenerator->getParameter(i);
+      constants[p->getId()] = p->getValue();
+    }
+
+  return compile(dataGenerator->getMath(), inputIds, constants);
+}
+
+
+/*
+ * Compiles the given math.
+ */
+int
+SedMathProgram::compile(const ASTNode* math,
+                        const std::vector<std::string>& inputIds,
+                        const std::map<std::string, double>& constants)
+{
+  clear();
+
+  if (math == NULL)
+    return LIBSEDML_INVALID_OBJECT;
+
+  mInputIds = inputIds;
+
+  map<string, unsigned int> inputs;
+
+  for (unsigned int i = 0; i < inputIds.size(); ++i)
+    inputs.insert(make_pair(inputIds[i], i));
+
+  int status = addOutput(math, inputs, constants);
+
+  if (status < 0)
+    {
+      clear();
+      return status;
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Adds the given math as a further output of this SedMathProgram.
+ */
+int
+SedMathProgram::addOutput(const ASTNode* math,
+                          const std::map<std::string, unsigned int>& inputs,
+                          const std::map<std::string, double>& constants)
+{
+  if (math == NULL)
+    return LIBSEDML_INVALID_OBJECT;
+
+  for (map<string, unsigned int>::const_iterator it = inputs.begin();
+       it != inputs.end(); ++it)
+  {
+    if (it->second >= mInputIds.size())
+      mInputIds.resize(it->second + 1);
+
+    if (mInputIds[it->second].empty())
+      mInputIds[it->second] = it->first;
+  }
+
+  mBindings = &inputs;
+  mConstants = &constants;
+  int value = compileNode(math);
+  mBindings = NULL;
+  mConstants = NULL;
+
+  // values compiled before a failure are not used by any output, and
+  // disappear when registers are allocated
+  if (value < 0)
+    return LIBSEDML_OPERATION_FAILED;
+
+  mOutputs.push_back((unsigned int)value);
+  allocateRegisters();
+  return (int)mOutputs.size() - 1;
+}
+
+
+/*
+ * Returns true if this SedMathProgram has been compiled.
+ */
+bool
+SedMathProgram::isCompiled() const
+{
+  return !mOutputs.empty();
+}
+
+
+/*
+ * Returns the number of inputs of this SedMathProgram.
+ */
+unsigned int
+SedMathProgram::getNumInputs() const
+{
+  return (unsigned int)mInputIds.size();
+}
+
+
+/*
+ * Returns the identifier bound to the nth input.
+ */
+const std::string&
+SedMathProgram::getInputId(unsigned int n) const
+{
+  static const string empty;
+  return n < mInputIds.size() ? mInputIds[n] : empty;
+}
+
+
+/*
+ * Returns the index of the input bound to the given identifier.
+ */
+int
+SedMathProgram::getInputIndex(const std::string& sid) const
+{
+  vector<string>::const_iterator it =
+    find(mInputIds.begin(), mInputIds.end(), sid);
+  return it == mInputIds.end() ? -1 : (int)(it - mInputIds.begin());
+}
+
+
+/*
+ * Returns the number of outputs of this SedMathProgram.
+ */
+unsigned int
+SedMathProgram::getNumOutputs() const
+{
+  return (unsigned int)mOutputs.size();
+}
+
+
+/*
+ * Returns the number of instructions of this SedMathProgram.
+ */
+unsigned int
+SedMathProgram::getNumInstructions() const
+{
+  unsigned int count = 0;
+
+  for (size_t i = 0; i < mCode.size(); ++i)
+    if (mCode[i].op != OP_STORE)
+      ++count;
+
+  return count;
+}
+
+
+/*
+ * Evaluates this SedMathProgram at a single point.
+ */
+double
+SedMathProgram::evaluate(const double* inputs) const
+{
+  vector<const double*> columns(mInputIds.size());
+
+  for (size_t i = 0; i < columns.size(); ++i)
+    columns[i] = inputs != NULL ? inputs + i : NULL;
+
+  double result;
+
+  if (evaluate(columns.empty() ? NULL : &columns[0], 1, &result)
+      != LIBSEDML_OPERATION_SUCCESS)
+    return numeric_limits<double>::quiet_NaN();
+
+  return result;
+}
+
+
+/*
+ * Evaluates the first output of this SedMathProgram over arrays of
+ * points.
+ */
+int
+SedMathProgram::evaluate(const double* const* inputs, size_t numPoints,
+                         double* result) const
+{
+  return run(inputs, numPoints, &result, 1);
+}
+
+
+/*
+ * Evaluates all outputs of this SedMathProgram over arrays of points.
+ */
+int
+SedMathProgram::evaluate(const double* const* inputs, size_t numPoints,
+                         double* const* results) const
+{
+  return run(inputs, numPoints, results, mOutputs.size());
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Runs the instructions over all points, storing the first numResults
+ * outputs.
+ */
+int
+SedMathProgram::run(const double* const* inputs, size_t numPoints,
+                    double* const* results, size_t numResults) const
+{
+  if (mOutputs.empty() || (numPoints > 0 && results == NULL))
+    return LIBSEDML_INVALID_OBJECT;
+
+  for (size_t k = 0; numPoints > 0 && k < numResults; ++k)
+    if (results[k] == NULL)
+      return LIBSEDML_INVALID_OBJECT;
+
+  if (!mInputIds.empty() && numPoints > 0)
+    {
+      if (inputs == NULL)
+        return LIBSEDML_INVALID_OBJECT;
+
+      for (size_t i = 0; i < mInputIds.size(); ++i)
+        if (inputs[i] == NULL)
+          return LIBSEDML_INVALID_OBJECT;
+    }
+
+  if (numPoints == 0)
+    return LIBSEDML_OPERATION_SUCCESS;
+
+  // aggregates are reduced over all points before the first block
+  vector<double> aggregates(mAggregates.size());
+
+  if (!mAggregates.empty())
+    {
+      vector<double> values(numPoints);
+      double* column = &values[0];
+
+      for (vector<Instruction>::const_iterator it = mCode.begin();
+           it != mCode.end(); ++it)
+      {
+        if (it->op != OP_AGGREGATE)
+          continue;
+
+        int status = mAggregates[it->a]->run(inputs, numPoints, &column, 1);
+
+        if (status != LIBSEDML_OPERATION_SUCCESS)
+          return status;
+
+        double v = values[0];
+
+        for (size_t i = 1; i < numPoints; ++i)
+          {
+            switch (it->b)
+              {
+              case AGGREGATE_SUM:     v += values[i]; break;
+              case AGGREGATE_PRODUCT: v *= values[i]; break;
+              case AGGREGATE_MIN:     v = values[i] < v ? values[i] : v; break;
+              default:                v = values[i] > v ? values[i] : v; break;
+              }
+          }
+
+        aggregates[it->a] = v;
+      }
+    }
+
+  size_t block = min(numPoints, SEDML_MATH_BLOCK_SIZE);
+  vector<double> buffer(mNumRegisters * block);
+  vector<const double*> regs(mNumRegisters);
+
+  for (size_t start = 0; start < numPoints; start += block)
+    {
+      size_t n = min(block, numPoints - start);
+
+      for (vector<Instruction>::const_iterator it = mCode.begin();
+           it != mCode.end(); ++it)
+      {
+        const Instruction& ins = *it;
+        double* d = &buffer[ins.dst * block];
+        const double* x = ins.op > OP_AGGREGATE ? regs[ins.a] : NULL;
+
+        switch (ins.op)
+          {
+          case OP_INPUT:
+            // inputs are read in place
+            regs[ins.dst] = inputs[ins.a] + start;
+            continue;
+          case OP_STORE:
+            // the output of a program with a single output is stored last,
+            // so that it may overwrite an input column
+            if (ins.b < numResults && x != results[ins.b] + start)
+              copy(x, x + n, results[ins.b] + start);
+
+            continue;
+          case OP_CONST:
+            fill(d, d + n, ins.value);
+            break;
+          case OP_AGGREGATE:
+            fill(d, d + n, aggregates[ins.a]);
+            break;
+          case OP_NEG:
+            unaryLoop(d, x, n, [](double v) { return -v; });
+            break;
+          case OP_ABS:
+            unaryLoop(d, x, n, [](double v) { return v < 0.0 ? -v : v; });
+            break;
+          case OP_ADD:
+            binaryLoop(d, x, regs[ins.b], n,
+                       [](double u, double v) { return u + v; });
+            break;
+          case OP_SUB:
+            binaryLoop(d, x, regs[ins.b], n,
+                       [](double u, double v) { return u - v; });
+            break;
+          case OP_MUL:
+            binaryLoop(d, x, regs[ins.b], n,
+                       [](double u, double v) { return u * v; });
+            break;
+          case OP_DIV:
+            binaryLoop(d, x, regs[ins.b], n,
+                       [](double u, double v) { return u / v; });
+            break;
+          case OP_MIN:
+            binaryLoop(d, x, regs[ins.b], n,
+                       [](double u, double v) { return v < u ? v : u; });
+            break;
+          case OP_MAX:
+            binaryLoop(d, x, regs[ins.b], n,
+                       [](double u, double v) { return v > u ? v : u; });
+            break;
+          case OP_SELECT:
+            {
+              const double* b = regs[ins.b];
+              const double* c = regs[ins.c];
+
+              for (size_t i = 0; i < n; ++i)
+                d[i] = x[i] != 0.0 ? b[i] : c[i];
+            }
+            break;
+          default:
+            {
+              int op = ins.op;
+
+              if (isUnary(op))
+                unaryLoop(d, x, n,
+                          [op](double v) { return applyUnary(op, v); });
+              else
+                binaryLoop(d, x, regs[ins.b], n, [op](double u, double v)
+                           { return applyBinary(op, u, v); });
+            }
+            break;
+          }
+
+        regs[ins.dst] = d;
+      }
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Resets this SedMathProgram to the empty state.
+ */
+void
+SedMathProgram::clear()
+{
+  mInputIds.clear();
+  mValues.clear();
+  mValueNumbers.clear();
+  mOutputs.clear();
+  mCode.clear();
+  mAggregates.clear();
+  mNumRegisters = 0;
+}
+
+
+/*
+ * Emits the code computing the given node, and returns the value
+ * holding the result, or -1 if the node cannot be compiled.
+ */
+int
+SedMathProgram::compileNode(const ASTNode* node)
+{
+  if (node == NULL)
+    return -1;
+
+  unsigned int numChildren = node->getNumChildren();
+
+  switch (node->getType())
+    {
+    case AST_INTEGER:
+      return emitConstant((double)node->getInteger());
+
+    case AST_REAL:
+    case AST_REAL_E:
+    case AST_RATIONAL:
+      return emitConstant(node->getReal());
+
+    case AST_CONSTANT_E:
+      return emitConstant(exp(1.0));
+
+    case AST_CONSTANT_PI:
+      return emitConstant(SEDML_MATH_PI);
+
+    case AST_CONSTANT_TRUE:
+      return emitConstant(1.0);
+
+    case AST_CONSTANT_FALSE:
+      return emitConstant(0.0);
+
+    case AST_NAME_AVOGADRO:
+      return emitConstant(SEDML_MATH_AVOGADRO);
+
+    case AST_NAME:
+    case AST_NAME_TIME:
+      {
+        if (node->getName() == NULL)
+          return -1;
+
+        string name = node->getName();
+        map<string, unsigned int>::const_iterator input =
+          mBindings->find(name);
+
+        if (input != mBindings->end())
+          return emit(OP_INPUT, input->second);
+
+        map<string, double>::const_iterator it = mConstants->find(name);
+
+        if (it == mConstants->end())
+          return -1;
+
+        return emitConstant(it->second);
+      }
+
+    case AST_PLUS:
+      return compileFold(node, OP_ADD);
+
+    case AST_TIMES:
+      return compileFold(node, OP_MUL);
+
+    case AST_LOGICAL_AND:
+      return compileFold(node, OP_AND);
+
+    case AST_LOGICAL_OR:
+      return compileFold(node, OP_OR);
+
+    case AST_LOGICAL_XOR:
+      return compileFold(node, OP_XOR);
+
+    case AST_FUNCTION_MIN:
+      if (numChildren == 1)
+        return compileAggregate(node, AGGREGATE_MIN);
+
+      return numChildren > 1 ? compileFold(node, OP_MIN) : -1;
+
+    case AST_FUNCTION_MAX:
+      if (numChildren == 1)
+        return compileAggregate(node, AGGREGATE_MAX);
+
+      return numChildren > 1 ? compileFold(node, OP_MAX) : -1;
+
+    case AST_FUNCTION:
+    case AST_CSYMBOL_FUNCTION:
+      {
+        int aggregate = getAggregate(node);
+
+        if (aggregate < 0 || numChildren != 1)
+          return -1;
+
+        return compileAggregate(node, aggregate);
+      }
+
+    case AST_RELATIONAL_EQ:
+      return compileComparison(node, OP_EQ);
+
+    case AST_RELATIONAL_NEQ:
+      return compileComparison(node, OP_NEQ);
+
+    case AST_RELATIONAL_GT:
+      return compileComparison(node, OP_GT);
+
+    case AST_RELATIONAL_GEQ:
+      return compileComparison(node, OP_GEQ);
+
+    case AST_RELATIONAL_LT:
+      return compileComparison(node, OP_LT);
+
+    case AST_RELATIONAL_LEQ:
+      return compileComparison(node, OP_LEQ);
+
+    case AST_FUNCTION_PIECEWISE:
+      {
+        // the otherwise value, or NaN, is selected from the last piece to
+        // the first, so that the first matching condition wins
+        int result = numChildren % 2 == 1
+                     ? compileNode(node->getChild(numChildren - 1))
+                     : emitConstant(numeric_limits<double>::quiet_NaN());
+
+        for (unsigned int i = numChildren / 2; i > 0 && result >= 0; --i)
+          {
+            int value = compileNode(node->getChild(2 * i - 2));
+            int condition = compileNode(node->getChild(2 * i - 1));
+
+            if (value < 0 || condition < 0)
+              return -1;
+
+            result = emit(OP_SELECT, condition, value, result);
+          }
+
+        return result;
+      }
+
+    default:
+      break;
+    }
+
+  // the remaining operations take one or two arguments
+  int op = -1;
+
+  switch (node->getType())
+    {
+    case AST_MINUS:
+      op = numChildren == 1 ? OP_NEG : OP_SUB;
+      break;
+    case AST_DIVIDE:            op = OP_DIV;      break;
+    case AST_POWER:
+    case AST_FUNCTION_POWER:    op = OP_POW;      break;
+    case AST_FUNCTION_ROOT:
+      op = numChildren == 1 ? OP_SQRT : OP_ROOT;
+      break;
+    case AST_FUNCTION_LOG:
+      op = numChildren == 1 ? OP_LOG10 : OP_LOG;
+      break;
+    case AST_FUNCTION_QUOTIENT: op = OP_QUOTIENT; break;
+    case AST_FUNCTION_REM:      op = OP_REM;      break;
+    case AST_LOGICAL_IMPLIES:   op = OP_IMPLIES;  break;
+    case AST_LOGICAL_NOT:       op = OP_NOT;      break;
+    case AST_FUNCTION_ABS:      op = OP_ABS;      break;
+    case AST_FUNCTION_EXP:      op = OP_EXP;      break;
+    case AST_FUNCTION_LN:       op = OP_LN;       break;
+    case AST_FUNCTION_FLOOR:    op = OP_FLOOR;    break;
+    case AST_FUNCTION_CEILING:  op = OP_CEIL;     break;
+    case AST_FUNCTION_FACTORIAL: op = OP_FACTORIAL; break;
+    case AST_FUNCTION_SIN:      op = OP_SIN;      break;
+    case AST_FUNCTION_COS:      op = OP_COS;      break;
+    case AST_FUNCTION_TAN:      op = OP_TAN;      break;
+    case AST_FUNCTION_SEC:      op = OP_SEC;      break;
+    case AST_FUNCTION_CSC:      op = OP_CSC;      break;
+    case AST_FUNCTION_COT:      op = OP_COT;      break;
+    case AST_FUNCTION_SINH:     op = OP_SINH;     break;
+    case AST_FUNCTION_COSH:     op = OP_COSH;     break;
+    case AST_FUNCTION_TANH:     op = OP_TANH;     break;
+    case AST_FUNCTION_SECH:     op = OP_SECH;     break;
+    case AST_FUNCTION_CSCH:     op = OP_CSCH;     break;
+    case AST_FUNCTION_COTH:     op = OP_COTH;     break;
+    case AST_FUNCTION_ARCSIN:   op = OP_ASIN;     break;
+    case AST_FUNCTION_ARCCOS:   op = OP_ACOS;     break;
+    case AST_FUNCTION_ARCTAN:   op = OP_ATAN;     break;
+    case AST_FUNCTION_ARCSEC:   op = OP_ASEC;     break;
+    case AST_FUNCTION_ARCCSC:   op = OP_ACSC;     break;
+    case AST_FUNCTION_ARCCOT:   op = OP_ACOT;     break;
+    case AST_FUNCTION_ARCSINH:  op = OP_ASINH;    break;
+    case AST_FUNCTION_ARCCOSH:  op = OP_ACOSH;    break;
+    case AST_FUNCTION_ARCTANH:  op = OP_ATANH;    break;
+    case AST_FUNCTION_ARCSECH:  op = OP_ASECH;    break;
+    case AST_FUNCTION_ARCCSCH:  op = OP_ACSCH;    break;
+    case AST_FUNCTION_ARCCOTH:  op = OP_ACOTH;    break;
+    default:
+      // delay, rateOf, lambda and user defined functions have no value here
+      return -1;
+    }
+
+  if (isUnary(op))
+    {
+      int x = numChildren == 1 ? compileNode(node->getChild(0)) : -1;
+      return x < 0 ? -1 : emit(op, x);
+    }
+
+  if (numChildren != 2)
+    return -1;
+
+  int x = compileNode(node->getChild(0));
+  int y = compileNode(node->getChild(1));
+  return (x < 0 || y < 0) ? -1 : emit(op, x, y);
+}
+
+
+/*
+ * Compiles the single argument of an aggregate function into a separate
+ * program, reduced over all points before evaluation; the same argument
+ * is only reduced once.
+ */
+int
+SedMathProgram::compileAggregate(const ASTNode* node, int op)
+{
+  shared_ptr<SedMathProgram> argument(new SedMathProgram());
+  argument->mInputIds = mInputIds;
+
+  if (argument->addOutput(node->getChild(0), *mBindings, *mConstants) < 0)
+    return -1;
+
+  size_t index = 0;
+
+  while (index < mAggregates.size() &&
+         !isSameProgram(*mAggregates[index], *argument))
+    ++index;
+
+  if (index == mAggregates.size())
+    mAggregates.push_back(argument);
+
+  return emit(OP_AGGREGATE, (unsigned int)index, (unsigned int)op);
+}
+
+
+/*
+ * Compiles an n-ary operation as a left fold over its arguments.
+ */
+int
+SedMathProgram::compileFold(const ASTNode* node, int op)
+{
+  unsigned int numChildren = node->getNumChildren();
+
+  if (numChildren == 0)
+    {
+      // the empty sum is 0, the empty product and conjunction 1
+      return emitConstant((op == OP_MUL || op == OP_AND) ? 1.0 : 0.0);
+    }
+
+  int result = compileNode(node->getChild(0));
+
+  for (unsigned int i = 1; i < numChildren && result >= 0; ++i)
+    {
+      int x = compileNode(node->getChild(i));
+      result = x < 0 ? -1 : emit(op, result, x);
+    }
+
+  if (result >= 0 && numChildren == 1 &&
+      (op == OP_AND || op == OP_OR || op == OP_XOR))
+    {
+      // a single argument is still reduced to true or false
+      result = emit(OP_NEQ, result, emitConstant(0.0));
+    }
+
+  return result;
+}
+
+
+/*
+ * Compiles a relational operation, true when it holds between each
+ * pair of consecutive arguments.
+ */
+int
+SedMathProgram::compileComparison(const ASTNode* node, int op)
+{
+  unsigned int numChildren = node->getNumChildren();
+
+  if (numChildren < 2)
+    return emitConstant(1.0);
+
+  int previous = compileNode(node->getChild(0));
+  int result = -1;
+
+  for (unsigned int i = 1; i < numChildren && previous >= 0; ++i)
+    {
+      int current = compileNode(node->getChild(i));
+
+      if (current < 0)
+        return -1;
+
+      int comparison = emit(op, previous, current);
+      result = result < 0 ? comparison : emit(OP_AND, result, comparison);
+      previous = current;
+    }
+
+  return previous < 0 ? -1 : result;
+}
+
+
+/*
+ * Returns the value computed by the given operation, appending it unless
+ * the same value was computed before, and evaluating it right away when
+ * all of its operands are constants.
+ */
+unsigned int
+SedMathProgram::emit(int op, unsigned int a, unsigned int b, unsigned int c,
+                     double value)
+{
+  unsigned int numOperands = getNumOperands(op);
+  unsigned int operands[3] = { a, b, c };
+  double values[3];
+
+  bool constant = numOperands > 0;
+
+  for (unsigned int k = 0; constant && k < numOperands; ++k)
+    {
+      constant = mValues[operands[k]].op == OP_CONST;
+      values[k] = mValues[operands[k]].value;
+    }
+
+  if (constant)
+    {
+      if (numOperands == 1)
+        value = applyUnary(op, values[0]);
+      else if (numOperands == 2)
+        value = applyBinary(op, values[0], values[1]);
+      else
+        value = values[0] != 0.0 ? values[1] : values[2];
+
+      op = OP_CONST;
+    }
+
+  if (op == OP_CONST)
+    a = b = c = 0;
+
+  // constants are told apart by their bits, so that NaN finds itself
+  unsigned long long bits;
+  memcpy(&bits, &value, sizeof(bits));
+  ValueKey key(op, a, b, c, bits);
+
+  map<ValueKey, unsigned int>::const_iterator it = mValueNumbers.find(key);
+
+  if (it != mValueNumbers.end())
+    return it->second;
+
+  unsigned int number = (unsigned int)mValues.size();
+  Instruction ins = { op, number, a, b, c, value };
+  mValues.push_back(ins);
+  mValueNumbers.insert(make_pair(key, number));
+  return number;
+}
+
+
+/*
+ * Returns the value of the given constant.
+ */
+unsigned int
+SedMathProgram::emitConstant(double value)
+{
+  return emit(OP_CONST, 0, 0, 0, value);
+}
+
+
+/*
+ * Builds the instructions run by evaluate() from the values used by the
+ * outputs: values no output needs are dropped, each output is stored as
+ * soon as it is computed, and a register is reused once the last
+ * instruction reading it has run.
+ */
+void
+SedMathProgram::allocateRegisters()
+{
+  size_t numValues = mValues.size();
+  vector<bool> live(numValues, false);
+  vector<vector<unsigned int> > outputs(numValues);
+
+  for (unsigned int k = 0; k < mOutputs.size(); ++k)
+    {
+      live[mOutputs[k]] = true;
+      outputs[mOutputs[k]].push_back(k);
+    }
+
+  vector<size_t> lastUse(numValues);
+
+  for (size_t i = numValues; i > 0; --i)
+    {
+      const Instruction& ins = mValues[i - 1];
+      lastUse[i - 1] = i - 1;
+
+      if (!live[i - 1])
+        continue;
+
+      unsigned int operands[3] = { ins.a, ins.b, ins.c };
+
+      for (unsigned int k = 0; k < getNumOperands(ins.op); ++k)
+        live[operands[k]] = true;
+    }
+
+  for (size_t i = 0; i < numValues; ++i)
+    {
+      const Instruction& ins = mValues[i];
+      unsigned int operands[3] = { ins.a, ins.b, ins.c };
+
+      for (unsigned int k = 0; live[i] && k < getNumOperands(ins.op); ++k)
+        lastUse[operands[k]] = i;
+    }
+
+  mCode.clear();
+  vector<unsigned int> reg(numValues, 0);
+  vector<unsigned int> free;
+  unsigned int numRegisters = 0;
+
+  for (size_t i = 0; i < numValues; ++i)
+    {
+      if (!live[i])
+        continue;
+
+      Instruction ins = mValues[i];
+      unsigned int operands[3] = { ins.a, ins.b, ins.c };
+      unsigned int numOperands = getNumOperands(ins.op);
+
+      for (unsigned int k = 0; k < numOperands; ++k)
+        {
+          unsigned int o = operands[k];
+          bool repeated = (k > 0 && o == operands[0])
+                          || (k > 1 && o == operands[1]);
+
+          if (lastUse[o] == i && !repeated)
+            free.push_back(reg[o]);
+        }
+
+      if (numOperands > 0) ins.a = reg[ins.a];
+
+      if (numOperands > 1) ins.b = reg[ins.b];
+
+      if (numOperands > 2) ins.c = reg[ins.c];
+
+      if (free.empty())
+        {
+          reg[i] = numRegisters++;
+        }
+      else
+        {
+          reg[i] = free.back();
+          free.pop_back();
+        }
+
+      ins.dst = reg[i];
+      mCode.push_back(ins);
+
+      for (size_t k = 0; k < outputs[i].size(); ++k)
+        {
+          Instruction store = { OP_STORE, 0, reg[i], outputs[i][k], 0, 0.0 };
+          mCode.push_back(store);
+        }
+
+      if (lastUse[i] == i)
+        free.push_back(reg[i]);
+    }
+
+  mNumRegisters = numRegisters;
+}
+
+
+/*
+ * Returns true if the two programs compute the same values.
+ */
+bool
+SedMathProgram::isSameProgram(const SedMathProgram& lhs,
+                              const SedMathProgram& rhs)
+{
+  if (lhs.mCode.size() != rhs.mCode.size() ||
+      lhs.mAggregates.size() != rhs.mAggregates.size())
+    return false;
+
+  for (size_t i = 0; i < lhs.mCode.size(); ++i)
+    {
+      const Instruction& a = lhs.mCode[i];
+      const Instruction& b = rhs.mCode[i];
+
+      if (a.op != b.op || a.dst != b.dst || a.a != b.a || a.b != b.b ||
+          a.c != b.c || memcmp(&a.value, &b.value, sizeof(double)) != 0)
+        return false;
+    }
+
+  for (size_t i = 0; i < lhs.mAggregates.size(); ++i)
+    if (!isSameProgram(*lhs.mAggregates[i], *rhs.mAggregates[i]))
+      return false;
+
+  return true;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+#endif  /* __cplusplus */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Creates a new, empty SedMathProgram and returns it.
+ */
+LIBSEDML_EXTERN
+SedMathProgram_t *
+SedMathProgram_create()
+{
+  return new (nothrow) SedMathProgram();
+}
+
+
+/**
+ * Frees the given SedMathProgram.
+ */
+LIBSEDML_EXTERN
+void
+SedMathProgram_free(SedMathProgram_t *smp)
+{
+  if (smp != NULL)
+    delete smp;
+}
+
+
+/**
+ * Compiles the math of the given SedDataGenerator.
+ */
+LIBSEDML_EXTERN
+int
+SedMathProgram_compile(SedMathProgram_t *smp, const SedDataGenerator_t *dg)
+{
+  if (smp == NULL)
+    return LIBSEDML_INVALID_OBJECT;
+
+  return smp->compile(dg);
+}
+
+
+/**
+ * Evaluates the given SedMathProgram over arrays of points.
+ */
+LIBSEDML_EXTERN
+int
+SedMathProgram_evaluate(const SedMathProgram_t *smp,
+                        const double **inputs,
+                        size_t numPoints,
+                        double *result)
+{
+  if (smp == NULL)
+    return LIBSEDML_INVALID_OBJECT;
+
+  return smp->evaluate(inputs, numPoints, result);
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,403 @@
+/**
+ * @file    SedMathProgram.h
+ * @brief   Compiled, vectorized evaluator for Sed math
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedMathProgram
+ * @ingroup Core
+ * @brief Evaluates the math of a SedDataGenerator over whole arrays.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedMathProgram compiles an ASTNode once into a flat list of
+ * register instructions, and then evaluates it over any number of
+ * points without walking the tree again.  Compiling a SedDataGenerator
+ * binds each of its SedVariable objects to an input column, in the
+ * order of the ListOfVariables, and folds each SedParameter into a
+ * constant.
+ *
+ * Evaluation runs the instructions over blocks of points, so that every
+ * instruction is a simple loop over contiguous arrays that the compiler
+ * can vectorize.  Inputs are read in place; no copy of the columns is
+ * made.
+ *
+ * The SED-ML aggregate functions @c min, @c max, @c sum and @c product
+ * applied to a single argument reduce that argument over all points and
+ * yield the same value for each point.
+ *
+ * Several expressions may be compiled into the same SedMathProgram with
+ * addOutput().  Identical subexpressions, within one expression or
+ * across expressions, are numbered as the same value, so that they are
+ * computed once per point however many outputs use them.
+ */
+
+#ifndef SedMathProgram_h
+#define SedMathProgram_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDataGenerator;
+
+
+class LIBSEDML_EXTERN SedMathProgram
+{
+public:
+
+  /**
+   * Creates a new, empty SedMathProgram.
+   */
+  SedMathProgram();
+
+
+  /**
+   * Destroys this SedMathProgram.
+   */
+  virtual ~SedMathProgram();
+
+
+  /**
+   * Compiles the math of the given SedDataGenerator.
+   *
+   * The variables of @p dataGenerator become the inputs of this program,
+   * in the order in which they appear in its ListOfVariables, and its
+   * parameters become constants.
+   *
+   * @param dataGenerator the SedDataGenerator to compile
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INVALID_OBJECT
+   * @li LIBSEDML_OPERATION_FAILED
+   */
+  int compile(const SedDataGenerator* dataGenerator);
+
+
+  /**
+   * Compiles the given math.
+   *
+   * @param math the ASTNode to compile
+   * @param inputIds the identifiers bound to the inputs, in order
+   * @param constants the values of the identifiers bound to constants
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INVALID_OBJECT
+   * @li LIBSEDML_OPERATION_FAILED
+   *
+   * On failure, for instance because @p math refers to an unbound
+   * identifier or uses a function that cannot be evaluated, this
+   * SedMathProgram is left empty.
+   */
+  int compile(const ASTNode* math,
+              const std::vector<std::string>& inputIds,
+              const std::map<std::string, double>& constants);
+
+
+  /**
+   * Adds the given math as a further output of this SedMathProgram.
+   *
+   * Subexpressions already computed for an earlier output are shared
+   * rather than computed again.
+   *
+   * @param math the ASTNode to compile
+   * @param inputs the index of the input bound to each identifier;
+   * inputs beyond getNumInputs() are added as needed.
+   * @param constants the values of the identifiers bound to constants
+   *
+   * @return the index of the new output, or one of the following
+   * negative values on failure:
+   * @li LIBSEDML_INVALID_OBJECT
+   * @li LIBSEDML_OPERATION_FAILED
+   *
+   * On failure the outputs compiled earlier are left unchanged.
+   */
+  int addOutput(const ASTNode* math,
+                const std::map<std::string, unsigned int>& inputs,
+                const std::map<std::string, double>& constants);
+
+
+  /**
+   * Predicate returning @c true if this SedMathProgram has been compiled.
+   *
+   * @return @c true if this SedMathProgram has at least one output,
+   * @c false otherwise.
+   */
+  bool isCompiled() const;
+
+
+  /**
+   * Returns the number of inputs of this SedMathProgram.
+   *
+   * @return the number of input columns expected by evaluate().
+   */
+  unsigned int getNumInputs() const;
+
+
+  /**
+   * Returns the identifier bound to the nth input.
+   *
+   * @param n an unsigned int representing the index of the input.
+   *
+   * @return the identifier, or the empty string if @p n is out of range.
+   */
+  const std::string& getInputId(unsigned int n) const;
+
+
+  /**
+   * Returns the index of the input bound to the given identifier.
+   *
+   * @param sid the identifier of the input.
+   *
+   * @return the index of the input, or @c -1 if no input is bound to
+   * @p sid.
+   */
+  int getInputIndex(const std::string& sid) const;
+
+
+  /**
+   * Returns the number of outputs of this SedMathProgram.
+   *
+   * @return the number of outputs.
+   */
+  unsigned int getNumOutputs() const;
+
+
+  /**
+   * Returns the number of instructions of this SedMathProgram.
+   *
+   * @return the number of instructions, not counting those of the
+   * arguments of aggregate functions.
+   */
+  unsigned int getNumInstructions() const;
+
+
+  /**
+   * Evaluates this SedMathProgram at a single point.
+   *
+   * @param inputs the values of the inputs, in order.
+   *
+   * @return the value of the first output, or NaN if this SedMathProgram
+   * has not been compiled.
+   */
+  double evaluate(const double* inputs) const;
+
+
+  /**
+   * Evaluates the first output of this SedMathProgram over arrays of
+   * points.
+   *
+   * @param inputs an array of getNumInputs() columns, each holding
+   * @p numPoints values.
+   * @param numPoints the number of points to evaluate.
+   * @param result an array of @p numPoints values receiving the result;
+   * it may be one of the input columns.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INVALID_OBJECT
+   */
+  int evaluate(const double* const* inputs, size_t numPoints,
+               double* result) const;
+
+
+  /**
+   * Evaluates all outputs of this SedMathProgram over arrays of points.
+   *
+   * @param inputs an array of getNumInputs() columns, each holding
+   * @p numPoints values.
+   * @param numPoints the number of points to evaluate.
+   * @param results an array of getNumOutputs() columns, each receiving
+   * @p numPoints values; unlike with a single output, none of them may
+   * be one of the input columns.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INVALID_OBJECT
+   */
+  int evaluate(const double* const* inputs, size_t numPoints,
+               double* const* results) const;
+
+
+  /** @cond doxygen-libsedml-internal */
+
+  struct Instruction
+  {
+    int op;
+    unsigned int dst;
+    unsigned int a;
+    unsigned int b;
+    unsigned int c;
+    double value;
+  };
+
+  /** @endcond doxygen-libsedml-internal */
+
+
+protected:
+
+  /** @cond doxygen-libsedml-internal */
+
+  typedef std::tuple<int, unsigned int, unsigned int, unsigned int,
+                     unsigned long long> ValueKey;
+
+  int run(const double* const* inputs, size_t numPoints,
+          double* const* results, size_t numResults) const;
+
+  void clear();
+
+  int compileNode(const ASTNode* node);
+
+  int compileAggregate(const ASTNode* node, int op);
+
+  int compileFold(const ASTNode* node, int op);
+
+  int compileComparison(const ASTNode* node, int op);
+
+  unsigned int emit(int op, unsigned int a = 0, unsigned int b = 0,
+                    unsigned int c = 0, double value = 0.0);
+
+  unsigned int emitConstant(double value);
+
+  void allocateRegisters();
+
+  static bool isSameProgram(const SedMathProgram& lhs,
+                            const SedMathProgram& rhs);
+
+  std::vector<std::string> mInputIds;
+
+  const std::map<std::string, unsigned int>* mBindings;
+
+  const std::map<std::string, double>* mConstants;
+
+  std::vector<Instruction> mValues;
+
+  std::map<ValueKey, unsigned int> mValueNumbers;
+
+  std::vector<unsigned int> mOutputs;
+
+  std::vector<Instruction> mCode;
+
+  std::vector<std::shared_ptr<SedMathProgram> > mAggregates;
+
+  unsigned int mNumRegisters;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+/**
+ * Creates a new, empty SedMathProgram and returns it.
+ */
+LIBSEDML_EXTERN
+SedMathProgram_t *
+SedMathProgram_create();
+
+
+/**
+ * Frees the given SedMathProgram, created with SedMathProgram_create().
+ */
+LIBSEDML_EXTERN
+void
+SedMathProgram_free(SedMathProgram_t *smp);
+
+
+/**
+ * Compiles the math of the given SedDataGenerator into @p smp.
+ *
+ * @return integer value indicating success/failure of the operation.
+ * The possible return values are:
+ * @li LIBSEDML_OPERATION_SUCCESS
+ * @li LIBSEDML_INVALID_OBJECT
+ * @li LIBSEDML_OPERATION_FAILED
+ */
+LIBSEDML_EXTERN
+int
+SedMathProgram_compile(SedMathProgram_t *smp, const SedDataGenerator_t *dg);
+
+
+/**
+ * Evaluates @p smp over @p numPoints points of the given input columns,
+ * storing the values in @p result.
+ *
+ * @return integer value indicating success/failure of the operation.
+ * The possible return values are:
+ * @li LIBSEDML_OPERATION_SUCCESS
+ * @li LIBSEDML_INVALID_OBJECT
+ */
+LIBSEDML_EXTERN
+int
+SedMathProgram_evaluate(const SedMathProgram_t *smp,
+                        const double **inputs,
+                        size_t numPoints,
+                        double *result);
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+
+#endif  /* SedMathProgram_h */
@@ -36,6 +36,7 @@
 
 #include <sedml/SedModel.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -57,9 +58,6 @@ SedModel::SedModel(unsigned int level, unsigned int version)
   , mChanges(level, version)
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
-
   // connect to child objects
   connectToChild();
 }
@@ -229,7 +227,9 @@ SedModel::isSetSource() const
 int
 SedModel::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  indexElement();
+  return result;
 }
 
 
@@ -279,6 +279,7 @@ int
 SedModel::unsetId()
 {
   mId.erase();
+  indexElement();
 
   if (mId.empty() == true)
     {
@@ -645,6 +646,48 @@ SedModel::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedModel::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedBase::writeSnapshot(writer);
+
+  writer.writeString(mId);
+  writer.writeString(mName);
+  writer.writeString(mLanguage);
+  writer.writeString(mSource);
+  mChanges.writeSnapshot(writer);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedModel::readSnapshot(SedSnapshotReader& reader)
+{
+  SedBase::readSnapshot(reader);
+
+  mId = reader.readString();
+  mName = reader.readString();
+  mLanguage = reader.readString();
+  mSource = reader.readString();
+  mChanges.readSnapshot(reader);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -653,8 +696,17 @@ SedModel::writeElements(XMLOutputStream& stream) const
 bool
 SedModel::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      if (getNumChanges() > 0)
+        {
+          mChanges.accept(v);
+        }
+    }
+
+  v.leave(*this);
 
+  return true;
 }
 
 
@@ -815,7 +867,6 @@ SedListOfModels::SedListOfModels(unsigned int level,
                                  unsigned int version)
   : SedListOf(level, version)
 {
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -876,10 +927,8 @@ SedListOfModels::get(const std::string& sid)
 const SedModel*
 SedListOfModels::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedModel>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <SedModel*>(*result);
+  int index = getIndexById(sid);
+  return (index < 0) ? 0 : static_cast <SedModel*>(mItems[index]);
 }
 
 
@@ -951,14 +1000,11 @@ SedModel*
 SedListOfModels::remove(const std::string& sid)
 {
   SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedModel>(sid));
+  int index = getIndexById(sid);
 
-  if (result != mItems.end())
+  if (index >= 0)
     {
-      item = *result;
-      mItems.erase(result);
+      item = SedListOf::remove((unsigned int)index);
     }
 
   return static_cast <SedModel*>(item);
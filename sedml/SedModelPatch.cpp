@@ -0,0 +1,475 @@
+/**
+ * @file    SedModelPatch.cpp
+ * @brief   Applies the SetValue changes of a repeated task to a shared model
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedModelPatch.h>
+#include <sedml/SedModelResolver.h>
+#include <sedml/SedTargetIndex.h>
+#include <sedml/SedMathProgram.h>
+#include <sedml/SedIterationSpace.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedRepeatedTask.h>
+#include <sedml/SedSetValue.h>
+#include <sedml/SedVariable.h>
+#include <sedml/SedParameter.h>
+#include <sedml/common/numberutil.h>
+
+#include <sbml/xml/XMLNode.h>
+
+#include <limits>
+
+using namespace std;
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygen-libsedml-internal */
+
+static const string SEDML_EMPTY_STRING;
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Creates a new SedModelPatch for the given SedRepeatedTask.
+ */
+SedModelPatch::SedModelPatch(const SedRepeatedTask* task)
+  : mTask(task)
+  , mBases()
+  , mSlots()
+  , mChanges()
+  , mNumRanges(0)
+  , mInputs()
+  , mCompiled(false)
+{
+}
+
+
+/*
+ * Destroys this SedModelPatch.
+ */
+SedModelPatch::~SedModelPatch()
+{
+}
+
+
+/*
+ * Returns the SedRepeatedTask of this SedModelPatch.
+ */
+const SedRepeatedTask*
+SedModelPatch::getRepeatedTask() const
+{
+  return mTask;
+}
+
+
+/*
+ * Resolves the models and targets of the SedSetValue elements, and
+ * compiles their math.
+ */
+int
+SedModelPatch::compile(SedModelResolver& resolver)
+{
+  mBases.clear();
+  mSlots.clear();
+  mChanges.clear();
+  mNumRanges = 0;
+  mCompiled = false;
+
+  if (mTask == NULL)
+    return LIBSEDML_INVALID_OBJECT;
+
+  vector<string> rangeIds;
+
+  for (unsigned int i = 0; i < mTask->getNumRanges(); ++i)
+    rangeIds.push_back(mTask->getRange(i)->getId());
+
+  map<string, shared_ptr<SedTargetIndex> > indexes;
+
+  for (unsigned int i = 0; i < mTask->getNumTaskChanges(); ++i)
+    {
+      const SedSetValue* setValue = mTask->getTaskChange(i);
+      Change change;
+
+      int status = findSlot(setValue->getModelReference(),
+                            setValue->getTarget(), resolver, change.slot,
+                            indexes);
+
+      if (status != LIBSEDML_OPERATION_SUCCESS)
+        return status;
+
+      vector<string> ids = rangeIds;
+
+      for (unsigned int j = 0; j < setValue->getNumVariables(); ++j)
+        {
+          const SedVariable* var = setValue->getVariable(j);
+
+          if (var->isSetSymbol())
+            return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+          unsigned int slot;
+          status = findSlot(var->isSetModelReference()
+                              ? var->getModelReference()
+                              : setValue->getModelReference(),
+                            var->getTarget(), resolver, slot, indexes);
+
+          if (status != LIBSEDML_OPERATION_SUCCESS)
+            return status;
+
+          ids.push_back(var->getId());
+          change.variables.push_back(slot);
+        }
+
+      map<string, double> constants;
+
+      for (unsigned int j = 0; j < setValue->getNumParameters(); ++j)
+        {
+          const SedParameter* p = setValue->getParameter(j);
+          constants[p->getId()] = p->getValue();
+        }
+
+      SedMathProgram* program = new SedMathProgram();
+      change.program.reset(program);
+
+      if (program->compile(setValue->getMath(), ids, constants)
+          != LIBSEDML_OPERATION_SUCCESS)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      mChanges.push_back(change);
+    }
+
+  mNumRanges = (unsigned int)rangeIds.size();
+  mCompiled = true;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Predicate returning @c true if this SedModelPatch was compiled.
+ */
+bool
+SedModelPatch::isCompiled() const
+{
+  return mCompiled;
+}
+
+
+/*
+ * Returns the shared XML of the model with the given identifier.
+ */
+std::shared_ptr<const XMLNode>
+SedModelPatch::getBaseModel(const std::string& modelReference) const
+{
+  map<string, shared_ptr<const XMLNode> >::const_iterator it =
+    mBases.find(modelReference);
+  return it != mBases.end() ? it->second : shared_ptr<const XMLNode>();
+}
+
+
+/*
+ * Returns the number of slots of this SedModelPatch.
+ */
+unsigned int
+SedModelPatch::getNumSlots() const
+{
+  return (unsigned int)mSlots.size();
+}
+
+
+/*
+ * Returns the index of the slot for the given target.
+ */
+int
+SedModelPatch::getSlotIndex(const std::string& modelReference,
+                            const std::string& target) const
+{
+  for (size_t i = 0; i < mSlots.size(); ++i)
+    if (mSlots[i].modelReference == modelReference &&
+        mSlots[i].target.getXPath() == target)
+      return (int)i;
+
+  // the same attribute may be selected by another expression
+  map<string, shared_ptr<const XMLNode> >::const_iterator it =
+    mBases.find(modelReference);
+
+  if (it == mBases.end())
+    return -1;
+
+  SedTarget compiled(target);
+  SedTargetIndex index(it->second.get());
+  const XMLNode* element = index.getElement(compiled);
+
+  for (size_t i = 0; element != NULL && i < mSlots.size(); ++i)
+    if (mSlots[i].modelReference == modelReference &&
+        mSlots[i].element == element &&
+        (!compiled.isSetAttribute() ||
+         mSlots[i].attribute == compiled.getAttribute()))
+      return (int)i;
+
+  return -1;
+}
+
+
+/*
+ * Returns the identifier of the model of the nth slot.
+ */
+const std::string&
+SedModelPatch::getModelReference(unsigned int n) const
+{
+  return n < mSlots.size() ? mSlots[n].modelReference : SEDML_EMPTY_STRING;
+}
+
+
+/*
+ * Returns the element of the shared XML holding the nth slot.
+ */
+const XMLNode*
+SedModelPatch::getElement(unsigned int n) const
+{
+  return n < mSlots.size() ? mSlots[n].element : NULL;
+}
+
+
+/*
+ * Returns the name of the attribute of the nth slot.
+ */
+const std::string&
+SedModelPatch::getAttribute(unsigned int n) const
+{
+  return n < mSlots.size() ? mSlots[n].attribute : SEDML_EMPTY_STRING;
+}
+
+
+/*
+ * Returns the value of the nth slot in the shared XML.
+ */
+double
+SedModelPatch::getBaseValue(unsigned int n) const
+{
+  return n < mSlots.size() ? mSlots[n].base
+                           : numeric_limits<double>::quiet_NaN();
+}
+
+
+/*
+ * Returns the current value of the nth slot.
+ */
+double
+SedModelPatch::getValue(unsigned int n) const
+{
+  return n < mSlots.size() ? mSlots[n].value
+                           : numeric_limits<double>::quiet_NaN();
+}
+
+
+/*
+ * Predicate returning @c true if the nth slot is changed.
+ */
+bool
+SedModelPatch::isChanged(unsigned int n) const
+{
+  return n < mSlots.size() && !(mSlots[n].value == mSlots[n].base);
+}
+
+
+/*
+ * Restores the values of all slots.
+ */
+void
+SedModelPatch::reset()
+{
+  for (size_t i = 0; i < mSlots.size(); ++i)
+    mSlots[i].value = mSlots[i].base;
+}
+
+
+/*
+ * Applies the SedSetValue elements for the given iteration.
+ */
+int
+SedModelPatch::update(const SedIterationSpace& space, unsigned int iteration)
+{
+  if (!mCompiled || space.getRepeatedTask() != mTask)
+    return LIBSEDML_INVALID_OBJECT;
+
+  int status = space.getValues(iteration, mInputs);
+
+  if (status != LIBSEDML_OPERATION_SUCCESS)
+    return status;
+
+  if (mTask->getResetModel())
+    reset();
+
+  for (size_t i = 0; i < mChanges.size(); ++i)
+    {
+      const Change& change = mChanges[i];
+
+      mInputs.resize(mNumRanges);
+
+      for (size_t j = 0; j < change.variables.size(); ++j)
+        mInputs.push_back(mSlots[change.variables[j]].value);
+
+      mSlots[change.slot].value =
+        change.program->evaluate(mInputs.empty() ? NULL : &mInputs[0]);
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Writes the changed slots of the given model into a copy of its XML.
+ */
+int
+SedModelPatch::apply(const std::string& modelReference, XMLNode& model) const
+{
+  SedTargetIndex index(&model);
+
+  for (size_t i = 0; i < mSlots.size(); ++i)
+    {
+      const Slot& slot = mSlots[i];
+
+      if (slot.modelReference != modelReference || !isChanged((unsigned)i))
+        continue;
+
+      XMLNode* element = const_cast<XMLNode*>(index.getElement(slot.target));
+
+      if (element == NULL)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      char buffer[SEDML_DOUBLE_BUFFER_SIZE];
+      SedUtil_formatDouble(slot.value, buffer);
+      element->addAttr(slot.attribute, buffer);
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Returns the slot for the given target, adding it if needed; the model
+ * is resolved, and indexed, the first time it is referred to.
+ */
+int
+SedModelPatch::findSlot(const std::string& modelReference,
+                        const std::string& target,
+                        SedModelResolver& resolver, unsigned int& slot,
+                        std::map<std::string,
+                          std::shared_ptr<SedTargetIndex> >& indexes)
+{
+  shared_ptr<SedTargetIndex>& index = indexes[modelReference];
+
+  if (!index)
+    {
+      const SedDocument* doc = mTask->getSedDocument();
+      const SedModel* model = doc != NULL ? doc->getModel(modelReference)
+                                          : NULL;
+
+      if (model == NULL)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      shared_ptr<const XMLNode> base;
+      int status = resolver.resolve(model, base);
+
+      if (status != LIBSEDML_OPERATION_SUCCESS)
+        return status;
+
+      mBases[modelReference] = base;
+      index.reset(new SedTargetIndex(base.get()));
+    }
+
+  SedTarget compiled(target);
+  const XMLNode* element = index->getElement(compiled);
+
+  if (element == NULL)
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  string attribute;
+
+  if (compiled.isSetAttribute())
+    {
+      attribute = compiled.getAttribute();
+    }
+  else
+    {
+      const char* name = SedTargetIndex::getValueAttribute(element);
+
+      if (name != NULL)
+        attribute = name;
+    }
+
+  if (attribute.empty())
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  for (size_t i = 0; i < mSlots.size(); ++i)
+    {
+      if (mSlots[i].modelReference == modelReference &&
+          mSlots[i].element == element && mSlots[i].attribute == attribute)
+        {
+          slot = (unsigned int)i;
+          return LIBSEDML_OPERATION_SUCCESS;
+        }
+    }
+
+  string text = element->getAttrValue(attribute);
+  double value = 0;
+  const char* end = SedUtil_parseDouble(text.c_str(), value);
+
+  if (end == NULL || *end != '\0')
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  Slot entry;
+  entry.modelReference = modelReference;
+  entry.target = compiled;
+  entry.element = element;
+  entry.attribute = attribute;
+  entry.base = value;
+  entry.value = value;
+  slot = (unsigned int)mSlots.size();
+  mSlots.push_back(entry);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+#endif  /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
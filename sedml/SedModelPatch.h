@@ -0,0 +1,343 @@
+/**
+ * @file    SedModelPatch.h
+ * @brief   Applies the SetValue changes of a repeated task to a shared model
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedModelPatch
+ * @ingroup Core
+ * @brief Applies the SetValue changes of a SedRepeatedTask as a patch
+ * over a shared model.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedRepeatedTask changes its models with its SedSetValue elements
+ * once per iteration, and restores them first when its "resetModel"
+ * attribute is @c true.  Copying the XML of a model for each iteration
+ * can cost more than simulating it.  A SedModelPatch instead resolves the
+ * target of each SedSetValue once, through a SedModelResolver, to an
+ * attribute of the shared XML of the model, its "slot", and compiles the
+ * math of each SedSetValue with SedMathProgram.  An iteration then only
+ * evaluates that math and stores the results as the values of the
+ * slots; the XML of the models is never copied nor changed.
+ *
+ * The values of the variables of a SedSetValue are read from the slots
+ * as well, so that they see the changes of the earlier iterations and of
+ * the earlier SedSetValue elements of the same iteration.  Variables
+ * referring to a symbol, such as time, have no value in a model and are
+ * not supported.
+ *
+ * A simulator reads the values of the slots, or calls apply() to write
+ * them into its own copy of the XML of a model.  A SedModelPatch can be
+ * copied cheaply, so that iterations run on several threads each use
+ * their own copy; the changes of nested repeated tasks are handled by a
+ * SedModelPatch of their own.
+ */
+
+#ifndef SedModelPatch_h
+#define SedModelPatch_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <sedml/SedTarget.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedRepeatedTask;
+class SedIterationSpace;
+class SedModelResolver;
+class SedMathProgram;
+class SedTargetIndex;
+
+
+class LIBSEDML_EXTERN SedModelPatch
+{
+public:
+
+  /**
+   * Creates a new SedModelPatch for the given SedRepeatedTask.
+   *
+   * The SedModelPatch must be compiled before it is used; the
+   * SedRepeatedTask must not be changed while it is in use.
+   *
+   * @param task the SedRepeatedTask whose SedSetValue elements are
+   * applied.
+   */
+  SedModelPatch(const SedRepeatedTask* task);
+
+
+  /**
+   * Destroys this SedModelPatch.
+   */
+  virtual ~SedModelPatch();
+
+
+  /**
+   * Returns the SedRepeatedTask of this SedModelPatch.
+   *
+   * @return the SedRepeatedTask this SedModelPatch was created for.
+   */
+  const SedRepeatedTask* getRepeatedTask() const;
+
+
+  /**
+   * Resolves the models and targets of the SedSetValue elements of the
+   * repeated task, and compiles their math.
+   *
+   * @param resolver the SedModelResolver through which the models the
+   * SedSetValue elements refer to are resolved.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INVALID_OBJECT, if the repeated task is @c NULL
+   * @li LIBSEDML_INVALID_ATTRIBUTE_VALUE, if a model, target or variable
+   * cannot be resolved, or math cannot be compiled
+   * @li any value returned by SedModelResolver::resolve()
+   */
+  int compile(SedModelResolver& resolver);
+
+
+  /**
+   * Predicate returning @c true if this SedModelPatch was compiled
+   * successfully.
+   *
+   * @return @c true if compile() succeeded, @c false otherwise.
+   */
+  bool isCompiled() const;
+
+
+  /**
+   * Returns the shared XML of the model with the given identifier.
+   *
+   * @param modelReference the identifier of a SedModel changed or read
+   * by the repeated task.
+   *
+   * @return the XML, with the changes of the SedModel applied but not
+   * those of this SedModelPatch, or an empty pointer if the repeated task
+   * does not refer to @p modelReference.
+   */
+  std::shared_ptr<const XMLNode>
+  getBaseModel(const std::string& modelReference) const;
+
+
+  /**
+   * Returns the number of slots of this SedModelPatch.
+   *
+   * @return the number of distinct attributes of the models that the
+   * SedSetValue elements set or read.
+   */
+  unsigned int getNumSlots() const;
+
+
+  /**
+   * Returns the index of the slot for the given target.
+   *
+   * @param modelReference the identifier of the SedModel.
+   * @param target an XPath expression selecting an attribute, or an
+   * element holding a value, of the model.
+   *
+   * @return the index of the slot, or @c -1 if there is none.
+   */
+  int getSlotIndex(const std::string& modelReference,
+                   const std::string& target) const;
+
+
+  /**
+   * Returns the identifier of the model of the nth slot.
+   *
+   * @param n an unsigned int representing the index of the slot.
+   *
+   * @return the identifier of the SedModel, or the empty string if @p n
+   * is out of range.
+   */
+  const std::string& getModelReference(unsigned int n) const;
+
+
+  /**
+   * Returns the element of the shared XML holding the nth slot.
+   *
+   * @param n an unsigned int representing the index of the slot.
+   *
+   * @return the element, or @c NULL if @p n is out of range.
+   */
+  const XMLNode* getElement(unsigned int n) const;
+
+
+  /**
+   * Returns the name of the attribute of the nth slot.
+   *
+   * @param n an unsigned int representing the index of the slot.
+   *
+   * @return the name of the attribute, or the empty string if @p n is
+   * out of range.
+   */
+  const std::string& getAttribute(unsigned int n) const;
+
+
+  /**
+   * Returns the value of the nth slot in the shared XML.
+   *
+   * @param n an unsigned int representing the index of the slot.
+   *
+   * @return the value, or NaN if @p n is out of range.
+   */
+  double getBaseValue(unsigned int n) const;
+
+
+  /**
+   * Returns the current value of the nth slot.
+   *
+   * @param n an unsigned int representing the index of the slot.
+   *
+   * @return the value, or NaN if @p n is out of range.
+   */
+  double getValue(unsigned int n) const;
+
+
+  /**
+   * Predicate returning @c true if the current value of the nth slot
+   * differs from its value in the shared XML.
+   *
+   * @param n an unsigned int representing the index of the slot.
+   *
+   * @return @c true if the slot is changed, @c false otherwise.
+   */
+  bool isChanged(unsigned int n) const;
+
+
+  /**
+   * Restores the values of all slots to their values in the shared XML.
+   */
+  void reset();
+
+
+  /**
+   * Applies the SedSetValue elements of the repeated task for the given
+   * iteration.
+   *
+   * The slots are reset first if the "resetModel" attribute of the
+   * repeated task is @c true; the SedSetValue elements are then evaluated
+   * in order, with the values of the ranges in @p iteration.
+   *
+   * @param space a SedIterationSpace over the repeated task of this
+   * SedModelPatch.
+   * @param iteration the index of the iteration.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INVALID_OBJECT, if this SedModelPatch is not compiled,
+   * or @p space is over another repeated task
+   * @li any value returned by SedIterationSpace::getValues()
+   */
+  int update(const SedIterationSpace& space, unsigned int iteration);
+
+
+  /**
+   * Writes the changed slots of the given model into a copy of its XML.
+   *
+   * @param modelReference the identifier of the SedModel.
+   * @param model the copy of the XML of the model, as returned by
+   * getBaseModel(), to write into.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INVALID_ATTRIBUTE_VALUE, if a target of a changed slot
+   * cannot be found in @p model
+   */
+  int apply(const std::string& modelReference, XMLNode& model) const;
+
+
+protected:
+
+  /** @cond doxygen-libsedml-internal */
+
+  struct Slot
+  {
+    std::string modelReference;
+    SedTarget target;
+    const XMLNode* element;
+    std::string attribute;
+    double base;
+    double value;
+  };
+
+  struct Change
+  {
+    unsigned int slot;
+    std::shared_ptr<const SedMathProgram> program;
+    std::vector<unsigned int> variables;
+  };
+
+  int findSlot(const std::string& modelReference, const std::string& target,
+               SedModelResolver& resolver, unsigned int& slot,
+               std::map<std::string, std::shared_ptr<SedTargetIndex> >&
+                 indexes);
+
+  const SedRepeatedTask* mTask;
+
+  std::map<std::string, std::shared_ptr<const XMLNode> > mBases;
+
+  std::vector<Slot> mSlots;
+
+  std::vector<Change> mChanges;
+
+  unsigned int mNumRanges;
+
+  std::vector<double> mInputs;
+
+  bool mCompiled;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedModelPatch_h */
@@ -0,0 +1,680 @@
+/**
+ * @file    SedModelResolver.cpp
+ * @brief   Loads the models of a Sed document and applies their changes
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedModelResolver.h>
+#include <sedml/SedTarget.h>
+#include <sedml/SedTargetIndex.h>
+#include <sedml/SedMathProgram.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedModel.h>
+#include <sedml/SedChangeAttribute.h>
+#include <sedml/SedAddXML.h>
+#include <sedml/SedChangeXML.h>
+#include <sedml/SedComputeChange.h>
+#include <sedml/SedVariable.h>
+#include <sedml/SedParameter.h>
+#include <sedml/common/numberutil.h>
+
+#include <sbml/xml/XMLNode.h>
+#include <sbml/xml/XMLInputStream.h>
+#include <sbml/math/ASTNode.h>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the given math, so that equal math is written the same.
+ */
+static void
+describeMath(const ASTNode* node, ostream& out)
+{
+  if (node == NULL)
+    {
+      out << "()";
+      return;
+    }
+
+  out << '(' << (int)node->getType();
+
+  if (node->getName() != NULL)
+    out << ' ' << node->getName();
+
+  char buffer[SEDML_DOUBLE_BUFFER_SIZE];
+
+  switch (node->getType())
+    {
+    case AST_INTEGER:
+      out << ' ' << node->getInteger();
+      break;
+    case AST_RATIONAL:
+      out << ' ' << node->getNumerator() << '/' << node->getDenominator();
+      break;
+    case AST_REAL:
+    case AST_REAL_E:
+      SedUtil_formatDouble(node->getReal(), buffer);
+      out << ' ' << buffer;
+      break;
+    case AST_CSYMBOL_FUNCTION:
+      out << ' ' << node->getDefinitionURLString();
+      break;
+    default:
+      break;
+    }
+
+  for (unsigned int i = 0; i < node->getNumChildren(); ++i)
+    describeMath(node->getChild(i), out);
+
+  out << ')';
+}
+
+
+/*
+ * Returns the new XML elements of an AddXML or ChangeXML: the element
+ * itself, or the elements held by a node without a name.
+ */
+static vector<const XMLNode*>
+getNewElements(const XMLNode* newXML)
+{
+  vector<const XMLNode*> elements;
+
+  if (newXML == NULL)
+    return elements;
+
+  if (newXML->isElement() && !newXML->getName().empty())
+    {
+      elements.push_back(newXML);
+      return elements;
+    }
+
+  for (unsigned int i = 0; i < newXML->getNumChildren(); ++i)
+    if (newXML->getChild(i).isElement())
+      elements.push_back(&newXML->getChild(i));
+
+  return elements;
+}
+
+
+/*
+ * Returns the position of the given element among the children of its
+ * parent.
+ */
+static int
+getChildIndex(const XMLNode* parent, const XMLNode* element)
+{
+  for (unsigned int i = 0; i < parent->getNumChildren(); ++i)
+    if (&parent->getChild(i) == element)
+      return (int)i;
+
+  return -1;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Creates a new SedModelResolver.
+ */
+SedModelResolver::SedModelResolver(const std::string& baseDirectory)
+  : mBaseDirectory(baseDirectory)
+  , mSources()
+  , mInstances()
+  , mMutex()
+{
+}
+
+
+/*
+ * Destroys this SedModelResolver and its cache.
+ */
+SedModelResolver::~SedModelResolver()
+{
+}
+
+
+/*
+ * Returns the base directory of this SedModelResolver.
+ */
+const std::string&
+SedModelResolver::getBaseDirectory() const
+{
+  return mBaseDirectory;
+}
+
+
+/*
+ * Sets the base directory of this SedModelResolver.
+ */
+void
+SedModelResolver::setBaseDirectory(const std::string& baseDirectory)
+{
+  lock_guard<mutex> lock(mMutex);
+  mBaseDirectory = baseDirectory;
+}
+
+
+/*
+ * Resolves the given SedModel.
+ */
+int
+SedModelResolver::resolve(const SedModel* model,
+                          std::shared_ptr<const XMLNode>& result)
+{
+  result.reset();
+
+  if (model == NULL)
+    return LIBSEDML_INVALID_OBJECT;
+
+  lock_guard<mutex> lock(mMutex);
+
+  shared_ptr<XMLNode> root;
+  string key;
+  vector<const SedModel*> stack;
+  int status = resolveModel(model, root, key, stack);
+
+  if (status == LIBSEDML_OPERATION_SUCCESS)
+    result = root;
+
+  return status;
+}
+
+
+/*
+ * Returns the number of sources this SedModelResolver has parsed.
+ */
+unsigned int
+SedModelResolver::getNumSources() const
+{
+  lock_guard<mutex> lock(mMutex);
+  return (unsigned int)mSources.size();
+}
+
+
+/*
+ * Returns the number of models this SedModelResolver holds.
+ */
+unsigned int
+SedModelResolver::getNumInstances() const
+{
+  lock_guard<mutex> lock(mMutex);
+  return (unsigned int)mInstances.size();
+}
+
+
+/*
+ * Empties the cache of this SedModelResolver.
+ */
+void
+SedModelResolver::clearCache()
+{
+  lock_guard<mutex> lock(mMutex);
+  mSources.clear();
+  mInstances.clear();
+}
+
+
+/*
+ * Loads the content of a source that is not a model of the document.
+ */
+int
+SedModelResolver::loadSource(const std::string& source, std::string& content)
+{
+  string path = source;
+
+  if (path.compare(0, 5, "file:") == 0)
+    path = path.substr(5);
+
+  bool absolute = !path.empty() &&
+                  (path[0] == '/' || path[0] == '\\' ||
+                   (path.size() > 1 && path[1] == ':'));
+
+  if (!absolute && !mBaseDirectory.empty())
+    path = mBaseDirectory + "/" + path;
+
+  ifstream file(path.c_str(), ios::in | ios::binary);
+
+  if (!file)
+    return LIBSEDML_OPERATION_FAILED;
+
+  ostringstream buffer;
+  buffer << file.rdbuf();
+  content = buffer.str();
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Resolves the given model, its source first, returning the XML and the
+ * key under which it is cached.
+ */
+int
+SedModelResolver::resolveModel(const SedModel* model,
+                               std::shared_ptr<XMLNode>& root,
+                               std::string& key,
+                               std::vector<const SedModel*>& stack)
+{
+  if (find(stack.begin(), stack.end(), model) != stack.end())
+    return LIBSEDML_INVALID_OBJECT;
+
+  stack.push_back(model);
+
+  const string& source = model->getSource();
+  const SedDocument* doc = model->getSedDocument();
+  const SedModel* parent = NULL;
+
+  if (doc != NULL && !source.empty())
+    parent = doc->getModel(source[0] == '#' ? source.substr(1) : source);
+
+  shared_ptr<XMLNode> base;
+  string baseKey;
+  int status;
+
+  if (parent != NULL)
+    {
+      status = resolveModel(parent, base, baseKey, stack);
+    }
+  else
+    {
+      string content;
+      status = loadSource(source, content);
+
+      if (status == LIBSEDML_OPERATION_SUCCESS)
+        status = parseSource(content, base, baseKey);
+    }
+
+  string description;
+
+  if (status == LIBSEDML_OPERATION_SUCCESS)
+    status = describeChanges(model, description, stack);
+
+  if (status != LIBSEDML_OPERATION_SUCCESS || description.empty())
+    {
+      stack.pop_back();
+      root = base;
+      key = baseKey;
+      return status;
+    }
+
+  key = baseKey + '\n' + description;
+
+  map<string, shared_ptr<XMLNode> >::const_iterator it =
+    mInstances.find(key);
+
+  if (it != mInstances.end())
+    {
+      stack.pop_back();
+      root = it->second;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  shared_ptr<XMLNode> copy(new XMLNode(*base));
+  unique_ptr<SedTargetIndex> index;
+
+  for (unsigned int i = 0; i < model->getNumChanges(); ++i)
+    {
+      status = applyChange(model, model->getChange(i), copy.get(), index,
+                           stack);
+
+      if (status != LIBSEDML_OPERATION_SUCCESS)
+        {
+          stack.pop_back();
+          return status;
+        }
+    }
+
+  stack.pop_back();
+  mInstances[key] = copy;
+  root = copy;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Parses the given content, unless the same content was parsed before.
+ */
+int
+SedModelResolver::parseSource(const std::string& content,
+                              std::shared_ptr<XMLNode>& root,
+                              std::string& key)
+{
+  ostringstream out;
+  out << "source " << hash<string>()(content) << ' ' << content.size();
+  key = out.str();
+
+  map<string, Source>::const_iterator it = mSources.find(key);
+
+  if (it != mSources.end() && it->second.content == content)
+    {
+      root = it->second.root;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  XMLInputStream stream(content.c_str(), false);
+
+  if (!stream.isGood())
+    return LIBSEDML_OPERATION_FAILED;
+
+  shared_ptr<XMLNode> parsed(new XMLNode(stream));
+
+  if (stream.isError() || !parsed->isElement() || parsed->getName().empty())
+    return LIBSEDML_OPERATION_FAILED;
+
+  root = parsed;
+
+  if (it != mSources.end())
+    {
+      // another content with the same hash is not cached, and is told
+      // apart by its address
+      out << ' ' << parsed.get();
+      key = out.str();
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  Source& entry = mSources[key];
+  entry.content = content;
+  entry.root = parsed;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Describes the changes of the given model, so that equal changes are
+ * described the same; the models their variables refer to are resolved
+ * on the way, and described by their keys.
+ */
+int
+SedModelResolver::describeChanges(const SedModel* model,
+                                  std::string& description,
+                                  std::vector<const SedModel*>& stack)
+{
+  ostringstream out;
+  out << setprecision(17);
+
+  for (unsigned int i = 0; i < model->getNumChanges(); ++i)
+    {
+      const SedChange* change = model->getChange(i);
+      out << change->getTypeCode() << '\t' << change->getTarget() << '\t';
+
+      switch (change->getTypeCode())
+        {
+        case SEDML_CHANGE_ATTRIBUTE:
+          out << static_cast<const SedChangeAttribute*>(change)->getNewValue();
+          break;
+
+        case SEDML_CHANGE_ADDXML:
+        case SEDML_CHANGE_CHANGEXML:
+          {
+            const XMLNode* newXML = change->getTypeCode() == SEDML_CHANGE_ADDXML
+              ? static_cast<const SedAddXML*>(change)->getNewXML()
+              : static_cast<const SedChangeXML*>(change)->getNewXML();
+
+            if (newXML != NULL)
+              out << newXML->toXMLString();
+          }
+          break;
+
+        case SEDML_CHANGE_COMPUTECHANGE:
+          {
+            const SedComputeChange* compute =
+              static_cast<const SedComputeChange*>(change);
+            describeMath(compute->getMath(), out);
+
+            for (unsigned int j = 0; j < compute->getNumParameters(); ++j)
+              {
+                const SedParameter* p = compute->getParameter(j);
+                out << '\t' << p->getId() << '=' << p->getValue();
+              }
+
+            for (unsigned int j = 0; j < compute->getNumVariables(); ++j)
+              {
+                const SedVariable* var = compute->getVariable(j);
+                out << '\t' << var->getId() << '=' << var->getTarget() << ' '
+                    << var->getSymbol();
+
+                const SedDocument* doc = model->getSedDocument();
+                const SedModel* other = doc != NULL
+                  ? doc->getModel(var->getModelReference()) : NULL;
+
+                if (other == NULL || other == model)
+                  continue;
+
+                shared_ptr<XMLNode> root;
+                string key;
+                int status = resolveModel(other, root, key, stack);
+
+                if (status != LIBSEDML_OPERATION_SUCCESS)
+                  return status;
+
+                out << " {" << key << '}';
+              }
+          }
+          break;
+
+        default:
+          break;
+        }
+
+      out << '\n';
+    }
+
+  description = out.str();
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Applies the given change to the XML of the model; the index of the
+ * XML is built when needed, and dropped when the XML changes shape.
+ */
+int
+SedModelResolver::applyChange(const SedModel* model, const SedChange* change,
+                              XMLNode* root,
+                              std::unique_ptr<SedTargetIndex>& index,
+                              std::vector<const SedModel*>& stack)
+{
+  if (!index)
+    index.reset(new SedTargetIndex(root));
+
+  SedTarget target(change->getTarget());
+  const XMLNode* found = index->getElement(target);
+
+  if (found == NULL)
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  // the XML is a copy owned by this resolver
+  XMLNode* element = const_cast<XMLNode*>(found);
+  XMLNode* parent = const_cast<XMLNode*>(index->getParent(found));
+
+  switch (change->getTypeCode())
+    {
+    case SEDML_CHANGE_ATTRIBUTE:
+      if (!target.isSetAttribute())
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      element->addAttr(target.getAttribute(),
+        static_cast<const SedChangeAttribute*>(change)->getNewValue());
+
+      if (target.getAttribute() == "id")
+        index.reset();
+
+      return LIBSEDML_OPERATION_SUCCESS;
+
+    case SEDML_CHANGE_ADDXML:
+      {
+        vector<const XMLNode*> elements =
+          getNewElements(static_cast<const SedAddXML*>(change)->getNewXML());
+
+        if (elements.empty() || target.isSetAttribute())
+          return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+        for (size_t i = 0; i < elements.size(); ++i)
+          element->addChild(*elements[i]);
+
+        index.reset();
+        return LIBSEDML_OPERATION_SUCCESS;
+      }
+
+    case SEDML_CHANGE_CHANGEXML:
+    case SEDML_CHANGE_REMOVEXML:
+      {
+        vector<const XMLNode*> elements;
+
+        if (change->getTypeCode() == SEDML_CHANGE_CHANGEXML)
+          {
+            elements = getNewElements(
+              static_cast<const SedChangeXML*>(change)->getNewXML());
+
+            if (elements.empty())
+              return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+          }
+
+        int position = parent != NULL ? getChildIndex(parent, element) : -1;
+
+        if (position < 0 || target.isSetAttribute())
+          return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+        delete parent->removeChild((unsigned int)position);
+
+        for (size_t i = 0; i < elements.size(); ++i)
+          parent->insertChild((unsigned int)(position + i), *elements[i]);
+
+        index.reset();
+        return LIBSEDML_OPERATION_SUCCESS;
+      }
+
+    case SEDML_CHANGE_COMPUTECHANGE:
+      {
+        const SedComputeChange* compute =
+          static_cast<const SedComputeChange*>(change);
+
+        vector<string> ids;
+        vector<double> values;
+
+        for (unsigned int i = 0; i < compute->getNumVariables(); ++i)
+          {
+            const SedVariable* var = compute->getVariable(i);
+            const SedDocument* doc = model->getSedDocument();
+            const SedModel* other = doc != NULL
+              ? doc->getModel(var->getModelReference()) : NULL;
+
+            // variables of other models read them with all their changes,
+            // those of this model read it as changed so far
+            shared_ptr<XMLNode> otherRoot;
+            unique_ptr<SedTargetIndex> otherIndex;
+            const SedTargetIndex* source = index.get();
+
+            if (other != NULL && other != model)
+              {
+                string key;
+                int status = resolveModel(other, otherRoot, key, stack);
+
+                if (status != LIBSEDML_OPERATION_SUCCESS)
+                  return status;
+
+                otherIndex.reset(new SedTargetIndex(otherRoot.get()));
+                source = otherIndex.get();
+              }
+
+            SedTarget varTarget(var->getTarget());
+            const XMLNode* node = source->getElement(varTarget);
+            const char* name = node == NULL ? NULL
+                               : varTarget.isSetAttribute()
+                               ? varTarget.getAttribute().c_str()
+                               : SedTargetIndex::getValueAttribute(node);
+
+            if (name == NULL)
+              return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+            string text = node->getAttrValue(name);
+            double value = 0;
+            const char* end = SedUtil_parseDouble(text.c_str(), value);
+
+            if (end == NULL || *end != '\0')
+              return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+            ids.push_back(var->getId());
+            values.push_back(value);
+          }
+
+        map<string, double> constants;
+
+        for (unsigned int i = 0; i < compute->getNumParameters(); ++i)
+          {
+            const SedParameter* p = compute->getParameter(i);
+            constants[p->getId()] = p->getValue();
+          }
+
+        SedMathProgram program;
+
+        if (program.compile(compute->getMath(), ids, constants)
+            != LIBSEDML_OPERATION_SUCCESS)
+          return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+        const char* name = target.isSetAttribute()
+                           ? target.getAttribute().c_str()
+                           : SedTargetIndex::getValueAttribute(element);
+        char buffer[SEDML_DOUBLE_BUFFER_SIZE];
+        SedUtil_formatDouble(program.evaluate(values.empty() ? NULL
+                                              : &values[0]), buffer);
+        element->addAttr(name != NULL ? name : "value", buffer);
+        return LIBSEDML_OPERATION_SUCCESS;
+      }
+
+    default:
+      return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+    }
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+#endif  /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
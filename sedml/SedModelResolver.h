@@ -0,0 +1,236 @@
+/**
+ * @file    SedModelResolver.h
+ * @brief   Loads the models of a Sed document and applies their changes
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedModelResolver
+ * @ingroup Core
+ * @brief Loads the models of a SedDocument and applies their changes.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedModelResolver turns a SedModel into the XML of the model it
+ * describes.  The "source" of the model is either the id of another
+ * SedModel of the same document, with or without a leading @c #, whose
+ * resolved XML is used as a starting point, or a file, whose path is
+ * taken relative to the base directory of the resolver.  The changes of
+ * the SedModel are then applied in order:
+ *
+ * @li a SedChangeAttribute sets the attribute its target selects;
+ * @li a SedAddXML adds its new XML as last children of its target;
+ * @li a SedChangeXML replaces its target with its new XML;
+ * @li a SedRemoveXML removes its target;
+ * @li a SedComputeChange evaluates its math from its parameters and the
+ * values of its variables, and sets the result as the attribute its
+ * target selects, or as the "value", "size", "initialConcentration" or
+ * "initialAmount" attribute of the element it selects.
+ *
+ * Both the parsed sources and the models with their changes applied are
+ * cached.  A source is identified by a hash of its content, and a model
+ * by the identity of its source together with its list of changes, so
+ * that the models of several tasks or documents that start from the
+ * same file and make the same changes share one instance.  The XML
+ * returned is shared, and must not be changed.
+ *
+ * Sources other than local files, such as MIRIAM URNs or URLs, are
+ * loaded by overriding loadSource().
+ */
+
+#ifndef SedModelResolver_h
+#define SedModelResolver_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedModel;
+class SedChange;
+class SedTargetIndex;
+
+
+class LIBSEDML_EXTERN SedModelResolver
+{
+public:
+
+  /**
+   * Creates a new SedModelResolver.
+   *
+   * @param baseDirectory the directory relative to which the paths of
+   * model files are taken, usually that of the SED-ML document; if
+   * empty, the current directory.
+   */
+  SedModelResolver(const std::string& baseDirectory = "");
+
+
+  /**
+   * Destroys this SedModelResolver and its cache.
+   */
+  virtual ~SedModelResolver();
+
+
+  /**
+   * Returns the base directory of this SedModelResolver.
+   *
+   * @return the directory relative to which the paths of model files
+   * are taken.
+   */
+  const std::string& getBaseDirectory() const;
+
+
+  /**
+   * Sets the base directory of this SedModelResolver.
+   *
+   * @param baseDirectory the directory relative to which the paths of
+   * model files are taken.
+   */
+  void setBaseDirectory(const std::string& baseDirectory);
+
+
+  /**
+   * Resolves the given SedModel.
+   *
+   * @param model the SedModel.
+   * @param result the shared pointer receiving the XML of the model,
+   * with all changes applied.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INVALID_OBJECT, if @p model is @c NULL or its sources
+   * refer to each other
+   * @li LIBSEDML_OPERATION_FAILED, if a source cannot be loaded or
+   * parsed
+   * @li LIBSEDML_INVALID_ATTRIBUTE_VALUE, if a change cannot be applied
+   */
+  int resolve(const SedModel* model, std::shared_ptr<const XMLNode>& result);
+
+
+  /**
+   * Returns the number of sources this SedModelResolver has parsed.
+   *
+   * @return the number of distinct source contents in the cache.
+   */
+  unsigned int getNumSources() const;
+
+
+  /**
+   * Returns the number of models this SedModelResolver holds.
+   *
+   * @return the number of distinct combinations of source and changes
+   * in the cache.
+   */
+  unsigned int getNumInstances() const;
+
+
+  /**
+   * Empties the cache of this SedModelResolver; the models already
+   * returned stay valid.
+   */
+  void clearCache();
+
+
+protected:
+
+  /**
+   * Loads the content of a source that is not a model of the document.
+   *
+   * The default implementation reads local files, with paths relative
+   * to the base directory, and accepts a leading @c file: scheme.
+   *
+   * @param source the "source" attribute of a SedModel.
+   * @param content the string receiving the content of the source.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_OPERATION_FAILED
+   */
+  virtual int loadSource(const std::string& source, std::string& content);
+
+
+  /** @cond doxygen-libsedml-internal */
+
+  struct Source
+  {
+    std::string content;
+    std::shared_ptr<XMLNode> root;
+  };
+
+  /* not copyable */
+  SedModelResolver(const SedModelResolver&);
+  SedModelResolver& operator=(const SedModelResolver&);
+
+  int resolveModel(const SedModel* model, std::shared_ptr<XMLNode>& root,
+                   std::string& key, std::vector<const SedModel*>& stack);
+
+  int parseSource(const std::string& content, std::shared_ptr<XMLNode>& root,
+                  std::string& key);
+
+  int applyChange(const SedModel* model, const SedChange* change,
+                  XMLNode* root, std::unique_ptr<SedTargetIndex>& index,
+                  std::vector<const SedModel*>& stack);
+
+  int describeChanges(const SedModel* model, std::string& description,
+                      std::vector<const SedModel*>& stack);
+
+  std::string mBaseDirectory;
+
+  std::map<std::string, Source> mSources;
+
+  std::map<std::string, std::shared_ptr<XMLNode> > mInstances;
+
+  mutable std::mutex mMutex;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedModelResolver_h */
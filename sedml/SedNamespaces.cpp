@@ -453,6 +453,54 @@ SedNamespaces::setNamespaces(XMLNamespaces * xmlns)
   else
     mNamespaces = NULL;
 }
+
+
+bool
+SedNamespaces::hasSameNamespaces(const XMLNamespaces * xmlns) const
+{
+  if (mNamespaces == NULL || xmlns == NULL)
+    return mNamespaces == xmlns;
+
+  if (mNamespaces->getLength() != xmlns->getLength())
+    return false;
+
+  for (int i = 0; i < xmlns->getLength(); ++i)
+    {
+      if (mNamespaces->getURI(i) != xmlns->getURI(i)
+          || mNamespaces->getPrefix(i) != xmlns->getPrefix(i))
+        return false;
+    }
+
+  return true;
+}
+
+
+std::shared_ptr<SedNamespaces>
+SedNamespaces::getSharedCopy(const XMLNamespaces * xmlns) const
+{
+  // the copy is checked against this object, rather than dropped when
+  // this object is modified, as the namespaces can be modified through
+  // the pointer returned by getNamespaces(); the atomic accesses let
+  // several threads construct elements from the same object
+  std::shared_ptr<SedNamespaces> copy = std::atomic_load(&mSharedCopy);
+
+  if (!copy || copy->mLevel != mLevel || copy->mVersion != mVersion
+      || !copy->hasSameNamespaces(xmlns))
+    {
+      copy = std::make_shared<SedNamespaces>(*this);
+      copy->setNamespaces(const_cast<XMLNamespaces*>(xmlns));
+      std::atomic_store(&mSharedCopy, copy);
+    }
+
+  return copy;
+}
+
+
+std::shared_ptr<SedNamespaces>
+SedNamespaces::getSharedCopy() const
+{
+  return getSharedCopy(mNamespaces);
+}
 /** @endcond */
 
 /** @cond doxygen-c-only */
@@ -97,6 +97,7 @@ static const char* const SEDML_XMLNS_L1V3   = "http://sed-ml.org/sed-ml/level1/v
 
 #include <string>
 #include <stdexcept>
+#include <memory>
 
 LIBSEDML_CPP_NAMESPACE_BEGIN
 
@@ -465,6 +466,30 @@ public:
 
 
   void setNamespaces(XMLNamespaces * xmlns);
+
+
+  /*
+   * Returns true if the namespaces of this object are xmlns: the same
+   * prefixes and URIs, in the same order.
+   */
+  bool hasSameNamespaces(const XMLNamespaces * xmlns) const;
+
+
+  /*
+   * Returns a copy of this object, with xmlns as namespaces, for elements
+   * to share.  The copy must not be modified.  The last copy returned is
+   * kept and returned again for as long as it matches, so that the
+   * elements of a document, which are all constructed from the
+   * SedNamespaces of the document, end up sharing a single copy.
+   */
+  std::shared_ptr<SedNamespaces>
+  getSharedCopy(const XMLNamespaces * xmlns) const;
+
+
+  /*
+   * Returns a copy of this object for elements to share, as above.
+   */
+  std::shared_ptr<SedNamespaces> getSharedCopy() const;
   /** @endcond */
 
 
@@ -477,6 +502,9 @@ protected:
   unsigned int    mVersion;
   XMLNamespaces * mNamespaces;
 
+  /* the copy last returned by getSharedCopy, or NULL */
+  mutable std::shared_ptr<SedNamespaces> mSharedCopy;
+
   /** @endcond */
 };
 
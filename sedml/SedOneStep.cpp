@@ -36,6 +36,7 @@
 
 #include <sedml/SedOneStep.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -54,8 +55,6 @@ SedOneStep::SedOneStep(unsigned int level, unsigned int version)
   , mIsSetStep(false)
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -236,6 +235,42 @@ SedOneStep::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedOneStep::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedSimulation::writeSnapshot(writer);
+
+  writer.writeDouble(mStep);
+  writer.writeBool(mIsSetStep);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedOneStep::readSnapshot(SedSnapshotReader& reader)
+{
+  SedSimulation::readSnapshot(reader);
+
+  mStep = reader.readDouble();
+  mIsSetStep = reader.readBool();
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -244,8 +279,17 @@ SedOneStep::writeElements(XMLOutputStream& stream) const
 bool
 SedOneStep::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      if (isSetAlgorithm() == true)
+        {
+          mAlgorithm->accept(v);
+        }
+    }
+
+  v.leave(*this);
 
+  return true;
 }
 
 
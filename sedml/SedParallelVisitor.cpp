@@ -0,0 +1,198 @@
+/**
+ * @file    SedParallelVisitor.cpp
+ * @brief   Visits the top-level lists of a SedDocument on a pool of threads
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedParallelVisitor.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedListOf.h>
+#include <sedml/SedThreadPool.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygen-libsbml-internal */
+
+/* the number of parts each thread gets on average, so that threads that
+ * finish early can take over some of the work of the others
+ */
+static const size_t SEDML_PARTS_PER_THREAD = 4;
+
+
+/*
+ * A contiguous range of the items of one of the top-level lists.
+ */
+struct SedVisitPart
+{
+  const SedListOf* list;
+  unsigned int first;
+  unsigned int last;
+};
+
+/** @endcond */
+
+
+SedReducibleVisitor::~SedReducibleVisitor()
+{
+}
+
+
+SedParallelVisitor::SedParallelVisitor(unsigned int numThreads)
+  : mNumThreads(numThreads)
+{
+}
+
+
+SedParallelVisitor::~SedParallelVisitor()
+{
+}
+
+
+unsigned int
+SedParallelVisitor::getNumThreads() const
+{
+  return mNumThreads;
+}
+
+
+void
+SedParallelVisitor::setNumThreads(unsigned int numThreads)
+{
+  mNumThreads = numThreads;
+}
+
+
+void
+SedParallelVisitor::traverse(const SedDocument& d,
+                             SedReducibleVisitor& visitor)
+{
+  /* the lists in the order in which SedDocument::accept visits them */
+  const SedListOf* lists[] =
+  {
+    d.getListOfDataDescriptions(),
+    d.getListOfSimulations(),
+    d.getListOfModels(),
+    d.getListOfTasks(),
+    d.getListOfDataGenerators(),
+    d.getListOfOutputs()
+  };
+  const size_t numLists = sizeof(lists) / sizeof(lists[0]);
+
+  size_t numItems = 0;
+
+  for (size_t i = 0; i < numLists; ++i)
+    numItems += lists[i]->size();
+
+  /* split the items into a few parts per thread */
+  size_t numParts = SEDML_PARTS_PER_THREAD * getNumWorkers(numItems);
+  size_t partSize = numParts > 0 ? (numItems + numParts - 1) / numParts : 1;
+
+  vector<SedVisitPart> parts;
+
+  for (size_t i = 0; i < numLists; ++i)
+    {
+      for (unsigned int first = 0; first < lists[i]->size();
+           first += (unsigned int)partSize)
+      {
+        SedVisitPart part;
+        part.list = lists[i];
+        part.first = first;
+        part.last = (unsigned int)min((size_t)lists[i]->size(),
+                                      first + partSize);
+        parts.push_back(part);
+      }
+    }
+
+  visitor.visit(d);
+
+  vector< unique_ptr<SedReducibleVisitor> > workers;
+  workers.reserve(parts.size());
+
+  for (size_t i = 0; i < parts.size(); ++i)
+    workers.push_back(unique_ptr<SedReducibleVisitor>(visitor.createWorker()));
+
+  /* each part is visited by its own worker; the lists themselves are
+   * only visited by the given visitor, below */
+  SedThreadPool::forEach(getNumWorkers(parts.size()), parts.size(),
+                         [&](size_t i)
+  {
+    const SedVisitPart& part = parts[i];
+
+    for (unsigned int n = part.first; n < part.last; ++n)
+      part.list->get(n)->accept(*workers[i]);
+  });
+
+  /* the parts of each list are merged between entering and leaving it */
+  size_t i = 0;
+
+  for (size_t l = 0; l < numLists; ++l)
+    {
+      if (lists[l]->size() == 0)
+        continue;
+
+      int type = lists[l]->getItemTypeCode();
+      visitor.visit(*lists[l], type);
+
+      for (; i < parts.size() && parts[i].list == lists[l]; ++i)
+        visitor.reduce(*workers[i]);
+
+      visitor.leave(*lists[l], type);
+    }
+
+  visitor.leave(d);
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+unsigned int
+SedParallelVisitor::getNumWorkers(size_t numParts) const
+{
+  return SedThreadPool::getNumWorkers(mNumThreads, numParts);
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,193 @@
+/**
+ * @file    SedParallelVisitor.h
+ * @brief   Visits the top-level lists of a SedDocument on a pool of threads
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedParallelVisitor
+ * @ingroup Core
+ * @brief Visits the top-level lists of a SedDocument on a pool of threads.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * The SedParallelVisitor runs a read-only SedReducibleVisitor over a
+ * SedDocument using a number of worker threads.  The elements of the
+ * top-level lists of the document (simulations, models, tasks, data
+ * generators, ...) are split into contiguous parts, and each part is
+ * visited, depth first, by its own visitor created with
+ * SedReducibleVisitor::createWorker().  Once all parts have been
+ * visited, their visitors are merged into the given visitor with
+ * SedReducibleVisitor::reduce(), in the order of the parts in the
+ * document, so that the result does not depend on the number of threads.
+ *
+ * The workers only visit the elements of their parts.  The document and
+ * its non-empty lists are visited and left once, by the given visitor, in
+ * the order SedDocument::accept() uses: each list is visited, the workers
+ * of its parts are reduced into the visitor, and the list is left.  As in
+ * SedDocument::accept(), visit(const SedDocument&) and
+ * visit(const SedListOf&, int) return nothing, so they cannot skip the
+ * lists; an element whose visit() returns @c false still has its
+ * children skipped.
+ *
+ * There is one worker per part rather than per thread: the threads take
+ * parts in any order, and a worker per part lets the results be reduced
+ * in document order.  With a few parts per thread, createWorker() and
+ * reduce() are called a few times as often as there are threads, so
+ * workers should be cheap to create.
+ *
+ * The document must not be modified while it is visited.
+ */
+
+#ifndef SedParallelVisitor_h
+#define SedParallelVisitor_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <sedml/SedVisitor.h>
+
+#include <cstddef>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedReducibleVisitor : public SedVisitor
+{
+public:
+
+  /**
+   * Destroys this SedReducibleVisitor.
+   */
+  virtual ~SedReducibleVisitor();
+
+
+  /**
+   * Creates a new visitor of the same kind as this one, without any
+   * state, to visit a part of a document.
+   *
+   * Workers are created on the calling thread before the document is
+   * visited, and are then each used by one thread only.
+   *
+   * @return a new SedReducibleVisitor, owned by the caller.
+   */
+  virtual SedReducibleVisitor* createWorker() const = 0;
+
+
+  /**
+   * Merges the state of the given worker into this visitor.
+   *
+   * @param worker a visitor created by createWorker(), which has visited
+   * a part of the document.
+   */
+  virtual void reduce(const SedReducibleVisitor& worker) = 0;
+};
+
+
+class LIBSEDML_EXTERN SedParallelVisitor
+{
+public:
+
+  /**
+   * Creates a new SedParallelVisitor using the given number of threads.
+   *
+   * @param numThreads the number of worker threads; @c 0 (the default)
+   * uses the number of hardware threads available.
+   */
+  SedParallelVisitor(unsigned int numThreads = 0);
+
+
+  /**
+   * Destroys this SedParallelVisitor.
+   */
+  virtual ~SedParallelVisitor();
+
+
+  /**
+   * Returns the number of worker threads used by this SedParallelVisitor.
+   *
+   * @return the number of threads, @c 0 for the number of hardware
+   * threads available.
+   */
+  unsigned int getNumThreads() const;
+
+
+  /**
+   * Sets the number of worker threads used by this SedParallelVisitor.
+   *
+   * @param numThreads the number of worker threads; @c 0 uses the number
+   * of hardware threads available.
+   */
+  void setNumThreads(unsigned int numThreads);
+
+
+  /**
+   * Visits the given document in parallel.
+   *
+   * The method returns once all parts have been visited and reduced into
+   * @p visitor.  If a worker throws an exception, the remaining parts are
+   * skipped, nothing is reduced, and the exception is rethrown.
+   *
+   * @param d the SedDocument to visit
+   * @param visitor the SedReducibleVisitor that visits @p d, and into
+   * which the workers are reduced
+   */
+  void traverse(const SedDocument& d, SedReducibleVisitor& visitor);
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  /**
+   * Returns the number of threads to use for the given number of parts.
+   */
+  unsigned int getNumWorkers(size_t numParts) const;
+
+
+  unsigned int mNumThreads;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif /* __cplusplus */
+
+#endif  /* SedParallelVisitor_h */
@@ -36,6 +36,7 @@
 
 #include <sedml/SedParameter.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -56,8 +57,6 @@ SedParameter::SedParameter(unsigned int level, unsigned int version)
   , mIsSetValue(false)
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -193,7 +192,9 @@ SedParameter::isSetValue() const
 int
 SedParameter::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  indexElement();
+  return result;
 }
 
 
@@ -229,6 +230,7 @@ int
 SedParameter::unsetId()
 {
   mId.erase();
+  indexElement();
 
   if (mId.empty() == true)
     {
@@ -334,6 +336,46 @@ SedParameter::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedParameter::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedBase::writeSnapshot(writer);
+
+  writer.writeString(mId);
+  writer.writeString(mName);
+  writer.writeDouble(mValue);
+  writer.writeBool(mIsSetValue);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedParameter::readSnapshot(SedSnapshotReader& reader)
+{
+  SedBase::readSnapshot(reader);
+
+  mId = reader.readString();
+  mName = reader.readString();
+  mValue = reader.readDouble();
+  mIsSetValue = reader.readBool();
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -342,8 +384,10 @@ SedParameter::writeElements(XMLOutputStream& stream) const
 bool
 SedParameter::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
 
+  return true;
 }
 
 
@@ -474,7 +518,6 @@ SedListOfParameters::SedListOfParameters(unsigned int level,
     unsigned int version)
   : SedListOf(level, version)
 {
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -535,10 +578,8 @@ SedListOfParameters::get(const std::string& sid)
 const SedParameter*
 SedListOfParameters::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedParameter>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <SedParameter*>(*result);
+  int index = getIndexById(sid);
+  return (index < 0) ? 0 : static_cast <SedParameter*>(mItems[index]);
 }
 
 
@@ -610,14 +651,11 @@ SedParameter*
 SedListOfParameters::remove(const std::string& sid)
 {
   SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedParameter>(sid));
+  int index = getIndexById(sid);
 
-  if (result != mItems.end())
+  if (index >= 0)
     {
-      item = *result;
-      mItems.erase(result);
+      item = SedListOf::remove((unsigned int)index);
     }
 
   return static_cast <SedParameter*>(item);
@@ -36,6 +36,7 @@
 
 #include <sedml/SedPlot2D.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -57,9 +58,6 @@ SedPlot2D::SedPlot2D(unsigned int level, unsigned int version)
   , mIsSetLogY(false)
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
-
   // connect to child objects
   connectToChild();
 }
@@ -450,6 +448,48 @@ SedPlot2D::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedPlot2D::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedOutput::writeSnapshot(writer);
+
+  mCurves.writeSnapshot(writer);
+  writer.writeBool(mLogX);
+  writer.writeBool(mIsSetLogX);
+  writer.writeBool(mLogY);
+  writer.writeBool(mIsSetLogY);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedPlot2D::readSnapshot(SedSnapshotReader& reader)
+{
+  SedOutput::readSnapshot(reader);
+
+  mCurves.readSnapshot(reader);
+  mLogX = reader.readBool();
+  mIsSetLogX = reader.readBool();
+  mLogY = reader.readBool();
+  mIsSetLogY = reader.readBool();
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -458,8 +498,17 @@ SedPlot2D::writeElements(XMLOutputStream& stream) const
 bool
 SedPlot2D::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      if (getNumCurves() > 0)
+        {
+          mCurves.accept(v);
+        }
+    }
+
+  v.leave(*this);
 
+  return true;
 }
 
 
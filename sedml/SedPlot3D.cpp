@@ -36,6 +36,7 @@
 
 #include <sedml/SedPlot3D.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -53,9 +54,6 @@ SedPlot3D::SedPlot3D(unsigned int level, unsigned int version)
   , mSurfaces(level, version)
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
-
   // connect to child objects
   connectToChild();
 }
@@ -346,6 +344,40 @@ SedPlot3D::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedPlot3D::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedOutput::writeSnapshot(writer);
+
+  mSurfaces.writeSnapshot(writer);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedPlot3D::readSnapshot(SedSnapshotReader& reader)
+{
+  SedOutput::readSnapshot(reader);
+
+  mSurfaces.readSnapshot(reader);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -354,8 +386,17 @@ SedPlot3D::writeElements(XMLOutputStream& stream) const
 bool
 SedPlot3D::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      if (getNumSurfaces() > 0)
+        {
+          mSurfaces.accept(v);
+        }
+    }
+
+  v.leave(*this);
 
+  return true;
 }
 
 
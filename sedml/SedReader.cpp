@@ -44,10 +44,22 @@
 #include <sedml/SedDocument.h>
 #include <sedml/SedError.h>
 #include <sedml/SedReader.h>
+#include <sedml/SedArena.h>
+#include <sedml/SedLoadStatistics.h>
 
 #include <sbml/compress/CompressCommon.h>
 #include <sbml/compress/InputDecompressor.h>
 
+#include <cstring>
+#include <string>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 /** @cond doxygen-ignored */
 
 using namespace std;
@@ -60,6 +72,9 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
  * Creates a new SedReader and returns it.
  */
 SedReader::SedReader()
+  : mUseArena(false)
+  , mUseMemoryMap(false)
+  , mTraceEnabled(false)
 {
 }
 
@@ -124,12 +139,11 @@ SedReader::readSedMLFromFile(const std::string& filename)
 /*
  * Reads an Sed document from the given XML string.
  *
- * If the string does not begin with XML declaration:
+ * If the string does not begin with XML declaration, it is read as if it
+ * began with:
  *
  *   <?xml version='1.0' encoding='UTF-8'?>
  *
- * it will be prepended.
- *
  * This method will log a fatal error if the XML string is not Sed.  See
  * the method documentation for readSedML(filename) for example error
  * checking code.
@@ -139,20 +153,91 @@ SedReader::readSedMLFromFile(const std::string& filename)
 SedDocument*
 SedReader::readSedMLFromString(const std::string& xml)
 {
+  return readInternal(xml.c_str(), false);
+}
 
-  const static string dummy_xml("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
 
-  if (!strncmp(xml.c_str(), dummy_xml.c_str(), 14))
+/*
+ * Reads an Sed document from the given buffer, which is only copied if it
+ * does not end with a NUL byte.
+ */
+SedDocument*
+SedReader::readSedMLFromBuffer(const char* buffer, size_t length)
+{
+  if (buffer == NULL || length == 0)
     {
-      return readInternal(xml.c_str(), false);
+      return readInternal("", false);
+    }
+  else if (buffer[length - 1] == '\0')
+    {
+      return readInternal(buffer, false);
     }
   else
     {
-      const std::string temp = (dummy_xml + xml);
-      return readInternal(temp.c_str(), false);
+      const std::string xml(buffer, length);
+      return readInternal(xml.c_str(), false);
     }
+}
 
 
+/*
+ * Sets whether the elements of documents read are allocated from an arena.
+ */
+void
+SedReader::setUseArena(bool useArena)
+{
+  mUseArena = useArena;
+}
+
+
+/*
+ * Returns whether the elements of documents read are allocated from an
+ * arena.
+ */
+bool
+SedReader::getUseArena() const
+{
+  return mUseArena;
+}
+
+
+/*
+ * Sets whether files read are mapped into memory.
+ */
+void
+SedReader::setUseMemoryMap(bool useMemoryMap)
+{
+  mUseMemoryMap = useMemoryMap;
+}
+
+
+/*
+ * Returns whether files read are mapped into memory.
+ */
+bool
+SedReader::getUseMemoryMap() const
+{
+  return mUseMemoryMap;
+}
+
+
+/*
+ * Sets whether the phases of reading are recorded as events.
+ */
+void
+SedReader::setTraceEnabled(bool traceEnabled)
+{
+  mTraceEnabled = traceEnabled;
+}
+
+
+/*
+ * Returns whether the phases of reading are recorded as events.
+ */
+bool
+SedReader::getTraceEnabled() const
+{
+  return mTraceEnabled;
 }
 
 
@@ -227,69 +312,217 @@ SedReader::readInternal(const char* content, bool isFile)
   //  d->setURI(content);
   //}
 
+  readDocument(d, content, isFile);
+
+  return d;
+}
+/** @endcond */
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Returns true if the given file will be read through one of the
+ * decompressors of libsbml.
+ */
+static bool
+isCompressedFile(const std::string& filename)
+{
+  static const char* suffixes[] = { ".gz", ".zip", ".bz2" };
+
+  for (size_t i = 0; i < sizeof(suffixes) / sizeof(suffixes[0]); ++i)
+    {
+      size_t length = strlen(suffixes[i]);
+
+      if (filename.size() >= length &&
+          strcmp_insensitive(filename.c_str() + filename.size() - length,
+                             suffixes[i]) == 0)
+        return true;
+    }
+
+  return false;
+}
+
+
+/*
+ * The content of a file mapped into memory, followed by at least one NUL
+ * byte so that it can be parsed as a string.
+ */
+class SedMappedFile
+{
+public:
+  SedMappedFile(const char* filename)
+    : mContent(NULL)
+    , mAddress(NULL)
+    , mLength(0)
+  {
+#if !defined(_WIN32)
+    int fd = open(filename, O_RDONLY);
+
+    if (fd < 0) return;
+
+    struct stat info;
+
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode))
+      {
+        size_t size = static_cast<size_t>(info.st_size);
+        size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+        // reserve zeroed pages for the file plus its terminator, and map
+        // the file over the start of them
+        size_t length = (size / page + 1) * page;
+        void* address = mmap(NULL, length, PROT_READ,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (address != MAP_FAILED)
+          {
+            if (size == 0 ||
+                mmap(address, size, PROT_READ, MAP_PRIVATE | MAP_FIXED,
+                     fd, 0) != MAP_FAILED)
+              {
+                if (size > 0)
+                  madvise(address, size, MADV_SEQUENTIAL);
+
+                mAddress = address;
+                mLength = length;
+                mContent = static_cast<const char*>(address);
+              }
+            else
+              {
+                munmap(address, length);
+              }
+          }
+      }
+
+    close(fd);
+#endif
+  }
+
+  ~SedMappedFile()
+  {
+#if !defined(_WIN32)
+    if (mAddress != NULL)
+      munmap(mAddress, mLength);
+#endif
+  }
+
+  /* the content of the file, or NULL if it could not be mapped */
+  const char* getContent() const
+  {
+    return mContent;
+  }
+
+private:
+  SedMappedFile(const SedMappedFile&);
+  SedMappedFile& operator=(const SedMappedFile&);
+
+  const char* mContent;
+  void* mAddress;
+  size_t mLength;
+};
+/** @endcond */
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Reads the content into the given document.
+ */
+void
+SedReader::readDocument(SedDocument* d, const char* content, bool isFile)
+{
+  d->getLoadStatistics().setTraceEnabled(mTraceEnabled);
+  SEDML_COLLECT_STATISTICS(d->getLoadStatistics());
+  SEDML_TIME_PHASE(SEDML_PHASE_READ);
+
   if (isFile && content != NULL && (util_file_exists(content) == false))
     {
       d->getErrorLog()->logError(XMLFileUnreadable);
+      return;
     }
-  else
-    {
-      XMLInputStream stream(content, isFile, "", d->getErrorLog());
 
-      d->read(stream);
+  if (isFile && mUseMemoryMap && !isCompressedFile(content))
+    {
+      SedMappedFile file(content);
 
-      if (stream.isError())
+      if (file.getContent() != NULL)
         {
-          // If we encountered an error, some parsers will report it sooner
-          // than others.  Unfortunately, those that fail sooner do it in an
-          // opaque call, so we can't change the behavior.  Since we don't want
-          // different parsers to report different validation errors, we bring
-          // all parsers back to the same point.
+          parseDocument(d, file.getContent(), false, false);
+          return;
+        }
+    }
 
+  // strings are read as if they began with an XML declaration
+  bool impliedDeclaration = !isFile && content != NULL &&
+                            strncmp(content, "<?xml", 5) != 0;
 
-          for (unsigned int i = 0; i < d->getErrorLog()->getNumErrors(); ++i)
-            {
-              if (isCriticalError(d->getErrorLog()->getError(i)->getErrorId()))
-                {
-                  // If we find even one critical error, all other errors are
-                  // suspect and may be bogus.  Remove them.
-
-                  for (int n = d->getErrorLog()->getNumErrors() - 1; n >= 0; n--)
-                    if (!isCriticalError(d->getErrorLog()->getError(n)->getErrorId()))
-                      {
-                        d->getErrorLog()->remove(d->getErrorLog()->getError(n)->getErrorId());
-                      }
-
-                  break;
-                }
-            }
-        }
-      else
-        {
-          // Low-level XML errors will have been caught in the first read,
-          // before we even attempt to interpret the content as Sed.  Here
-          // we want to start checking some basic Sed-level errors.
+  parseDocument(d, content, isFile, impliedDeclaration);
+}
 
-          if (stream.getEncoding() == "")
-            {
-              d->getErrorLog()->logError(MissingXMLEncoding);
-            }
-          else if (strcmp_insensitive(stream.getEncoding().c_str(), "UTF-8") != 0)
-            {
-              d->getErrorLog()->logError(SedNotUTF8);
-            }
 
-          if (stream.getVersion() == "")
-            {
-              d->getErrorLog()->logError(BadXMLDecl);
-            }
-          else if (strcmp_insensitive(stream.getVersion().c_str(), "1.0") != 0)
+/*
+ * Parses the given content into the given document.
+ */
+void
+SedReader::parseDocument(SedDocument* d, const char* content, bool isFile,
+                         bool impliedDeclaration)
+{
+  XMLInputStream stream(content, isFile, "", d->getErrorLog());
+
+  // the arena is kept alive by the scope, and then by the elements
+  // allocated from it
+  SedArena* arena = mUseArena ? SedArena::create() : NULL;
+  SedArenaScope scope(arena);
+
+  if (arena != NULL) arena->removeReference();
+
+  d->read(stream);
+
+  if (stream.isError())
+    {
+      // If we encountered an error, some parsers will report it sooner
+      // than others.  Unfortunately, those that fail sooner do it in an
+      // opaque call, so we can't change the behavior.  Since we don't want
+      // different parsers to report different validation errors, we bring
+      // all parsers back to the same point.
+
+
+      SedErrorLog* log = d->getErrorLog();
+
+      for (unsigned int i = 0; i < log->getNumErrors(); ++i)
+        {
+          if (isCriticalError(log->getError(i)->getErrorId()))
             {
-              d->getErrorLog()->logError(BadXMLDecl);
+              // If we find even one critical error, all other errors are
+              // suspect and may be bogus.  Remove them.
+
+              log->removeAllExcept(isCriticalError);
+              break;
             }
         }
     }
+  else if (!impliedDeclaration)
+    {
+      // Low-level XML errors will have been caught in the first read,
+      // before we even attempt to interpret the content as Sed.  Here
+      // we want to start checking some basic Sed-level errors.
 
-  return d;
+      if (stream.getEncoding() == "")
+        {
+          d->getErrorLog()->logError(MissingXMLEncoding);
+        }
+      else if (strcmp_insensitive(stream.getEncoding().c_str(), "UTF-8") != 0)
+        {
+          d->getErrorLog()->logError(SedNotUTF8);
+        }
+
+      if (stream.getVersion() == "")
+        {
+          d->getErrorLog()->logError(BadXMLDecl);
+        }
+      else if (strcmp_insensitive(stream.getVersion().c_str(), "1.0") != 0)
+        {
+          d->getErrorLog()->logError(BadXMLDecl);
+        }
+    }
 }
 /** @endcond */
 
@@ -319,6 +552,42 @@ SedReader_free(SedReader_t *sr)
 }
 
 
+/**
+ * Sets whether the elements of documents read are allocated from an arena.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setUseArena(SedReader_t *sr, int useArena)
+{
+  if (sr != NULL)
+    sr->setUseArena(useArena != 0);
+}
+
+
+/**
+ * Sets whether files read by the given SedReader are mapped into memory.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setUseMemoryMap(SedReader_t *sr, int useMemoryMap)
+{
+  if (sr != NULL)
+    sr->setUseMemoryMap(useMemoryMap != 0);
+}
+
+
+/**
+ * Sets whether the phases of reading a document are recorded as events.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setTraceEnabled(SedReader_t *sr, int traceEnabled)
+{
+  if (sr != NULL)
+    sr->setTraceEnabled(traceEnabled != 0);
+}
+
+
 /**
  * Reads an Sed document from the given file.  If filename does not exist
  * or is not an Sed file, an error will be logged.  Errors can be
@@ -392,12 +661,11 @@ SedReader_readSedMLFromFile(SedReader_t *sr, const char *filename)
 /**
  * Reads an Sed document from the given XML string.
  *
- * If the string does not begin with XML declaration:
+ * If the string does not begin with XML declaration, it is read as if it
+ * began with:
  *
  *   <?xml version='1.0' encoding='UTF-8'?>
  *
- * it will be prepended.
- *
  * This method will log a fatal error if the XML string is not Sed.  See
  * the method documentation for readSedML(filename) for example error
  * checking code.
@@ -409,13 +677,28 @@ SedDocument_t *
 SedReader_readSedMLFromString(SedReader_t *sr, const char *xml)
 {
   if (sr != NULL)
-    return (xml != NULL) ? sr->readSedMLFromString(xml) :
+    return (xml != NULL) ? sr->readSedMLFromBuffer(xml, strlen(xml) + 1) :
            sr->readSedMLFromString("");
   else
     return NULL;
 }
 
 
+/**
+ * Reads an Sed document from the given buffer of @p length bytes.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedReader_readSedMLFromBuffer(SedReader_t *sr, const char *buffer,
+                              size_t length)
+{
+  if (sr != NULL)
+    return sr->readSedMLFromBuffer(buffer, length);
+  else
+    return NULL;
+}
+
+
 /**
  * Predicate returning @c non-zero or @c zero depending on whether
  * underlying libSed is linked with zlib at compile time.
@@ -543,12 +826,11 @@ readSedMLFromFile(const char *filename)
 /**
  * Reads an Sed document from the given XML string.
  *
- * If the string does not begin with XML declaration:
+ * If the string does not begin with XML declaration, it is read as if it
+ * began with:
  *
  *   <?xml version='1.0' encoding='UTF-8'?>
  *
- * it will be prepended.
- *
  * This method will log a fatal error if the XML string is not Sed.  See
  * the method documentation for readSedML(filename) for example error
  * checking code.
@@ -560,7 +842,23 @@ SedDocument_t *
 readSedMLFromString(const char *xml)
 {
   SedReader sr;
-  return (xml != NULL) ? sr.readSedMLFromString(xml) : sr.readSedMLFromString("");
+  return (xml != NULL) ? sr.readSedMLFromBuffer(xml, strlen(xml) + 1) :
+         sr.readSedMLFromString("");
+}
+
+
+/**
+ * Reads an Sed document from a buffer of @p length bytes holding XML
+ * content.  The buffer is not copied if its last byte is a NUL byte.
+ *
+ * @return a pointer to the SedDocument read.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+readSedMLFromBuffer(const char *buffer, size_t length)
+{
+  SedReader sr;
+  return sr.readSedMLFromBuffer(buffer, length);
 }
 
 LIBSEDML_CPP_NAMESPACE_END
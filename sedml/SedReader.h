@@ -98,6 +98,8 @@
 #include <sedml/common/sedmlfwd.h>
 #include <sbml/util/util.h>
 
+#include <stddef.h>
+
 
 #ifdef __cplusplus
 
@@ -396,9 +398,9 @@ public:
    *
    * This method is flexible with respect to the presence of an XML
    * declaration at the beginning of the string.  In particular, if the
-   * string in @p xml does not begin with the XML declaration
-   * <code>&lt;?xml version='1.0' encoding='UTF-8'?&gt;</code>, then this
-   * method will automatically prepend the declaration to @p xml.
+   * string in @p xml does not begin with an XML declaration, it is read
+   * as if it began with
+   * <code>&lt;?xml version='1.0' encoding='UTF-8'?&gt;</code>.
    *
    * This method will log a fatal error if the content given in the
    * parameter @p xml is not Sed.  See the method documentation for
@@ -414,6 +416,26 @@ public:
   SedDocument* readSedMLFromString(const std::string& xml);
 
 
+  /**
+   * Reads an Sed document from the given buffer holding XML content.
+   *
+   * The content is parsed in place: if the last of the @p length bytes
+   * is a NUL byte (as for a C string whose terminator is included in
+   * @p length), the buffer is not copied at all.  Otherwise it is copied
+   * once, to add the terminator the XML parser needs.  Like
+   * readSedMLFromString(), this method accepts content without an XML
+   * declaration.
+   *
+   * @param buffer the XML content.
+   * @param length the number of bytes in @p buffer.
+   *
+   * @return a pointer to the SedDocument created from the Sed content.
+   *
+   * @see SedReader::readSedMLFromString(@if java String xml@endif)
+   */
+  SedDocument* readSedMLFromBuffer(const char* buffer, size_t length);
+
+
   /**
    * Static method; returns @c true if this copy of libSed supports
    * <i>gzip</I> and <i>zip</i> format compression.
@@ -450,15 +472,119 @@ public:
   static bool hasBzip2();
 
 
+  /**
+   * Sets whether the elements of documents read by this SedReader are
+   * allocated from a SedArena owned by the document.
+   *
+   * Allocating from an arena makes reading faster and keeps the heap from
+   * fragmenting when many documents are read and discarded.  The memory
+   * of the elements is only given back once all elements of the document
+   * are deleted, so this is best used for documents that are mostly read
+   * rather than edited.
+   *
+   * @param useArena @c true to allocate from an arena, @c false (the
+   * default) to use the system allocator.
+   *
+   * @see SedArena
+   */
+  void setUseArena(bool useArena);
+
+
+  /**
+   * Returns whether the elements of documents read by this SedReader are
+   * allocated from a SedArena.
+   *
+   * @return @c true if an arena is used, @c false otherwise.
+   *
+   * @see setUseArena(bool useArena)
+   */
+  bool getUseArena() const;
+
+
+  /**
+   * Sets whether files read by this SedReader are mapped into memory
+   * rather than read through a buffered stream.
+   *
+   * Mapping a large file avoids copying its content and lets the
+   * operating system page it in as it is parsed.  Compressed files are
+   * always read through a stream, as are all files on platforms without
+   * memory mapping.  A file must not be modified while it is read.
+   *
+   * @param useMemoryMap @c true to map files into memory, @c false (the
+   * default) to read them through a stream.
+   */
+  void setUseMemoryMap(bool useMemoryMap);
+
+
+  /**
+   * Returns whether files read by this SedReader are mapped into memory.
+   *
+   * @return @c true if files are mapped into memory, @c false otherwise.
+   *
+   * @see setUseMemoryMap(bool useMemoryMap)
+   */
+  bool getUseMemoryMap() const;
+
+
+  /**
+   * Sets whether the phases of reading a document are recorded as events
+   * in its SedLoadStatistics, from which a trace can be written with
+   * SedLoadStatistics::writeChromeTrace().
+   *
+   * This has no effect unless libSEDML was built with the CMake option
+   * @c WITH_INSTRUMENTATION.
+   *
+   * @param traceEnabled @c true to record events, @c false (the default)
+   * to only count and time the phases.
+   *
+   * @see SedDocument::getLoadStatistics()
+   */
+  void setTraceEnabled(bool traceEnabled);
+
+
+  /**
+   * Returns whether the phases of reading a document are recorded as
+   * events.
+   *
+   * @return @c true if events are recorded, @c false otherwise.
+   *
+   * @see setTraceEnabled(bool traceEnabled)
+   */
+  bool getTraceEnabled() const;
+
+
 protected:
   /** @cond doxygen-libsbml-internal */
 
   /**
    * Used by readSedML() and readSedMLFromString().
    *
+   * Subclasses may override this method to prepare the SedDocument
+   * before its content is read by readDocument().
+   *
    * @if notcpp @htmlinclude warn-default-args-in-docs.html @endif@~
    */
-  SedDocument* readInternal(const char* content, bool isFile = true);
+  virtual SedDocument* readInternal(const char* content, bool isFile = true);
+
+
+  /**
+   * Reads the given content (a filename or an XML string) into the
+   * (empty) SedDocument @p d, logging any errors in its SedErrorLog.
+   */
+  void readDocument(SedDocument* d, const char* content, bool isFile);
+
+
+  /**
+   * Parses the given content into @p d; the checks of the XML declaration
+   * are skipped for strings that have none.
+   */
+  void parseDocument(SedDocument* d, const char* content, bool isFile,
+                     bool impliedDeclaration);
+
+
+  bool mUseArena;
+  bool mUseMemoryMap;
+  bool mTraceEnabled;
 
   /** @endcond */
 };
@@ -490,6 +616,32 @@ void
 SedReader_free(SedReader_t *sr);
 
 
+/**
+ * Sets whether the elements of documents read by the given SedReader are
+ * allocated from an arena (@p useArena non-zero) or not.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setUseArena(SedReader_t *sr, int useArena);
+
+
+/**
+ * Sets whether files read by the given SedReader are mapped into memory.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setUseMemoryMap(SedReader_t *sr, int useMemoryMap);
+
+
+/**
+ * Sets whether the phases of reading a document with the given SedReader
+ * are recorded as events.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setTraceEnabled(SedReader_t *sr, int traceEnabled);
+
+
 /**
  * Reads an Sed document from the given file.  If filename does not exist
  * or is not an Sed file, an error will be logged.  Errors can be
@@ -552,12 +704,11 @@ SedReader_readSedMLFromFile(SedReader_t *sr, const char *filename);
 /**
  * Reads an Sed document from the given XML string.
  *
- * If the string does not begin with XML declaration:
+ * If the string does not begin with XML declaration, it is read as if it
+ * began with:
  *
  *   <?xml version='1.0' encoding='UTF-8'?>
  *
- * it will be prepended.
- *
  * This method will log a fatal error if the XML string is not Sed.  See
  * the method documentation for readSedML(filename) for example error
  * checking code.
@@ -569,6 +720,19 @@ SedDocument_t *
 SedReader_readSedMLFromString(SedReader_t *sr, const char *xml);
 
 
+/**
+ * Reads an Sed document from the given buffer of @p length bytes.  The
+ * buffer is not copied if its last byte is a NUL byte.
+ *
+ * @return a pointer to the SedDocument read.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedReader_readSedMLFromBuffer(SedReader_t *sr, const char *buffer,
+                              size_t length);
+
+
+
 /**
  * Predicate returning @c non-zero or @c zero depending on whether
  * underlying libSed is linked with..
@@ -617,12 +781,11 @@ readSedMLFromFile(const char *filename);
 /**
  * Reads an Sed document from a string assumed to be in XML format.
  *
- * If the string does not begin with XML declaration,
+ * If the string does not begin with XML declaration, it is read as if it
+ * began with
  *@verbatim
 <?xml version='1.0' encoding='UTF-8'?>
 @endverbatim
- *
- * an XML declaration string will be prepended.
  *
  * This method will report an error if the given string @p xml is not Sed.
  * The error will be logged in the error log of the SedDocument object
@@ -637,6 +800,17 @@ SedDocument_t *
 readSedMLFromString(const char *xml);
 
 
+/**
+ * Reads an Sed document from a buffer of @p length bytes holding XML
+ * content.  The buffer is not copied if its last byte is a NUL byte.
+ *
+ * @return a pointer to the SedDocument read.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+readSedMLFromBuffer(const char *buffer, size_t length);
+
+
 END_C_DECLS
 LIBSEDML_CPP_NAMESPACE_END
 
@@ -52,8 +52,6 @@ SedRemoveXML::SedRemoveXML(unsigned int level, unsigned int version)
   : SedChange(level, version)
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -181,8 +179,10 @@ SedRemoveXML::writeElements(XMLOutputStream& stream) const
 bool
 SedRemoveXML::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
 
+  return true;
 }
 
 
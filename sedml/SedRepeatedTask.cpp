@@ -36,6 +36,7 @@
 
 #include <sedml/SedRepeatedTask.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -58,9 +59,6 @@ SedRepeatedTask::SedRepeatedTask(unsigned int level, unsigned int version)
   , mSubTasks(level, version)
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
-
   // connect to child objects
   connectToChild();
 }
@@ -767,6 +765,50 @@ SedRepeatedTask::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedRepeatedTask::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedTask::writeSnapshot(writer);
+
+  writer.writeString(mRangeId);
+  writer.writeBool(mResetModel);
+  writer.writeBool(mIsSetResetModel);
+  mRanges.writeSnapshot(writer);
+  mTaskChanges.writeSnapshot(writer);
+  mSubTasks.writeSnapshot(writer);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedRepeatedTask::readSnapshot(SedSnapshotReader& reader)
+{
+  SedTask::readSnapshot(reader);
+
+  mRangeId = reader.readString();
+  mResetModel = reader.readBool();
+  mIsSetResetModel = reader.readBool();
+  mRanges.readSnapshot(reader);
+  mTaskChanges.readSnapshot(reader);
+  mSubTasks.readSnapshot(reader);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -775,8 +817,27 @@ SedRepeatedTask::writeElements(XMLOutputStream& stream) const
 bool
 SedRepeatedTask::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      if (getNumRanges() > 0)
+        {
+          mRanges.accept(v);
+        }
+
+      if (getNumTaskChanges() > 0)
+        {
+          mTaskChanges.accept(v);
+        }
+
+      if (getNumSubTasks() > 0)
+        {
+          mSubTasks.accept(v);
+        }
+    }
+
+  v.leave(*this);
 
+  return true;
 }
 
 
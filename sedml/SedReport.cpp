@@ -36,6 +36,7 @@
 
 #include <sedml/SedReport.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -53,9 +54,6 @@ SedReport::SedReport(unsigned int level, unsigned int version)
   , mDataSets(level, version)
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
-
   // connect to child objects
   connectToChild();
 }
@@ -346,6 +344,40 @@ SedReport::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedReport::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedOutput::writeSnapshot(writer);
+
+  mDataSets.writeSnapshot(writer);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedReport::readSnapshot(SedSnapshotReader& reader)
+{
+  SedOutput::readSnapshot(reader);
+
+  mDataSets.readSnapshot(reader);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -354,8 +386,17 @@ SedReport::writeElements(XMLOutputStream& stream) const
 bool
 SedReport::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      if (getNumDataSets() > 0)
+        {
+          mDataSets.accept(v);
+        }
+    }
+
+  v.leave(*this);
 
+  return true;
 }
 
 
@@ -0,0 +1,607 @@
+/**
+ * @file    SedResultStore.cpp
+ * @brief   Columnar storage of the values recorded by Sed tasks
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedResultStore.h>
+#include <sedml/SedExpressionDag.h>
+#include <sedml/SedVariable.h>
+
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+using namespace std;
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * The values of one column, either in memory or in a memory-mapped
+ * temporary file.
+ */
+class SedResultColumn
+{
+public:
+  SedResultColumn(const vector<size_t>& shape, size_t size)
+    : mShape(shape)
+    , mSize(size)
+    , mData(NULL)
+    , mValues()
+    , mAddress(NULL)
+    , mLength(0)
+  {
+  }
+
+  ~SedResultColumn()
+  {
+#if !defined(_WIN32)
+    if (mAddress != NULL)
+      munmap(mAddress, mLength);
+#endif
+  }
+
+  /* keeps the values in memory */
+  bool allocate()
+  {
+    try
+      {
+        mValues.assign(mSize, 0.0);
+      }
+    catch (const bad_alloc&)
+      {
+        return false;
+      }
+
+    mData = mValues.empty() ? NULL : &mValues[0];
+    return true;
+  }
+
+  /* keeps the values in a file of the given directory, which is removed
+   * right away so that only the mapping refers to it */
+  bool map(const string& directory)
+  {
+#if !defined(_WIN32)
+    string dir = directory;
+
+    if (dir.empty())
+      {
+        const char* tmp = getenv("TMPDIR");
+        dir = (tmp != NULL && *tmp != '\0') ? tmp : "/tmp";
+      }
+
+    string path = dir + "/sedml-results-XXXXXX";
+    vector<char> name(path.begin(), path.end());
+    name.push_back('\0');
+
+    int fd = mkstemp(&name[0]);
+
+    if (fd < 0)
+      return false;
+
+    unlink(&name[0]);
+
+    size_t length = mSize * sizeof(double);
+    void* address = MAP_FAILED;
+
+    if (ftruncate(fd, (off_t)length) == 0)
+      address = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                     fd, 0);
+
+    close(fd);
+
+    if (address == MAP_FAILED)
+      return false;
+
+    mAddress = address;
+    mLength = length;
+    mData = static_cast<double*>(address);
+    return true;
+#else
+    (void)directory;
+    return false;
+#endif
+  }
+
+  vector<size_t> mShape;
+  size_t mSize;
+  double* mData;
+  vector<double> mValues;
+  void* mAddress;
+  size_t mLength;
+
+private:
+  SedResultColumn(const SedResultColumn&);
+  SedResultColumn& operator=(const SedResultColumn&);
+};
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Creates a new, empty SedResultStore.
+ */
+SedResultStore::SedResultStore(size_t memoryBudget)
+  : mMemoryBudget(memoryBudget)
+  , mSpillDirectory()
+  , mColumns()
+  , mIndex()
+  , mMemoryUsage(0)
+  , mMutex()
+{
+}
+
+
+/*
+ * Destroys this SedResultStore and all of its columns.
+ */
+SedResultStore::~SedResultStore()
+{
+  clear();
+}
+
+
+/*
+ * Returns the memory budget of this SedResultStore.
+ */
+size_t
+SedResultStore::getMemoryBudget() const
+{
+  lock_guard<mutex> lock(mMutex);
+  return mMemoryBudget;
+}
+
+
+/*
+ * Sets the memory budget of this SedResultStore.
+ */
+void
+SedResultStore::setMemoryBudget(size_t memoryBudget)
+{
+  lock_guard<mutex> lock(mMutex);
+  mMemoryBudget = memoryBudget;
+}
+
+
+/*
+ * Returns the directory in which the files of mapped columns are
+ * created.
+ */
+std::string
+SedResultStore::getSpillDirectory() const
+{
+  lock_guard<mutex> lock(mMutex);
+  return mSpillDirectory;
+}
+
+
+/*
+ * Sets the directory in which the files of mapped columns are created.
+ */
+void
+SedResultStore::setSpillDirectory(const std::string& directory)
+{
+  lock_guard<mutex> lock(mMutex);
+  mSpillDirectory = directory;
+}
+
+
+/*
+ * Creates a column for the given quantity recorded by a task.
+ */
+int
+SedResultStore::createColumn(const std::string& taskId,
+                             const std::string& target,
+                             const std::string& symbol,
+                             const std::vector<size_t>& shape)
+{
+  if (shape.empty())
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  size_t size = 1;
+
+  for (size_t i = 0; i < shape.size(); ++i)
+    {
+      if (shape[i] != 0 &&
+          size > numeric_limits<size_t>::max() / sizeof(double) / shape[i])
+        return LIBSEDML_OPERATION_FAILED;
+
+      size *= shape[i];
+    }
+
+  lock_guard<mutex> lock(mMutex);
+
+  ColumnKey key(taskId, target, symbol);
+
+  if (mIndex.find(key) != mIndex.end())
+    return LIBSEDML_DUPLICATE_OBJECT_ID;
+
+  SedResultColumn* column = new (nothrow) SedResultColumn(shape, size);
+
+  if (column == NULL)
+    return LIBSEDML_OPERATION_FAILED;
+
+  // columns past the budget go to a file; those that cannot be mapped
+  // are still kept in memory rather than lost
+  size_t bytes = size * sizeof(double);
+  bool spill = mMemoryBudget > 0 && size > 0 &&
+               mMemoryUsage + bytes > mMemoryBudget;
+
+  if (!(spill && column->map(mSpillDirectory)))
+    {
+      if (!column->allocate())
+        {
+          delete column;
+          return LIBSEDML_OPERATION_FAILED;
+        }
+
+      mMemoryUsage += bytes;
+    }
+
+  unsigned int n = (unsigned int)mColumns.size();
+  mColumns.push_back(column);
+  mIndex.insert(make_pair(key, n));
+  return (int)n;
+}
+
+
+/*
+ * Creates a column for the quantity the given SedVariable refers to.
+ */
+int
+SedResultStore::createColumn(const SedVariable* variable,
+                             const std::vector<size_t>& shape)
+{
+  if (variable == NULL)
+    return LIBSEDML_INVALID_OBJECT;
+
+  return createColumn(variable->getTaskReference(), variable->getTarget(),
+                      variable->getSymbol(), shape);
+}
+
+
+/*
+ * Returns the number of columns of this SedResultStore.
+ */
+unsigned int
+SedResultStore::getNumColumns() const
+{
+  lock_guard<mutex> lock(mMutex);
+  return (unsigned int)mColumns.size();
+}
+
+
+/*
+ * Returns the index of the column of the given quantity.
+ */
+int
+SedResultStore::getColumnIndex(const std::string& taskId,
+                               const std::string& target,
+                               const std::string& symbol) const
+{
+  lock_guard<mutex> lock(mMutex);
+  map<ColumnKey, unsigned int>::const_iterator it =
+    mIndex.find(ColumnKey(taskId, target, symbol));
+  return it == mIndex.end() ? -1 : (int)it->second;
+}
+
+
+/*
+ * Returns the index of the column of the quantity the given SedVariable
+ * refers to.
+ */
+int
+SedResultStore::getColumnIndex(const SedVariable* variable) const
+{
+  if (variable == NULL)
+    return -1;
+
+  return getColumnIndex(variable->getTaskReference(), variable->getTarget(),
+                        variable->getSymbol());
+}
+
+
+/*
+ * Returns the values of the nth column.
+ */
+double*
+SedResultStore::getData(unsigned int n)
+{
+  lock_guard<mutex> lock(mMutex);
+  const SedResultColumn* column = getColumn(n);
+  return column != NULL ? column->mData : NULL;
+}
+
+
+/*
+ * Returns the values of the nth column.
+ */
+const double*
+SedResultStore::getData(unsigned int n) const
+{
+  lock_guard<mutex> lock(mMutex);
+  const SedResultColumn* column = getColumn(n);
+  return column != NULL ? column->mData : NULL;
+}
+
+
+/*
+ * Returns the number of values of the nth column.
+ */
+size_t
+SedResultStore::getSize(unsigned int n) const
+{
+  lock_guard<mutex> lock(mMutex);
+  const SedResultColumn* column = getColumn(n);
+  return column != NULL ? column->mSize : 0;
+}
+
+
+/*
+ * Returns the shape of the nth column.
+ */
+std::vector<size_t>
+SedResultStore::getShape(unsigned int n) const
+{
+  lock_guard<mutex> lock(mMutex);
+  const SedResultColumn* column = getColumn(n);
+  return column != NULL ? column->mShape : vector<size_t>();
+}
+
+
+/*
+ * Predicate returning true if the nth column is mapped from a temporary
+ * file.
+ */
+bool
+SedResultStore::isMapped(unsigned int n) const
+{
+  lock_guard<mutex> lock(mMutex);
+  const SedResultColumn* column = getColumn(n);
+  return column != NULL && column->mAddress != NULL;
+}
+
+
+/*
+ * Returns a view of the values of the nth column along one dimension.
+ */
+SedResultView
+SedResultStore::getView(unsigned int n, unsigned int dimension,
+                        const std::vector<size_t>& index) const
+{
+  SedResultView view = { NULL, 0, 1 };
+
+  lock_guard<mutex> lock(mMutex);
+  const SedResultColumn* column = getColumn(n);
+
+  if (column == NULL || dimension >= column->mShape.size() ||
+      index.size() != column->mShape.size())
+    return view;
+
+  // walk the dimensions from the fastest varying one
+  size_t offset = 0;
+  size_t stride = 1;
+
+  for (size_t k = column->mShape.size(); k > 0; --k)
+    {
+      if (k - 1 == dimension)
+        {
+          view.stride = stride;
+        }
+      else
+        {
+          if (index[k - 1] >= column->mShape[k - 1])
+            return view;
+
+          offset += index[k - 1] * stride;
+        }
+
+      stride *= column->mShape[k - 1];
+    }
+
+  view.size = column->mShape[dimension];
+  view.data = view.size > 0 ? column->mData + offset : NULL;
+  return view;
+}
+
+
+/*
+ * Finds the columns of the inputs of the given SedExpressionDag.
+ */
+int
+SedResultStore::getInputs(const SedExpressionDag& dag,
+                          std::vector<const double*>& inputs) const
+{
+  inputs.clear();
+
+  lock_guard<mutex> lock(mMutex);
+  size_t size = 0;
+
+  for (unsigned int i = 0; i < dag.getNumInputs(); ++i)
+    {
+      const SedVariable* variable = dag.getInput(i);
+      map<ColumnKey, unsigned int>::const_iterator it =
+        mIndex.find(ColumnKey(variable->getTaskReference(),
+                              variable->getTarget(), variable->getSymbol()));
+
+      if (it == mIndex.end())
+        return LIBSEDML_INVALID_OBJECT;
+
+      const SedResultColumn* column = mColumns[it->second];
+
+      if (i > 0 && column->mSize != size)
+        return LIBSEDML_INVALID_OBJECT;
+
+      size = column->mSize;
+      inputs.push_back(column->mData);
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns the number of bytes of values kept in memory.
+ */
+size_t
+SedResultStore::getMemoryUsage() const
+{
+  lock_guard<mutex> lock(mMutex);
+  return mMemoryUsage;
+}
+
+
+/*
+ * Removes all columns from this SedResultStore.
+ */
+void
+SedResultStore::clear()
+{
+  lock_guard<mutex> lock(mMutex);
+
+  for (size_t i = 0; i < mColumns.size(); ++i)
+    delete mColumns[i];
+
+  mColumns.clear();
+  mIndex.clear();
+  mMemoryUsage = 0;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Returns the nth column; the caller holds the lock.
+ */
+const SedResultColumn*
+SedResultStore::getColumn(unsigned int n) const
+{
+  return n < mColumns.size() ? mColumns[n] : NULL;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+#endif  /* __cplusplus */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Creates a new, empty SedResultStore and returns it.
+ */
+LIBSEDML_EXTERN
+SedResultStore_t *
+SedResultStore_create(size_t memoryBudget)
+{
+  return new (nothrow) SedResultStore(memoryBudget);
+}
+
+
+/**
+ * Frees the given SedResultStore.
+ */
+LIBSEDML_EXTERN
+void
+SedResultStore_free(SedResultStore_t *srs)
+{
+  if (srs != NULL)
+    delete srs;
+}
+
+
+/**
+ * Creates a column for the quantity the given SedVariable refers to.
+ */
+LIBSEDML_EXTERN
+int
+SedResultStore_createColumn(SedResultStore_t *srs,
+                            const SedVariable_t *variable,
+                            const size_t *shape,
+                            unsigned int numDimensions)
+{
+  if (srs == NULL || (shape == NULL && numDimensions > 0))
+    return LIBSEDML_INVALID_OBJECT;
+
+  return srs->createColumn(variable,
+                           vector<size_t>(shape, shape + numDimensions));
+}
+
+
+/**
+ * Returns the index of the column for the given SedVariable.
+ */
+LIBSEDML_EXTERN
+int
+SedResultStore_getColumnIndex(const SedResultStore_t *srs,
+                              const SedVariable_t *variable)
+{
+  return (srs != NULL) ? srs->getColumnIndex(variable) : -1;
+}
+
+
+/**
+ * Returns the values of the nth column.
+ */
+LIBSEDML_EXTERN
+double *
+SedResultStore_getData(SedResultStore_t *srs, unsigned int n)
+{
+  return (srs != NULL) ? srs->getData(n) : NULL;
+}
+
+
+/**
+ * Returns the number of values of the nth column.
+ */
+LIBSEDML_EXTERN
+size_t
+SedResultStore_getSize(const SedResultStore_t *srs, unsigned int n)
+{
+  return (srs != NULL) ? srs->getSize(n) : 0;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
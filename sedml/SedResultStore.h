@@ -0,0 +1,432 @@
+/**
+ * @file    SedResultStore.h
+ * @brief   Columnar storage of the values recorded by Sed tasks
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedResultStore
+ * @ingroup Core
+ * @brief Columnar storage of the values recorded by tasks.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedResultStore holds one contiguous column of @c double values for
+ * each quantity a task records, identified by the task and the target
+ * or symbol of a SedVariable.  A column has a shape: a time course
+ * yields one dimension, and each SedRepeatedTask around it adds one in
+ * front, so that the values of one iteration are contiguous and the
+ * values of one point across iterations are a strided view.
+ *
+ * Columns are kept in memory as long as they fit in the memory budget.
+ * A column that would exceed it is placed in a temporary file mapped
+ * into memory instead, so that the operating system pages results in
+ * and out as they are used; the file disappears with the store.  In
+ * both cases the values are read and written in place through
+ * getData(), and the pointer stays valid until the store is cleared or
+ * destroyed.  Memory-mapped columns are not available on Windows, where
+ * all columns are kept in memory.
+ *
+ * Columns may be created and accessed from several threads at once, as
+ * when tasks are run by a SedExecutor; writing the values of one column
+ * from several threads is up to the caller to synchronize.
+ */
+
+#ifndef SedResultStore_h
+#define SedResultStore_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedVariable;
+class SedExpressionDag;
+class SedResultColumn;
+
+
+/**
+ * A strided view of values of a SedResultStore column: the ith value is
+ * @c data[i * stride], for @c i below @c size.
+ */
+struct SedResultView
+{
+  const double* data;
+  size_t size;
+  size_t stride;
+};
+
+
+class LIBSEDML_EXTERN SedResultStore
+{
+public:
+
+  /**
+   * Creates a new, empty SedResultStore.
+   *
+   * @param memoryBudget the number of bytes of values kept in memory
+   * before further columns are mapped from temporary files, or @c 0 to
+   * keep all columns in memory.
+   */
+  SedResultStore(size_t memoryBudget = 0);
+
+
+  /**
+   * Destroys this SedResultStore and all of its columns.
+   */
+  virtual ~SedResultStore();
+
+
+  /**
+   * Returns the memory budget of this SedResultStore.
+   *
+   * @return the number of bytes of values kept in memory, or @c 0 if
+   * there is no limit.
+   */
+  size_t getMemoryBudget() const;
+
+
+  /**
+   * Sets the memory budget of this SedResultStore, for the columns
+   * created from now on.
+   *
+   * @param memoryBudget the number of bytes of values kept in memory, or
+   * @c 0 for no limit.
+   */
+  void setMemoryBudget(size_t memoryBudget);
+
+
+  /**
+   * Returns the directory in which the files of mapped columns are
+   * created.
+   *
+   * @return a copy of the directory, so that it may be changed from
+   * another thread meanwhile; if empty, that of the @c TMPDIR environment
+   * variable or @c /tmp is used.
+   */
+  std::string getSpillDirectory() const;
+
+
+  /**
+   * Sets the directory in which the files of mapped columns are created.
+   *
+   * @param directory the directory.
+   */
+  void setSpillDirectory(const std::string& directory);
+
+
+  /**
+   * Creates a column for the given quantity recorded by a task.
+   *
+   * @param taskId the identifier of the task recording the values.
+   * @param target the target of the SedVariable, or the empty string.
+   * @param symbol the symbol of the SedVariable, or the empty string.
+   * @param shape the size of each dimension of the column; the last one
+   * varies fastest.
+   *
+   * @return the index of the new column, or one of the following
+   * negative values on failure:
+   * @li LIBSEDML_DUPLICATE_OBJECT_ID, if the column exists already
+   * @li LIBSEDML_INVALID_ATTRIBUTE_VALUE, if @p shape is empty
+   * @li LIBSEDML_OPERATION_FAILED, if no memory could be obtained
+   *
+   * The values of a new column are all @c 0.
+   */
+  int createColumn(const std::string& taskId, const std::string& target,
+                   const std::string& symbol,
+                   const std::vector<size_t>& shape);
+
+
+  /**
+   * Creates a column for the quantity the given SedVariable refers to.
+   *
+   * @param variable the SedVariable, whose taskReference, target and
+   * symbol identify the column.
+   * @param shape the size of each dimension of the column.
+   *
+   * @return the index of the new column, or a negative value on failure,
+   * as for createColumn(taskId, target, symbol, shape); a @c NULL
+   * @p variable yields LIBSEDML_INVALID_OBJECT.
+   */
+  int createColumn(const SedVariable* variable,
+                   const std::vector<size_t>& shape);
+
+
+  /**
+   * Returns the number of columns of this SedResultStore.
+   *
+   * @return the number of columns.
+   */
+  unsigned int getNumColumns() const;
+
+
+  /**
+   * Returns the index of the column of the given quantity.
+   *
+   * @param taskId the identifier of the task recording the values.
+   * @param target the target of the SedVariable, or the empty string.
+   * @param symbol the symbol of the SedVariable, or the empty string.
+   *
+   * @return the index of the column, or @c -1 if there is none.
+   */
+  int getColumnIndex(const std::string& taskId, const std::string& target,
+                     const std::string& symbol) const;
+
+
+  /**
+   * Returns the index of the column of the quantity the given
+   * SedVariable refers to.
+   *
+   * @param variable the SedVariable.
+   *
+   * @return the index of the column, or @c -1 if there is none.
+   */
+  int getColumnIndex(const SedVariable* variable) const;
+
+
+  /**
+   * Returns the values of the nth column.
+   *
+   * @param n an unsigned int representing the index of the column.
+   *
+   * @return the values, to be read or written in place, or @c NULL if
+   * @p n is out of range.
+   */
+  double* getData(unsigned int n);
+
+
+  /**
+   * Returns the values of the nth column.
+   *
+   * @param n an unsigned int representing the index of the column.
+   *
+   * @return the values, or @c NULL if @p n is out of range.
+   */
+  const double* getData(unsigned int n) const;
+
+
+  /**
+   * Returns the number of values of the nth column.
+   *
+   * @param n an unsigned int representing the index of the column.
+   *
+   * @return the product of the dimensions of the column, or @c 0 if
+   * @p n is out of range.
+   */
+  size_t getSize(unsigned int n) const;
+
+
+  /**
+   * Returns the shape of the nth column.
+   *
+   * @param n an unsigned int representing the index of the column.
+   *
+   * @return the size of each dimension, or an empty vector if @p n is
+   * out of range.
+   */
+  std::vector<size_t> getShape(unsigned int n) const;
+
+
+  /**
+   * Predicate returning @c true if the nth column is mapped from a
+   * temporary file.
+   *
+   * @param n an unsigned int representing the index of the column.
+   *
+   * @return @c true if the column did not fit in the memory budget,
+   * @c false otherwise.
+   */
+  bool isMapped(unsigned int n) const;
+
+
+  /**
+   * Returns a view of the values of the nth column along one dimension.
+   *
+   * @param n an unsigned int representing the index of the column.
+   * @param dimension the dimension along which the view runs.
+   * @param index the position in each dimension; the entry for
+   * @p dimension is ignored.
+   *
+   * @return the view, or a view of size @c 0 if @p n, @p dimension or
+   * @p index is out of range.
+   */
+  SedResultView getView(unsigned int n, unsigned int dimension,
+                        const std::vector<size_t>& index) const;
+
+
+  /**
+   * Finds the columns of the inputs of the given SedExpressionDag.
+   *
+   * @param dag the SedExpressionDag of the data generators to evaluate.
+   * @param inputs the vector receiving the values of one column per input
+   * of @p dag, to be passed to SedExpressionDag::evaluate().
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INVALID_OBJECT, if an input has no column, or the
+   * columns differ in size
+   */
+  int getInputs(const SedExpressionDag& dag,
+                std::vector<const double*>& inputs) const;
+
+
+  /**
+   * Returns the number of bytes of values of this SedResultStore kept in
+   * memory.
+   *
+   * @return the size of the columns that are not mapped from files.
+   */
+  size_t getMemoryUsage() const;
+
+
+  /**
+   * Removes all columns from this SedResultStore.
+   */
+  void clear();
+
+
+protected:
+
+  /** @cond doxygen-libsedml-internal */
+
+  typedef std::tuple<std::string, std::string, std::string> ColumnKey;
+
+  /* not copyable */
+  SedResultStore(const SedResultStore&);
+  SedResultStore& operator=(const SedResultStore&);
+
+  const SedResultColumn* getColumn(unsigned int n) const;
+
+  size_t mMemoryBudget;
+
+  std::string mSpillDirectory;
+
+  std::vector<SedResultColumn*> mColumns;
+
+  std::map<ColumnKey, unsigned int> mIndex;
+
+  size_t mMemoryUsage;
+
+  mutable std::mutex mMutex;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+/**
+ * Creates a new, empty SedResultStore with the given memory budget (in
+ * bytes, @c 0 for no limit) and returns it.
+ */
+LIBSEDML_EXTERN
+SedResultStore_t *
+SedResultStore_create(size_t memoryBudget);
+
+
+/**
+ * Frees the given SedResultStore, created with SedResultStore_create().
+ */
+LIBSEDML_EXTERN
+void
+SedResultStore_free(SedResultStore_t *srs);
+
+
+/**
+ * Creates a column of @p srs for the quantity the given SedVariable
+ * refers to, with @p numDimensions dimensions of the given sizes, and
+ * returns its index or a negative value on failure.
+ */
+LIBSEDML_EXTERN
+int
+SedResultStore_createColumn(SedResultStore_t *srs,
+                            const SedVariable_t *variable,
+                            const size_t *shape,
+                            unsigned int numDimensions);
+
+
+/**
+ * Returns the index of the column of @p srs for the quantity the given
+ * SedVariable refers to, or @c -1.
+ */
+LIBSEDML_EXTERN
+int
+SedResultStore_getColumnIndex(const SedResultStore_t *srs,
+                              const SedVariable_t *variable);
+
+
+/**
+ * Returns the values of the nth column of @p srs, or @c NULL.
+ */
+LIBSEDML_EXTERN
+double *
+SedResultStore_getData(SedResultStore_t *srs, unsigned int n);
+
+
+/**
+ * Returns the number of values of the nth column of @p srs.
+ */
+LIBSEDML_EXTERN
+size_t
+SedResultStore_getSize(const SedResultStore_t *srs, unsigned int n);
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+
+#endif  /* SedResultStore_h */
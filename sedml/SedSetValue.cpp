@@ -36,6 +36,7 @@
 
 #include <sedml/SedSetValue.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 #include <sbml/math/MathML.h>
 #include <sbml/math/ASTNode.h>
@@ -61,9 +62,6 @@ SedSetValue::SedSetValue(unsigned int level, unsigned int version)
   , mMath(NULL)
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
-
   // connect to child objects
   connectToChild();
 }
@@ -789,6 +787,7 @@ SedSetValue::writeElements(XMLOutputStream& stream) const
 
   if (isSetMath() == true)
     {
+      SEDML_TIME_PHASE(SEDML_PHASE_WRITE_MATHML);
       writeMathML(getMath(), stream, NULL);
     }
 }
@@ -797,6 +796,54 @@ SedSetValue::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedSetValue::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedBase::writeSnapshot(writer);
+
+  mVariables.writeSnapshot(writer);
+  mParameters.writeSnapshot(writer);
+  writer.writeString(mRange);
+  writer.writeString(mModelReference);
+  writer.writeString(mSymbol);
+  writer.writeString(mTarget);
+  writer.writeMath(mMath);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedSetValue::readSnapshot(SedSnapshotReader& reader)
+{
+  SedBase::readSnapshot(reader);
+
+  mVariables.readSnapshot(reader);
+  mParameters.readSnapshot(reader);
+  mRange = reader.readString();
+  mModelReference = reader.readString();
+  mSymbol = reader.readString();
+  mTarget = reader.readString();
+
+  delete mMath;
+  mMath = reader.readMath();
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -805,8 +852,22 @@ SedSetValue::writeElements(XMLOutputStream& stream) const
 bool
 SedSetValue::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      if (getNumVariables() > 0)
+        {
+          mVariables.accept(v);
+        }
 
+      if (getNumParameters() > 0)
+        {
+          mParameters.accept(v);
+        }
+    }
+
+  v.leave(*this);
+
+  return true;
 }
 
 
@@ -947,6 +1008,7 @@ SedSetValue::readOtherXML(XMLInputStream& stream)
 
   if (name == "math")
     {
+      SEDML_TIME_PHASE(SEDML_PHASE_MATHML);
       const XMLToken elem = stream.peek();
       const std::string prefix = checkMathMLNamespace(elem);
 
@@ -1002,7 +1064,6 @@ SedListOfTaskChanges::SedListOfTaskChanges(unsigned int level,
     unsigned int version)
   : SedListOf(level, version)
 {
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -1063,10 +1124,8 @@ SedListOfTaskChanges::get(const std::string& sid)
 const SedSetValue*
 SedListOfTaskChanges::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSetValue>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <SedSetValue*>(*result);
+  int index = getIndexById(sid);
+  return (index < 0) ? 0 : static_cast <SedSetValue*>(mItems[index]);
 }
 
 
@@ -1138,14 +1197,11 @@ SedSetValue*
 SedListOfTaskChanges::remove(const std::string& sid)
 {
   SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSetValue>(sid));
+  int index = getIndexById(sid);
 
-  if (result != mItems.end())
+  if (index >= 0)
     {
-      item = *result;
-      mItems.erase(result);
+      item = SedListOf::remove((unsigned int)index);
     }
 
   return static_cast <SedSetValue*>(item);
@@ -36,6 +36,7 @@
 
 #include <sedml/SedSimulation.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -55,9 +56,6 @@ SedSimulation::SedSimulation(unsigned int level, unsigned int version)
   , mAlgorithm(NULL)
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
-
   // connect to child objects
   connectToChild();
 }
@@ -222,7 +220,9 @@ SedSimulation::isSetAlgorithm() const
 int
 SedSimulation::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  indexElement();
+  return result;
 }
 
 
@@ -278,6 +278,7 @@ int
 SedSimulation::unsetId()
 {
   mId.erase();
+  indexElement();
 
   if (mId.empty() == true)
     {
@@ -424,6 +425,50 @@ SedSimulation::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedSimulation::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedBase::writeSnapshot(writer);
+
+  writer.writeString(mId);
+  writer.writeString(mName);
+  writer.writeObject(mAlgorithm);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedSimulation::readSnapshot(SedSnapshotReader& reader)
+{
+  SedBase::readSnapshot(reader);
+
+  mId = reader.readString();
+  mName = reader.readString();
+
+  delete mAlgorithm;
+  mAlgorithm = static_cast<SedAlgorithm*>(
+    reader.readObject(getSedNamespaces(), SEDML_SIMULATION_ALGORITHM));
+
+  if (mAlgorithm != NULL)
+    mAlgorithm->connectToParent(this);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -432,8 +477,17 @@ SedSimulation::writeElements(XMLOutputStream& stream) const
 bool
 SedSimulation::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      if (isSetAlgorithm() == true)
+        {
+          mAlgorithm->accept(v);
+        }
+    }
+
+  v.leave(*this);
 
+  return true;
 }
 
 
@@ -558,7 +612,6 @@ SedListOfSimulations::SedListOfSimulations(unsigned int level,
     unsigned int version)
   : SedListOf(level, version)
 {
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -619,10 +672,8 @@ SedListOfSimulations::get(const std::string& sid)
 const SedSimulation*
 SedListOfSimulations::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSimulation>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <SedSimulation*>(*result);
+  int index = getIndexById(sid);
+  return (index < 0) ? 0 : static_cast <SedSimulation*>(mItems[index]);
 }
 
 
@@ -730,14 +781,11 @@ SedSimulation*
 SedListOfSimulations::remove(const std::string& sid)
 {
   SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSimulation>(sid));
+  int index = getIndexById(sid);
 
-  if (result != mItems.end())
+  if (index >= 0)
     {
-      item = *result;
-      mItems.erase(result);
+      item = SedListOf::remove((unsigned int)index);
     }
 
   return static_cast <SedSimulation*>(item);
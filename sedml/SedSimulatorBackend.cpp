@@ -0,0 +1,120 @@
+/**
+ * @file    SedSimulatorBackend.cpp
+ * @brief   Interface between SedExecutor and a simulator
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedSimulatorBackend.h>
+#include <sedml/SedIterationSpace.h>
+#include <sedml/SedRepeatedTask.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+SedSimulatorBackend::~SedSimulatorBackend()
+{
+}
+
+
+int
+SedSimulatorBackend::loadModel(const SedModel*)
+{
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+int
+SedSimulatorBackend::executeRepeatedTask(const SedRepeatedTask* task)
+{
+  SedIterationSpace space(task);
+
+  if (!space.isValid())
+    return LIBSEDML_INVALID_OBJECT;
+
+  while (space.next())
+    {
+      int status = executeStep(space);
+
+      if (status != LIBSEDML_OPERATION_SUCCESS)
+        return status;
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+int
+SedSimulatorBackend::executeStep(const SedIterationSpace& space)
+{
+  const SedTask* task = space.getTask();
+
+  if (task == NULL)
+    return LIBSEDML_INVALID_OBJECT;
+
+  return executeTask(task);
+}
+
+
+unsigned int
+SedSimulatorBackend::getEnsembleSize() const
+{
+  return 0;
+}
+
+
+int
+SedSimulatorBackend::executeEnsemble(const SedEnsembleBatch&)
+{
+  return LIBSEDML_OPERATION_FAILED;
+}
+
+
+int
+SedSimulatorBackend::evaluateDataGenerator(const SedDataGenerator*)
+{
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+int
+SedSimulatorBackend::writeOutput(const SedOutput*)
+{
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+#endif  /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
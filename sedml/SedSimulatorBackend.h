@@ -0,0 +1,198 @@
+/**
+ * @file    SedSimulatorBackend.h
+ * @brief   Interface between SedExecutor and a simulator
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedSimulatorBackend
+ * @ingroup Core
+ * @brief The interface through which a SedExecutor runs the elements of
+ * a SedDocument.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * libSEDML does not simulate models itself.  A simulator integrates with
+ * SedExecutor by deriving from SedSimulatorBackend and implementing at
+ * least executeTask(); the other methods do nothing by default, except
+ * for executeRepeatedTask(), which walks the steps of the repeated task
+ * with a SedIterationSpace.
+ *
+ * A simulator able to integrate several parameter sets of a model at
+ * once overrides getEnsembleSize() and executeEnsemble(); SedExecutor
+ * then runs the repeated tasks that allow it, as told by
+ * SedEnsembleBatch::isBatchable(), as batches of iterations instead.
+ *
+ * A SedExecutor calls the methods of its backend from several threads
+ * at once, for elements that do not depend on each other; they must
+ * therefore be safe to call concurrently.  Each element is passed only
+ * once all the elements it depends on, as listed by SedDependencyGraph,
+ * have been dealt with successfully.
+ */
+
+#ifndef SedSimulatorBackend_h
+#define SedSimulatorBackend_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedModel;
+class SedTask;
+class SedRepeatedTask;
+class SedIterationSpace;
+class SedEnsembleBatch;
+class SedDataGenerator;
+class SedOutput;
+
+
+class LIBSEDML_EXTERN SedSimulatorBackend
+{
+public:
+
+  /**
+   * Destroys this SedSimulatorBackend.
+   */
+  virtual ~SedSimulatorBackend();
+
+
+  /**
+   * Loads the given model, and applies its changes.
+   *
+   * @param model the SedModel to load.
+   *
+   * @return integer value indicating success/failure of the operation;
+   * anything but LIBSEDML_OPERATION_SUCCESS stops the elements depending
+   * on @p model from being run.  The default implementation returns
+   * LIBSEDML_OPERATION_SUCCESS.
+   */
+  virtual int loadModel(const SedModel* model);
+
+
+  /**
+   * Runs the given task.
+   *
+   * @param task the SedTask to run; it is never a SedRepeatedTask.
+   *
+   * @return integer value indicating success/failure of the operation.
+   */
+  virtual int executeTask(const SedTask* task) = 0;
+
+
+  /**
+   * Runs the given repeated task.
+   *
+   * The default implementation calls executeStep() for each step of a
+   * SedIterationSpace over @p task, in order, and stops at the first
+   * step that fails.
+   *
+   * @param task the SedRepeatedTask to run.
+   *
+   * @return integer value indicating success/failure of the operation.
+   */
+  virtual int executeRepeatedTask(const SedRepeatedTask* task);
+
+
+  /**
+   * Runs the current step of a repeated task.
+   *
+   * The default implementation calls executeTask() for the task of the
+   * step; the values of the ranges are available from @p space.
+   *
+   * @param space the SedIterationSpace, positioned on the step to run.
+   *
+   * @return integer value indicating success/failure of the operation.
+   */
+  virtual int executeStep(const SedIterationSpace& space);
+
+
+  /**
+   * Returns the number of iterations of a repeated task this backend
+   * runs at once.
+   *
+   * @return the largest number of iterations passed to executeEnsemble();
+   * the default implementation returns @c 0, for a backend that does
+   * not run ensembles.
+   */
+  virtual unsigned int getEnsembleSize() const;
+
+
+  /**
+   * Runs a batch of iterations of a repeated task as an ensemble.
+   *
+   * Each iteration of @p batch runs the task of the batch once, from the
+   * model of that task with the parameter values of that iteration, and
+   * its results are those of that iteration of the repeated task.
+   *
+   * @param batch the SedEnsembleBatch to run.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The default implementation returns LIBSEDML_OPERATION_FAILED; it is
+   * never called when getEnsembleSize() returns @c 0.
+   */
+  virtual int executeEnsemble(const SedEnsembleBatch& batch);
+
+
+  /**
+   * Computes the values of the given data generator.
+   *
+   * @param dataGenerator the SedDataGenerator to compute.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The default implementation returns LIBSEDML_OPERATION_SUCCESS.
+   */
+  virtual int evaluateDataGenerator(const SedDataGenerator* dataGenerator);
+
+
+  /**
+   * Produces the given output.
+   *
+   * @param output the SedOutput to produce.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The default implementation returns LIBSEDML_OPERATION_SUCCESS.
+   */
+  virtual int writeOutput(const SedOutput* output);
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedSimulatorBackend_h */
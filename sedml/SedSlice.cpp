@@ -36,6 +36,7 @@
 
 #include <sedml/SedSlice.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -54,9 +55,6 @@ SedSlice::SedSlice(unsigned int level, unsigned int version)
   , mValue("")
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
-
   // connect to child objects
   connectToChild();
 }
@@ -333,6 +331,42 @@ SedSlice::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedSlice::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedBase::writeSnapshot(writer);
+
+  writer.writeString(mReference);
+  writer.writeString(mValue);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedSlice::readSnapshot(SedSnapshotReader& reader)
+{
+  SedBase::readSnapshot(reader);
+
+  mReference = reader.readString();
+  mValue = reader.readString();
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -341,8 +375,10 @@ SedSlice::writeElements(XMLOutputStream& stream) const
 bool
 SedSlice::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
 
+  return true;
 }
 
 
@@ -464,7 +500,6 @@ SedListOfSlices::SedListOfSlices(unsigned int level,
                                  unsigned int version)
   : SedListOf(level, version)
 {
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -525,10 +560,8 @@ SedListOfSlices::get(const std::string& sid)
 const SedSlice*
 SedListOfSlices::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSlice>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <SedSlice*>(*result);
+  int index = getIndexById(sid);
+  return (index < 0) ? 0 : static_cast <SedSlice*>(mItems[index]);
 }
 
 
@@ -600,14 +633,11 @@ SedSlice*
 SedListOfSlices::remove(const std::string& sid)
 {
   SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSlice>(sid));
+  int index = getIndexById(sid);
 
-  if (result != mItems.end())
+  if (index >= 0)
     {
-      item = *result;
-      mItems.erase(result);
+      item = SedListOf::remove((unsigned int)index);
     }
 
   return static_cast <SedSlice*>(item);
@@ -0,0 +1,846 @@
+/**
+ * @file    SedSnapshot.cpp
+ * @brief   Binary snapshots of SedDocument objects
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedSnapshot.h>
+#include <sedml/SedTypes.h>
+#include <sbml/xml/XMLNode.h>
+#include <sbml/xml/XMLAttributes.h>
+#include <sbml/xml/XMLNamespaces.h>
+#include <sbml/xml/XMLTriple.h>
+#include <sbml/math/ASTNode.h>
+
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+using namespace std;
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygen-libsbml-internal */
+
+/* flags describing the kind of an XMLNode */
+static const unsigned int SnapshotXMLText  = 1;
+static const unsigned int SnapshotXMLStart = 2;
+static const unsigned int SnapshotXMLEnd   = 4;
+static const unsigned int SnapshotXMLEOF   = 8;
+
+/* strings and arrays are read in chunks of this many bytes, so that a
+ * damaged length does not make us allocate huge amounts of memory */
+static const size_t SnapshotChunkSize = 65536;
+
+/* math and XML trees nested deeper than this are considered damaged */
+static const unsigned int SnapshotMaxDepth = 4096;
+
+/** @endcond */
+
+
+SedSnapshotWriter::SedSnapshotWriter(std::ostream& stream)
+  : mStream(stream)
+{
+}
+
+
+bool
+SedSnapshotWriter::good() const
+{
+  return mStream.good();
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+void
+SedSnapshotWriter::writeBytes(const char* data, size_t length)
+{
+  mStream.write(data, static_cast<streamsize>(length));
+}
+
+/** @endcond */
+
+
+void
+SedSnapshotWriter::writeUInt(unsigned int value)
+{
+  char bytes[4];
+
+  for (int i = 0; i < 4; ++i)
+    bytes[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+
+  writeBytes(bytes, 4);
+}
+
+
+void
+SedSnapshotWriter::writeInt(int value)
+{
+  writeUInt(static_cast<unsigned int>(value));
+}
+
+
+void
+SedSnapshotWriter::writeLong(long value)
+{
+  unsigned long long bits = static_cast<unsigned long long>(value);
+  char bytes[8];
+
+  for (int i = 0; i < 8; ++i)
+    bytes[i] = static_cast<char>((bits >> (8 * i)) & 0xff);
+
+  writeBytes(bytes, 8);
+}
+
+
+void
+SedSnapshotWriter::writeDouble(double value)
+{
+  unsigned long long bits;
+  memcpy(&bits, &value, sizeof(bits));
+
+  char bytes[8];
+
+  for (int i = 0; i < 8; ++i)
+    bytes[i] = static_cast<char>((bits >> (8 * i)) & 0xff);
+
+  writeBytes(bytes, 8);
+}
+
+
+void
+SedSnapshotWriter::writeBool(bool value)
+{
+  char byte = value ? 1 : 0;
+  writeBytes(&byte, 1);
+}
+
+
+void
+SedSnapshotWriter::writeString(const std::string& value)
+{
+  writeUInt(static_cast<unsigned int>(value.size()));
+  writeBytes(value.data(), value.size());
+}
+
+
+void
+SedSnapshotWriter::writeDoubles(const std::vector<double>& values)
+{
+  writeUInt(static_cast<unsigned int>(values.size()));
+
+  char buffer[SnapshotChunkSize];
+  size_t used = 0;
+
+  for (size_t n = 0; n < values.size(); ++n)
+    {
+      unsigned long long bits;
+      memcpy(&bits, &values[n], sizeof(bits));
+
+      for (int i = 0; i < 8; ++i)
+        buffer[used++] = static_cast<char>((bits >> (8 * i)) & 0xff);
+
+      if (used == SnapshotChunkSize)
+        {
+          writeBytes(buffer, used);
+          used = 0;
+        }
+    }
+
+  writeBytes(buffer, used);
+}
+
+
+void
+SedSnapshotWriter::writeAttributes(const XMLAttributes& attributes)
+{
+  writeUInt(static_cast<unsigned int>(attributes.getLength()));
+
+  for (int i = 0; i < attributes.getLength(); ++i)
+    {
+      writeString(attributes.getName(i));
+      writeString(attributes.getURI(i));
+      writeString(attributes.getPrefix(i));
+      writeString(attributes.getValue(i));
+    }
+}
+
+
+void
+SedSnapshotWriter::writeNamespaces(const XMLNamespaces& namespaces)
+{
+  writeUInt(static_cast<unsigned int>(namespaces.getLength()));
+
+  for (int i = 0; i < namespaces.getLength(); ++i)
+    {
+      writeString(namespaces.getURI(i));
+      writeString(namespaces.getPrefix(i));
+    }
+}
+
+
+void
+SedSnapshotWriter::writeXMLNode(const XMLNode* node)
+{
+  writeBool(node != NULL);
+
+  if (node == NULL) return;
+
+  unsigned int flags = 0;
+
+  if (node->isText())  flags |= SnapshotXMLText;
+
+  if (node->isStart()) flags |= SnapshotXMLStart;
+
+  if (node->isEnd())   flags |= SnapshotXMLEnd;
+
+  if (node->isEOF())   flags |= SnapshotXMLEOF;
+
+  writeUInt(flags);
+
+  if (node->isText())
+    {
+      writeString(node->getCharacters());
+    }
+  else
+    {
+      writeString(node->getName());
+      writeString(node->getURI());
+      writeString(node->getPrefix());
+      writeAttributes(node->getAttributes());
+      writeNamespaces(node->getNamespaces());
+    }
+
+  writeUInt(node->getNumChildren());
+
+  for (unsigned int i = 0; i < node->getNumChildren(); ++i)
+    writeXMLNode(&node->getChild(i));
+}
+
+
+void
+SedSnapshotWriter::writeMath(const ASTNode* math)
+{
+  writeBool(math != NULL);
+
+  if (math == NULL) return;
+
+  ASTNodeType_t type = math->getType();
+  writeInt(static_cast<int>(type));
+
+  switch (type)
+    {
+    case AST_INTEGER:
+      writeLong(math->getInteger());
+      break;
+
+    case AST_REAL:
+      writeDouble(math->getReal());
+      break;
+
+    case AST_REAL_E:
+      writeDouble(math->getMantissa());
+      writeLong(math->getExponent());
+      break;
+
+    case AST_RATIONAL:
+      writeLong(math->getNumerator());
+      writeLong(math->getDenominator());
+      break;
+
+    default:
+      break;
+    }
+
+  const char* name = NULL;
+
+  if (math->isName() || type == AST_FUNCTION || type == AST_FUNCTION_DELAY)
+    name = math->getName();
+
+  writeBool(name != NULL);
+
+  if (name != NULL)
+    writeString(name);
+
+  const XMLAttributes* url = math->getDefinitionURL();
+
+  if (url != NULL)
+    writeAttributes(*url);
+  else
+    writeAttributes(XMLAttributes());
+
+  writeString(math->getUnits());
+  writeString(math->getId());
+  writeString(math->getClass());
+  writeString(math->getStyle());
+  writeBool(math->isBvar());
+
+  writeUInt(math->getNumSemanticsAnnotations());
+
+  for (unsigned int i = 0; i < math->getNumSemanticsAnnotations(); ++i)
+    writeXMLNode(math->getSemanticsAnnotation(i));
+
+  writeUInt(math->getNumChildren());
+
+  for (unsigned int i = 0; i < math->getNumChildren(); ++i)
+    writeMath(math->getChild(i));
+}
+
+
+void
+SedSnapshotWriter::writeObject(const SedBase* object)
+{
+  writeBool(object != NULL);
+
+  if (object == NULL) return;
+
+  writeInt(object->getTypeCode());
+  object->writeSnapshot(*this);
+}
+
+
+
+SedSnapshotReader::SedSnapshotReader(std::istream& stream)
+  : mStream(stream)
+  , mFailed(false)
+  , mDepth(0)
+{
+}
+
+
+bool
+SedSnapshotReader::good() const
+{
+  return !mFailed;
+}
+
+
+void
+SedSnapshotReader::setFailed()
+{
+  mFailed = true;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+bool
+SedSnapshotReader::readBytes(char* data, size_t length)
+{
+  if (mFailed) return false;
+
+  mStream.read(data, static_cast<streamsize>(length));
+
+  if (static_cast<size_t>(mStream.gcount()) != length)
+    mFailed = true;
+
+  return !mFailed;
+}
+
+/** @endcond */
+
+
+unsigned int
+SedSnapshotReader::readUInt()
+{
+  unsigned char bytes[4];
+
+  if (!readBytes(reinterpret_cast<char*>(bytes), 4)) return 0;
+
+  unsigned int value = 0;
+
+  for (int i = 0; i < 4; ++i)
+    value |= static_cast<unsigned int>(bytes[i]) << (8 * i);
+
+  return value;
+}
+
+
+int
+SedSnapshotReader::readInt()
+{
+  return static_cast<int>(readUInt());
+}
+
+
+long
+SedSnapshotReader::readLong()
+{
+  unsigned char bytes[8];
+
+  if (!readBytes(reinterpret_cast<char*>(bytes), 8)) return 0;
+
+  unsigned long long bits = 0;
+
+  for (int i = 0; i < 8; ++i)
+    bits |= static_cast<unsigned long long>(bytes[i]) << (8 * i);
+
+  return static_cast<long>(static_cast<long long>(bits));
+}
+
+
+double
+SedSnapshotReader::readDouble()
+{
+  unsigned char bytes[8];
+
+  if (!readBytes(reinterpret_cast<char*>(bytes), 8)) return 0;
+
+  unsigned long long bits = 0;
+
+  for (int i = 0; i < 8; ++i)
+    bits |= static_cast<unsigned long long>(bytes[i]) << (8 * i);
+
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+
+bool
+SedSnapshotReader::readBool()
+{
+  char byte = 0;
+
+  if (!readBytes(&byte, 1)) return false;
+
+  if (byte != 0 && byte != 1)
+    mFailed = true;
+
+  return byte == 1;
+}
+
+
+std::string
+SedSnapshotReader::readString()
+{
+  size_t length = readUInt();
+  std::string value;
+
+  while (length > 0 && !mFailed)
+    {
+      size_t chunk = min(length, SnapshotChunkSize);
+      size_t offset = value.size();
+      value.resize(offset + chunk);
+
+      if (!readBytes(&value[offset], chunk))
+        return std::string();
+
+      length -= chunk;
+    }
+
+  return value;
+}
+
+
+std::vector<double>
+SedSnapshotReader::readDoubles()
+{
+  size_t count = readUInt();
+  std::vector<double> values;
+  unsigned char buffer[SnapshotChunkSize];
+
+  while (count > 0 && !mFailed)
+    {
+      size_t chunk = min(count, SnapshotChunkSize / 8);
+
+      if (!readBytes(reinterpret_cast<char*>(buffer), 8 * chunk))
+        return std::vector<double>();
+
+      for (size_t n = 0; n < chunk; ++n)
+        {
+          unsigned long long bits = 0;
+
+          for (int i = 0; i < 8; ++i)
+            bits |= static_cast<unsigned long long>(buffer[8 * n + i]) << (8 * i);
+
+          double value;
+          memcpy(&value, &bits, sizeof(value));
+          values.push_back(value);
+        }
+
+      count -= chunk;
+    }
+
+  return values;
+}
+
+
+void
+SedSnapshotReader::readAttributes(XMLAttributes& attributes)
+{
+  unsigned int length = readUInt();
+
+  for (unsigned int i = 0; i < length && !mFailed; ++i)
+    {
+      std::string name   = readString();
+      std::string uri    = readString();
+      std::string prefix = readString();
+      std::string value  = readString();
+
+      if (!mFailed)
+        attributes.add(name, value, uri, prefix);
+    }
+}
+
+
+void
+SedSnapshotReader::readNamespaces(XMLNamespaces& namespaces)
+{
+  unsigned int length = readUInt();
+
+  for (unsigned int i = 0; i < length && !mFailed; ++i)
+    {
+      std::string uri    = readString();
+      std::string prefix = readString();
+
+      if (!mFailed)
+        namespaces.add(uri, prefix);
+    }
+}
+
+
+XMLNode*
+SedSnapshotReader::readXMLNode()
+{
+  if (!readBool()) return NULL;
+
+  if (mDepth >= SnapshotMaxDepth)
+    {
+      mFailed = true;
+      return NULL;
+    }
+
+  unsigned int flags = readUInt();
+  XMLNode* node = NULL;
+
+  if ((flags & SnapshotXMLText) != 0)
+    {
+      node = new XMLNode(readString());
+    }
+  else
+    {
+      std::string name   = readString();
+      std::string uri    = readString();
+      std::string prefix = readString();
+      XMLAttributes attributes;
+      XMLNamespaces namespaces;
+      readAttributes(attributes);
+      readNamespaces(namespaces);
+
+      XMLTriple triple(name, uri, prefix);
+
+      if ((flags & SnapshotXMLStart) != 0)
+        node = new XMLNode(triple, attributes, namespaces);
+      else if ((flags & SnapshotXMLEnd) != 0)
+        node = new XMLNode(triple);
+      else
+        node = new XMLNode();
+    }
+
+  if ((flags & SnapshotXMLEnd) != 0)
+    node->setEnd();
+
+  if ((flags & SnapshotXMLEOF) != 0)
+    node->setEOF();
+
+  unsigned int numChildren = readUInt();
+
+  ++mDepth;
+
+  for (unsigned int i = 0; i < numChildren && !mFailed; ++i)
+    {
+      XMLNode* child = readXMLNode();
+
+      if (child == NULL)
+        {
+          mFailed = true;
+          break;
+        }
+
+      node->addChild(*child);
+      delete child;
+    }
+
+  --mDepth;
+
+  if (mFailed)
+    {
+      delete node;
+      return NULL;
+    }
+
+  return node;
+}
+
+
+ASTNode*
+SedSnapshotReader::readMath()
+{
+  if (!readBool()) return NULL;
+
+  if (mDepth >= SnapshotMaxDepth)
+    {
+      mFailed = true;
+      return NULL;
+    }
+
+  ASTNodeType_t type = static_cast<ASTNodeType_t>(readInt());
+  ASTNode* math = new ASTNode(type);
+
+  switch (type)
+    {
+    case AST_INTEGER:
+      math->setValue(readLong());
+      break;
+
+    case AST_REAL:
+      math->setValue(readDouble());
+      break;
+
+    case AST_REAL_E:
+      {
+        double mantissa = readDouble();
+        math->setValue(mantissa, readLong());
+      }
+      break;
+
+    case AST_RATIONAL:
+      {
+        long numerator = readLong();
+        math->setValue(numerator, readLong());
+      }
+      break;
+
+    default:
+      break;
+    }
+
+  if (readBool())
+    {
+      math->setName(readString().c_str());
+
+      // setting the name may have changed the type
+      math->setType(type);
+    }
+
+  XMLAttributes url;
+  readAttributes(url);
+
+  if (url.getLength() > 0)
+    math->setDefinitionURL(url);
+
+  std::string units = readString();
+
+  if (!units.empty())
+    math->setUnits(units);
+
+  std::string id = readString();
+
+  if (!id.empty())
+    math->setId(id);
+
+  std::string className = readString();
+
+  if (!className.empty())
+    math->setClass(className);
+
+  std::string style = readString();
+
+  if (!style.empty())
+    math->setStyle(style);
+
+  if (readBool())
+    math->setBvar();
+
+  ++mDepth;
+
+  unsigned int numAnnotations = readUInt();
+
+  for (unsigned int i = 0; i < numAnnotations && !mFailed; ++i)
+    {
+      XMLNode* annotation = readXMLNode();
+
+      if (annotation == NULL)
+        mFailed = true;
+      else
+        math->addSemanticsAnnotation(annotation);
+    }
+
+  unsigned int numChildren = readUInt();
+
+  for (unsigned int i = 0; i < numChildren && !mFailed; ++i)
+    {
+      ASTNode* child = readMath();
+
+      if (child == NULL)
+        mFailed = true;
+      else
+        math->addChild(child);
+    }
+
+  --mDepth;
+
+  if (mFailed)
+    {
+      delete math;
+      return NULL;
+    }
+
+  return math;
+}
+
+
+SedBase*
+SedSnapshotReader::readObject(SedNamespaces* sedns, int expectedTypeCode)
+{
+  if (!readBool()) return NULL;
+
+  int typeCode = readInt();
+
+  if (mFailed || (expectedTypeCode != SEDML_UNKNOWN &&
+                  typeCode != expectedTypeCode))
+    {
+      mFailed = true;
+      return NULL;
+    }
+
+  SedBase* object = createObject(typeCode, sedns);
+
+  if (object == NULL)
+    {
+      mFailed = true;
+      return NULL;
+    }
+
+  object->readSnapshot(*this);
+
+  if (mFailed)
+    {
+      delete object;
+      return NULL;
+    }
+
+  return object;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+SedBase*
+SedSnapshotReader::createObject(int typeCode, SedNamespaces* sedns)
+{
+  switch (typeCode)
+    {
+    case SEDML_MODEL:                          return new SedModel(sedns);
+
+    case SEDML_CHANGE:                         return new SedChange(sedns);
+
+    case SEDML_CHANGE_ATTRIBUTE:               return new SedChangeAttribute(sedns);
+
+    case SEDML_CHANGE_REMOVEXML:               return new SedRemoveXML(sedns);
+
+    case SEDML_CHANGE_COMPUTECHANGE:           return new SedComputeChange(sedns);
+
+    case SEDML_CHANGE_ADDXML:                  return new SedAddXML(sedns);
+
+    case SEDML_CHANGE_CHANGEXML:               return new SedChangeXML(sedns);
+
+    case SEDML_DATAGENERATOR:                  return new SedDataGenerator(sedns);
+
+    case SEDML_VARIABLE:                       return new SedVariable(sedns);
+
+    case SEDML_PARAMETER:                      return new SedParameter(sedns);
+
+    case SEDML_TASK:                           return new SedTask(sedns);
+
+    case SEDML_TASK_SUBTASK:                   return new SedSubTask(sedns);
+
+    case SEDML_TASK_SETVALUE:                  return new SedSetValue(sedns);
+
+    case SEDML_TASK_REPEATEDTASK:              return new SedRepeatedTask(sedns);
+
+    case SEDML_OUTPUT:                         return new SedOutput(sedns);
+
+    case SEDML_OUTPUT_DATASET:                 return new SedDataSet(sedns);
+
+    case SEDML_OUTPUT_CURVE:                   return new SedCurve(sedns);
+
+    case SEDML_OUTPUT_SURFACE:                 return new SedSurface(sedns);
+
+    case SEDML_OUTPUT_REPORT:                  return new SedReport(sedns);
+
+    case SEDML_OUTPUT_PLOT2D:                  return new SedPlot2D(sedns);
+
+    case SEDML_OUTPUT_PLOT3D:                  return new SedPlot3D(sedns);
+
+    case SEDML_SIMULATION:                     return new SedSimulation(sedns);
+
+    case SEDML_SIMULATION_ALGORITHM:           return new SedAlgorithm(sedns);
+
+    case SEDML_SIMULATION_UNIFORMTIMECOURSE:   return new SedUniformTimeCourse(sedns);
+
+    case SEDML_SIMULATION_ALGORITHM_PARAMETER: return new SedAlgorithmParameter(sedns);
+
+    case SEDML_SIMULATION_ONESTEP:             return new SedOneStep(sedns);
+
+    case SEDML_SIMULATION_STEADYSTATE:         return new SedSteadyState(sedns);
+
+    case SEDML_RANGE:                          return new SedRange(sedns);
+
+    case SEDML_RANGE_UNIFORMRANGE:             return new SedUniformRange(sedns);
+
+    case SEDML_RANGE_VECTORRANGE:              return new SedVectorRange(sedns);
+
+    case SEDML_RANGE_FUNCTIONALRANGE:          return new SedFunctionalRange(sedns);
+
+    case SEDML_DATA_DESCRIPTION:               return new SedDataDescription(sedns);
+
+    case SEDML_DATA_SOURCE:                    return new SedDataSource(sedns);
+
+    case SEDML_DATA_SLICE:                     return new SedSlice(sedns);
+
+    default:                                   return NULL;
+    }
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
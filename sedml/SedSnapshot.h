@@ -0,0 +1,294 @@
+/**
+ * @file    SedSnapshot.h
+ * @brief   Binary snapshots of SedDocument objects
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedSnapshotWriter
+ * @ingroup Core
+ * @brief Writes Sed objects to a stream in the binary snapshot format.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A snapshot holds the complete state of a SedDocument in a compact
+ * binary form that can be read back without parsing any XML: all numbers
+ * are stored as little-endian values of fixed size, and all strings,
+ * arrays and lists are preceded by their length.  Math and XML content
+ * (notes, annotations, and the new XML of changes) are stored as trees
+ * rather than as text.
+ *
+ * SedSnapshotWriter and SedSnapshotReader provide the primitives used by
+ * the writeSnapshot() and readSnapshot() methods of each Sed class;
+ * applications will normally only need SedDocument::saveSnapshot() and
+ * SedDocument::loadSnapshot().
+ */
+
+#ifndef SedSnapshot_h
+#define SedSnapshot_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedTypeCodes.h>
+
+
+#ifdef __cplusplus
+
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+class ASTNode;
+class XMLAttributes;
+class XMLNamespaces;
+class XMLNode;
+LIBSBML_CPP_NAMESPACE_END
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class SedBase;
+class SedNamespaces;
+
+
+/**
+ * The version of the snapshot format written by this version of libSEDML.
+ * Snapshots of any other version are rejected when read.
+ */
+#define SEDML_SNAPSHOT_FORMAT_VERSION 1
+
+
+class LIBSEDML_EXTERN SedSnapshotWriter
+{
+public:
+
+  /**
+   * Creates a new SedSnapshotWriter writing to the given stream, which
+   * should have been opened in binary mode.
+   *
+   * @param stream the stream to write to.
+   */
+  SedSnapshotWriter(std::ostream& stream);
+
+
+  /**
+   * Returns @c true if all values so far have been written successfully.
+   *
+   * @return @c false if the underlying stream has failed.
+   */
+  bool good() const;
+
+
+  /**
+   * Writes the given value; integers take four bytes (longs and doubles
+   * eight), strings and arrays are preceded by their length.
+   */
+  void writeUInt(unsigned int value);
+
+  void writeInt(int value);
+
+  void writeLong(long value);
+
+  void writeDouble(double value);
+
+  void writeBool(bool value);
+
+  void writeString(const std::string& value);
+
+  void writeDoubles(const std::vector<double>& values);
+
+
+  /**
+   * Writes the given XMLNode tree, which may be @c NULL.
+   *
+   * @param node the XMLNode to write.
+   */
+  void writeXMLNode(const XMLNode* node);
+
+
+  /**
+   * Writes the given math tree, which may be @c NULL.
+   *
+   * @param math the ASTNode to write.
+   */
+  void writeMath(const ASTNode* math);
+
+
+  /**
+   * Writes the given Sed object (which may be @c NULL) preceded by its
+   * type code, so that it can be recreated by SedSnapshotReader::readObject().
+   *
+   * @param object the object to write.
+   */
+  void writeObject(const SedBase* object);
+
+
+  /**
+   * Writes the given XML attributes or namespaces.
+   */
+  void writeAttributes(const XMLAttributes& attributes);
+
+  void writeNamespaces(const XMLNamespaces& namespaces);
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  void writeBytes(const char* data, size_t length);
+
+  std::ostream& mStream;
+
+  /** @endcond */
+};
+
+
+
+/**
+ * @class SedSnapshotReader
+ * @ingroup Core
+ * @brief Reads Sed objects from a stream in the binary snapshot format.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * Each method of SedSnapshotReader reads the value written by the
+ * corresponding method of SedSnapshotWriter.  Once the data read turns
+ * out to be truncated or inconsistent, the reader is marked as failed and
+ * all further values read are zero, empty or @c NULL.
+ */
+class LIBSEDML_EXTERN SedSnapshotReader
+{
+public:
+
+  /**
+   * Creates a new SedSnapshotReader reading from the given stream, which
+   * should have been opened in binary mode.
+   *
+   * @param stream the stream to read from.
+   */
+  SedSnapshotReader(std::istream& stream);
+
+
+  /**
+   * Returns @c true if all values so far have been read successfully.
+   *
+   * @return @c false if the data read was truncated or invalid.
+   */
+  bool good() const;
+
+
+  /**
+   * Marks this reader as failed.
+   */
+  void setFailed();
+
+
+  /**
+   * Reads a value written by the corresponding method of SedSnapshotWriter.
+   */
+  unsigned int readUInt();
+
+  int readInt();
+
+  long readLong();
+
+  double readDouble();
+
+  bool readBool();
+
+  std::string readString();
+
+  std::vector<double> readDoubles();
+
+
+  /**
+   * Reads an XMLNode tree written by SedSnapshotWriter::writeXMLNode().
+   *
+   * @return the new XMLNode, owned by the caller, or @c NULL.
+   */
+  XMLNode* readXMLNode();
+
+
+  /**
+   * Reads a math tree written by SedSnapshotWriter::writeMath().
+   *
+   * @return the new ASTNode, owned by the caller, or @c NULL.
+   */
+  ASTNode* readMath();
+
+
+  /**
+   * Reads a Sed object written by SedSnapshotWriter::writeObject().
+   *
+   * @param sedns the SedNamespaces the object is created with.
+   * @param expectedTypeCode if not @c SEDML_UNKNOWN, the type code the
+   * object is required to have.
+   *
+   * @return the object read, which may be @c NULL; @c NULL is also
+   * returned on failure.
+   */
+  SedBase* readObject(SedNamespaces* sedns,
+                      int expectedTypeCode = SEDML_UNKNOWN);
+
+
+  /**
+   * Reads XML attributes or namespaces, adding them to the given object.
+   */
+  void readAttributes(XMLAttributes& attributes);
+
+  void readNamespaces(XMLNamespaces& namespaces);
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  bool readBytes(char* data, size_t length);
+
+  /* creates an empty object of the given type */
+  static SedBase* createObject(int typeCode, SedNamespaces* sedns);
+
+  std::istream& mStream;
+  bool mFailed;
+  unsigned int mDepth;
+
+  /** @endcond */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif /* __cplusplus */
+
+#endif  /* SedSnapshot_h */
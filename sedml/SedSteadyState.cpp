@@ -52,8 +52,6 @@ SedSteadyState::SedSteadyState(unsigned int level, unsigned int version)
   : SedSimulation(level, version)
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -181,8 +179,17 @@ SedSteadyState::writeElements(XMLOutputStream& stream) const
 bool
 SedSteadyState::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      if (isSetAlgorithm() == true)
+        {
+          mAlgorithm->accept(v);
+        }
+    }
+
+  v.leave(*this);
 
+  return true;
 }
 
 
@@ -0,0 +1,201 @@
+/**
+ * @file    SedStreamReader.cpp
+ * @brief   Streams the top-level elements of an Sed Document to a callback
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedDocument.h>
+#include <sedml/SedStreamReader.h>
+
+#include <cstring>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/*
+ * Destroys this SedElementCallback.
+ */
+SedElementCallback::~SedElementCallback()
+{
+}
+
+
+/*
+ * Creates a new SedStreamReader using the given callback.
+ */
+SedStreamReader::SedStreamReader(SedElementCallback* callback)
+  : SedReader()
+  , mCallback(callback)
+{
+}
+
+
+/*
+ * Destroys this SedStreamReader.
+ */
+SedStreamReader::~SedStreamReader()
+{
+}
+
+
+/*
+ * Returns the callback used by this SedStreamReader.
+ */
+SedElementCallback*
+SedStreamReader::getCallback() const
+{
+  return mCallback;
+}
+
+
+/*
+ * Sets the callback used by this SedStreamReader.
+ */
+void
+SedStreamReader::setCallback(SedElementCallback* callback)
+{
+  mCallback = callback;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Used by readSedML() and readSedMLFromString().
+ */
+SedDocument*
+SedStreamReader::readInternal(const char* content, bool isFile)
+{
+  SedDocument* d = new SedDocument();
+
+  d->setElementCallback(mCallback);
+
+  readDocument(d, content, isFile);
+
+  // the callback is not needed (and might no longer exist) after reading
+  d->setElementCallback(NULL);
+
+  return d;
+}
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+/*
+ * Adapts a C callback function to a SedElementCallback.
+ */
+class SedFunctionCallback : public SedElementCallback
+{
+public:
+  SedFunctionCallback(SedElementCallback_t callback, void* userData)
+    : mFunction(callback)
+    , mUserData(userData)
+  {
+  }
+
+  virtual bool elementRead(SedBase* element)
+  {
+    return mFunction == NULL || mFunction(element, mUserData) != 0;
+  }
+
+private:
+  SedElementCallback_t mFunction;
+  void* mUserData;
+};
+
+
+/**
+ * Creates a new SedStreamReader and returns it.
+ */
+LIBSEDML_EXTERN
+SedStreamReader_t *
+SedStreamReader_create(SedElementCallback_t callback, void* userData)
+{
+  return new(nothrow) SedStreamReader(
+           new(nothrow) SedFunctionCallback(callback, userData));
+}
+
+
+/**
+ * Frees the given SedStreamReader.
+ */
+LIBSEDML_EXTERN
+void
+SedStreamReader_free(SedStreamReader_t *sr)
+{
+  if (sr == NULL) return;
+
+  delete sr->getCallback();
+  delete sr;
+}
+
+
+/**
+ * Reads an Sed document from the given file.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedStreamReader_readSedMLFromFile(SedStreamReader_t *sr, const char *filename)
+{
+  if (sr != NULL)
+    return (filename != NULL) ? sr->readSedMLFromFile(filename) :
+           sr->readSedMLFromFile("");
+  else
+    return NULL;
+}
+
+
+/**
+ * Reads an Sed document from the given XML string.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedStreamReader_readSedMLFromString(SedStreamReader_t *sr, const char *xml)
+{
+  if (sr != NULL)
+    return (xml != NULL) ? sr->readSedMLFromBuffer(xml, strlen(xml) + 1) :
+           sr->readSedMLFromString("");
+  else
+    return NULL;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,222 @@
+/**
+ * @file    SedStreamReader.h
+ * @brief   Streams the top-level elements of an Sed Document to a callback
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedStreamReader
+ * @ingroup Core
+ * @brief Reads SED-ML handing each top-level element to a callback.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * The SedStreamReader reads SED-ML just like SedReader, but hands every
+ * top-level element (SedDataDescription, SedModel, SedSimulation,
+ * SedTask, SedDataGenerator and SedOutput) to a SedElementCallback as
+ * soon as its end tag has been read.  The callback decides whether the
+ * element is kept in the resulting SedDocument or deleted right away.
+ *
+ * When the callback does not keep the elements, only one top-level
+ * element is held in memory at any time, so large documents can be
+ * scanned for a few elements of interest, and downstream processing can
+ * proceed while the rest of the document is still being parsed.
+ *
+ * The SedDocument returned by the read methods contains the document
+ * level information (attributes, notes, annotations and the error log)
+ * as well as all elements the callback decided to keep.
+ *
+ * @note Since elements can be dropped, the check for empty listOf
+ * elements is not performed while streaming.
+ */
+
+#ifndef SedStreamReader_h
+#define SedStreamReader_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+#include <sedml/SedReader.h>
+
+
+#ifdef __cplusplus
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedElementCallback
+{
+public:
+
+  /**
+   * Destroys this SedElementCallback.
+   */
+  virtual ~SedElementCallback();
+
+
+  /**
+   * Called for each top-level element once it has been read completely.
+   *
+   * The element is connected to its SedDocument, so that the document
+   * (its error log, and all elements kept so far) can be accessed
+   * through SedBase::getSedDocument().
+   *
+   * @param element the element that was just read.
+   *
+   * @return @c true to keep the element in the document, @c false to
+   * have it deleted.  After returning @c false the element must no longer
+   * be used.
+   */
+  virtual bool elementRead(SedBase* element) = 0;
+};
+
+
+class LIBSEDML_EXTERN SedStreamReader : public SedReader
+{
+public:
+
+  /**
+   * Creates a new SedStreamReader handing the elements it reads to the
+   * given callback.  The callback is not owned by the reader.
+   *
+   * @param callback the SedElementCallback to use
+   */
+  SedStreamReader(SedElementCallback* callback);
+
+
+  /**
+   * Destroys this SedStreamReader.
+   */
+  virtual ~SedStreamReader();
+
+
+  /**
+   * Returns the callback used by this SedStreamReader.
+   *
+   * @return the SedElementCallback of this reader.
+   */
+  SedElementCallback* getCallback() const;
+
+
+  /**
+   * Sets the callback used by this SedStreamReader.
+   *
+   * @param callback the SedElementCallback to use
+   */
+  void setCallback(SedElementCallback* callback);
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  /**
+   * Reads the content installing the callback on the document.
+   */
+  virtual SedDocument* readInternal(const char* content, bool isFile = true);
+
+
+  SedElementCallback* mCallback;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Function type used by SedStreamReader_t for each top-level element.
+ *
+ * Return @c non-zero to keep the element in the document, @c zero to have
+ * it deleted.
+ */
+typedef int (*SedElementCallback_t)(SedBase_t* element, void* userData);
+
+
+/**
+ * Creates a new SedStreamReader calling @p callback (with @p userData)
+ * for each top-level element it reads, and returns it.
+ */
+LIBSEDML_EXTERN
+SedStreamReader_t *
+SedStreamReader_create(SedElementCallback_t callback, void* userData);
+
+
+/**
+ * Frees the given SedStreamReader, created with SedStreamReader_create().
+ */
+LIBSEDML_EXTERN
+void
+SedStreamReader_free(SedStreamReader_t *sr);
+
+
+/**
+ * Reads an Sed document from the given file, handing each top-level
+ * element to the callback of the reader.
+ *
+ * @return a pointer to the SedDocument read.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedStreamReader_readSedMLFromFile(SedStreamReader_t *sr, const char *filename);
+
+
+/**
+ * Reads an Sed document from the given XML string, handing each
+ * top-level element to the callback of the reader.
+ *
+ * @return a pointer to the SedDocument read.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedStreamReader_readSedMLFromString(SedStreamReader_t *sr, const char *xml);
+
+
+#endif  /* !SWIG */
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedStreamReader_h */
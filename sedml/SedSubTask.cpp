@@ -36,6 +36,7 @@
 
 #include <sedml/SedSubTask.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -55,8 +56,6 @@ SedSubTask::SedSubTask(unsigned int level, unsigned int version)
   , mTask("")
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -286,6 +285,44 @@ SedSubTask::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedSubTask::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedBase::writeSnapshot(writer);
+
+  writer.writeInt(mOrder);
+  writer.writeBool(mIsSetOrder);
+  writer.writeString(mTask);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedSubTask::readSnapshot(SedSnapshotReader& reader)
+{
+  SedBase::readSnapshot(reader);
+
+  mOrder = reader.readInt();
+  mIsSetOrder = reader.readBool();
+  mTask = reader.readString();
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -294,8 +331,10 @@ SedSubTask::writeElements(XMLOutputStream& stream) const
 bool
 SedSubTask::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
 
+  return true;
 }
 
 
@@ -407,7 +446,6 @@ SedListOfSubTasks::SedListOfSubTasks(unsigned int level,
                                      unsigned int version)
   : SedListOf(level, version)
 {
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -468,10 +506,8 @@ SedListOfSubTasks::get(const std::string& sid)
 const SedSubTask*
 SedListOfSubTasks::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSubTask>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <SedSubTask*>(*result);
+  int index = getIndexById(sid);
+  return (index < 0) ? 0 : static_cast <SedSubTask*>(mItems[index]);
 }
 
 
@@ -543,14 +579,11 @@ SedSubTask*
 SedListOfSubTasks::remove(const std::string& sid)
 {
   SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSubTask>(sid));
+  int index = getIndexById(sid);
 
-  if (result != mItems.end())
+  if (index >= 0)
     {
-      item = *result;
-      mItems.erase(result);
+      item = SedListOf::remove((unsigned int)index);
     }
 
   return static_cast <SedSubTask*>(item);
@@ -36,6 +36,7 @@
 
 #include <sedml/SedSurface.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -55,8 +56,6 @@ SedSurface::SedSurface(unsigned int level, unsigned int version)
   , mZDataReference("")
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -292,6 +291,44 @@ SedSurface::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedSurface::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedCurve::writeSnapshot(writer);
+
+  writer.writeBool(mLogZ);
+  writer.writeBool(mIsSetLogZ);
+  writer.writeString(mZDataReference);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedSurface::readSnapshot(SedSnapshotReader& reader)
+{
+  SedCurve::readSnapshot(reader);
+
+  mLogZ = reader.readBool();
+  mIsSetLogZ = reader.readBool();
+  mZDataReference = reader.readString();
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -300,8 +337,10 @@ SedSurface::writeElements(XMLOutputStream& stream) const
 bool
 SedSurface::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
 
+  return true;
 }
 
 
@@ -413,7 +452,6 @@ SedListOfSurfaces::SedListOfSurfaces(unsigned int level,
                                      unsigned int version)
   : SedListOf(level, version)
 {
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -474,10 +512,8 @@ SedListOfSurfaces::get(const std::string& sid)
 const SedSurface*
 SedListOfSurfaces::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSurface>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <SedSurface*>(*result);
+  int index = getIndexById(sid);
+  return (index < 0) ? 0 : static_cast <SedSurface*>(mItems[index]);
 }
 
 
@@ -549,14 +585,11 @@ SedSurface*
 SedListOfSurfaces::remove(const std::string& sid)
 {
   SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedSurface>(sid));
+  int index = getIndexById(sid);
 
-  if (result != mItems.end())
+  if (index >= 0)
     {
-      item = *result;
-      mItems.erase(result);
+      item = SedListOf::remove((unsigned int)index);
     }
 
   return static_cast <SedSurface*>(item);
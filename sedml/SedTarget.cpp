@@ -0,0 +1,400 @@
+/**
+ * @file    SedTarget.cpp
+ * @brief   A compiled XPath target of a Sed change or variable
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedTarget.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <cctype>
+#include <cstdlib>
+
+using namespace std;
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the parts of an XPath expression from left to right.
+ */
+class SedXPathParser
+{
+public:
+  SedXPathParser(const string& xpath)
+    : mText(xpath)
+    , mPos(0)
+  {
+  }
+
+  void skipSpace()
+  {
+    while (mPos < mText.size() && (mText[mPos] == ' ' || mText[mPos] == '\t'
+           || mText[mPos] == '\n' || mText[mPos] == '\r'))
+      ++mPos;
+  }
+
+  bool atEnd()
+  {
+    skipSpace();
+    return mPos >= mText.size();
+  }
+
+  bool accept(char c)
+  {
+    skipSpace();
+
+    if (mPos >= mText.size() || mText[mPos] != c)
+      return false;
+
+    ++mPos;
+    return true;
+  }
+
+  bool peek(char c, size_t offset = 0) const
+  {
+    return mPos + offset < mText.size() && mText[mPos + offset] == c;
+  }
+
+  /* reads a name, possibly prefixed, or a wildcard, and returns its
+   * local part */
+  bool readName(string& name, bool wildcard)
+  {
+    skipSpace();
+    string part;
+
+    if (!readNCName(part, wildcard))
+      return false;
+
+    if (peek(':') && !peek(':', 1))
+      {
+        ++mPos;
+
+        if (!readNCName(part, wildcard))
+          return false;
+      }
+
+    name = part;
+    return true;
+  }
+
+  bool readLiteral(string& value)
+  {
+    skipSpace();
+
+    if (mPos >= mText.size() || (mText[mPos] != '\'' && mText[mPos] != '"'))
+      return false;
+
+    size_t end = mText.find(mText[mPos], mPos + 1);
+
+    if (end == string::npos)
+      return false;
+
+    value = mText.substr(mPos + 1, end - mPos - 1);
+    mPos = end + 1;
+    return true;
+  }
+
+  bool readNumber(unsigned int& number)
+  {
+    skipSpace();
+    size_t start = mPos;
+
+    while (mPos < mText.size() && mText[mPos] >= '0' && mText[mPos] <= '9')
+      ++mPos;
+
+    if (mPos == start)
+      return false;
+
+    number = (unsigned int)strtoul(mText.substr(start, mPos - start).c_str(),
+                                   NULL, 10);
+    return number > 0;
+  }
+
+private:
+  bool readNCName(string& name, bool wildcard)
+  {
+    if (wildcard && peek('*'))
+      {
+        ++mPos;
+        name = "*";
+        return true;
+      }
+
+    size_t start = mPos;
+
+    while (mPos < mText.size())
+      {
+        unsigned char c = (unsigned char)mText[mPos];
+        bool first = mPos == start;
+
+        if (!(isalpha(c) || c == '_' || c >= 0x80 ||
+              (!first && (isdigit(c) || c == '-' || c == '.'))))
+          break;
+
+        ++mPos;
+      }
+
+    name = mText.substr(start, mPos - start);
+    return !name.empty();
+  }
+
+  const string& mText;
+  size_t mPos;
+};
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Creates a new SedTarget from the given XPath expression.
+ */
+SedTarget::SedTarget(const std::string& xpath)
+  : mXPath()
+  , mSteps()
+  , mAttribute()
+  , mId()
+  , mValid(false)
+  , mIdReference(false)
+{
+  compile(xpath);
+}
+
+
+/*
+ * Destroys this SedTarget.
+ */
+SedTarget::~SedTarget()
+{
+}
+
+
+/*
+ * Compiles the given XPath expression into this SedTarget.
+ */
+int
+SedTarget::compile(const std::string& xpath)
+{
+  clear();
+  mXPath = xpath;
+
+  SedXPathParser parser(mXPath);
+
+  while (!parser.atEnd())
+    {
+      if (!parser.accept('/') || !mAttribute.empty())
+        {
+          clear();
+          return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+        }
+
+      bool descendant = parser.peek('/');
+
+      if (descendant)
+        parser.accept('/');
+
+      // a final attribute step
+      if (parser.accept('@'))
+        {
+          if (descendant || mSteps.empty() ||
+              !parser.readName(mAttribute, false))
+            {
+              clear();
+              return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+            }
+
+          continue;
+        }
+
+      Step step;
+      step.descendant = descendant;
+
+      if (!parser.readName(step.name, true))
+        {
+          clear();
+          return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+        }
+
+      while (parser.accept('['))
+        {
+          Predicate predicate;
+          predicate.position = 0;
+
+          bool ok = parser.accept('@')
+                    ? parser.readName(predicate.attribute, false) &&
+                      parser.accept('=') && parser.readLiteral(predicate.value)
+                    : parser.readNumber(predicate.position);
+
+          if (!ok || !parser.accept(']'))
+            {
+              clear();
+              return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+            }
+
+          step.predicates.push_back(predicate);
+        }
+
+      mSteps.push_back(step);
+    }
+
+  if (mSteps.empty())
+    {
+      clear();
+      return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+    }
+
+  mValid = true;
+
+  // the id of the last element step can be looked up directly when
+  // nothing else is needed to find the element
+  const Step& last = mSteps.back();
+  mIdReference = last.predicates.size() == 1 &&
+                 last.predicates[0].attribute == "id";
+
+  for (size_t i = 0; mIdReference && i < mSteps.size(); ++i)
+    mIdReference = !mSteps[i].descendant &&
+                   (i + 1 == mSteps.size() || mSteps[i].predicates.empty());
+
+  if (mIdReference)
+    mId = last.predicates[0].value;
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns the XPath expression of this SedTarget.
+ */
+const std::string&
+SedTarget::getXPath() const
+{
+  return mXPath;
+}
+
+
+/*
+ * Predicate returning true if the XPath expression could be compiled.
+ */
+bool
+SedTarget::isValid() const
+{
+  return mValid;
+}
+
+
+/*
+ * Predicate returning true if this SedTarget names an element by its id.
+ */
+bool
+SedTarget::isIdReference() const
+{
+  return mIdReference;
+}
+
+
+/*
+ * Returns the id of the element named by this SedTarget.
+ */
+const std::string&
+SedTarget::getId() const
+{
+  return mId;
+}
+
+
+/*
+ * Predicate returning true if this SedTarget selects an attribute.
+ */
+bool
+SedTarget::isSetAttribute() const
+{
+  return !mAttribute.empty();
+}
+
+
+/*
+ * Returns the name of the attribute selected by this SedTarget.
+ */
+const std::string&
+SedTarget::getAttribute() const
+{
+  return mAttribute;
+}
+
+
+/*
+ * Returns the number of element steps of this SedTarget.
+ */
+unsigned int
+SedTarget::getNumSteps() const
+{
+  return (unsigned int)mSteps.size();
+}
+
+
+/*
+ * Returns the nth element step of this SedTarget.
+ */
+const SedTarget::Step*
+SedTarget::getStep(unsigned int n) const
+{
+  return n < mSteps.size() ? &mSteps[n] : NULL;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Resets this SedTarget to the invalid state, keeping its expression.
+ */
+void
+SedTarget::clear()
+{
+  mSteps.clear();
+  mAttribute.clear();
+  mId.clear();
+  mValid = false;
+  mIdReference = false;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+#endif  /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,234 @@
+/**
+ * @file    SedTarget.h
+ * @brief   A compiled XPath target of a Sed change or variable
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedTarget
+ * @ingroup Core
+ * @brief A compiled XPath target of a SedChange, SedVariable or
+ * SedSetValue.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedTarget parses the XPath expression of a "target" attribute once,
+ * so that it can be resolved against any number of models with a
+ * SedTargetIndex without being parsed again.  The absolute location
+ * paths used by SED-ML are supported: child (@c /) and descendant
+ * (@c //) steps, name tests with or without a prefix, or @c *, and
+ * predicates comparing an attribute to a quoted string or selecting a
+ * position, optionally followed by a final attribute step such as
+ * @c /@initialConcentration.  Prefixes are not resolved: steps and
+ * attributes match by local name.
+ *
+ * Targets of the common form naming an element by its id, such as
+ * @verbatim
+ /sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='TRIO']
+ @endverbatim
+ * are recognized by isIdReference(), and resolved through the id index
+ * of the SedTargetIndex rather than by walking the model.
+ */
+
+#ifndef SedTarget_h
+#define SedTarget_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedTarget
+{
+public:
+
+  /** @cond doxygen-libsedml-internal */
+
+  struct Predicate
+  {
+    std::string attribute;
+    std::string value;
+    unsigned int position;
+  };
+
+  struct Step
+  {
+    std::string name;
+    bool descendant;
+    std::vector<Predicate> predicates;
+  };
+
+  /** @endcond doxygen-libsedml-internal */
+
+
+  /**
+   * Creates a new SedTarget from the given XPath expression.
+   *
+   * @param xpath the XPath expression; use isValid() to find out whether
+   * it could be compiled.
+   */
+  SedTarget(const std::string& xpath = "");
+
+
+  /**
+   * Destroys this SedTarget.
+   */
+  virtual ~SedTarget();
+
+
+  /**
+   * Compiles the given XPath expression into this SedTarget.
+   *
+   * @param xpath the XPath expression.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INVALID_ATTRIBUTE_VALUE, if @p xpath is not an
+   * absolute location path of the supported form; this SedTarget is
+   * then invalid.
+   */
+  int compile(const std::string& xpath);
+
+
+  /**
+   * Returns the XPath expression of this SedTarget.
+   *
+   * @return the XPath expression last compiled.
+   */
+  const std::string& getXPath() const;
+
+
+  /**
+   * Predicate returning @c true if the XPath expression of this
+   * SedTarget could be compiled.
+   *
+   * @return @c true if this SedTarget can be resolved, @c false
+   * otherwise.
+   */
+  bool isValid() const;
+
+
+  /**
+   * Predicate returning @c true if this SedTarget names an element by its
+   * id.
+   *
+   * @return @c true if the last element step of this SedTarget selects
+   * children by their "id" attribute, and the steps before it are plain
+   * child steps; such targets are resolved through the id index of a
+   * SedTargetIndex.
+   */
+  bool isIdReference() const;
+
+
+  /**
+   * Returns the id of the element named by this SedTarget.
+   *
+   * @return the id compared to in the last element step if
+   * isIdReference() is @c true, the empty string otherwise.
+   */
+  const std::string& getId() const;
+
+
+  /**
+   * Predicate returning @c true if this SedTarget selects an attribute.
+   *
+   * @return @c true if the XPath expression ends with an attribute step.
+   */
+  bool isSetAttribute() const;
+
+
+  /**
+   * Returns the name of the attribute selected by this SedTarget.
+   *
+   * @return the local name of the attribute of the final attribute step,
+   * or the empty string if there is none.
+   */
+  const std::string& getAttribute() const;
+
+
+  /**
+   * Returns the number of element steps of this SedTarget.
+   *
+   * @return the number of element steps, not counting a final attribute
+   * step.
+   */
+  unsigned int getNumSteps() const;
+
+
+  /**
+   * Returns the nth element step of this SedTarget.
+   *
+   * @param n an unsigned int representing the index of the step.
+   *
+   * @return the step, or @c NULL if @p n is out of range.
+   */
+  const Step* getStep(unsigned int n) const;
+
+
+protected:
+
+  /** @cond doxygen-libsedml-internal */
+
+  void clear();
+
+  std::string mXPath;
+
+  std::vector<Step> mSteps;
+
+  std::string mAttribute;
+
+  std::string mId;
+
+  bool mValid;
+
+  bool mIdReference;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedTarget_h */
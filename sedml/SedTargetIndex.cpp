@@ -0,0 +1,417 @@
+/**
+ * @file    SedTargetIndex.cpp
+ * @brief   An index of the elements of a model for resolving Sed targets
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedTargetIndex.h>
+#include <sedml/SedTarget.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <sbml/xml/XMLNode.h>
+
+#include <algorithm>
+
+using namespace std;
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygen-libsedml-internal */
+
+/* the attributes holding the value of an element of an SBML model, in
+ * the order in which they are looked for */
+static const char* SEDML_VALUE_ATTRIBUTES[] =
+{
+  "value", "size", "initialConcentration", "initialAmount", NULL
+};
+
+
+static bool
+matchesName(const XMLNode* element, const SedTarget::Step& step)
+{
+  return step.name == "*" || element->getName() == step.name;
+}
+
+
+static void
+addDescendants(const XMLNode* element, vector<const XMLNode*>& result)
+{
+  for (unsigned int i = 0; i < element->getNumChildren(); ++i)
+    {
+      const XMLNode* child = &element->getChild(i);
+
+      if (!child->isElement())
+        continue;
+
+      result.push_back(child);
+      addDescendants(child, result);
+    }
+}
+
+
+/*
+ * Keeps the candidates the predicates of the step select, in turn, so
+ * that a position counts among the candidates left by the predicates
+ * before it.
+ */
+static void
+applyPredicates(const SedTarget::Step& step, vector<const XMLNode*>& nodes)
+{
+  for (size_t p = 0; p < step.predicates.size(); ++p)
+    {
+      const SedTarget::Predicate& predicate = step.predicates[p];
+      vector<const XMLNode*> kept;
+
+      if (predicate.position > 0)
+        {
+          if (predicate.position <= nodes.size())
+            kept.push_back(nodes[predicate.position - 1]);
+        }
+      else
+        {
+          for (size_t i = 0; i < nodes.size(); ++i)
+            if (nodes[i]->hasAttr(predicate.attribute) &&
+                nodes[i]->getAttrValue(predicate.attribute) == predicate.value)
+              kept.push_back(nodes[i]);
+        }
+
+      nodes.swap(kept);
+    }
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Creates a new SedTargetIndex of the given model.
+ */
+SedTargetIndex::SedTargetIndex(const XMLNode* root)
+  : mRoot(root)
+  , mElements()
+  , mParents()
+  , mOrder()
+  , mIds()
+{
+  if (root == NULL)
+    return;
+
+  // a node without a name holds the top-level elements of a document
+  if (root->isElement() && !root->getName().empty())
+    {
+      addElement(root, NULL);
+    }
+  else
+    {
+      for (unsigned int i = 0; i < root->getNumChildren(); ++i)
+        if (root->getChild(i).isElement())
+          addElement(&root->getChild(i), NULL);
+    }
+}
+
+
+/*
+ * Destroys this SedTargetIndex.
+ */
+SedTargetIndex::~SedTargetIndex()
+{
+}
+
+
+/*
+ * Returns the document element of the model of this SedTargetIndex.
+ */
+const XMLNode*
+SedTargetIndex::getRoot() const
+{
+  return mRoot;
+}
+
+
+/*
+ * Returns the number of elements of the model.
+ */
+unsigned int
+SedTargetIndex::getNumElements() const
+{
+  return (unsigned int)mElements.size();
+}
+
+
+/*
+ * Returns the first element of the model with the given id.
+ */
+const XMLNode*
+SedTargetIndex::getElementById(const std::string& id) const
+{
+  unordered_map<string, vector<const XMLNode*> >::const_iterator it =
+    mIds.find(id);
+  return it == mIds.end() ? NULL : it->second.front();
+}
+
+
+/*
+ * Returns the parent of the given element of the model.
+ */
+const XMLNode*
+SedTargetIndex::getParent(const XMLNode* element) const
+{
+  unordered_map<const XMLNode*, const XMLNode*>::const_iterator it =
+    mParents.find(element);
+  return it == mParents.end() ? NULL : it->second;
+}
+
+
+/*
+ * Finds the elements the given target selects.
+ */
+unsigned int
+SedTargetIndex::getElements(const SedTarget& target,
+                            std::vector<const XMLNode*>& elements) const
+{
+  elements.clear();
+
+  if (!target.isValid() || mElements.empty())
+    return 0;
+
+  if (target.isIdReference())
+    {
+      unordered_map<string, vector<const XMLNode*> >::const_iterator it =
+        mIds.find(target.getId());
+
+      if (it != mIds.end())
+        {
+          for (size_t i = 0; i < it->second.size(); ++i)
+            if (matchesAncestors(target, it->second[i]))
+              elements.push_back(it->second[i]);
+        }
+    }
+  else
+    {
+      // the context of the first step is the document, whose children are
+      // the top-level elements
+      vector<const XMLNode*> contexts(1, (const XMLNode*)NULL);
+
+      for (unsigned int s = 0; s < target.getNumSteps(); ++s)
+        {
+          const SedTarget::Step& step = *target.getStep(s);
+
+          // a descendant step is a child step from each context and each
+          // element below it
+          if (step.descendant)
+            {
+              vector<const XMLNode*> expanded;
+
+              for (size_t c = 0; c < contexts.size(); ++c)
+                {
+                  expanded.push_back(contexts[c]);
+
+                  if (contexts[c] == NULL)
+                    expanded.insert(expanded.end(), mElements.begin(),
+                                    mElements.end());
+                  else
+                    addDescendants(contexts[c], expanded);
+                }
+
+              sortElements(expanded);
+              contexts.swap(expanded);
+            }
+
+          vector<const XMLNode*> next;
+
+          for (size_t c = 0; c < contexts.size(); ++c)
+            {
+              vector<const XMLNode*> nodes;
+
+              if (contexts[c] == NULL)
+                {
+                  for (size_t i = 0; i < mElements.size(); ++i)
+                    if (getParent(mElements[i]) == NULL &&
+                        matchesName(mElements[i], step))
+                      nodes.push_back(mElements[i]);
+                }
+              else
+                {
+                  unsigned int numChildren = contexts[c]->getNumChildren();
+
+                  for (unsigned int i = 0; i < numChildren; ++i)
+                    {
+                      const XMLNode* child = &contexts[c]->getChild(i);
+
+                      if (child->isElement() && matchesName(child, step))
+                        nodes.push_back(child);
+                    }
+                }
+
+              applyPredicates(step, nodes);
+              next.insert(next.end(), nodes.begin(), nodes.end());
+            }
+
+          // the children of nested contexts interleave
+          if (step.descendant)
+            sortElements(next);
+
+          contexts.swap(next);
+        }
+
+      elements.swap(contexts);
+    }
+
+  if (target.isSetAttribute())
+    {
+      vector<const XMLNode*> kept;
+
+      for (size_t i = 0; i < elements.size(); ++i)
+        if (elements[i]->hasAttr(target.getAttribute()))
+          kept.push_back(elements[i]);
+
+      elements.swap(kept);
+    }
+
+  return (unsigned int)elements.size();
+}
+
+
+/*
+ * Returns the first element the given target selects.
+ */
+const XMLNode*
+SedTargetIndex::getElement(const SedTarget& target) const
+{
+  vector<const XMLNode*> elements;
+  return getElements(target, elements) > 0 ? elements[0] : NULL;
+}
+
+
+/*
+ * Returns the value of the attribute the given target selects.
+ */
+int
+SedTargetIndex::getValue(const SedTarget& target, std::string& value) const
+{
+  if (!target.isSetAttribute())
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  const XMLNode* element = getElement(target);
+
+  if (element == NULL)
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  value = element->getAttrValue(target.getAttribute());
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns the name of the attribute holding the value of the given
+ * element.
+ */
+const char*
+SedTargetIndex::getValueAttribute(const XMLNode* element)
+{
+  for (const char** name = SEDML_VALUE_ATTRIBUTES; *name != NULL; ++name)
+    if (element->hasAttr(*name))
+      return *name;
+
+  return NULL;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Records the given element and those below it, in document order.
+ */
+void
+SedTargetIndex::addElement(const XMLNode* element, const XMLNode* parent)
+{
+  mOrder[element] = (unsigned int)mElements.size();
+  mElements.push_back(element);
+  mParents[element] = parent;
+
+  if (element->hasAttr("id"))
+    mIds[element->getAttrValue("id")].push_back(element);
+
+  for (unsigned int i = 0; i < element->getNumChildren(); ++i)
+    {
+      const XMLNode* child = &element->getChild(i);
+
+      if (child->isElement())
+        addElement(child, element);
+    }
+}
+
+
+/*
+ * Sorts the given elements in document order, without duplicates; the
+ * document itself, NULL, comes first.
+ */
+void
+SedTargetIndex::sortElements(std::vector<const XMLNode*>& elements) const
+{
+  const unordered_map<const XMLNode*, unsigned int>& order = mOrder;
+  sort(elements.begin(), elements.end(),
+       [&order](const XMLNode* a, const XMLNode* b)
+       { return b != NULL && (a == NULL || order.at(a) < order.at(b)); });
+  elements.erase(unique(elements.begin(), elements.end()), elements.end());
+}
+
+
+/*
+ * Returns true if the element and its ancestors match the steps of the
+ * given target, which are plain child steps from the document element.
+ */
+bool
+SedTargetIndex::matchesAncestors(const SedTarget& target,
+                                 const XMLNode* element) const
+{
+  for (unsigned int s = target.getNumSteps(); s > 0; --s)
+    {
+      if (element == NULL || !matchesName(element, *target.getStep(s - 1)))
+        return false;
+
+      element = getParent(element);
+    }
+
+  return element == NULL;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+#endif  /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
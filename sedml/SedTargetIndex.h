@@ -0,0 +1,221 @@
+/**
+ * @file    SedTargetIndex.h
+ * @brief   An index of the elements of a model for resolving Sed targets
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedTargetIndex
+ * @ingroup Core
+ * @brief An index of the elements of a model, for resolving SedTarget
+ * objects.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedTargetIndex walks the XML of a model once, and records the
+ * elements by their "id" attribute together with the parent of each
+ * element.  A SedTarget for which SedTarget::isIdReference() is @c true
+ * is then resolved by looking its id up and checking the names of the
+ * ancestors of the elements found, without walking the model; any other
+ * SedTarget is resolved by evaluating its steps from the root.
+ *
+ * The index refers to the XMLNode objects of the model, which must not
+ * be changed or destroyed while it is in use.
+ */
+
+#ifndef SedTargetIndex_h
+#define SedTargetIndex_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedTarget;
+
+
+class LIBSEDML_EXTERN SedTargetIndex
+{
+public:
+
+  /**
+   * Creates a new SedTargetIndex of the given model.
+   *
+   * @param root the document element of the model, such as the
+   * @c &lt;sbml&gt; element of an SBML model.
+   */
+  SedTargetIndex(const XMLNode* root);
+
+
+  /**
+   * Destroys this SedTargetIndex.
+   */
+  virtual ~SedTargetIndex();
+
+
+  /**
+   * Returns the document element of the model of this SedTargetIndex.
+   *
+   * @return the XMLNode this SedTargetIndex was created for.
+   */
+  const XMLNode* getRoot() const;
+
+
+  /**
+   * Returns the number of elements of the model.
+   *
+   * @return the number of elements indexed.
+   */
+  unsigned int getNumElements() const;
+
+
+  /**
+   * Returns the first element of the model with the given id.
+   *
+   * @param id the value of the "id" attribute.
+   *
+   * @return the first element in document order with that id, or
+   * @c NULL if there is none.
+   */
+  const XMLNode* getElementById(const std::string& id) const;
+
+
+  /**
+   * Returns the parent of the given element of the model.
+   *
+   * @param element an element of the model.
+   *
+   * @return the parent element, or @c NULL for the document element and
+   * for elements that are not part of the model.
+   */
+  const XMLNode* getParent(const XMLNode* element) const;
+
+
+  /**
+   * Finds the elements the given target selects.
+   *
+   * @param target the SedTarget.
+   * @param elements the vector receiving the elements, in document
+   * order; for a target ending with an attribute step, the elements
+   * that have the attribute.
+   *
+   * @return the number of elements found.
+   */
+  unsigned int getElements(const SedTarget& target,
+                           std::vector<const XMLNode*>& elements) const;
+
+
+  /**
+   * Returns the first element the given target selects.
+   *
+   * @param target the SedTarget.
+   *
+   * @return the element, or @c NULL if @p target selects none or is not
+   * valid.
+   */
+  const XMLNode* getElement(const SedTarget& target) const;
+
+
+  /**
+   * Returns the value of the attribute the given target selects.
+   *
+   * @param target a SedTarget ending with an attribute step.
+   * @param value the string receiving the value of the attribute of the
+   * first element selected.
+   *
+   * @return integer value indicating success/failure of the operation.
+   * The possible return values are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INVALID_ATTRIBUTE_VALUE, if @p target selects no
+   * element, or does not select an attribute the element has.
+   */
+  int getValue(const SedTarget& target, std::string& value) const;
+
+
+  /**
+   * Returns the name of the attribute holding the value of the given
+   * element of an SBML model when a target names no attribute: the first
+   * of "value", "size", "initialConcentration" and "initialAmount" the
+   * element has.
+   *
+   * @param element the element.
+   *
+   * @return the name of the attribute, or @c NULL if the element has none
+   * of them.
+   */
+  static const char* getValueAttribute(const XMLNode* element);
+
+
+protected:
+
+  /** @cond doxygen-libsedml-internal */
+
+  /* not copyable */
+  SedTargetIndex(const SedTargetIndex&);
+  SedTargetIndex& operator=(const SedTargetIndex&);
+
+  void addElement(const XMLNode* element, const XMLNode* parent);
+
+  void sortElements(std::vector<const XMLNode*>& elements) const;
+
+  bool matchesAncestors(const SedTarget& target,
+                        const XMLNode* element) const;
+
+  const XMLNode* mRoot;
+
+  std::vector<const XMLNode*> mElements;
+
+  std::unordered_map<const XMLNode*, const XMLNode*> mParents;
+
+  std::unordered_map<const XMLNode*, unsigned int> mOrder;
+
+  std::unordered_map<std::string, std::vector<const XMLNode*> > mIds;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedTargetIndex_h */
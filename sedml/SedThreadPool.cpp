@@ -0,0 +1,147 @@
+/**
+ * @file    SedThreadPool.cpp
+ * @brief   Runs work on a pool of threads
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedThreadPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+/** @cond doxygen-libsedml-internal */
+
+unsigned int
+SedThreadPool::getNumWorkers(unsigned int numThreads, size_t numItems)
+{
+  if (numThreads == 0)
+    numThreads = thread::hardware_concurrency();
+
+  if (numThreads == 0)
+    numThreads = 1;
+
+  return (unsigned int)min((size_t)numThreads, numItems);
+}
+
+
+void
+SedThreadPool::run(unsigned int numWorkers,
+                   const function<void (unsigned int)>& worker)
+{
+  vector<thread> threads;
+
+  try
+    {
+      threads.reserve(numWorkers > 0 ? numWorkers - 1 : 0);
+
+      for (unsigned int n = 1; n < numWorkers; ++n)
+        threads.push_back(thread(worker, n));
+    }
+  catch (...)
+    {
+      /* no more threads: those running share the work */
+    }
+
+  exception_ptr failure;
+
+  /* the calling thread does its share of the work too */
+  try
+    {
+      worker(0);
+    }
+  catch (...)
+    {
+      failure = current_exception();
+    }
+
+  for (size_t n = 0; n < threads.size(); ++n)
+    threads[n].join();
+
+  if (failure)
+    rethrow_exception(failure);
+}
+
+
+void
+SedThreadPool::forEach(unsigned int numWorkers, size_t numItems,
+                       const function<void (size_t)>& task)
+{
+  if (numItems == 0) return;
+
+  atomic<size_t> next(0);
+  mutex failureMutex;
+  exception_ptr failure;
+
+  /* each worker takes the next item, until all are done or one failed */
+  run(numWorkers, [&](unsigned int)
+  {
+    for (size_t i = next++; i < numItems; i = next++)
+      {
+        try
+          {
+            task(i);
+          }
+        catch (...)
+          {
+            lock_guard<mutex> lock(failureMutex);
+
+            if (!failure)
+              failure = current_exception();
+
+            next = numItems;
+            return;
+          }
+      }
+  });
+
+  if (failure)
+    rethrow_exception(failure);
+}
+
+/** @endcond */
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,125 @@
+/**
+ * @file    SedThreadPool.h
+ * @brief   Runs work on a pool of threads
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedThreadPool
+ * @ingroup Core
+ * @brief Runs work on a pool of threads (internal).
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * The SedThreadPool holds the thread handling shared by SedBatchReader,
+ * SedExecutor and SedParallelVisitor: choosing the number of threads,
+ * starting them with the calling thread doing its share of the work,
+ * and joining them again.  If a thread cannot be started, the work is
+ * done by the threads already running, which are always joined, so that
+ * no std::thread is destroyed while still joinable.
+ */
+
+#ifndef SedThreadPool_h
+#define SedThreadPool_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <cstddef>
+#include <functional>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+class SedThreadPool
+{
+public:
+
+  /**
+   * Returns the number of threads to use for the given number of items.
+   *
+   * @param numThreads the number of threads requested; @c 0 uses the
+   * number of hardware threads available.
+   * @param numItems the number of items to work on.
+   *
+   * @return the number of threads, at most @p numItems.
+   */
+  static unsigned int getNumWorkers(unsigned int numThreads,
+                                    size_t numItems);
+
+
+  /**
+   * Calls @p worker on @p numWorkers threads, passing each the number of
+   * its thread, and returns once all of them have returned.
+   *
+   * The calling thread runs worker 0 itself.  Workers that cannot be
+   * started, because no more threads can be created, are skipped, so
+   * every worker must be able to finish the work of the others.  An
+   * exception thrown by worker 0 is rethrown once the other threads have
+   * been joined; the other workers must not throw.
+   *
+   * @param numWorkers the number of workers to run.
+   * @param worker the function to run.
+   */
+  static void run(unsigned int numWorkers,
+                  const std::function<void (unsigned int)>& worker);
+
+
+  /**
+   * Calls @p task for each of @p numItems items on @p numWorkers threads,
+   * which take the next item in turn.
+   *
+   * The first exception thrown by a task stops the threads from taking
+   * further items, and is rethrown once all threads have been joined.
+   *
+   * @param numWorkers the number of threads to use.
+   * @param numItems the number of items.
+   * @param task the function to call with the index of each item.
+   */
+  static void forEach(unsigned int numWorkers, size_t numItems,
+                      const std::function<void (size_t)>& task);
+};
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif /* __cplusplus */
+
+#endif /* SedThreadPool_h */
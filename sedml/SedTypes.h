@@ -76,9 +76,28 @@
 
 #include <sedml/SedBase.h>
 #include <sedml/SedListOf.h>
+#include <sedml/SedArena.h>
+#include <sedml/SedSnapshot.h>
+#include <sedml/SedLoadStatistics.h>
+#include <sedml/SedMathProgram.h>
+#include <sedml/SedExpressionDag.h>
+#include <sedml/SedResultStore.h>
+#include <sedml/SedTarget.h>
+#include <sedml/SedTargetIndex.h>
+#include <sedml/SedModelResolver.h>
+#include <sedml/SedModelPatch.h>
+#include <sedml/SedEnsembleBatch.h>
+#include <sedml/SedIterationSpace.h>
+#include <sedml/SedDependencyGraph.h>
+#include <sedml/SedDependencySlice.h>
+#include <sedml/SedParallelVisitor.h>
+#include <sedml/SedSimulatorBackend.h>
+#include <sedml/SedExecutor.h>
 
 
 #include <sedml/SedReader.h>
+#include <sedml/SedStreamReader.h>
+#include <sedml/SedBatchReader.h>
 #include <sedml/SedWriter.h>
 
 #include <sbml/xml/XMLError.h>
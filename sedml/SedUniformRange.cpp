@@ -36,6 +36,7 @@
 
 #include <sedml/SedUniformRange.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -59,8 +60,6 @@ SedUniformRange::SedUniformRange(unsigned int level, unsigned int version)
   , mType("")
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -421,6 +420,52 @@ SedUniformRange::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedUniformRange::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedRange::writeSnapshot(writer);
+
+  writer.writeDouble(mStart);
+  writer.writeBool(mIsSetStart);
+  writer.writeDouble(mEnd);
+  writer.writeBool(mIsSetEnd);
+  writer.writeInt(mNumberOfPoints);
+  writer.writeBool(mIsSetNumberOfPoints);
+  writer.writeString(mType);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedUniformRange::readSnapshot(SedSnapshotReader& reader)
+{
+  SedRange::readSnapshot(reader);
+
+  mStart = reader.readDouble();
+  mIsSetStart = reader.readBool();
+  mEnd = reader.readDouble();
+  mIsSetEnd = reader.readBool();
+  mNumberOfPoints = reader.readInt();
+  mIsSetNumberOfPoints = reader.readBool();
+  mType = reader.readString();
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -429,8 +474,10 @@ SedUniformRange::writeElements(XMLOutputStream& stream) const
 bool
 SedUniformRange::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
 
+  return true;
 }
 
 
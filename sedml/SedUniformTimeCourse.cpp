@@ -36,6 +36,7 @@
 
 #include <sedml/SedUniformTimeCourse.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -60,8 +61,6 @@ SedUniformTimeCourse::SedUniformTimeCourse(unsigned int level, unsigned int vers
   , mIsSetNumberOfPoints(false)
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -425,6 +424,54 @@ SedUniformTimeCourse::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedUniformTimeCourse::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedSimulation::writeSnapshot(writer);
+
+  writer.writeDouble(mInitialTime);
+  writer.writeBool(mIsSetInitialTime);
+  writer.writeDouble(mOutputStartTime);
+  writer.writeBool(mIsSetOutputStartTime);
+  writer.writeDouble(mOutputEndTime);
+  writer.writeBool(mIsSetOutputEndTime);
+  writer.writeInt(mNumberOfPoints);
+  writer.writeBool(mIsSetNumberOfPoints);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedUniformTimeCourse::readSnapshot(SedSnapshotReader& reader)
+{
+  SedSimulation::readSnapshot(reader);
+
+  mInitialTime = reader.readDouble();
+  mIsSetInitialTime = reader.readBool();
+  mOutputStartTime = reader.readDouble();
+  mIsSetOutputStartTime = reader.readBool();
+  mOutputEndTime = reader.readDouble();
+  mIsSetOutputEndTime = reader.readBool();
+  mNumberOfPoints = reader.readInt();
+  mIsSetNumberOfPoints = reader.readBool();
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -433,8 +480,17 @@ SedUniformTimeCourse::writeElements(XMLOutputStream& stream) const
 bool
 SedUniformTimeCourse::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      if (isSetAlgorithm() == true)
+        {
+          mAlgorithm->accept(v);
+        }
+    }
+
+  v.leave(*this);
 
+  return true;
 }
 
 
@@ -36,6 +36,7 @@
 
 #include <sedml/SedVariable.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -58,8 +59,6 @@ SedVariable::SedVariable(unsigned int level, unsigned int version)
   , mModelReference("")
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -261,7 +260,9 @@ SedVariable::isSetModelReference() const
 int
 SedVariable::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  indexElement();
+  return result;
 }
 
 
@@ -347,6 +348,7 @@ int
 SedVariable::unsetId()
 {
   mId.erase();
+  indexElement();
 
   if (mId.empty() == true)
     {
@@ -505,6 +507,50 @@ SedVariable::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedVariable::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedBase::writeSnapshot(writer);
+
+  writer.writeString(mId);
+  writer.writeString(mName);
+  writer.writeString(mSymbol);
+  writer.writeString(mTarget);
+  writer.writeString(mTaskReference);
+  writer.writeString(mModelReference);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedVariable::readSnapshot(SedSnapshotReader& reader)
+{
+  SedBase::readSnapshot(reader);
+
+  mId = reader.readString();
+  mName = reader.readString();
+  mSymbol = reader.readString();
+  mTarget = reader.readString();
+  mTaskReference = reader.readString();
+  mModelReference = reader.readString();
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -513,8 +559,10 @@ SedVariable::writeElements(XMLOutputStream& stream) const
 bool
 SedVariable::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
 
+  return true;
 }
 
 
@@ -720,7 +768,6 @@ SedListOfVariables::SedListOfVariables(unsigned int level,
                                        unsigned int version)
   : SedListOf(level, version)
 {
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -781,10 +828,8 @@ SedListOfVariables::get(const std::string& sid)
 const SedVariable*
 SedListOfVariables::get(const std::string& sid) const
 {
-  vector<SedBase*>::const_iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedVariable>(sid));
-  return (result == mItems.end()) ? 0 : static_cast <SedVariable*>(*result);
+  int index = getIndexById(sid);
+  return (index < 0) ? 0 : static_cast <SedVariable*>(mItems[index]);
 }
 
 
@@ -856,14 +901,11 @@ SedVariable*
 SedListOfVariables::remove(const std::string& sid)
 {
   SedBase* item = NULL;
-  vector<SedBase*>::iterator result;
-
-  result = find_if(mItems.begin(), mItems.end(), SedIdEq<SedVariable>(sid));
+  int index = getIndexById(sid);
 
-  if (result != mItems.end())
+  if (index >= 0)
     {
-      item = *result;
-      mItems.erase(result);
+      item = SedListOf::remove((unsigned int)index);
     }
 
   return static_cast <SedVariable*>(item);
@@ -36,7 +36,10 @@
 
 #include <sedml/SedVectorRange.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedSnapshot.h>
 #include <sbml/xml/XMLInputStream.h>
+#include <sedml/SedDocument.h>
+#include <sedml/common/numberutil.h>
 
 
 using namespace std;
@@ -45,6 +48,13 @@ using namespace std;
 LIBSEDML_CPP_NAMESPACE_BEGIN
 
 
+/* the namespace of the binary encoding of the values, a libSEDML
+ * extension, and the prefix it is written with */
+static const char* const BINARY_VALUES_XMLNS =
+  "http://sed-ml.org/libsedml/binaryValues";
+static const char* const BINARY_VALUES_PREFIX = "libsedml";
+
+
 /*
  * Creates a new SedVectorRange with the given level, version, and package version.
  */
@@ -53,8 +63,6 @@ SedVectorRange::SedVectorRange(unsigned int level, unsigned int version)
   , mValues()
 
 {
-  // set an SedNamespaces derived object of this package
-  setSedNamespacesAndOwn(new SedNamespaces(level, version));
 }
 
 
@@ -182,6 +190,40 @@ SedVectorRange::setValues(const std::vector<double>& value)
 }
 
 
+/*
+ * Sets the values of this SedVectorRange from an array.
+ */
+int
+SedVectorRange::setValues(const double* values, size_t numValues)
+{
+  if (values == NULL && numValues > 0)
+    return LIBSEDML_INVALID_OBJECT;
+
+  mValues.assign(values, values + numValues);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns a pointer to the values of this SedVectorRange.
+ */
+const double*
+SedVectorRange::getValuesData() const
+{
+  return mValues.empty() ? NULL : &mValues[0];
+}
+
+
+/*
+ * Returns a pointer to the values of this SedVectorRange.
+ */
+double*
+SedVectorRange::getValuesData()
+{
+  return mValues.empty() ? NULL : &mValues[0];
+}
+
+
 /**
  * Adds another value to the "value" attribute of this SedVectorRange.
  *
@@ -277,13 +319,47 @@ SedVectorRange::writeElements(XMLOutputStream& stream) const
 {
   SedRange::writeElements(stream);
 
-  if (hasValues())
+  const SedDocument* doc = getSedDocument();
+
+  if (doc != NULL && doc->getBinaryValueThreshold() > 0
+      && mValues.size() > doc->getBinaryValueThreshold())
+    {
+      string text;
+      bool compressed = SedUtil_encodeDoubles(&mValues[0], mValues.size(),
+                        doc->getCompressBinaryValues(), text);
+
+      // the element is not part of SED-ML, so it goes in a namespace of
+      // its own
+      stream.startElement("binaryValues", BINARY_VALUES_PREFIX);
+      stream.writeAttribute(BINARY_VALUES_PREFIX, "xmlns",
+                            std::string(BINARY_VALUES_XMLNS));
+      stream.writeAttribute("count", (long)mValues.size());
+
+      if (compressed)
+        stream.writeAttribute("compression", std::string("zlib"));
+
+      stream.setAutoIndent(false);
+      stream << text;
+      stream.endElement("binaryValues", BINARY_VALUES_PREFIX);
+      stream.setAutoIndent(true);
+    }
+  else if (hasValues())
     {
+      // each value is written as " <number> ", formatted locale
+      // independently and with as many digits as needed to read it back
+      char number[SEDML_DOUBLE_BUFFER_SIZE];
+      string text;
+
       for (std::vector<double>::const_iterator it = mValues.begin(); it != mValues.end(); ++it)
         {
+          size_t length = SedUtil_formatDouble(*it, number);
+          text.assign(1, ' ');
+          text.append(number, length);
+          text.append(1, ' ');
+
           stream.startElement("value");
           stream.setAutoIndent(false);
-          stream << " " << *it << " ";
+          stream << text;
           stream.endElement("value");
           stream.setAutoIndent(true);
         }
@@ -294,6 +370,40 @@ SedVectorRange::writeElements(XMLOutputStream& stream) const
 /** @endcond doxygen-libsedml-internal */
 
 
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Writes the attributes and children of this object to a snapshot.
+ */
+void
+SedVectorRange::writeSnapshot(SedSnapshotWriter& writer) const
+{
+  SedRange::writeSnapshot(writer);
+
+  writer.writeDoubles(mValues);
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the attributes and children of this object from a snapshot.
+ */
+void
+SedVectorRange::readSnapshot(SedSnapshotReader& reader)
+{
+  SedRange::readSnapshot(reader);
+
+  mValues = reader.readDoubles();
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
 /** @cond doxygen-libsedml-internal */
 
 /*
@@ -302,8 +412,10 @@ SedVectorRange::writeElements(XMLOutputStream& stream) const
 bool
 SedVectorRange::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
 
+  return true;
 }
 
 
@@ -369,23 +481,50 @@ SedVectorRange::readOtherXML(XMLInputStream& stream)
   bool          read = false;
   //const string& name = stream.peek().getName();
 
+  string text;
+
   while (stream.peek().getName() == "value")
     {
       stream.next(); // consume start
-      stringstream text;
+      text.clear();
 
       while (stream.isGood() && stream.peek().isText())
-        text << stream.next().getCharacters();
+        text += stream.next().getCharacters();
 
-      double value; text >> value;
+      double value;
 
-      if (!text.fail())
+      if (SedUtil_parseDouble(text.c_str(), value) != NULL)
         mValues.push_back(value);
 
       stream.next(); // consume end
       read = true;
     }
 
+  while (stream.peek().getName() == "binaryValues"
+         && stream.peek().getURI() == BINARY_VALUES_XMLNS)
+    {
+      const XMLToken element = stream.next(); // consume start
+      long count = -1;
+      element.getAttributes().readInto("count", count);
+      bool compressed =
+        element.getAttributes().getValue("compression") == "zlib";
+
+      text.clear();
+
+      while (stream.isGood() && stream.peek().isText())
+        text += stream.next().getCharacters();
+
+      if (count < 0
+          || !SedUtil_decodeDoubles(text, (size_t)count, compressed, mValues))
+        {
+          logError(SedNotSchemaConformant, getLevel(), getVersion(),
+                   "The <binaryValues> of a <vectorRange> could not be decoded.");
+        }
+
+      stream.skipPastEnd(element);
+      read = true;
+    }
+
   if (SedRange::readOtherXML(stream))
     {
       read = true;
@@ -172,6 +172,41 @@ public:
   virtual int setValues(const std::vector<double>& value);
 
 
+  /**
+   * Sets the values of this SedVectorRange to the @p numValues numbers
+   * starting at @p values.
+   *
+   * @param values pointer to the first of the values to be set
+   * @param numValues the number of values to be set
+   *
+   * @return integer value indicating success/failure of the
+   * function.  @if clike The value is drawn from the
+   * enumeration #OperationReturnValues_t. @endif The possible values
+   * returned by this function are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INVALID_OBJECT
+   */
+  virtual int setValues(const double* values, size_t numValues);
+
+
+  /**
+   * Returns a pointer to the values of this SedVectorRange, which are
+   * stored contiguously; getNumValues() gives their number.
+   *
+   * @return a pointer to the first value, or @c NULL if there are none.
+   */
+  const double* getValuesData() const;
+
+
+  /**
+   * Returns a pointer to the values of this SedVectorRange, which are
+   * stored contiguously; getNumValues() gives their number.
+   *
+   * @return a pointer to the first value, or @c NULL if there are none.
+   */
+  double* getValuesData();
+
+
   /**
    * Adds another value to the "value" attribute of this SedVectorRange.
    *
@@ -267,6 +302,28 @@ public:
   /** @endcond doxygen-libsedml-internal */
 
 
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Writes the attributes and children of this object to a snapshot.
+   */
+  virtual void writeSnapshot(SedSnapshotWriter& writer) const;
+
+
+  /** @endcond doxygen-libsedml-internal */
+
+
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Reads the attributes and children of this object from a snapshot.
+   */
+  virtual void readSnapshot(SedSnapshotReader& reader);
+
+
+  /** @endcond doxygen-libsedml-internal */
+
+
   /** @cond doxygen-libsedml-internal */
 
   /**
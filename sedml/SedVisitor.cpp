@@ -63,13 +63,14 @@ SedVisitor::visit(const SedListOf& x, int type)
 bool
 SedVisitor::visit(const SedBase& sb)
 {
-  return false;
+  return true;
 }
 
 
 void
 SedVisitor::leave(const SedDocument& x)
 {
+  leave(static_cast<const SedBase&>(x));
 }
 
 void
@@ -81,6 +82,7 @@ SedVisitor::leave(const SedBase& x)
 void
 SedVisitor::leave(const SedListOf& x, int type)
 {
+  leave(static_cast<const SedBase&>(x));
 }
 
 LIBSEDML_CPP_NAMESPACE_END
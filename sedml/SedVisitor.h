@@ -53,6 +53,14 @@
  * <code>accept</code> that are used for invoking an object of class
  * SedVisitor.  An example of its use is in the Sed validation system,
  * which is internally implemented using this Visitor Pattern facility.
+ *
+ * SedDocument::accept() visits the elements of a document depth first, in
+ * the order in which they are written.  Every element is passed to
+ * visit() before its children, and to leave() after them; returning
+ * @c false from visit(const SedBase& x) skips the children of @p x, but
+ * still calls leave() for it.
+ *
+ * @see SedParallelVisitor
  */
 
 #ifndef SedVisitor_h
@@ -112,6 +120,9 @@ public:
    * Pattern</i></a> to perform operations on SedBase objects.
    *
    * @param x the SedBase object to visit.
+   *
+   * @return @c true (the default) if the children of @p x are to be
+   * visited, @c false to skip them.
    */
   virtual bool visit(const SedBase                    &x);
 
@@ -127,9 +138,10 @@ public:
   /**
    * Interface method for using the <a target="_blank"
    * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
-   * Pattern</i></a> to perform operations on Reaction objects.
+   * Pattern</i></a> to perform operations on SedBase objects, once
+   * their children have been visited.
    *
-   * @param x the Reaction object to visit.
+   * @param x the SedBase object to leave.
    */
   virtual void leave(const SedBase     &x);
 
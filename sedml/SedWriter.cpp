@@ -47,6 +47,7 @@
 #include <sedml/SedErrorLog.h>
 #include <sedml/SedDocument.h>
 #include <sedml/SedWriter.h>
+#include <sedml/SedLoadStatistics.h>
 
 #include <sbml/compress/CompressCommon.h>
 #include <sbml/compress/OutputCompressor.h>
@@ -113,6 +114,36 @@ SedWriter::setProgramVersion(const std::string& version)
 }
 
 
+/*
+ * Returns the counters and timers of the last document written.
+ */
+const SedLoadStatistics&
+SedWriter::getWriteStatistics() const
+{
+  return mWriteStatistics;
+}
+
+
+/*
+ * Sets whether the phases of writing are recorded as events.
+ */
+void
+SedWriter::setTraceEnabled(bool traceEnabled)
+{
+  mWriteStatistics.setTraceEnabled(traceEnabled);
+}
+
+
+/*
+ * Returns whether the phases of writing are recorded as events.
+ */
+bool
+SedWriter::getTraceEnabled() const
+{
+  return mWriteStatistics.getTraceEnabled();
+}
+
+
 /*
  * Writes the given Sed document to filename.
  *
@@ -142,6 +173,7 @@ bool
 SedWriter::writeSedML(const SedDocument* d, const std::string& filename)
 {
   std::ostream* stream = NULL;
+  bool compressed = true;
 
   try
     {
@@ -149,6 +181,7 @@ SedWriter::writeSedML(const SedDocument* d, const std::string& filename)
       if (string::npos != filename.find(".xml", filename.length() - 4))
         {
           stream = new(std::nothrow) std::ofstream(filename.c_str());
+          compressed = false;
         }
       // open a gzip file
       else if (string::npos != filename.find(".gz", filename.length() - 3))
@@ -191,6 +224,7 @@ SedWriter::writeSedML(const SedDocument* d, const std::string& filename)
       else
         {
           stream = new(std::nothrow) std::ofstream(filename.c_str());
+          compressed = false;
         }
     }
   catch (ZlibNotLinked&)
@@ -222,6 +256,40 @@ SedWriter::writeSedML(const SedDocument* d, const std::string& filename)
       return false;
     }
 
+#ifdef LIBSEDML_USE_INSTRUMENTATION
+  if (compressed)
+    {
+      // write to memory first, so that the compression is timed apart
+      SEDML_COLLECT_STATISTICS(mWriteStatistics);
+      ostringstream staged;
+      bool written = writeSedML(d, staged);
+      bool result = written;
+
+      {
+        SEDML_TIME_PHASE(SEDML_PHASE_COMPRESS);
+
+        if (written)
+          {
+            *stream << staged.str();
+            stream->flush();
+            result = stream->good();
+          }
+
+        delete stream;
+      }
+
+      if (written && !result)
+        {
+          SedErrorLog *log = (const_cast<SedDocument *>(d))->getErrorLog();
+          log->logError(XMLFileOperationError);
+        }
+
+      return result;
+    }
+#else
+  (void)compressed;
+#endif
+
   bool result = writeSedML(d, *stream);
   delete stream;
 
@@ -241,6 +309,9 @@ SedWriter::writeSedML(const SedDocument* d, std::ostream& stream)
 {
   bool result = false;
 
+  SEDML_COLLECT_STATISTICS(mWriteStatistics);
+  SEDML_TIME_PHASE(SEDML_PHASE_WRITE);
+
   try
     {
       stream.exceptions(ios_base::badbit | ios_base::failbit | ios_base::eofbit);
@@ -84,6 +84,7 @@
 
 #include <sedml/common/extern.h>
 #include <sedml/common/sedmlfwd.h>
+#include <sedml/SedLoadStatistics.h>
 
 
 #ifdef __cplusplus
@@ -317,11 +318,48 @@ public:
   static bool hasBzip2();
 
 
+  /**
+   * Returns the counters and timers of the phases of the last document
+   * written by this SedWriter.
+   *
+   * Compressing a document is only timed apart from writing it when
+   * libSEDML was built with the CMake option @c WITH_INSTRUMENTATION, in
+   * which case the document is first written to memory.
+   *
+   * @return the SedLoadStatistics of the last write; all zero if
+   * libSEDML was built without instrumentation.
+   *
+   * @see SedLoadStatistics::isEnabled()
+   */
+  const SedLoadStatistics& getWriteStatistics() const;
+
+
+  /**
+   * Sets whether the phases of writing a document are recorded as events.
+   *
+   * @param traceEnabled @c true to record events, @c false (the default)
+   * to only count and time the phases.
+   *
+   * @see SedLoadStatistics::writeChromeTrace(std::ostream& stream)
+   */
+  void setTraceEnabled(bool traceEnabled);
+
+
+  /**
+   * Returns whether the phases of writing a document are recorded as
+   * events.
+   *
+   * @return @c true if events are recorded, @c false otherwise.
+   */
+  bool getTraceEnabled() const;
+
+
 protected:
   /** @cond doxygen-libsbml-internal */
 
   std::string mProgramName;
   std::string mProgramVersion;
+  SedLoadStatistics mWriteStatistics;
 
   /** @endcond */
 };
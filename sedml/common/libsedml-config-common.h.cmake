@@ -86,6 +86,10 @@
 /* Define to 1 to enable primitive memory tracing. */
 #cmakedefine TRACE_MEMORY
 
+/* Define to 1 to count and time the phases of reading and writing
+   documents (see SedLoadStatistics). */
+#cmakedefine LIBSEDML_USE_INSTRUMENTATION 1
+
 /* Define to 1 if your processor stores words with the most significant byte
    first (like Motorola and SPARC, unlike Intel and VAX). */
 #cmakedefine WORDS_BIGENDIAN 1
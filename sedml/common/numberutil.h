@@ -0,0 +1,139 @@
+/**
+ * @file    numberutil.h
+ * @brief   Locale independent parsing and formatting of numbers
+ *
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+
+#ifndef LIBSEDML_NUMBERUTIL_H
+#define LIBSEDML_NUMBERUTIL_H
+
+#include <sedml/common/extern.h>
+
+#ifdef __cplusplus
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/**
+ * Size of a buffer large enough for any number written by
+ * SedUtil_formatDouble(), including the terminating NUL.
+ */
+#define SEDML_DOUBLE_BUFFER_SIZE 32
+
+
+/**
+ * Parses a floating-point number from the start of @p str, independent of
+ * the current locale.
+ *
+ * Leading whitespace is skipped.  Besides decimal numbers with optional
+ * fraction and exponent, "INF", "-INF" and "NaN" are accepted (in any
+ * case).  The result is correctly rounded.
+ *
+ * @param str the NUL-terminated string to parse.
+ * @param value set to the number parsed.
+ *
+ * @return a pointer to the first character after the number, or @c NULL
+ * if @p str does not start with a number (@p value is left unchanged).
+ */
+LIBSEDML_EXTERN
+const char*
+SedUtil_parseDouble(const char* str, double& value);
+
+
+/**
+ * Writes @p value into @p buffer, independent of the current locale, in a
+ * single pass: the digits (at most 17, and nearly always the fewest)
+ * read back as the same value, laid out as by printf's "%g".  Infinity
+ * and not-a-number are written as "INF", "-INF" and "NaN".
+ *
+ * @param value the number to write.
+ * @param buffer where to write the NUL-terminated result; must have room
+ * for at least #SEDML_DOUBLE_BUFFER_SIZE characters.
+ *
+ * @return the number of characters written, not counting the NUL.
+ */
+LIBSEDML_EXTERN
+size_t
+SedUtil_formatDouble(double value, char* buffer);
+
+
+/**
+ * Encodes @p numValues doubles as base64 text of their little-endian
+ * IEEE 754 representation, optionally compressed with zlib (deflate)
+ * first.
+ *
+ * @param values the values to encode.
+ * @param numValues the number of values.
+ * @param compress whether to compress the data before encoding it; this
+ * is ignored if libSEDML is built without zlib.
+ * @param result set to the base64 text.
+ *
+ * @return @c true if the data were compressed, @c false otherwise.
+ */
+LIBSEDML_EXTERN
+bool
+SedUtil_encodeDoubles(const double* values, size_t numValues, bool compress,
+                      std::string& result);
+
+
+/**
+ * Decodes @p numValues doubles from base64 text produced by
+ * SedUtil_encodeDoubles(), appending them to @p values.  Whitespace in
+ * the text is ignored.
+ *
+ * @param text the base64 text.
+ * @param numValues the number of values encoded.
+ * @param compressed whether the data were compressed.
+ * @param values the vector the decoded values are appended to.
+ *
+ * @return @c true on success, @c false if the text is not valid, does not
+ * hold @p numValues values (including a count too large for the text to
+ * expand to), or is compressed and libSEDML was built without zlib
+ * (@p values is left unchanged).
+ */
+LIBSEDML_EXTERN
+bool
+SedUtil_decodeDoubles(const std::string& text, size_t numValues,
+                      bool compressed, std::vector<double>& values);
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* LIBSEDML_NUMBERUTIL_H */
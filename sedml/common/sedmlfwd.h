@@ -78,6 +78,42 @@ typedef CLASS_OR_STRUCT SedBase                     SedBase_t;
  */
 typedef CLASS_OR_STRUCT SedReader                     SedReader_t;
 
+/**
+ * @var typedef class SedBatchReader SedBatchReader_t
+ * @copydoc SedBatchReader
+ */
+typedef CLASS_OR_STRUCT SedBatchReader                SedBatchReader_t;
+
+/**
+ * @var typedef class SedExpressionDag SedExpressionDag_t
+ * @copydoc SedExpressionDag
+ */
+typedef CLASS_OR_STRUCT SedExpressionDag              SedExpressionDag_t;
+
+/**
+ * @var typedef class SedIterationSpace SedIterationSpace_t
+ * @copydoc SedIterationSpace
+ */
+typedef CLASS_OR_STRUCT SedIterationSpace             SedIterationSpace_t;
+
+/**
+ * @var typedef class SedMathProgram SedMathProgram_t
+ * @copydoc SedMathProgram
+ */
+typedef CLASS_OR_STRUCT SedMathProgram                SedMathProgram_t;
+
+/**
+ * @var typedef class SedResultStore SedResultStore_t
+ * @copydoc SedResultStore
+ */
+typedef CLASS_OR_STRUCT SedResultStore                SedResultStore_t;
+
+/**
+ * @var typedef class SedStreamReader SedStreamReader_t
+ * @copydoc SedStreamReader
+ */
+typedef CLASS_OR_STRUCT SedStreamReader               SedStreamReader_t;
+
 /**
  * @var typedef class SedWriter SedWriter_t
  * @copydoc SedWriter
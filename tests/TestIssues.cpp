@@ -37,22 +37,59 @@
  * 
  */
 
+#include <atomic>
+#include <cmath>
 #include <limits>
 
 #include <iostream>
 #include <check.h>
 #include <string>
 #include <sstream>
+#include <vector>
 
 #include <sbml/common/libsbml-version.h>
 #include <sedml/common/libsedml-version.h>
 
 #include <sedml/SedDocument.h>
 #include <sedml/SedDataGenerator.h>
+#include <sedml/SedModel.h>
+#include <sedml/SedChangeAttribute.h>
+#include <sedml/SedRemoveXML.h>
+#include <sedml/SedComputeChange.h>
+#include <sedml/SedUniformTimeCourse.h>
+#include <sedml/SedAlgorithm.h>
+#include <sedml/SedRepeatedTask.h>
+#include <sedml/SedSetValue.h>
+#include <sedml/SedReport.h>
+#include <sedml/SedPlot2D.h>
+#include <sedml/SedVectorRange.h>
+#include <sedml/SedUniformRange.h>
+#include <sedml/SedFunctionalRange.h>
 #include <sedml/SedWriter.h>
+#include <sedml/SedReader.h>
+#include <sedml/SedStreamReader.h>
+#include <sedml/SedBatchReader.h>
+#include <sedml/SedArena.h>
+#include <sedml/SedLoadStatistics.h>
+#include <sedml/SedMathProgram.h>
+#include <sedml/SedExpressionDag.h>
+#include <sedml/SedResultStore.h>
+#include <sedml/SedTarget.h>
+#include <sedml/SedTargetIndex.h>
+#include <sedml/SedModelResolver.h>
+#include <sedml/SedModelPatch.h>
+#include <sedml/SedEnsembleBatch.h>
+#include <sedml/SedIterationSpace.h>
+#include <sedml/SedDependencyGraph.h>
+#include <sedml/SedDependencySlice.h>
+#include <sedml/SedParallelVisitor.h>
+#include <sedml/SedSimulatorBackend.h>
+#include <sedml/SedExecutor.h>
+#include <sedml/common/numberutil.h>
 
 #include <sbml/math/L3FormulaFormatter.h>
 #include <sbml/math/L3Parser.h>
+#include <sbml/xml/XMLNode.h>
 
 /** @cond doxygenIgnored */
 
@@ -99,6 +136,1663 @@ START_TEST (test_mathml_issue1)
 END_TEST
 
 
+START_TEST (test_element_index)
+{
+  SedDocument doc;
+  SedModel* model = doc.createModel();
+  model->setId("model1");
+  SedTask* task = doc.createTask();
+  task->setId("task1");
+  task->setMetaId("meta_task1");
+
+  fail_unless( doc.getElementBySId("model1") == model );
+  fail_unless( doc.getElementBySId("task1") == task );
+  fail_unless( doc.getElementByMetaId("meta_task1") == task );
+  fail_unless( task->getElementBySId("model1") == NULL );
+
+  // renaming updates the index
+  task->setId("task2");
+  fail_unless( doc.getElementBySId("task1") == NULL );
+  fail_unless( doc.getElementBySId("task2") == task );
+
+  // removed elements are no longer found
+  delete doc.removeModel("model1");
+  fail_unless( doc.getElementBySId("model1") == NULL );
+
+  // elements read from a document are indexed
+  SedWriter sw;
+  ostringstream stream;
+  sw.writeSedML(&doc, stream);
+  SedDocument* copy = readSedMLFromString(stream.str().c_str());
+  fail_unless( copy->getElementBySId("task2") != NULL );
+  fail_unless( copy->getElementBySId("task2") == copy->getTask("task2") );
+  delete copy;
+}
+END_TEST
+
+
+
+/* keeps tasks only, counting all elements seen */
+class KeepTasksCallback : public SedElementCallback
+{
+public:
+  KeepTasksCallback() : numSeen(0) { }
+
+  virtual bool elementRead(SedBase* element)
+  {
+    ++numSeen;
+    return element->getTypeCode() == SEDML_TASK;
+  }
+
+  unsigned int numSeen;
+};
+
+
+START_TEST (test_stream_reader)
+{
+  SedDocument doc;
+  doc.createModel()->setId("model1");
+  doc.createModel()->setId("model2");
+  doc.createTask()->setId("task1");
+
+  SedWriter sw;
+  ostringstream stream;
+  sw.writeSedML(&doc, stream);
+
+  KeepTasksCallback callback;
+  SedStreamReader reader(&callback);
+  SedDocument* read = reader.readSedMLFromString(stream.str());
+
+  fail_unless( callback.numSeen == 3 );
+  fail_unless( read->getNumModels() == 0 );
+  fail_unless( read->getNumTasks() == 1 );
+  fail_unless( read->getElementBySId("model1") == NULL );
+  fail_unless( read->getElementCallback() == NULL );
+  delete read;
+}
+END_TEST
+
+
+START_TEST (test_batch_reader)
+{
+  SedWriter sw;
+  vector<string> filenames;
+
+  for (unsigned int i = 0; i < 5; ++i)
+  {
+    ostringstream id;
+    id << "task" << i;
+    SedDocument doc;
+    doc.createTask()->setId(id.str());
+
+    filenames.push_back("test_batch_reader_" + id.str() + ".sedml");
+    sw.writeSedMLToFile(&doc, filenames.back());
+  }
+
+  // a missing file is read into a document carrying its own error
+  filenames.push_back("test_batch_reader_missing.sedml");
+
+  SedBatchReader reader(3);
+  vector<SedDocument*> docs = reader.readSedMLFromFiles(filenames);
+
+  fail_unless( docs.size() == filenames.size() );
+  for (unsigned int i = 0; i < 5; ++i)
+  {
+    ostringstream id;
+    id << "task" << i;
+    fail_unless( docs[i]->getNumErrors() == 0 );
+    fail_unless( docs[i]->getTask(id.str()) != NULL );
+    delete docs[i];
+    remove(filenames[i].c_str());
+  }
+
+  fail_unless( docs[5]->getNumErrors() > 0 );
+  delete docs[5];
+}
+END_TEST
+
+
+/* gives access to the namespaces of a task without unsharing them */
+class SharedNamespacesTask : public SedTask
+{
+public:
+  SharedNamespacesTask(unsigned int level, unsigned int version)
+    : SedTask(level, version) { }
+
+  SharedNamespacesTask(SedNamespaces* sedns) : SedTask(sedns) { }
+
+  const SedNamespaces* getShared() const
+  {
+    return getConstSedNamespaces();
+  }
+};
+
+
+START_TEST (test_shared_namespaces)
+{
+  SharedNamespacesTask task1(1, 2);
+  SharedNamespacesTask task2(1, 2);
+
+  // elements created for the same level and version share their namespaces
+  fail_unless( task1.getShared() == task2.getShared() );
+
+  // as do elements constructed from the same namespaces, also after the
+  // namespaces declared on them are set (as for every element read)
+  SedNamespaces sedns(1, 2);
+  SharedNamespacesTask task3(&sedns);
+  SharedNamespacesTask task4(&sedns);
+  fail_unless( task3.getShared() == task4.getShared() );
+  fail_unless( task3.getShared() != &sedns );
+  task3.setNamespaces(NULL);
+  task4.setNamespaces(NULL);
+  fail_unless( task3.getShared() == task4.getShared() );
+  fail_unless( task3.getShared()->getNamespaces() == NULL );
+
+  // modifying the namespaces of an element gives it a copy of its own
+  task1.getNamespaces()->add("http://www.sbml.org/sbml/level2", "sbml");
+  fail_unless( task1.getShared() != task2.getShared() );
+  fail_unless( task1.getNamespaces()->getLength() == 2 );
+  fail_unless( task2.getNamespaces()->getLength() == 1 );
+  fail_unless( SharedNamespacesTask(1, 2).getShared()
+               ->getNamespaces()->getLength() == 1 );
+
+  // the document keeps namespaces of its own
+  SedDocument doc(&sedns);
+  doc.getNamespaces()->add("http://www.sbml.org/sbml/level2", "sbml");
+  fail_unless( sedns.getNamespaces()->getLength() == 1 );
+  fail_unless( doc.createTask()->getNamespaces()->getLength() == 2 );
+}
+END_TEST
+
+
+START_TEST (test_arena)
+{
+  SedDocument* doc;
+  size_t allocated;
+
+  {
+    SedArenaScope scope;
+    doc = new SedDocument(1, 2);
+    doc->createModel()->setId("model1");
+    doc->createTask()->setId("task1");
+    allocated = scope.getArena()->getNumBytesAllocated();
+  }
+
+  fail_unless( allocated > 0 );
+  fail_unless( SedArena::getCurrent() == NULL );
+
+  SedWriter sw;
+  ostringstream stream;
+  sw.writeSedML(doc, stream);
+
+  // elements outliving the scope keep the arena alive
+  SedTask* task = doc->removeTask("task1");
+  delete doc;
+  fail_unless( task->getId() == "task1" );
+  delete task;
+
+  SedReader reader;
+  reader.setUseArena(true);
+  fail_unless( reader.getUseArena() == true );
+
+  SedDocument* read = reader.readSedMLFromString(stream.str());
+  fail_unless( read->getNumErrors() == 0 );
+  fail_unless( read->getTask("task1") != NULL );
+  fail_unless( read->getModel("model1") != NULL );
+  delete read;
+}
+END_TEST
+
+
+START_TEST (test_vector_range_values)
+{
+  const double values[] = { 0.1, -2.5e-300, 1.0 / 3.0, 1e22, 0 };
+
+  SedDocument doc;
+  SedRepeatedTask* task = doc.createRepeatedTask();
+  task->setId("task1");
+  SedVectorRange* range = task->createVectorRange();
+  range->setId("range1");
+
+  fail_unless( range->getValuesData() == NULL );
+  fail_unless( range->setValues(values, 5) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( range->getNumValues() == 5 );
+  fail_unless( range->getValuesData()[2] == values[2] );
+
+  SedWriter sw;
+  ostringstream stream;
+  sw.writeSedML(&doc, stream);
+
+  // values are written with the digits needed to read them back exactly
+  SedDocument* read = readSedMLFromString(stream.str().c_str());
+  SedRepeatedTask* readTask =
+    static_cast<SedRepeatedTask*>(read->getTask("task1"));
+  const SedVectorRange* readRange =
+    static_cast<const SedVectorRange*>(readTask->getRange("range1"));
+
+  fail_unless( readRange->getNumValues() == 5 );
+  for (unsigned int i = 0; i < 5; ++i)
+    fail_unless( readRange->getValuesData()[i] == values[i] );
+
+  delete read;
+}
+END_TEST
+
+
+START_TEST (test_number_conversion)
+{
+  double value = 0;
+
+  // numbers the fast path cannot take: long mantissas, large exponents,
+  // halfway cases and subnormals
+  fail_unless( SedUtil_parseDouble("9007199254740993", value) != NULL );
+  fail_unless( value == 9007199254740992.0 );
+  fail_unless( SedUtil_parseDouble("9007199254740993.00001", value) != NULL );
+  fail_unless( value == 9007199254740994.0 );
+  fail_unless( SedUtil_parseDouble("1.7976931348623157e308", value) != NULL );
+  fail_unless( value == numeric_limits<double>::max() );
+  fail_unless( SedUtil_parseDouble("4.9406564584124654e-324", value) != NULL );
+  fail_unless( value == numeric_limits<double>::denorm_min() );
+  fail_unless( SedUtil_parseDouble("-2.2250738585072014e-308", value) != NULL );
+  fail_unless( value == -numeric_limits<double>::min() );
+  fail_unless( SedUtil_parseDouble("1e400", value) != NULL );
+  fail_unless( value == numeric_limits<double>::infinity() );
+  fail_unless( SedUtil_parseDouble("1e-400", value) != NULL );
+  fail_unless( value == 0 );
+
+  char buffer[SEDML_DOUBLE_BUFFER_SIZE];
+
+  SedUtil_formatDouble(0.1, buffer);
+  fail_unless( string(buffer) == "0.1" );
+  SedUtil_formatDouble(-1e-5, buffer);
+  fail_unless( string(buffer) == "-1e-05" );
+  SedUtil_formatDouble(1e15, buffer);
+  fail_unless( string(buffer) == "1e+15" );
+  SedUtil_formatDouble(123456789012345.0, buffer);
+  fail_unless( string(buffer) == "123456789012345" );
+  SedUtil_formatDouble(1.0 / 3.0, buffer);
+  fail_unless( string(buffer) == "0.3333333333333333" );
+
+  const double values[] = { numeric_limits<double>::max(),
+                            numeric_limits<double>::denorm_min(),
+                            -numeric_limits<double>::min(), 2.0 / 3.0,
+                            1e23, 5e-324, 123.456 };
+
+  for (unsigned int i = 0; i < 7; ++i)
+    {
+      SedUtil_formatDouble(values[i], buffer);
+      fail_unless( SedUtil_parseDouble(buffer, value) != NULL );
+      fail_unless( value == values[i] );
+    }
+}
+END_TEST
+
+
+START_TEST (test_vector_range_binary_values)
+{
+  vector<double> values;
+  for (unsigned int i = 0; i < 100; ++i)
+    values.push_back(i / 7.0);
+
+  SedDocument doc;
+  SedRepeatedTask* task = doc.createRepeatedTask();
+  task->setId("task1");
+  SedVectorRange* range = task->createVectorRange();
+  range->setId("range1");
+  range->setValues(values);
+  doc.setBinaryValueThreshold(10);
+  doc.setCompressBinaryValues(true);
+
+  SedWriter sw;
+
+  ostringstream stream;
+  sw.writeSedML(&doc, stream);
+  fail_unless( stream.str().find("<libsedml:binaryValues") != string::npos );
+  fail_unless( stream.str().find("<value>") == string::npos );
+
+  SedDocument* read = readSedMLFromString(stream.str().c_str());
+  fail_unless( read->getNumErrors() == 0 );
+
+  SedRepeatedTask* readTask =
+    static_cast<SedRepeatedTask*>(read->getTask("task1"));
+  const SedVectorRange* readRange =
+    static_cast<const SedVectorRange*>(readTask->getRange("range1"));
+  fail_unless( readRange->getValues() == values );
+
+  delete read;
+
+  // the element is only decoded in its own namespace, not in SED-ML's
+  string xml = stream.str();
+  size_t start = xml.find("<libsedml:binaryValues");
+  size_t end = xml.find("</libsedml:binaryValues>") + 24;
+  xml.replace(start, end - start, "<binaryValues count=\"1\">"
+              "AAAAAAAA8D8=</binaryValues>");
+
+  read = readSedMLFromString(xml.c_str());
+  fail_unless( read->getNumErrors() > 0 );
+
+  readTask = static_cast<SedRepeatedTask*>(read->getTask("task1"));
+  readRange = static_cast<const SedVectorRange*>(readTask->getRange("range1"));
+  fail_unless( readRange->getValues().empty() );
+
+  delete read;
+}
+END_TEST
+
+
+START_TEST (test_vector_range_binary_count)
+{
+  vector<double> values(100, 1.0);
+
+  SedDocument doc;
+  SedRepeatedTask* task = doc.createRepeatedTask();
+  task->setId("task1");
+  SedVectorRange* range = task->createVectorRange();
+  range->setId("range1");
+  range->setValues(values);
+  doc.setBinaryValueThreshold(10);
+  doc.setCompressBinaryValues(true);
+
+  SedWriter sw;
+
+  ostringstream stream;
+  sw.writeSedML(&doc, stream);
+  string xml = stream.str();
+  size_t pos = xml.find("count=\"100\"");
+  fail_unless( pos != string::npos );
+
+  // a count far beyond what the payload can inflate to must be rejected
+  // before anything is allocated for it
+  xml.replace(pos, 11, "count=\"2305843009213693951\"");
+
+  SedDocument* read = readSedMLFromString(xml.c_str());
+  fail_unless( read->getNumErrors() > 0 );
+
+  SedRepeatedTask* readTask =
+    static_cast<SedRepeatedTask*>(read->getTask("task1"));
+  const SedVectorRange* readRange =
+    static_cast<const SedVectorRange*>(readTask->getRange("range1"));
+  fail_unless( readRange->getValues().empty() );
+
+  delete read;
+}
+END_TEST
+
+
+START_TEST (test_snapshot)
+{
+  const char* xml =
+    "<?xml version='1.0' encoding='UTF-8'?>\n"
+    "<sedML xmlns='http://sed-ml.org/sed-ml/level1/version2' level='1' version='2'>\n"
+    "  <notes><p xmlns='http://www.w3.org/1999/xhtml'>a note</p></notes>\n"
+    "  <annotation><info xmlns='http://example.org/info' key='value'/></annotation>\n"
+    "  <listOfSimulations>\n"
+    "    <uniformTimeCourse id='sim1' initialTime='0' outputStartTime='0' outputEndTime='10' numberOfPoints='100'>\n"
+    "      <algorithm kisaoID='KISAO:0000019'/>\n"
+    "    </uniformTimeCourse>\n"
+    "  </listOfSimulations>\n"
+    "  <listOfModels>\n"
+    "    <model id='model1' language='urn:sedml:language:sbml' source='model.xml'>\n"
+    "      <listOfChanges>\n"
+    "        <changeXML target='/sbml:sbml/sbml:model'>\n"
+    "          <newXML><parameter xmlns='http://www.sbml.org/sbml/level2' id='p' value='1'/></newXML>\n"
+    "        </changeXML>\n"
+    "      </listOfChanges>\n"
+    "    </model>\n"
+    "  </listOfModels>\n"
+    "  <listOfTasks>\n"
+    "    <repeatedTask id='task1' range='range1' resetModel='false'>\n"
+    "      <listOfRanges>\n"
+    "        <vectorRange id='range1'><value>0.1</value><value>2.5</value></vectorRange>\n"
+    "      </listOfRanges>\n"
+    "    </repeatedTask>\n"
+    "  </listOfTasks>\n"
+    "  <listOfDataGenerators>\n"
+    "    <dataGenerator id='dg1'>\n"
+    "      <listOfVariables>\n"
+    "        <variable id='v1' taskReference='task1' symbol='urn:sedml:symbol:time'/>\n"
+    "      </listOfVariables>\n"
+    "      <math xmlns='http://www.w3.org/1998/Math/MathML'>\n"
+    "        <apply><times/><ci> v1 </ci><cn type='e-notation'> 2 <sep/> 3 </cn></apply>\n"
+    "      </math>\n"
+    "    </dataGenerator>\n"
+    "  </listOfDataGenerators>\n"
+    "</sedML>\n";
+
+  SedDocument* doc = readSedMLFromString(xml);
+  fail_unless( doc->getNumErrors() == 0 );
+
+  ostringstream expected;
+  SedWriter().writeSedML(doc, expected);
+
+  stringstream snapshot;
+  fail_unless( doc->saveSnapshot(snapshot) == LIBSEDML_OPERATION_SUCCESS );
+
+  SedDocument* copy = SedDocument::loadSnapshot(snapshot);
+  fail_unless( copy != NULL );
+  fail_unless( copy->getDataGenerator("dg1") != NULL );
+  fail_unless( copy->getDataGenerator("dg1")->getSedDocument() == copy );
+
+  ostringstream actual;
+  SedWriter().writeSedML(copy, actual);
+  fail_unless( actual.str() == expected.str() );
+
+  // truncated snapshots are rejected
+  string data = snapshot.str();
+  istringstream truncated(data.substr(0, data.size() / 2));
+  fail_unless( SedDocument::loadSnapshot(truncated) == NULL );
+
+  delete copy;
+  delete doc;
+}
+END_TEST
+
+
+START_TEST (test_read_from_buffer)
+{
+  // no XML declaration, and no terminating NUL byte
+  string xml =
+    "<sedML xmlns='http://sed-ml.org/sed-ml/level1/version2' level='1' version='2'>"
+    "<listOfTasks><task id='task1'/></listOfTasks></sedML>";
+  vector<char> buffer(xml.begin(), xml.end());
+
+  SedReader reader;
+  SedDocument* doc = reader.readSedMLFromBuffer(&buffer[0], buffer.size());
+  fail_unless( doc->getNumErrors() == 0 );
+  fail_unless( doc->getTask("task1") != NULL );
+  delete doc;
+
+  doc = reader.readSedMLFromBuffer(xml.c_str(), xml.size() + 1);
+  fail_unless( doc->getNumErrors() == 0 );
+  fail_unless( doc->getTask("task1") != NULL );
+
+  SedWriter sw;
+  sw.writeSedMLToFile(doc, "test_read_from_buffer.sedml");
+  delete doc;
+
+  reader.setUseMemoryMap(true);
+  doc = reader.readSedMLFromFile("test_read_from_buffer.sedml");
+  fail_unless( doc->getNumErrors() == 0 );
+  fail_unless( doc->getTask("task1") != NULL );
+  delete doc;
+
+  remove("test_read_from_buffer.sedml");
+
+  doc = reader.readSedMLFromFile("test_read_from_buffer.sedml");
+  fail_unless( doc->getNumErrors() > 0 );
+  delete doc;
+}
+END_TEST
+
+
+START_TEST (test_list_id_index)
+{
+  SedListOfDataGenerators list;
+
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    ostringstream id;
+    id << "dg" << i;
+    list.createDataGenerator()->setId(id.str());
+  }
+
+  fail_unless( list.get("dg42") == list.get(42) );
+  fail_unless( list.getIndexById("dg99") == 99 );
+  fail_unless( list.get("missing") == NULL );
+
+  // items appended after the index was built are found as well
+  list.createDataGenerator()->setId("dg100");
+  fail_unless( list.getIndexById("dg100") == 100 );
+
+  // renamed items
+  list.get(42)->setId("renamed");
+  fail_unless( list.get("dg42") == NULL );
+  fail_unless( list.getIndexById("renamed") == 42 );
+
+  // inserted and removed items shift the others
+  SedDataGenerator dg;
+  dg.setId("first");
+  list.insert(0, &dg);
+  fail_unless( list.getIndexById("first") == 0 );
+  fail_unless( list.getIndexById("renamed") == 43 );
+
+  delete list.remove("dg0");
+  fail_unless( list.get("dg0") == NULL );
+  fail_unless( list.getIndexById("dg1") == 1 );
+
+  // the first of several items with the same id is returned
+  list.createDataGenerator()->setId("dg1");
+  fail_unless( list.getIndexById("dg1") == 1 );
+}
+END_TEST
+
+
+START_TEST (test_math_program)
+{
+  SedDataGenerator dg;
+  dg.createVariable()->setId("x");
+  dg.createVariable()->setId("y");
+  SedParameter* p = dg.createParameter();
+  p->setId("p");
+  p->setValue(2.0);
+
+  ASTNode* math = SBML_parseL3Formula("p * x + piecewise(y, y > 5, -y)");
+  dg.setMath(math);
+  delete math;
+
+  SedMathProgram program;
+  fail_unless( program.compile(&dg) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( program.getNumInputs() == 2 );
+  fail_unless( program.getInputIndex("y") == 1 );
+
+  // more points than fit in one block
+  const size_t numPoints = 1000;
+  vector<double> x(numPoints), y(numPoints), result(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    x[i] = 0.5 * i;
+    y[i] = 0.01 * i;
+  }
+  const double* inputs[] = { &x[0], &y[0] };
+
+  fail_unless( program.evaluate(inputs, numPoints, &result[0])
+               == LIBSEDML_OPERATION_SUCCESS );
+  for (size_t i = 0; i < numPoints; ++i)
+    fail_unless( result[i] == 2.0 * x[i] + (y[i] > 5 ? y[i] : -y[i]) );
+
+  double point[] = { 1.0, 6.0 };
+  fail_unless( program.evaluate(point) == 8.0 );
+
+  // aggregates reduce over all points
+  math = SBML_parseL3Formula("x / max(x) + sum(y)");
+  dg.setMath(math);
+  delete math;
+
+  fail_unless( program.compile(&dg) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( program.evaluate(inputs, numPoints, &result[0])
+               == LIBSEDML_OPERATION_SUCCESS );
+  double sum = 0.0;
+  for (size_t i = 0; i < numPoints; ++i)
+    sum += y[i];
+  fail_unless( fabs(result[0] - sum) < 1e-9 );
+  fail_unless( fabs(result[numPoints - 1] - (1.0 + sum)) < 1e-9 );
+
+  // constant subexpressions are folded
+  math = SBML_parseL3Formula("x * (2 + 3) ^ 2");
+  dg.setMath(math);
+  delete math;
+
+  fail_unless( program.compile(&dg) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( program.getNumInstructions() == 3 );
+  fail_unless( program.evaluate(point) == 25.0 );
+
+  // unbound identifiers are rejected
+  math = SBML_parseL3Formula("x + z");
+  dg.setMath(math);
+  delete math;
+
+  fail_unless( program.compile(&dg) == LIBSEDML_OPERATION_FAILED );
+  fail_unless( !program.isCompiled() );
+}
+END_TEST
+
+
+START_TEST (test_iteration_space)
+{
+  SedDocument doc;
+  SedTask* task = doc.createTask();
+  task->setId("task1");
+
+  // the inner scan uses the value of the outer range i
+  SedRepeatedTask* inner = doc.createRepeatedTask();
+  inner->setId("inner");
+  inner->setRangeId("j");
+  SedVectorRange* j = inner->createVectorRange();
+  j->setId("j");
+  j->addValue(1);
+  j->addValue(2);
+  j->addValue(3);
+  SedFunctionalRange* f = inner->createFunctionalRange();
+  f->setId("f");
+  f->setRange("j");
+  ASTNode* math = SBML_parseL3Formula("i * 10 + j");
+  f->setMath(math);
+  delete math;
+  inner->createSubTask()->setTask("task1");
+
+  SedRepeatedTask* outer = doc.createRepeatedTask();
+  outer->setId("outer");
+  outer->setRangeId("i");
+  SedUniformRange* i = outer->createUniformRange();
+  i->setId("i");
+  i->setStart(0);
+  i->setEnd(1);
+  i->setNumberOfPoints(4);
+  i->setType("linear");
+  SedVectorRange* v = outer->createVectorRange();
+  v->setId("v");
+  v->addValue(10);
+  v->addValue(20);
+  SedFunctionalRange* g = outer->createFunctionalRange();
+  g->setId("g");
+  g->setRange("i");
+  SedParameter* p = g->createParameter();
+  p->setId("p");
+  p->setValue(1);
+  math = SBML_parseL3Formula("2 * i + p");
+  g->setMath(math);
+  delete math;
+  SedSubTask* st = outer->createSubTask();
+  st->setTask("inner");
+  st->setOrder(2);
+  st = outer->createSubTask();
+  st->setTask("task1");
+  st->setOrder(1);
+
+  SedIterationSpace space(outer);
+  fail_unless( space.isValid() );
+  fail_unless( space.getNumIterations() == 5 );
+  fail_unless( space.getNumSteps() == 20 );
+  fail_unless( space.getRangeId(2) == "g" );
+  fail_unless( space.getRangeValue(0, 2) == 0.5 );
+  fail_unless( space.getRangeValue(1, 1) == 20 );
+  fail_unless( std::isnan(space.getRangeValue(1, 2)) );
+  fail_unless( space.getRangeValue(2, 4) == 3 );
+
+  unsigned int steps = 0;
+  while (space.next())
+  {
+    if (steps % 4 == 0)
+    {
+      fail_unless( space.getDepth() == 1 );
+      fail_unless( space.getTask() == task );
+    }
+    else
+    {
+      fail_unless( space.getDepth() == 2 );
+      fail_unless( space.getRepeatedTask(1) == inner );
+      fail_unless( space.getIteration(1) == steps % 4 - 1 );
+      fail_unless( space.getValue("f") ==
+                   space.getValue("i") * 10 + space.getValue("j") );
+    }
+    fail_unless( space.getIteration(0) == steps / 4 );
+    ++steps;
+  }
+  fail_unless( steps == 20 );
+  fail_unless( space.getDepth() == 0 );
+
+  // logarithmic ranges
+  i->setStart(1);
+  i->setEnd(100);
+  i->setNumberOfPoints(2);
+  i->setType("log");
+  SedIterationSpace logSpace(outer);
+  fail_unless( logSpace.getNumIterations() == 3 );
+  fail_unless( fabs(logSpace.getRangeValue(0, 1) - 10) < 1e-12 );
+
+  // repeated tasks cannot contain themselves
+  inner->createSubTask()->setTask("outer");
+  SedIterationSpace cyclic(outer);
+  fail_unless( !cyclic.isValid() );
+  fail_unless( !cyclic.next() );
+}
+END_TEST
+
+
+/* runs tasks without simulating anything, failing task t5 */
+class TestBackend : public SedSimulatorBackend
+{
+public:
+  TestBackend() : mNumTasks(0), mNumDataGenerators(0) {}
+
+  virtual int executeTask(const SedTask* task)
+  {
+    ++mNumTasks;
+    return task->getId() == "t5" ? LIBSEDML_OPERATION_FAILED
+                                 : LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  virtual int evaluateDataGenerator(const SedDataGenerator*)
+  {
+    ++mNumDataGenerators;
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  std::atomic<int> mNumTasks;
+  std::atomic<int> mNumDataGenerators;
+};
+
+
+START_TEST (test_executor)
+{
+  SedDocument doc;
+  doc.createModel()->setId("m1");
+  doc.createUniformTimeCourse()->setId("s1");
+
+  for (unsigned int i = 0; i < 20; ++i)
+  {
+    ostringstream id;
+    id << "t" << i;
+    SedTask* task = doc.createTask();
+    task->setId(id.str());
+    task->setModelReference("m1");
+    task->setSimulationReference("s1");
+  }
+
+  SedRepeatedTask* repeated = doc.createRepeatedTask();
+  repeated->setId("r1");
+  repeated->setRangeId("i");
+  SedUniformRange* range = repeated->createUniformRange();
+  range->setId("i");
+  range->setStart(0);
+  range->setEnd(1);
+  range->setNumberOfPoints(2);
+  repeated->createSubTask()->setTask("t0");
+
+  SedDataGenerator* dg = doc.createDataGenerator();
+  dg->setId("dg3");
+  dg->createVariable()->setTaskReference("t3");
+  dg = doc.createDataGenerator();
+  dg->setId("dg5");
+  dg->createVariable()->setTaskReference("t5");
+
+  SedDependencyGraph graph(&doc);
+  fail_unless( !graph.hasCycle() );
+  fail_unless( graph.getNumNodes() == 25 );
+
+  int t0 = graph.getNodeIndex("t0");
+  int r1 = graph.getNodeIndex("r1");
+  fail_unless( graph.getDependencies(t0).size() == 2 );
+  fail_unless( graph.getSubTasks(r1).size() == 1 );
+  fail_unless( graph.getSubTasks(r1)[0] == (unsigned int)t0 );
+  fail_unless( graph.getDependencies(r1) == graph.getDependencies(t0) );
+  fail_unless( graph.getDependencies(graph.getNodeIndex("dg5"))[0]
+               == (unsigned int)graph.getNodeIndex("t5") );
+
+  // the tasks run independently; what depends on t5 does not run
+  TestBackend backend;
+  SedExecutor executor(&backend, 4);
+  fail_unless( executor.execute(graph) == LIBSEDML_OPERATION_FAILED );
+  fail_unless( executor.getNumFailed() == 2 );
+  fail_unless( executor.getStatus(graph.getNodeIndex("dg5"))
+               == LIBSEDML_OPERATION_FAILED );
+  fail_unless( executor.getStatus(graph.getNodeIndex("dg3"))
+               == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( backend.mNumTasks == 20 + 3 );
+  fail_unless( backend.mNumDataGenerators == 1 );
+
+  // repeated tasks cannot run themselves
+  repeated->createSubTask()->setTask("r1");
+  fail_unless( executor.execute(&doc) == LIBSEDML_INVALID_OBJECT );
+}
+END_TEST
+
+
+START_TEST (test_expression_dag)
+{
+  const char* generators[][4] = {
+    /* id, math, variable ids bound to targets A and B */
+    { "fx", "x / (x + y)", "x", "y" },
+    { "fy", "b / (a + b)", "a", "b" },
+    { "lx", "ln(u)",       "u", NULL },
+    { "bad", "u + w",      "u", NULL },
+  };
+
+  SedDocument doc;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    SedDataGenerator* dg = doc.createDataGenerator();
+    dg->setId(generators[i][0]);
+    for (size_t j = 2; j < 4 && generators[i][j] != NULL; ++j)
+    {
+      SedVariable* var = dg->createVariable();
+      var->setId(generators[i][j]);
+      var->setTaskReference("task1");
+      var->setTarget(j == 2 ? "A" : "B");
+    }
+    ASTNode* math = SBML_parseL3Formula(generators[i][1]);
+    dg->setMath(math);
+    delete math;
+  }
+
+  SedExpressionDag dag(&doc);
+  fail_unless( dag.getNumInputs() == 2 );
+  fail_unless( dag.getInputIndex(doc.getDataGenerator(1)->getVariable(1)) == 1 );
+  fail_unless( dag.getNumOutputs() == 3 );
+  fail_unless( dag.getOutputIndex("lx") == 2 );
+  fail_unless( dag.getOutputIndex("bad") == -1 );
+
+  // A, B, A + B, A / (A + B), B / (A + B) and ln(A)
+  fail_unless( dag.getProgram().getNumInstructions() == 6 );
+
+  const size_t numPoints = 300;
+  vector<double> a(numPoints), b(numPoints);
+  vector<vector<double> > results(3, vector<double>(numPoints));
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    a[i] = 1.0 + i;
+    b[i] = 2.0 * i;
+  }
+  const double* inputs[] = { &a[0], &b[0] };
+  double* columns[] = { &results[0][0], &results[1][0], &results[2][0] };
+
+  fail_unless( dag.evaluate(inputs, numPoints, columns)
+               == LIBSEDML_OPERATION_SUCCESS );
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    fail_unless( results[0][i] == a[i] / (a[i] + b[i]) );
+    fail_unless( results[1][i] == b[i] / (a[i] + b[i]) );
+    fail_unless( results[2][i] == log(a[i]) );
+  }
+}
+END_TEST
+
+
+START_TEST (test_dependency_slice)
+{
+  SedDocument doc;
+  for (unsigned int i = 1; i <= 2; ++i)
+  {
+    ostringstream model, sim, task;
+    model << "m" << i;
+    sim << "s" << i;
+    task << "t" << i;
+    doc.createModel()->setId(model.str());
+    doc.createUniformTimeCourse()->setId(sim.str());
+    SedTask* t = doc.createTask();
+    t->setId(task.str());
+    t->setModelReference(model.str());
+    t->setSimulationReference(sim.str());
+  }
+
+  SedRepeatedTask* repeated = doc.createRepeatedTask();
+  repeated->setId("r1");
+  repeated->createSubTask()->setTask("t1");
+
+  /* dg1 and dg2 both use target A of t1 */
+  const char* variables[][3] = {
+    { "dg1", "t1", "A" },
+    { "dg2", "t1", "A" },
+    { "dg2", "t1", "B" },
+    { "dg3", "t2", "A" },
+    { "dg4", "r1", "A" },
+  };
+  for (size_t i = 0; i < 5; ++i)
+  {
+    SedDataGenerator* dg = doc.getDataGenerator(variables[i][0]);
+    if (dg == NULL)
+    {
+      dg = doc.createDataGenerator();
+      dg->setId(variables[i][0]);
+    }
+    SedVariable* var = dg->createVariable();
+    var->setTaskReference(variables[i][1]);
+    var->setTarget(variables[i][2]);
+  }
+
+  SedPlot2D* plot = doc.createPlot2D();
+  plot->setId("p1");
+  SedCurve* curve = plot->createCurve();
+  curve->setXDataReference("dg1");
+  curve->setYDataReference("dg2");
+  SedReport* report = doc.createReport();
+  report->setId("p2");
+  report->createDataSet()->setDataReference("dg3");
+  plot = doc.createPlot2D();
+  plot->setId("p3");
+  plot->createCurve()->setYDataReference("dg4");
+
+  SedDependencyGraph graph(&doc);
+  SedDependencySlice slice(graph);
+  fail_unless( slice.addOutput("dg1") == LIBSEDML_INVALID_ATTRIBUTE_VALUE );
+  fail_unless( slice.addOutput("p1") == LIBSEDML_OPERATION_SUCCESS );
+
+  // p1, dg1, dg2, t1, m1 and s1
+  fail_unless( slice.getNodes().size() == 6 );
+  fail_unless( !slice.contains(doc.getTask("t2")) );
+  fail_unless( slice.getNumTasks() == 1 );
+  fail_unless( slice.getNumModels() == 1 );
+  fail_unless( slice.getNumSimulations() == 1 );
+  fail_unless( slice.getNumDataGenerators() == 2 );
+  fail_unless( slice.getRecordedVariables(doc.getTask("t1")).size() == 2 );
+  fail_unless( slice.getRecordedVariables(doc.getTask("t2")).empty() );
+
+  TestBackend backend;
+  SedExecutor executor(&backend, 2);
+  fail_unless( executor.execute(slice) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( backend.mNumTasks == 1 );
+  fail_unless( backend.mNumDataGenerators == 2 );
+  fail_unless( executor.getStatus(graph.getNodeIndex("t2"))
+               == LIBSEDML_INVALID_OBJECT );
+
+  // the tasks a repeated task runs are used, but not run on their own
+  fail_unless( slice.addOutput("p3") == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( slice.getNumTasks() == 2 );
+  fail_unless( slice.contains(doc.getTask("r1")) );
+  fail_unless( slice.getRecordedVariables(doc.getTask("r1")).size() == 1 );
+}
+END_TEST
+
+
+START_TEST (test_result_store)
+{
+  // room for one of the two columns only
+  SedResultStore store(600 * sizeof(double));
+  vector<size_t> shape(2);
+  shape[0] = 10;
+  shape[1] = 50;
+
+  fail_unless( store.createColumn("t1", "A", "", shape) == 0 );
+  fail_unless( store.createColumn("t1", "A", "", shape)
+               == LIBSEDML_DUPLICATE_OBJECT_ID );
+  fail_unless( store.createColumn("t1", "B", "", shape) == 1 );
+  fail_unless( !store.isMapped(0) );
+  fail_unless( store.getMemoryUsage() == 500 * sizeof(double) );
+
+  double* values = store.getData(1);
+  for (size_t i = 0; i < 500; ++i)
+  {
+    values[i] = (double)i;
+    store.getData(0)[i] = 1.0;
+  }
+
+  // point 7 of each of the 10 iterations
+  vector<size_t> index(2, 0);
+  index[1] = 7;
+  SedResultView view = store.getView(1, 0, index);
+  fail_unless( view.size == 10 );
+  fail_unless( view.stride == 50 );
+  for (size_t i = 0; i < view.size; ++i)
+    fail_unless( view.data[i * view.stride] == 50.0 * i + 7 );
+
+  // data generators read the columns in place
+  SedDocument doc;
+  SedDataGenerator* dg = doc.createDataGenerator();
+  dg->setId("dg1");
+  const char* targets[] = { "A", "B" };
+  for (size_t i = 0; i < 2; ++i)
+  {
+    SedVariable* var = dg->createVariable();
+    var->setId(targets[i]);
+    var->setTaskReference("t1");
+    var->setTarget(targets[i]);
+  }
+  ASTNode* math = SBML_parseL3Formula("A + B");
+  dg->setMath(math);
+  delete math;
+
+  SedExpressionDag dag(&doc);
+  vector<const double*> inputs;
+  vector<double> result(500);
+  double* results[] = { &result[0] };
+  fail_unless( store.getInputs(dag, inputs) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( inputs[1] == values );
+  fail_unless( dag.evaluate(&inputs[0], 500, results)
+               == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( result[499] == 500.0 );
+
+  store.clear();
+  fail_unless( store.getNumColumns() == 0 );
+  fail_unless( store.getInputs(dag, inputs) == LIBSEDML_INVALID_OBJECT );
+}
+END_TEST
+
+
+START_TEST (test_target_index)
+{
+  const char* model =
+    "<sbml xmlns='http://www.sbml.org/sbml/level3/version1/core'"
+    " level='3' version='1'>"
+    "  <model id='m'>"
+    "    <listOfSpecies>"
+    "      <species id='TRIO' initialConcentration='0.5'/>"
+    "      <species id='GLC'/>"
+    "    </listOfSpecies>"
+    "    <listOfParameters>"
+    "      <parameter id='k' value='1'/>"
+    "    </listOfParameters>"
+    "    <listOfReactions>"
+    "      <reaction id='R1'>"
+    "        <kineticLaw>"
+    "          <listOfLocalParameters>"
+    "            <localParameter id='k' value='2'/>"
+    "          </listOfLocalParameters>"
+    "        </kineticLaw>"
+    "      </reaction>"
+    "    </listOfReactions>"
+    "  </model>"
+    "</sbml>";
+
+  XMLNode* root = XMLNode::convertStringToXMLNode(model);
+  fail_unless( root != NULL );
+
+  SedTargetIndex index(root);
+  fail_unless( index.getNumElements() == 12 );
+
+  // resolved through the id index
+  SedTarget target("/sbml:sbml/sbml:model/sbml:listOfSpecies/"
+                   "sbml:species[@id='TRIO']/@initialConcentration");
+  fail_unless( target.isValid() );
+  fail_unless( target.isIdReference() );
+  string value;
+  fail_unless( index.getValue(target, value) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( value == "0.5" );
+
+  // the local parameter k is not the global one
+  target.compile("/sbml:sbml/sbml:model/sbml:listOfParameters/"
+                 "sbml:parameter[@id='k']/@value");
+  fail_unless( index.getValue(target, value) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( value == "1" );
+
+  // other forms are evaluated step by step
+  target.compile("//sbml:reaction[@id='R1']//sbml:localParameter[1]/@value");
+  fail_unless( target.isValid() );
+  fail_unless( !target.isIdReference() );
+  fail_unless( index.getValue(target, value) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( value == "2" );
+
+  vector<const XMLNode*> elements;
+  target.compile("//*[@id='k']");
+  fail_unless( index.getElements(target, elements) == 2 );
+
+  target.compile("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[2]");
+  fail_unless( index.getElement(target) == index.getElementById("GLC") );
+
+  fail_unless( target.compile("species[@id='TRIO']")
+               == LIBSEDML_INVALID_ATTRIBUTE_VALUE );
+  fail_unless( index.getElement(target) == NULL );
+
+  delete root;
+}
+END_TEST
+
+
+/*
+ * A resolver that serves its sources from memory.
+ */
+class TestModelResolver : public SedModelResolver
+{
+protected:
+  virtual int loadSource(const std::string& source, std::string& content)
+  {
+    if (source != "model.xml")
+      return LIBSEDML_OPERATION_FAILED;
+
+    content =
+      "<?xml version='1.0' encoding='UTF-8'?>"
+      "<sbml xmlns='http://www.sbml.org/sbml/level3/version1/core'"
+      " level='3' version='1'>"
+      "  <model id='m'>"
+      "    <listOfParameters>"
+      "      <parameter id='k1' value='1'/>"
+      "      <parameter id='k2' value='2'/>"
+      "    </listOfParameters>"
+      "  </model>"
+      "</sbml>";
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+};
+
+
+START_TEST (test_model_resolver)
+{
+  SedDocument doc(1, 4);
+
+  SedModel* m1 = doc.createModel();
+  m1->setId("m1");
+  m1->setSource("model.xml");
+  SedChangeAttribute* attribute = m1->createChangeAttribute();
+  attribute->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/"
+                       "sbml:parameter[@id='k1']/@value");
+  attribute->setNewValue("3");
+
+  SedModel* m2 = doc.createModel();
+  m2->setId("m2");
+  m2->setSource("#m1");
+  SedRemoveXML* remove = m2->createRemoveXML();
+  remove->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/"
+                    "sbml:parameter[@id='k2']");
+  SedComputeChange* compute = m2->createComputeChange();
+  compute->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/"
+                     "sbml:parameter[@id='k1']/@value");
+  SedVariable* var = compute->createVariable();
+  var->setId("x");
+  var->setModelReference("m1");
+  var->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/"
+                 "sbml:parameter[@id='k1']");
+  SedParameter* p = compute->createParameter();
+  p->setId("p");
+  p->setValue(2);
+  ASTNode* math = SBML_parseL3Formula("x * p");
+  compute->setMath(math);
+  delete math;
+
+  // the same source and changes in another model share their XML
+  SedModel* m3 = doc.createModel();
+  m3->setId("m3");
+  m3->setSource("model.xml");
+  m3->addChange(attribute);
+
+  TestModelResolver resolver;
+  std::shared_ptr<const XMLNode> first;
+  std::shared_ptr<const XMLNode> second;
+  std::shared_ptr<const XMLNode> third;
+  fail_unless( resolver.resolve(m1, first) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( resolver.resolve(m2, second) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( resolver.resolve(m3, third) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( first == third );
+  fail_unless( resolver.getNumSources() == 1 );
+  fail_unless( resolver.getNumInstances() == 2 );
+
+  SedTargetIndex index(first.get());
+  string value;
+  SedTarget target("/sbml:sbml/sbml:model/sbml:listOfParameters/"
+                   "sbml:parameter[@id='k1']/@value");
+  fail_unless( index.getValue(target, value) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( value == "3" );
+  fail_unless( index.getElementById("k2") != NULL );
+
+  SedTargetIndex changed(second.get());
+  fail_unless( changed.getValue(target, value) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( value == "6" );
+  fail_unless( changed.getElementById("k2") == NULL );
+
+  // models referring to themselves cannot be resolved
+  SedModel* m4 = doc.createModel();
+  m4->setId("m4");
+  m4->setSource("#m4");
+  fail_unless( resolver.resolve(m4, third) == LIBSEDML_INVALID_OBJECT );
+  fail_unless( third == NULL );
+
+  m4->setSource("missing.xml");
+  fail_unless( resolver.resolve(m4, third) == LIBSEDML_OPERATION_FAILED );
+
+  resolver.clearCache();
+  fail_unless( resolver.getNumSources() == 0 );
+  fail_unless( resolver.getNumInstances() == 0 );
+}
+END_TEST
+
+
+START_TEST (test_model_resolver_constants)
+{
+  SedDocument doc(1, 4);
+  const char* formulas[] = { "p * 2", "p * 3" };
+  std::shared_ptr<const XMLNode> models[2];
+  TestModelResolver resolver;
+
+  // changes that differ only in an integer constant are not shared
+  for (int i = 0; i < 2; ++i)
+  {
+    SedModel* model = doc.createModel();
+    model->setSource("model.xml");
+    SedComputeChange* compute = model->createComputeChange();
+    compute->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/"
+                       "sbml:parameter[@id='k1']/@value");
+    SedParameter* p = compute->createParameter();
+    p->setId("p");
+    p->setValue(1);
+    ASTNode* math = SBML_parseL3Formula(formulas[i]);
+    compute->setMath(math);
+    delete math;
+
+    fail_unless( resolver.resolve(model, models[i])
+                 == LIBSEDML_OPERATION_SUCCESS );
+  }
+
+  fail_unless( resolver.getNumInstances() == 2 );
+  fail_unless( models[0] != models[1] );
+
+  string value;
+  SedTarget target("/sbml:sbml/sbml:model/sbml:listOfParameters/"
+                   "sbml:parameter[@id='k1']/@value");
+  fail_unless( SedTargetIndex(models[0].get()).getValue(target, value)
+               == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( value == "2" );
+  fail_unless( SedTargetIndex(models[1].get()).getValue(target, value)
+               == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( value == "3" );
+}
+END_TEST
+
+
+START_TEST (test_model_patch)
+{
+  SedDocument doc(1, 4);
+  SedModel* model = doc.createModel();
+  model->setId("m1");
+  model->setSource("model.xml");
+  SedTask* task = doc.createTask();
+  task->setId("task1");
+  task->setModelReference("m1");
+
+  SedRepeatedTask* scan = doc.createRepeatedTask();
+  scan->setId("scan");
+  scan->setRangeId("r");
+  scan->setResetModel(false);
+  SedVectorRange* r = scan->createVectorRange();
+  r->setId("r");
+  r->addValue(1);
+  r->addValue(2);
+  r->addValue(3);
+  scan->createSubTask()->setTask("task1");
+
+  // k1 accumulates the values of r, k2 follows them
+  SedSetValue* setValue = scan->createTaskChange();
+  setValue->setModelReference("m1");
+  setValue->setRange("r");
+  setValue->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/"
+                      "sbml:parameter[@id='k1']/@value");
+  SedVariable* var = setValue->createVariable();
+  var->setId("k");
+  var->setModelReference("m1");
+  var->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/"
+                 "sbml:parameter[@id='k1']");
+  ASTNode* math = SBML_parseL3Formula("k + r");
+  setValue->setMath(math);
+  delete math;
+
+  setValue = scan->createTaskChange();
+  setValue->setModelReference("m1");
+  setValue->setRange("r");
+  setValue->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/"
+                      "sbml:parameter[@id='k2']");
+  math = SBML_parseL3Formula("10 * r");
+  setValue->setMath(math);
+  delete math;
+
+  TestModelResolver resolver;
+  SedModelPatch patch(scan);
+  fail_unless( !patch.isCompiled() );
+  fail_unless( patch.compile(resolver) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( patch.isCompiled() );
+  fail_unless( patch.getNumSlots() == 2 );
+
+  int k1 = patch.getSlotIndex("m1", "/sbml:sbml/sbml:model/"
+                              "sbml:listOfParameters/sbml:parameter[@id='k1']");
+  int k2 = patch.getSlotIndex("m1", "/sbml:sbml/sbml:model/"
+                              "sbml:listOfParameters/sbml:parameter[@id='k2']");
+  fail_unless( k1 == 0 );
+  fail_unless( k2 == 1 );
+  fail_unless( patch.getAttribute(k2) == "value" );
+  fail_unless( patch.getBaseValue(k1) == 1 );
+
+  SedIterationSpace space(scan);
+  fail_unless( patch.update(space, 0) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( patch.update(space, 1) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( patch.getValue(k1) == 4 );
+  fail_unless( patch.getValue(k2) == 20 );
+
+  // the shared model is left as it is
+  std::shared_ptr<const XMLNode> base = patch.getBaseModel("m1");
+  fail_unless( patch.getElement(k1)->getAttrValue("value") == "1" );
+
+  XMLNode copy(*base);
+  fail_unless( patch.apply("m1", copy) == LIBSEDML_OPERATION_SUCCESS );
+  SedTargetIndex index(&copy);
+  fail_unless( index.getElementById("k2")->getAttrValue("value") == "20" );
+
+  // with resetModel, every iteration starts from the shared model
+  scan->setResetModel(true);
+  fail_unless( patch.update(space, 2) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( patch.getValue(k1) == 4 );
+  fail_unless( patch.isChanged(k1) );
+
+  patch.reset();
+  fail_unless( !patch.isChanged(k1) );
+  fail_unless( patch.getValue(k2) == 2 );
+}
+END_TEST
+
+
+/*
+ * A backend that runs repeated tasks as ensembles of two iterations.
+ */
+class TestEnsembleBackend : public SedSimulatorBackend
+{
+public:
+  TestEnsembleBackend() : mNumTasks(0), mNumBatches(0) {}
+
+  virtual int executeTask(const SedTask*)
+  {
+    ++mNumTasks;
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  virtual unsigned int getEnsembleSize() const
+  {
+    return 2;
+  }
+
+  virtual int executeEnsemble(const SedEnsembleBatch& batch)
+  {
+    ++mNumBatches;
+    fail_unless( batch.getSimulation() != NULL );
+    fail_unless( batch.getNumParameters() == 1 );
+
+    const double* values = batch.getValues(0);
+    for (unsigned int i = 0; i < batch.getNumIterations(); ++i)
+    {
+      mIterations.push_back(batch.getIteration(i));
+      mValues.push_back(values[i]);
+    }
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  std::atomic<int> mNumTasks;
+  int mNumBatches;
+  vector<unsigned int> mIterations;
+  vector<double> mValues;
+};
+
+
+START_TEST (test_ensemble_batch)
+{
+  SedDocument doc(1, 4);
+  SedModel* model = doc.createModel();
+  model->setId("m1");
+  model->setSource("model.xml");
+  doc.createUniformTimeCourse()->setId("s1");
+  SedTask* task = doc.createTask();
+  task->setId("task1");
+  task->setModelReference("m1");
+  task->setSimulationReference("s1");
+
+  SedRepeatedTask* scan = doc.createRepeatedTask();
+  scan->setId("scan");
+  scan->setRangeId("r");
+  scan->setResetModel(true);
+  SedVectorRange* r = scan->createVectorRange();
+  r->setId("r");
+  for (unsigned int i = 0; i < 5; ++i)
+    r->addValue(i * 0.5);
+  scan->createSubTask()->setTask("task1");
+
+  SedSetValue* setValue = scan->createTaskChange();
+  setValue->setModelReference("m1");
+  setValue->setRange("r");
+  setValue->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/"
+                      "sbml:parameter[@id='k1']/@value");
+  ASTNode* math = SBML_parseL3Formula("r");
+  setValue->setMath(math);
+  delete math;
+
+  fail_unless( SedEnsembleBatch::isBatchable(scan) );
+
+  // without a resolver, the iterations run one at a time
+  TestEnsembleBackend backend;
+  SedExecutor executor(&backend, 2);
+  fail_unless( executor.execute(&doc) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( backend.mNumTasks == 6 );
+  fail_unless( backend.mNumBatches == 0 );
+
+  TestModelResolver resolver;
+  executor.setModelResolver(&resolver);
+  fail_unless( executor.execute(&doc) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( backend.mNumTasks == 7 );
+  fail_unless( backend.mNumBatches == 3 );
+  fail_unless( backend.mIterations.size() == 5 );
+  for (unsigned int i = 0; i < 5; ++i)
+  {
+    fail_unless( backend.mIterations[i] == i );
+    fail_unless( backend.mValues[i] == i * 0.5 );
+  }
+
+  // a model that keeps its state needs the previous iteration
+  scan->setResetModel(false);
+  fail_unless( !SedEnsembleBatch::isBatchable(scan) );
+}
+END_TEST
+
+
+START_TEST (test_load_statistics)
+{
+  string xml =
+    "<sedML xmlns='http://sed-ml.org/sed-ml/level1/version2' level='1' version='2'>"
+    "<listOfDataGenerators><dataGenerator id='dg1'>"
+    "<math xmlns='http://www.w3.org/1998/Math/MathML'><ci> x </ci></math>"
+    "</dataGenerator></listOfDataGenerators></sedML>";
+
+  SedReader reader;
+  reader.setTraceEnabled(true);
+  SedDocument* doc = reader.readSedMLFromString(xml);
+  fail_unless( doc->getNumErrors() == 0 );
+
+  const SedLoadStatistics& stats = doc->getLoadStatistics();
+  fail_unless( stats.getTraceEnabled() );
+
+  if (SedLoadStatistics::isEnabled())
+  {
+    fail_unless( stats.getCount(SEDML_PHASE_READ) == 1 );
+    fail_unless( stats.getCount(SEDML_PHASE_CONSTRUCT) == 3 );
+    fail_unless( stats.getCount(SEDML_PHASE_MATHML) == 1 );
+    fail_unless( stats.getNumTraceEvents() > 0 );
+    fail_unless( stats.getTotalSeconds() >= stats.getSeconds(SEDML_PHASE_READ) );
+  }
+  else
+  {
+    fail_unless( stats.getCount(SEDML_PHASE_READ) == 0 );
+    fail_unless( stats.getNumTraceEvents() == 0 );
+    fail_unless( stats.getTotalSeconds() == 0 );
+  }
+
+  ostringstream trace;
+  fail_unless( stats.writeChromeTrace(trace) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( trace.str().find("\"traceEvents\"") != string::npos );
+
+  SedWriter writer;
+  ostringstream out;
+  fail_unless( writer.writeSedML(doc, out) );
+  fail_unless( writer.getWriteStatistics().getCount(SEDML_PHASE_WRITE_MATHML)
+               == (SedLoadStatistics::isEnabled() ? 1u : 0u) );
+
+  delete doc;
+}
+END_TEST
+
+
+/*
+ * Records the type codes of the elements visited, in order, leaving out
+ * the lists, which are visited once for every part of them.
+ */
+class TestTypeCodeVisitor : public SedReducibleVisitor
+{
+public:
+  TestTypeCodeVisitor() : mDepth(0), mBalanced(true) {}
+
+  virtual bool visit(const SedBase& x)
+  {
+    mTypeCodes.push_back(x.getTypeCode());
+    ++mDepth;
+    return true;
+  }
+
+  virtual void leave(const SedBase& x)
+  {
+    if (mDepth == 0)
+      mBalanced = false;
+    else
+      --mDepth;
+  }
+
+  virtual SedReducibleVisitor* createWorker() const
+  {
+    return new TestTypeCodeVisitor();
+  }
+
+  virtual void reduce(const SedReducibleVisitor& worker)
+  {
+    const TestTypeCodeVisitor& other =
+      static_cast<const TestTypeCodeVisitor&>(worker);
+    mTypeCodes.insert(mTypeCodes.end(), other.mTypeCodes.begin(),
+                      other.mTypeCodes.end());
+    mBalanced = mBalanced && other.mBalanced && other.mDepth == 0;
+  }
+
+  vector<int> mTypeCodes;
+  unsigned int mDepth;
+  bool mBalanced;
+};
+
+
+START_TEST (test_parallel_visitor)
+{
+  SedDocument doc;
+  doc.createUniformTimeCourse()->createAlgorithm()->setKisaoID("KISAO:0000019");
+  doc.createModel()->createChangeAttribute();
+  doc.createTask();
+
+  for (int i = 0; i < 25; ++i)
+  {
+    SedDataGenerator* dg = doc.createDataGenerator();
+    dg->createVariable();
+    dg->createParameter();
+  }
+
+  TestTypeCodeVisitor sequential;
+  fail_unless( doc.accept(sequential) );
+  fail_unless( sequential.mBalanced && sequential.mDepth == 0 );
+  // the document, 4 lists, 5 elements and 25 data generators with 2
+  // children each
+  fail_unless( sequential.mTypeCodes.size() == 85 );
+  fail_unless( sequential.mTypeCodes[1] == SEDML_LIST_OF );
+  fail_unless( sequential.mTypeCodes[2] == SEDML_SIMULATION_UNIFORMTIMECOURSE );
+
+  for (unsigned int numThreads = 1; numThreads <= 4; numThreads += 3)
+  {
+    SedParallelVisitor parallel(numThreads);
+    fail_unless( parallel.getNumThreads() == numThreads );
+
+    // each list is entered once, however many parts it is split into
+    TestTypeCodeVisitor visitor;
+    parallel.traverse(doc, visitor);
+    fail_unless( visitor.mBalanced && visitor.mDepth == 0 );
+    fail_unless( visitor.mTypeCodes == sequential.mTypeCodes );
+  }
+
+  // children are skipped when visit returns false
+  class TestTopLevelVisitor : public SedVisitor
+  {
+  public:
+    TestTopLevelVisitor() : mCount(0) {}
+    virtual bool visit(const SedBase& x)
+    {
+      ++mCount;
+      return x.getTypeCode() == SEDML_LIST_OF;
+    }
+    unsigned int mCount;
+  } topLevel;
+
+  doc.accept(topLevel);
+  // the document, 4 lists and 28 top-level elements
+  fail_unless( topLevel.mCount == 33 );
+}
+END_TEST
+
+
+START_TEST (test_error_messages)
+{
+  SedError error(SedNotUTF8, 1, 2, "in test.xml");
+  fail_unless( error.isValid() );
+  fail_unless( error.getErrorId() == SedNotUTF8 );
+  fail_unless( error.getSeverity() == LIBSEDML_SEV_ERROR );
+  fail_unless( error.getShortMessage() == "File does not use UTF-8 encoding" );
+
+  // the full message is put together when the error is created, so it is
+  // the same through XMLError and in copies
+  const XMLError& base = error;
+  fail_unless( base.getMessage().find("An SED-ML XML file must use UTF-8") == 0 );
+  fail_unless( base.getMessage().find(" in test.xml\n") != string::npos );
+  SedError copy(error);
+  fail_unless( copy.getMessage() == base.getMessage() );
+  fail_unless( base.toString().find(copy.getMessage()) != string::npos );
+
+  ostringstream stream;
+  error.print(stream);
+  fail_unless( stream.str().find(copy.getMessage()) != string::npos );
+
+  // codes in the range of SED-ML codes, but not in the table
+  SedError unknown(SedNotUTF8 + 7, 1, 2, "details");
+  fail_unless( !unknown.isValid() );
+  fail_unless( unknown.getSeverity() == LIBSEDML_SEV_WARNING );
+  fail_unless( unknown.getMessage().find("details") != string::npos );
+
+  // other codes keep their details as message
+  SedError other(200000, 1, 2, "application error");
+  fail_unless( other.getMessage() == "application error" );
+}
+END_TEST
+
+
+static bool
+isOddErrorId(const unsigned int errorId)
+{
+  return errorId % 2 == 1;
+}
+
+
+START_TEST (test_error_log_counts)
+{
+  SedErrorLog log;
+
+  for (unsigned int i = 0; i < 1000; ++i)
+    log.logError(200000 + i % 4, 1, 2, "", 0, 0,
+                 i % 2 ? LIBSEDML_SEV_WARNING : LIBSEDML_SEV_ERROR);
+
+  fail_unless( log.getNumErrors() == 1000 );
+  fail_unless( log.getNumFailsWithSeverity(LIBSEDML_SEV_WARNING) == 500 );
+  fail_unless( log.getNumErrorsWithId(200001) == 250 );
+  fail_unless( log.contains(200003) );
+  fail_unless( !log.contains(200004) );
+
+  log.remove(200001);
+  fail_unless( log.getNumErrorsWithId(200001) == 249 );
+  fail_unless( log.getNumFailsWithSeverity(LIBSEDML_SEV_WARNING) == 499 );
+
+  // the kept errors stay in order
+  fail_unless( log.removeAllExcept(isOddErrorId) == 500 );
+  fail_unless( log.getNumErrors() == 499 );
+  fail_unless( log.getNumFailsWithSeverity(LIBSEDML_SEV_ERROR) == 0 );
+  fail_unless( log.getError(0)->getErrorId() == 200003 );
+  fail_unless( log.getError(1)->getErrorId() == 200001 );
+
+  log.clearLog();
+  fail_unless( !log.contains(200003) );
+
+  // changes made through XMLErrorLog are counted as well
+  XMLErrorLog& base = log;
+  log.logError(200002, 1, 2, "", 0, 0, LIBSEDML_SEV_WARNING);
+  fail_unless( log.getNumFailsWithSeverity(LIBSEDML_SEV_WARNING) == 1 );
+
+  base.changeErrorSeverity(LIBSBML_SEV_WARNING, LIBSBML_SEV_ERROR);
+  fail_unless( log.getNumFailsWithSeverity(LIBSEDML_SEV_WARNING) == 0 );
+  fail_unless( log.getNumFailsWithSeverity(LIBSEDML_SEV_ERROR) == 1 );
+
+  base.clearLog();
+  log.logError(200004, 1, 2, "", 0, 0, LIBSEDML_SEV_ERROR);
+  fail_unless( !log.contains(200002) );
+  fail_unless( log.contains(200004) );
+  fail_unless( log.getNumFailsWithSeverity(LIBSEDML_SEV_ERROR) == 1 );
+
+  log.clearLog();
+
+  // a full log only keeps fatal errors
+  log.setMaxErrors(10);
+  fail_unless( log.getMaxErrors() == 10 );
+
+  for (unsigned int i = 0; i < 20; ++i)
+    log.logError(200000, 1, 2, "", 0, 0, LIBSEDML_SEV_WARNING);
+  log.logError(200001, 1, 2, "", 0, 0, LIBSEDML_SEV_FATAL);
+
+  fail_unless( log.getNumErrors() == 11 );
+  fail_unless( log.getNumDroppedErrors() == 10 );
+  fail_unless( log.contains(200001) );
+
+  log.clearLog();
+  fail_unless( log.getNumDroppedErrors() == 0 );
+}
+END_TEST
+
 
 Suite *
 create_suite_SedMLIssues (void)
@@ -117,6 +1811,33 @@ create_suite_SedMLIssues (void)
   cout << "  libSEDML : " << getLibSEDMLDottedVersion() << endl << endl;
  
   tcase_add_test( tcase, test_mathml_issue1         );
+  tcase_add_test( tcase, test_element_index         );
+  tcase_add_test( tcase, test_stream_reader         );
+  tcase_add_test( tcase, test_batch_reader          );
+  tcase_add_test( tcase, test_shared_namespaces     );
+  tcase_add_test( tcase, test_arena                 );
+  tcase_add_test( tcase, test_vector_range_values   );
+  tcase_add_test( tcase, test_number_conversion );
+  tcase_add_test( tcase, test_vector_range_binary_values );
+  tcase_add_test( tcase, test_vector_range_binary_count );
+  tcase_add_test( tcase, test_snapshot              );
+  tcase_add_test( tcase, test_read_from_buffer      );
+  tcase_add_test( tcase, test_list_id_index         );
+  tcase_add_test( tcase, test_math_program          );
+  tcase_add_test( tcase, test_iteration_space       );
+  tcase_add_test( tcase, test_executor              );
+  tcase_add_test( tcase, test_expression_dag        );
+  tcase_add_test( tcase, test_dependency_slice      );
+  tcase_add_test( tcase, test_result_store          );
+  tcase_add_test( tcase, test_target_index          );
+  tcase_add_test( tcase, test_model_resolver        );
+  tcase_add_test( tcase, test_model_resolver_constants );
+  tcase_add_test( tcase, test_model_patch           );
+  tcase_add_test( tcase, test_ensemble_batch        );
+  tcase_add_test( tcase, test_load_statistics       );
+  tcase_add_test( tcase, test_parallel_visitor      );
+  tcase_add_test( tcase, test_error_messages        );
+  tcase_add_test( tcase, test_error_log_counts       );
 
   suite_add_tcase(suite, tcase);
 